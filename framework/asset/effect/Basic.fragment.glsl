@@ -17,9 +17,17 @@ uniform float 		alphaThreshold;
 varying vec2 vertexUV;
 varying vec3 vertexUVW;
 
+#ifdef INSTANCING
+	varying vec4 vertexDiffuseColor;
+#endif // INSTANCING
+
 void main(void)
 {
-	vec4 	diffuse 		= diffuseColor;
+	#ifdef INSTANCING
+		vec4 	diffuse 		= vertexDiffuseColor;
+	#else
+		vec4 	diffuse 		= diffuseColor;
+	#endif // INSTANCING
 	
 	#if defined(DIFFUSE_CUBEMAP)
 		diffuse		= textureCube(diffuseCubeMap, vertexUVW);
@@ -13,6 +13,14 @@
 attribute vec3 position;
 attribute vec2 uv;
 
+#ifdef INSTANCING
+	// per-instance attributes, see DrawCall::instances()
+	attribute mat4 instanceModelToWorldMatrix;
+	attribute vec4 instanceDiffuseColor;
+
+	varying vec4 vertexDiffuseColor;
+#endif // INSTANCING
+
 uniform mat4 modelToWorldMatrix;
 uniform mat4 worldToScreenMatrix;
 uniform vec2 uvScale;
@@ -37,7 +45,10 @@ void main(void)
 		pos = skinning_moveVertex(pos);
 	#endif // NUM_BONES
 	
-	#ifdef MODEL_TO_WORLD
+	#ifdef INSTANCING
+		vertexDiffuseColor = instanceDiffuseColor;
+		pos = instanceModelToWorldMatrix * pos;
+	#elif defined(MODEL_TO_WORLD)
 		pos = modelToWorldMatrix * pos;
 	#endif
 	
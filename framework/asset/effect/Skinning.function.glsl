@@ -1,11 +1,50 @@
 #if defined(VERTEX_SHADER) && defined(NUM_BONES)
 
-	uniform 	mat4	boneMatrices[NUM_BONES];
 	attribute	vec4	boneIdsA;
 	attribute	vec4	boneIdsB;
 	attribute	vec4	boneWeightsA;
 	attribute	vec4	boneWeightsB;
 
+#ifdef BONE_TEXTURE
+
+	// the 4 columns of a bone matrix are 4 consecutive texels of the same row
+	uniform		sampler2D	boneTexture;
+	uniform		vec2		boneTextureSize;
+	uniform		float		boneTextureOffset;
+
+	mat4 skinning_boneMatrix(float boneId)
+	{
+		float	texelId	= (boneTextureOffset + boneId) * 4.0;
+		float	row		= floor(texelId / boneTextureSize.x);
+		vec2	uv		= (vec2(texelId - row * boneTextureSize.x, row) + 0.5) / boneTextureSize;
+		vec2	du		= vec2(1.0 / boneTextureSize.x, 0.0);
+
+		return mat4(
+			texture2D(boneTexture, uv),
+			texture2D(boneTexture, uv + du),
+			texture2D(boneTexture, uv + 2.0 * du),
+			texture2D(boneTexture, uv + 3.0 * du)
+		);
+	}
+
+	vec4 skinning_moveVertex(vec4 inputVec)
+	{
+		return (
+			boneWeightsA.x * skinning_boneMatrix(boneIdsA.x) +
+			boneWeightsA.y * skinning_boneMatrix(boneIdsA.y) +
+			boneWeightsA.z * skinning_boneMatrix(boneIdsA.z) +
+			boneWeightsA.w * skinning_boneMatrix(boneIdsA.w) +
+			boneWeightsB.x * skinning_boneMatrix(boneIdsB.x) +
+			boneWeightsB.y * skinning_boneMatrix(boneIdsB.y) +
+			boneWeightsB.z * skinning_boneMatrix(boneIdsB.z) +
+			boneWeightsB.w * skinning_boneMatrix(boneIdsB.w)
+			) * inputVec;
+	}
+
+#else
+
+	uniform 	mat4	boneMatrices[NUM_BONES];
+
 	vec4 skinning_moveVertex(vec4 inputVec)
 	{
 		return ( 
@@ -20,4 +59,6 @@
 			) * inputVec;	
 	}
 
+#endif // BONE_TEXTURE
+
 #endif // defined(VERTEX_SHADER) && defined(NUM_BONES)
@@ -0,0 +1,112 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+#include <cstdlib>
+
+namespace minko
+{
+    // minimal STL allocator returning storage aligned on 'Alignment' bytes, for data read with aligned SIMD loads
+    template <typename T, std::size_t Alignment = 16>
+    class AlignedAllocator
+    {
+    public:
+        typedef T               value_type;
+        typedef T*              pointer;
+        typedef const T*        const_pointer;
+        typedef T&              reference;
+        typedef const T&        const_reference;
+        typedef std::size_t     size_type;
+        typedef std::ptrdiff_t  difference_type;
+
+        template <typename U>
+        struct rebind
+        {
+            typedef AlignedAllocator<U, Alignment> other;
+        };
+
+    public:
+        AlignedAllocator()
+        {
+        }
+
+        template <typename U>
+        AlignedAllocator(const AlignedAllocator<U, Alignment>&)
+        {
+        }
+
+        pointer
+        allocate(size_type n)
+        {
+            if (n == 0)
+                return nullptr;
+
+            // over-allocate and keep the address returned by malloc right before the aligned block
+            auto raw = static_cast<char*>(std::malloc(n * sizeof(T) + Alignment + sizeof(void*)));
+
+            if (raw == nullptr)
+                throw std::bad_alloc();
+
+            auto aligned = reinterpret_cast<std::uintptr_t>(raw + sizeof(void*) + Alignment - 1)
+                & ~static_cast<std::uintptr_t>(Alignment - 1);
+
+            reinterpret_cast<void**>(aligned)[-1] = raw;
+
+            return reinterpret_cast<pointer>(aligned);
+        }
+
+        void
+        deallocate(pointer p, size_type)
+        {
+            if (p != nullptr)
+                std::free(reinterpret_cast<void**>(p)[-1]);
+        }
+
+        template <typename U, typename... Args>
+        void
+        construct(U* p, Args&&... args)
+        {
+            ::new(static_cast<void*>(p)) U(std::forward<Args>(args)...);
+        }
+
+        template <typename U>
+        void
+        destroy(U* p)
+        {
+            p->~U();
+        }
+
+        inline
+        bool
+        operator==(const AlignedAllocator&) const
+        {
+            return true;
+        }
+
+        inline
+        bool
+        operator!=(const AlignedAllocator&) const
+        {
+            return false;
+        }
+    };
+}
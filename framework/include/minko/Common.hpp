@@ -30,6 +30,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include <iostream>
 #include <list>
 #include <forward_list>
+#include <deque>
 #include <map>
 #include <memory>
 #include <queue>
@@ -93,6 +94,7 @@ namespace minko
         class VertexFormat;
         class VertexBuffer;
         class IndexBuffer;
+        class OcclusionBuffer;
 
         enum class TextureType
         {
@@ -133,12 +135,16 @@ namespace minko
 
             // supported from OES 3.0
             RGB_ETC2,
-            RGBA_ETC2
+            RGBA_ETC2,
+
+            // 32 bits per component, see AbstractContext::supportsFloatTextures()
+            RGBA32F
         };
 
         class AbstractTexture;
         class Texture;
         class CubeTexture;
+        class FloatTexture;
 
         struct ScissorBox
         {
@@ -180,7 +186,10 @@ namespace minko
         class Renderer;
         class PerspectiveCamera;
         class Culling;
+        class SpatialIndex;
+        class OcclusionCulling;
         class Picking;
+        class StaticBatching;
         class JobManager;
 
         class AbstractLight;
@@ -210,6 +219,7 @@ namespace minko
         class StructureProvider;
         class ValueBase;
         class Value;
+        class PropertyId;
         class Container;
         class AbstractFilter;
 
@@ -266,6 +276,9 @@ namespace minko
         class QuadGeometry;
         class TeapotGeometry;
         class LineGeometry;
+        class BVH;
+        class SkinClip;
+        class SkinPoseCache;
     }
 
     namespace animation
@@ -286,6 +299,9 @@ namespace minko
         class Box;
         class Frustum;
         class OctTree;
+        struct Vec3;
+        struct Vec4;
+        struct Mat4;
 
         inline
         bool
@@ -391,6 +407,7 @@ namespace minko
     namespace async
     {
         class Worker;
+        class ThreadPool;
     }
 
     namespace log
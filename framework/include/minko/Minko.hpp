@@ -37,6 +37,9 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/render/ProgramSignature.hpp"
 #include "minko/render/CompareMode.hpp"
 #include "minko/render/StencilOperation.hpp"
+#include "minko/math/Vec3.hpp"
+#include "minko/math/Vec4.hpp"
+#include "minko/math/Mat4.hpp"
 #include "minko/math/Vector2.hpp"
 #include "minko/math/Vector3.hpp"
 #include "minko/math/Vector4.hpp"
@@ -45,6 +48,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/math/Box.hpp"
 #include "minko/math/Ray.hpp"
 #include "minko/math/Frustum.hpp"
+#include "minko/math/OctTree.hpp"
 #include "minko/Signal.hpp"
 #include "minko/scene/Node.hpp"
 #include "minko/scene/NodeSet.hpp"
@@ -53,6 +57,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/data/StructureProvider.hpp"
 #include "minko/data/Value.hpp"
 #include "minko/data/Container.hpp"
+#include "minko/data/PropertyId.hpp"
 #include "minko/data/AbstractFilter.hpp"
 #include "minko/component/AbstractComponent.hpp"
 #include "minko/component/Transform.hpp"
@@ -71,7 +76,11 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/component/MouseManager.hpp"
 #include "minko/component/SkinningMethod.hpp"
 #include "minko/component/Culling.hpp"
+#include "minko/component/SpatialIndex.hpp"
+#include "minko/component/OcclusionCulling.hpp"
+#include "minko/component/PickingMethod.hpp"
 #include "minko/component/Picking.hpp"
+#include "minko/component/StaticBatching.hpp"
 #include "minko/component/AbstractAnimation.hpp"
 #include "minko/component/MasterAnimation.hpp"
 #include "minko/component/Animation.hpp"
@@ -83,9 +92,11 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/render/Program.hpp"
 #include "minko/render/VertexBuffer.hpp"
 #include "minko/render/IndexBuffer.hpp"
+#include "minko/render/OcclusionBuffer.hpp"
 #include "minko/render/AbstractTexture.hpp"
 #include "minko/render/Texture.hpp"
 #include "minko/render/CubeTexture.hpp"
+#include "minko/render/FloatTexture.hpp"
 #include "minko/render/Priority.hpp"
 #include "minko/geometry/Geometry.hpp"
 #include "minko/geometry/CubeGeometry.hpp"
@@ -93,6 +104,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/geometry/QuadGeometry.hpp"
 #include "minko/geometry/TeapotGeometry.hpp"
 #include "minko/geometry/LineGeometry.hpp"
+#include "minko/geometry/BVH.hpp"
 #include "minko/file/File.hpp"
 #include "minko/file/Options.hpp"
 #include "minko/file/Loader.hpp"
@@ -110,3 +122,4 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/input/Touch.hpp"
 #include "minko/scene/Layout.hpp"
 #include "minko/async/Worker.hpp"
+#include "minko/async/ThreadPool.hpp"
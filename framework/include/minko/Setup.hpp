@@ -251,6 +251,23 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 # define MINKO_ARCH    MINKO_ARCH_32
 #endif
 
+// SIMD (the math kernels fall back to scalar code when built with --no-simd)
+
+#if !defined(MINKO_NO_SIMD)
+# if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define MINKO_SSE2
+# endif
+# if defined(MINKO_SSE2) && defined(__AVX2__)
+#  define MINKO_AVX2
+# endif
+#endif
+
+#if defined(_MSC_VER)
+# define MINKO_ALIGN(bytes) __declspec(align(bytes))
+#else
+# define MINKO_ALIGN(bytes) __attribute__((aligned(bytes)))
+#endif
+
 // Device
 
 #define MINKO_DEVICE_UNKNOWN        0x00000000
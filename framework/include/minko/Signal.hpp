@@ -28,76 +28,192 @@ namespace minko
         public std::enable_shared_from_this<Signal<A...>>
     {
     private:
-        typedef std::function<void(A...)>                                        CallbackFunction;
-        typedef std::pair<float, CallbackFunction>                                Callback;
-        typedef typename std::list<Callback>::iterator                            CallbackIterator;
-        typedef typename std::list<std::pair<float, unsigned int>>::iterator    SlotIterator;
+        typedef std::function<void(A...)>                                       CallbackFunction;
 
         template <typename... B>
         class SignalSlot;
 
+        static const unsigned int NO_HANDLE = 0xffffffff;
+
+        // callbacks are stored by value, sorted by decreasing priority, and
+        // disconnected ones are only flagged until the next compaction
+        struct Callback
+        {
+            float               priority;
+            unsigned int        handle;
+            bool                connected;
+            CallbackFunction    function;
+        };
+
+        // index of a slot's callback in _callbacks (or in _toAdd when pending), the generation
+        // is incremented whenever the handle is released so that stale slots are ignored
+        struct Handle
+        {
+            unsigned int        generation;
+            unsigned int        index;
+            bool                pending;
+        };
+
     public:
         typedef std::shared_ptr<Signal<A...>>            Ptr;
         typedef std::shared_ptr<SignalSlot<A...>>        Slot;
 
     private:
-        std::list<Callback>                                        _callbacks;
-        std::list<std::pair<float, unsigned int>>                _slotIds;
-        unsigned int                                             _nextSlotId;
+        std::vector<Callback>                                   _callbacks;
+        std::vector<Handle>                                     _handles;
+        std::vector<unsigned int>                               _freeHandles;
+        unsigned int                                            _numCallbacks;
+        unsigned int                                            _numDisconnected;
 
-        bool                                                    _locked;
-        std::list<std::pair<Callback, uint>>                    _toAdd;
-        std::list<std::pair<CallbackIterator, SlotIterator>>    _toRemove;
-        std::list<unsigned int>                                    _toRemoveSlotId;
-        bool                                                    _signalListDirty;
+        unsigned int                                            _lockDepth;
+        std::vector<Callback>                                   _toAdd;
+        std::vector<unsigned int>                               _toRemove;
 
     private:
         Signal() :
             std::enable_shared_from_this<Signal<A...>>(),
-            _nextSlotId(0),
-            _locked(false),
-            _signalListDirty(false)
+            _numCallbacks(0),
+            _numDisconnected(0),
+            _lockDepth(0)
         {
         }
 
+        unsigned int
+        acquireHandle()
+        {
+            if (_freeHandles.empty())
+            {
+                _handles.push_back({ 0u, 0u, false });
+
+                return _handles.size() - 1;
+            }
+
+            auto handle = _freeHandles.back();
+
+            _freeHandles.pop_back();
+
+            return handle;
+        }
+
         void
-        removeConnectionById(const unsigned int connectionId)
+        releaseHandle(unsigned int handle)
         {
-            auto connectionIdIt = _slotIds.begin();
-            auto callbackIt     = _callbacks.begin();
+            ++_handles[handle].generation;
+            _freeHandles.push_back(handle);
+        }
+
+        void
+        updateHandles(unsigned int first)
+        {
+            for (auto i = first; i < _callbacks.size(); ++i)
+                if (_callbacks[i].handle != NO_HANDLE)
+                    _handles[_callbacks[i].handle].index = i;
+        }
 
-            while ((*connectionIdIt).second != connectionId)
+        void
+        insertCallback(Callback&& callback)
+        {
+            // most callbacks share the same priority, so the insertion point is searched from the end
+            auto index = _callbacks.size();
+
+            while (index > 0 && _callbacks[index - 1].priority < callback.priority)
+                --index;
+
+            auto& handle = _handles[callback.handle];
+
+            handle.pending = false;
+            if (index == _callbacks.size())
             {
-                connectionIdIt++;
-                callbackIt++;
+                handle.index = index;
+                _callbacks.push_back(std::move(callback));
             }
+            else
+            {
+                _callbacks.insert(_callbacks.begin() + index, std::move(callback));
+                updateHandles(index);
+            }
+        }
 
-            removeConnectionByIterator(connectionIdIt, callbackIt);
+        void
+        removeDisconnectedCallbacks()
+        {
+            auto first = std::find_if(_callbacks.begin(), _callbacks.end(), [](const Callback& callback)
+            {
+                return !callback.connected;
+            });
+            auto firstIndex = first - _callbacks.begin();
+
+            _callbacks.erase(
+                std::remove_if(first, _callbacks.end(), [](const Callback& callback) { return !callback.connected; }),
+                _callbacks.end()
+            );
+            _numDisconnected = 0;
+            updateHandles(firstIndex);
         }
 
         void
-        removeConnectionByIterator(SlotIterator         connectionIdIt,
-                                   CallbackIterator     callbackIt)
+        disconnect(unsigned int handleId, unsigned int generation)
         {
-            if (_locked)
+            auto& handle = _handles[handleId];
+
+            if (handle.generation != generation)
+                return;
+
+            if (handle.pending)
             {
-                auto addIt = std::find_if(_toAdd.begin(), _toAdd.end(), [&](std::pair<Callback, unsigned int>& add)
-                {
-                    return add.second == (*connectionIdIt).second;
-                });
+                // connected during the current execution, it is simply never added
+                auto& callback = _toAdd[handle.index];
+
+                callback.connected = false;
+                callback.handle = NO_HANDLE;
+            }
+            else
+            {
+                auto& callback = _callbacks[handle.index];
 
-                if (addIt != _toAdd.end())
-                    _toAdd.erase(addIt);
+                callback.handle = NO_HANDLE;
+                if (_lockDepth != 0)
+                    // the callback might be running: it is kept until the end of the execution
+                    _toRemove.push_back(handle.index);
                 else
                 {
-                    _toRemove.push_back(std::pair<CallbackIterator, SlotIterator>(callbackIt, connectionIdIt));
-                    _toRemoveSlotId.push_back(connectionIdIt->second);
+                    callback.connected = false;
+                    callback.function = nullptr;
+                    // compacted once they are the majority, so that _callbacks does not grow with
+                    // signals that are never executed
+                    if (++_numDisconnected > (_callbacks.size() >> 1))
+                        removeDisconnectedCallbacks();
                 }
             }
-            else
+
+            --_numCallbacks;
+            releaseHandle(handleId);
+        }
+
+        void
+        unlock()
+        {
+            for (auto index : _toRemove)
             {
-                _callbacks.erase(callbackIt);
-                _slotIds.erase(connectionIdIt);
+                auto& callback = _callbacks[index];
+
+                callback.connected = false;
+                callback.function = nullptr;
+                ++_numDisconnected;
+            }
+            _toRemove.clear();
+
+            if (_numDisconnected != 0)
+                removeDisconnectedCallbacks();
+
+            if (!_toAdd.empty())
+            {
+                auto toAdd = std::move(_toAdd);
+
+                _toAdd.clear();
+                for (auto& callback : toAdd)
+                    if (callback.connected)
+                        insertCallback(std::move(callback));
             }
         }
 
@@ -113,86 +229,46 @@ namespace minko
         uint
         numCallbacks() const
         {
-            return _callbacks.size();
-        }
-
-        void
-        sortSignals()
-        {
-            _callbacks.sort([&](const Callback& callback1, const Callback& callback2) -> bool
-            {
-                return callback1.first > callback2.first;
-            });
-
-            _slotIds.sort([&](const std::pair<float, unsigned int>& slot1, const std::pair<float, unsigned int>& slot2) -> bool
-            {
-                return slot1.first > slot2.first;
-            });
+            return _numCallbacks;
         }
 
         Slot
         connect(CallbackFunction callback, float priority = 0)
         {
-            auto connection = SignalSlot<A...>::create(Signal<A...>::shared_from_this(), _nextSlotId++);
+            auto handleId   = acquireHandle();
+            auto& handle    = _handles[handleId];
 
-            if (_locked)
-                _toAdd.push_back(std::pair<Callback, unsigned int>(std::pair<float, CallbackFunction>(priority, callback), connection->_id));
-            else
+            ++_numCallbacks;
+            if (_lockDepth != 0)
             {
-
-                _callbacks.push_back(std::pair<float, CallbackFunction>(priority, callback));
-                _slotIds.push_back(std::pair<float, unsigned int>(priority, connection->_id));
-
-                if (_callbacks.size() >= 2)
-                {
-                    auto prec = std::prev(_callbacks.end(), 2);
-
-                    if (priority > prec->first)
-                        sortSignals();
-                }
+                handle.pending = true;
+                handle.index = _toAdd.size();
+                _toAdd.push_back({ priority, handleId, true, std::move(callback) });
             }
+            else
+                insertCallback({ priority, handleId, true, std::move(callback) });
 
-            return connection;
+            return SignalSlot<A...>::create(Signal<A...>::shared_from_this(), handleId, handle.generation);
         }
 
         void
         execute(A... arguments)
         {
+            // callbacks connected or disconnected meanwhile are only (un)registered once the outermost
+            // execution is over, so the vector is never resized while it is iterated
+            const auto numCallbacks = _callbacks.size();
 
-            _locked = true;
-            for (auto& callback : _callbacks)
-                callback.second(arguments...);
-            _locked = false;
-
-            for (auto& callbackIt : _toRemove)
-            {
-                _callbacks.erase(callbackIt.first);
-                _slotIds.erase(callbackIt.second);
-            }
-
-            for (auto& callbackAndConnectionId : _toAdd)
+            ++_lockDepth;
+            for (auto i = 0u; i < numCallbacks; ++i)
             {
+                auto& callback = _callbacks[i];
 
-                _callbacks.push_back(callbackAndConnectionId.first);
-                _slotIds.push_back(std::pair<float, unsigned int>(callbackAndConnectionId.first.first, callbackAndConnectionId.second));
-
-                if (_callbacks.size() >= 2)
-                {
-                    auto prec = std::prev(_callbacks.end(), 2);
-
-                    if (callbackAndConnectionId.first.first > prec->first)
-                        _signalListDirty = true;
-                }
+                if (callback.connected)
+                    callback.function(arguments...);
             }
 
-            if (_signalListDirty)
-            {
-                _signalListDirty = false;
-                sortSignals();
-            }
-
-            _toAdd.clear();
-            _toRemove.clear();
+            if (--_lockDepth == 0 && (!_toRemove.empty() || !_toAdd.empty() || _numDisconnected != 0))
+                unlock();
         }
 
     private:
@@ -217,7 +293,7 @@ namespace minko
             {
                 if (_signal != nullptr)
                 {
-                    _signal->removeConnectionById(_id);
+                    _signal->disconnect(_handle, _generation);
                     _signal = nullptr;
                 }
             }
@@ -228,20 +304,22 @@ namespace minko
             }
 
         private:
-            std::shared_ptr<Signal<T...>>    _signal;
-            const unsigned int                _id;
+            std::shared_ptr<Signal<T...>>   _signal;
+            const unsigned int              _handle;
+            const unsigned int              _generation;
 
         private:
             inline static
             Ptr
-            create(std::shared_ptr<Signal<T...>> signal, const unsigned int id)
+            create(std::shared_ptr<Signal<T...>> signal, const unsigned int handle, const unsigned int generation)
             {
-                return std::shared_ptr<SignalSlot<T...>>(new SignalSlot(signal, id));
+                return std::shared_ptr<SignalSlot<T...>>(new SignalSlot(signal, handle, generation));
             }
 
-            SignalSlot(std::shared_ptr<Signal<T...>> signal, const unsigned int id) :
+            SignalSlot(std::shared_ptr<Signal<T...>> signal, const unsigned int handle, const unsigned int generation) :
                 _signal(signal),
-                _id(id)
+                _handle(handle),
+                _generation(generation)
             {
             }
         };
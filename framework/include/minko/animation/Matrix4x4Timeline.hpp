@@ -34,10 +34,17 @@ namespace minko
 
 		private:
 			typedef std::shared_ptr<math::Matrix4x4>			Matrix4x4Ptr;
-			typedef std::vector<std::pair<uint, Matrix4x4Ptr>>	MatrixTimetable;
+
 		private:
-			MatrixTimetable	_matrices;
-			bool			_interpolate;
+			// keys sorted by time, the 16 values of the i-th matrix start at _matrices[i * 16]
+			std::vector<uint>	_timetable;
+			std::vector<float>	_matrices;
+			bool				_interpolate;
+
+			// key found by the previous evaluation: playing forward only moves it to the next key
+			mutable uint		_keyId;
+			mutable Matrix4x4Ptr	_nextKey;
+			Matrix4x4Ptr		_value;
 
 		public:
 			inline static
@@ -73,9 +80,28 @@ namespace minko
 			AbstractTimeline::Ptr
 			clone();
 
+			inline
+			uint
+			numKeys() const
+			{
+				return _timetable.size();
+			}
+
+			inline
+			uint
+			keyTime(uint keyId) const
+			{
+				return _timetable[keyId];
+			}
+
 			void
 			update(uint time, UpdateTargetPtr, bool skipPropertyNameFormatting = true);
 
+			// Writes the value at 'time' to a matrix resolved beforehand, see Animation. The matrix is left
+			// untouched, without change notification, when it already holds that value.
+			void
+			evaluate(uint time, Matrix4x4Ptr output);
+
             Matrix4x4Ptr
             interpolate(uint time, Matrix4x4Ptr output = nullptr) const;
 
@@ -91,6 +117,9 @@ namespace minko
 			void
 			initializeMatrixTimetable(const std::vector<uint>&,
 									  const std::vector<Matrix4x4Ptr>&);
+
+			uint
+			keyId(uint time) const;
 		};
 	}
 }
\ No newline at end of file
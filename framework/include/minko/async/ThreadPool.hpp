@@ -0,0 +1,86 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+namespace minko
+{
+    namespace async
+    {
+        // Fixed set of worker threads used to split a CPU-bound loop across the available cores.
+        // parallelFor() must only be called from one thread at a time, and never from a task.
+        class ThreadPool
+        {
+        public:
+            typedef std::shared_ptr<ThreadPool>                         Ptr;
+            typedef std::function<void (uint taskId, uint threadId)>    Task;
+
+        private:
+            std::vector<std::thread>    _threads;
+            std::mutex                  _mutex;
+            std::condition_variable     _jobStarted;
+            std::condition_variable     _jobDone;
+            uint                        _jobId;
+            bool                        _stopped;
+
+            const Task*                 _task;
+            uint                        _numTasks;
+            std::atomic<uint>           _nextTaskId;
+            uint                        _numBusyThreads;
+
+        public:
+            inline static
+            Ptr
+            create(uint numThreads)
+            {
+                return std::shared_ptr<ThreadPool>(new ThreadPool(numThreads));
+            }
+
+            ~ThreadPool();
+
+            // number of worker threads, the calling thread excluded
+            inline
+            uint
+            numThreads() const
+            {
+                return _threads.size();
+            }
+
+            // Calls task(taskId, threadId) for each taskId in [0, numTasks) and returns once they are all done.
+            // The calling thread takes part in the job with threadId 0, worker threads use 1 to numThreads().
+            void
+            parallelFor(uint numTasks, const Task& task);
+
+        private:
+            ThreadPool(uint numThreads);
+
+            void
+            workerLoop(uint threadId);
+
+            void
+            runTasks(uint threadId);
+        };
+    }
+}
@@ -294,6 +294,13 @@ namespace minko
 			void
 			initialize();
 
+			inline
+			std::shared_ptr<SceneManager>
+			sceneManager() const
+			{
+				return _sceneManager;
+			}
+
 			void
 			targetAddedHandler(AbsCmpPtr cmp, NodePtr node);
 
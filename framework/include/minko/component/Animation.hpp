@@ -38,10 +38,26 @@ namespace minko
             typedef std::shared_ptr<MasterAnimation>                MasterAnimationPtr;
             typedef std::shared_ptr<scene::Node>                    NodePtr;
             typedef std::shared_ptr<AbstractComponent>              AbsCmpPtr;
+            typedef std::shared_ptr<animation::Matrix4x4Timeline>   Matrix4x4TimelinePtr;
+            typedef std::shared_ptr<math::Matrix4x4>                Matrix4x4Ptr;
+            typedef std::shared_ptr<data::Container>                ContainerPtr;
+            typedef Signal<ContainerPtr, const std::string&>::Slot  PropertyChangedSlot;
 
         private:
             std::vector<AbsTimelinePtr>                             _timelines;
 
+            // matrix timelines write straight to the matrices they animate, resolved once per target,
+            // other timelines look their property up on each update
+            std::vector<Matrix4x4TimelinePtr>                       _matrixTimelines;
+            std::vector<AbsTimelinePtr>                             _otherTimelines;
+            std::unordered_map<NodePtr, std::vector<Matrix4x4Ptr>>  _boundMatrices;     // nullptr for a missing property
+            std::unordered_map<NodePtr,
+                               std::list<PropertyChangedSlot>>      _bindingSlots;
+            Signal<AbsCmpPtr, NodePtr>::Slot                        _unbindSlot;
+
+            // a MasterAnimation drives the time and the updates of the animations of its hierarchy
+            bool                                                    _isDrivenByMaster;
+
         public:
             inline static
             Ptr
@@ -92,10 +108,23 @@ namespace minko
             void
             update() override;
 
+            const std::vector<Matrix4x4Ptr>&
+            boundMatrices(NodePtr target);
+
+            void
+            unbind(AbsCmpPtr, NodePtr target);
+
+            void
+            propertyAddedOrRemovedHandler(ContainerPtr, const std::string& propertyName);
+
+            void
+            propertyReferenceChangedHandler(ContainerPtr, const std::string& propertyName);
+
             void
             frameBeginHandler(std::shared_ptr<SceneManager> manager, float time, float deltaTime) override
             {
-                AbstractAnimation::frameBeginHandler(manager, time, deltaTime);
+                if (!_isDrivenByMaster)
+                    AbstractAnimation::frameBeginHandler(manager, time, deltaTime);
             }
 
             inline
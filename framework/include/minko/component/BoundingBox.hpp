@@ -54,6 +54,8 @@ namespace minko
             bool                                            _invalidBox;
             bool                                            _invalidWorldSpaceBox;
 
+            Signal<Ptr>::Ptr                                _changed;
+
             Signal<AbsCmpPtr, NodePtr>::Slot                _targetAddedSlot;
             Signal<AbsCmpPtr, NodePtr>::Slot                _targetRemovedSlot;
             Signal<NodePtr, NodePtr, AbsCmpPtr>::Slot       _componentAddedSlot;
@@ -124,9 +126,19 @@ namespace minko
                 return _worldSpaceBox;
             }
 
+            // recomputes the box, to be called when the geometry of a surface of the target changed
             void
             update();
 
+            // executed when the surfaces of the target change or update() is called,
+            // not when the target moves (see the "transform.modelToWorldMatrix" property)
+            inline
+            Signal<Ptr>::Ptr
+            changed() const
+            {
+                return _changed;
+            }
+
         private:
             BoundingBox(std::shared_ptr<math::Vector3> topRight, std::shared_ptr<math::Vector3> bottomLeft);
 
@@ -137,6 +149,9 @@ namespace minko
             void
             initialize();
 
+            void
+            updateBox();
+
             void
             updateWorldSpaceBox();
             
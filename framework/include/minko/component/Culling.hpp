@@ -39,16 +39,20 @@ namespace minko
             typedef std::shared_ptr<math::AbstractShape>                        ShapePtr;
 
         private:
-            static std::shared_ptr<math::OctTree>                               _octTree;
-
             std::shared_ptr<math::AbstractShape>                                _frustum;
+            std::shared_ptr<SpatialIndex>                                       _spatialIndex;
+            bool                                                                _frustumChanged;
+            uint                                                                _culledRevision;
+            bool                                                                _batch;
+            uint                                                                _numVisible;
+            uint                                                                _numCulled;
+            std::vector<std::shared_ptr<Renderer>>                              _renderers;
 
             Signal<AbstractComponent::Ptr, NodePtr>::Slot                       _targetAddedSlot;
             Signal<AbstractComponent::Ptr, NodePtr>::Slot                       _targetRemovedSlot;
-            Signal<NodePtr, NodePtr, NodePtr>::Slot                             _addedSlot;
             Signal<NodePtr, NodePtr, NodePtr>::Slot                             _addedToSceneSlot;
-            Signal<NodePtr, NodePtr>::Slot                                      _layoutChangedSlot;
             Signal<std::shared_ptr<data::Container>, const std::string&>::Slot  _viewMatrixChangedSlot;
+            Signal<std::shared_ptr<SceneManager>, uint, std::shared_ptr<render::AbstractTexture>>::Slot _renderingBeginSlot;
 
             std::string                                                         _bindProperty;
 
@@ -65,6 +69,46 @@ namespace minko
                 return CullingComponent;
             }
 
+            inline
+            bool
+            batch() const
+            {
+                return _batch;
+            }
+
+            // when enabled, the boxes of all the nodes are tested at once against the frustum planes
+            // (see math::OctTree::testFrustumBatch) instead of walking the octree: this is faster when
+            // most of the scene is visible, or when the nodes are too spread for the octants to cull
+            // large groups of them; the culling shape must be a math::Frustum
+            inline
+            Ptr
+            batch(bool value)
+            {
+                if (value != _batch)
+                {
+                    _batch = value;
+                    _frustumChanged = true;
+                }
+
+                return std::static_pointer_cast<Culling>(shared_from_this());
+            }
+
+            // number of surfaces found visible by the last culling pass, which only runs when the
+            // frustum, the spatial index or the renderers of the camera changed
+            inline
+            uint
+            numVisible() const
+            {
+                return _numVisible;
+            }
+
+            inline
+            uint
+            numCulled() const
+            {
+                return _numCulled;
+            }
+
         private:
             Culling(ShapePtr                shape,
                     const std::string&      bindProperty);
@@ -79,13 +123,12 @@ namespace minko
             targetRemovedHandler(AbstractComponent::Ptr ctrl, NodePtr target);
 
             void
-            addedHandler(NodePtr node, NodePtr target, NodePtr ancestor);
-
-            void
-            layoutChangedHandler(NodePtr node, NodePtr target);
+            worldToScreenChangedHandler(std::shared_ptr<data::Container> data, const std::string& propertyName);
 
             void
-            worldToScreenChangedHandler(std::shared_ptr<data::Container> data, const std::string& propertyName);
+            renderingBeginHandler(std::shared_ptr<SceneManager>             sceneManager,
+                                  uint                                      frameId,
+                                  std::shared_ptr<render::AbstractTexture>  renderTarget);
 
             void
             targetAddedToSceneHandler(NodePtr node, NodePtr target, NodePtr ancestor);
@@ -43,6 +43,7 @@ namespace minko
 
 		private:
 			std::vector<AbstractAnimationPtr>				_animations;
+			std::vector<AnimationPtr>						_timelineAnimations;	// the Animations evaluated in update()
 
 		public:
 
@@ -93,6 +94,14 @@ namespace minko
 			AbstractAnimation::Ptr
 			resetPlaybackWindow();
 
+			// forwarded to the Skinning components of the animated skins, see Skinning::crossFade()
+			void
+			crossFade(std::shared_ptr<geometry::SkinClip> clip, uint duration);
+
+			// forwarded to the Skinning components of the animated skins, see Skinning::additiveClip()
+			void
+			additiveClip(std::shared_ptr<geometry::SkinClip> clip, float weight);
+
 			void
 			initAnimations();
 
@@ -100,6 +109,9 @@ namespace minko
 			rebindDependencies(std::map<AbsCmpPtr, AbsCmpPtr>& componentsMap, std::map<NodePtr, NodePtr>& nodeMap, CloneOption option);
 
 		protected:
+			void
+			releaseAnimations();
+
 			MasterAnimation(bool isLooping);
 
 			MasterAnimation(const MasterAnimation& masterAnim, const CloneOption& option);
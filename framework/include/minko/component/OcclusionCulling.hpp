@@ -0,0 +1,126 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+#include "minko/component/AbstractComponent.hpp"
+#include "minko/Signal.hpp"
+#include "minko/scene/Layout.hpp"
+
+namespace minko
+{
+    namespace component
+    {
+        // Hides the surfaces that are behind occluders, after frustum culling. The surfaces of the
+        // nodes with the Layout::Group::OCCLUDER layout are rasterized on the CPU into a low
+        // resolution depth buffer (see render::OcclusionBuffer), then the bounding box of each
+        // surface left visible by the Culling of the camera is tested against it. Occluded surfaces
+        // are flagged in the renderers of the camera (see Renderer::occluded()).
+        // Occluders should be few, large and simple: their geometry must keep its CPU-side data.
+        class OcclusionCulling :
+            public AbstractComponent
+        {
+        public:
+            typedef std::shared_ptr<OcclusionCulling>                           Ptr;
+
+        private:
+            typedef std::shared_ptr<scene::Node>                                NodePtr;
+
+        private:
+            std::shared_ptr<render::OcclusionBuffer>                            _buffer;
+            std::shared_ptr<SpatialIndex>                                       _spatialIndex;
+            std::string                                                         _bindProperty;
+            bool                                                                _viewChanged;
+            uint                                                                _testedRevision;
+            std::vector<std::shared_ptr<Renderer>>                              _renderers;
+            uint                                                                _numOccluders;
+            uint                                                                _numOccluded;
+
+            std::vector<NodePtr>                                                _occluders;
+            std::vector<NodePtr>                                                _occludees;
+
+            Signal<AbstractComponent::Ptr, NodePtr>::Slot                       _targetAddedSlot;
+            Signal<AbstractComponent::Ptr, NodePtr>::Slot                       _targetRemovedSlot;
+            Signal<NodePtr, NodePtr, NodePtr>::Slot                             _addedToSceneSlot;
+            Signal<std::shared_ptr<data::Container>, const std::string&>::Slot  _viewMatrixChangedSlot;
+            Signal<std::shared_ptr<SceneManager>, uint, std::shared_ptr<render::AbstractTexture>>::Slot _renderingBeginSlot;
+
+        public:
+            inline static
+            Ptr
+            create(const std::string&   bindPropertyName    = "camera.worldToScreenMatrix",
+                   uint                 width               = 256,
+                   uint                 height              = 128)
+            {
+                Ptr occlusionCulling = std::shared_ptr<OcclusionCulling>(new OcclusionCulling(bindPropertyName, width, height));
+
+                occlusionCulling->initialize();
+
+                return occlusionCulling;
+            }
+
+            inline
+            std::shared_ptr<render::OcclusionBuffer>
+            occlusionBuffer() const
+            {
+                return _buffer;
+            }
+
+            // number of occluders rasterized and of surfaces found occluded by the last pass, which
+            // only runs when the view, the spatial index or the renderers of the camera changed
+            inline
+            uint
+            numOccluders() const
+            {
+                return _numOccluders;
+            }
+
+            inline
+            uint
+            numOccluded() const
+            {
+                return _numOccluded;
+            }
+
+        private:
+            OcclusionCulling(const std::string& bindProperty, uint width, uint height);
+
+            void
+            initialize();
+
+            void
+            targetAddedHandler(AbstractComponent::Ptr ctrl, NodePtr target);
+
+            void
+            targetRemovedHandler(AbstractComponent::Ptr ctrl, NodePtr target);
+
+            void
+            targetAddedToSceneHandler(NodePtr node, NodePtr target, NodePtr ancestor);
+
+            void
+            renderingBeginHandler(std::shared_ptr<SceneManager>             sceneManager,
+                                  uint                                      frameId,
+                                  std::shared_ptr<render::AbstractTexture>  renderTarget);
+
+            void
+            rasterizeOccluder(NodePtr node, const float* worldToScreen);
+        };
+    }
+}
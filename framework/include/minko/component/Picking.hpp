@@ -22,6 +22,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/Common.hpp"
 #include "minko/Signal.hpp"
 #include "minko/component/AbstractComponent.hpp"
+#include "minko/component/PickingMethod.hpp"
 #include "minko/data/ArrayProvider.hpp"
 
 namespace minko
@@ -46,6 +47,7 @@ namespace minko
             typedef std::shared_ptr<data::ArrayProvider>        ArrayProviderPtr;
             typedef std::shared_ptr<data::StructureProvider>    StructureProviderPtr;
             typedef std::shared_ptr<AbstractCanvas>             AbstractCanvasPtr;
+            typedef std::shared_ptr<render::AbstractTexture>    AbsTexturePtr;
 
         private:
             TexturePtr                                          _renderTarget;
@@ -65,12 +67,22 @@ namespace minko
 
             std::vector<NodePtr>                                _descendants;
 
+            PickingMethod                                       _method;
+            bool                                                _pickingRequested;
+            bool                                                _readPixelsPending;
+            std::shared_ptr<math::Ray>                          _ray;
+            std::shared_ptr<math::Ray>                          _modelRay;
+            std::vector<std::pair<float, NodePtr>>              _candidates;
+            std::unordered_set<NodePtr>                         _testedNodes;
+
             Signal<AbsCtrlPtr, NodePtr>::Slot                   _targetAddedSlot;
             Signal<AbsCtrlPtr, NodePtr>::Slot                   _targetRemovedSlot;
             Signal<NodePtr, NodePtr, NodePtr>::Slot             _addedSlot;
             Signal<NodePtr, NodePtr, NodePtr>::Slot             _removedSlot;
             Signal<RendererPtr>::Slot                           _renderingBeginSlot;
             Signal<RendererPtr>::Slot                           _renderingEndSlot;
+            Signal<SceneManagerPtr, float, float>::Slot         _frameBeginSlot;
+            Signal<SceneManagerPtr, uint, AbsTexturePtr>::Slot  _sceneRenderingBeginSlot;
             Signal<NodePtr, NodePtr, AbsCtrlPtr>::Slot          _componentAddedSlot;
             Signal<NodePtr, NodePtr, AbsCtrlPtr>::Slot          _componentRemovedSlot;
 
@@ -128,15 +140,31 @@ namespace minko
         public:
             inline static
             Ptr
-            create(NodePtr camera, bool addPickingLayoutToNodes = true, bool emulateMouseWithTouch = true)
+            create(NodePtr          camera,
+                   bool             addPickingLayoutToNodes = true,
+                   bool             emulateMouseWithTouch   = true,
+                   PickingMethod    method                  = PickingMethod::RENDERING)
             {
                 Ptr picking = std::shared_ptr<Picking>(new Picking());
 
-                picking->initialize(camera, addPickingLayoutToNodes, emulateMouseWithTouch);
+                picking->initialize(camera, addPickingLayoutToNodes, emulateMouseWithTouch, method);
 
                 return picking;
             }
 
+            inline
+            PickingMethod
+            method() const
+            {
+                return _method;
+            }
+
+            // Nearest surface of the picking layout under the point (x, y) of the screen, both in
+            // [-1, 1] from the top left corner, found by casting a ray on the CPU whatever the method.
+            // Geometries without CPU side data are picked by their bounding box.
+            SurfacePtr
+            pick(float x, float y);
+
             inline
             Signal<NodePtr>::Ptr
             mouseOver()
@@ -251,7 +279,7 @@ namespace minko
 
         private:
             void
-            initialize(NodePtr camera, bool addPickingLayout, bool emulateMouseWithTouch);
+            initialize(NodePtr camera, bool addPickingLayout, bool emulateMouseWithTouch, PickingMethod method);
 
             void
             targetAddedHandler(AbsCtrlPtr ctrl, NodePtr target);
@@ -292,6 +320,21 @@ namespace minko
             void
             renderingEnd(RendererPtr renderer);
 
+            void
+            frameBeginHandler(SceneManagerPtr sceneManager, float time, float deltaTime);
+
+            void
+            sceneRenderingBeginHandler(SceneManagerPtr sceneManager, uint frameId, AbsTexturePtr renderTarget);
+
+            void
+            requestPicking();
+
+            void
+            updatePickedSurface(SurfacePtr surface);
+
+            bool
+            castSurface(SurfacePtr surface, float& distance);
+
             Picking();
 
             void
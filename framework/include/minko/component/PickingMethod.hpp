@@ -0,0 +1,42 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+    namespace component
+    {
+        // How Picking finds the surface under the pointer:
+        // - RENDERING renders the surfaces with their picking color around the pointer and reads the
+        //   pixel back, which waits for the GPU to complete the frame;
+        // - RENDERING_ASYNC reads the pixel back without waiting when the context supports it (see
+        //   AbstractContext::supportsAsyncReadPixels()), the events are then one frame late;
+        // - RAY_CAST casts a ray on the CPU, against the world space bounding boxes of the scene
+        //   (through its SpatialIndex when there is one) and then the triangles of the geometries.
+        enum class PickingMethod
+        {
+            RENDERING = 0,
+            RENDERING_ASYNC,
+            RAY_CAST
+        };
+    }
+}
@@ -57,7 +57,7 @@ namespace minko
         private:
             std::string                                                         _name;
 
-            DrawCallList                                                        _drawCalls;
+            std::vector<DrawCallPtr>                                            _drawCalls;
             std::unordered_map<SurfacePtr, DrawCallList>                        _surfaceDrawCalls;
 
             unsigned int                                                        _backgroundColor;
@@ -71,6 +71,9 @@ namespace minko
             bool                                                                _clearBeforeRender;
 
             std::set<std::shared_ptr<Surface>>                                  _toCollect;
+            // one bit per Surface::id(), set when culling found the surface outside of the view
+            std::vector<uint>                                                   _culledSurfaces;
+            std::vector<uint>                                                   _occludedSurfaces;
             EffectPtr                                                           _effect;
             float                                                               _priority;
             bool                                                                _enabled;
@@ -256,6 +259,60 @@ namespace minko
             render(std::shared_ptr<render::AbstractContext> context,
                    AbsTexturePtr renderTarget = nullptr);
 
+            // Visibility of a surface as computed by culling (see Culling). Unlike Surface::visible(),
+            // it does not add or remove draw calls: render() only skips the draw calls of the
+            // surfaces that were culled.
+            inline
+            bool
+            computedVisibility(uint surfaceId) const
+            {
+                return !testSurfaceBit(_culledSurfaces, surfaceId);
+            }
+
+            inline
+            void
+            computedVisibility(uint surfaceId, bool value)
+            {
+                setSurfaceBit(_culledSurfaces, surfaceId, !value);
+            }
+
+            inline
+            void
+            resetComputedVisibility()
+            {
+                _culledSurfaces.clear();
+            }
+
+            // surfaces hidden behind occluders (see OcclusionCulling), skipped by render() as well
+            inline
+            bool
+            occluded(uint surfaceId) const
+            {
+                return testSurfaceBit(_occludedSurfaces, surfaceId);
+            }
+
+            inline
+            void
+            occluded(uint surfaceId, bool value)
+            {
+                setSurfaceBit(_occludedSurfaces, surfaceId, value);
+            }
+
+            inline
+            void
+            resetOcclusion()
+            {
+                _occludedSurfaces.clear();
+            }
+
+            // whether the draw calls of the surface are rendered: neither culled nor occluded
+            inline
+            bool
+            renderable(uint surfaceId) const
+            {
+                return computedVisibility(surfaceId) && !occluded(surfaceId);
+            }
+
             inline
             Signal<Ptr>::Ptr
             renderingBegin()
@@ -361,6 +418,35 @@ namespace minko
             void
             setSceneManager(std::shared_ptr<SceneManager> sceneManager);
 
+            inline static
+            bool
+            testSurfaceBit(const std::vector<uint>& bits, uint surfaceId)
+            {
+                const auto word = surfaceId >> 5;
+
+                return word < bits.size() && (bits[word] & (1u << (surfaceId & 31))) != 0;
+            }
+
+            inline static
+            void
+            setSurfaceBit(std::vector<uint>& bits, uint surfaceId, bool value)
+            {
+                const auto word = surfaceId >> 5;
+                const auto bit = 1u << (surfaceId & 31);
+
+                if (word >= bits.size())
+                {
+                    if (!value)
+                        return;
+                    bits.resize(word + 1, 0u);
+                }
+
+                if (value)
+                    bits[word] |= bit;
+                else
+                    bits[word] &= ~bit;
+            }
+
             inline
             std::set<AbsFilterPtr>&
             filtersRef(data::BindingSource source)
@@ -51,6 +51,7 @@ namespace minko
             Signal<Ptr, uint, AbsTexturePtr>::Ptr               _renderEnd;
 
             std::shared_ptr<data::StructureProvider>            _data;
+            uint                                                _timePropertyId;
 
             Signal<AbstractComponent::Ptr, NodePtr>::Slot       _targetAddedSlot;
             Signal<AbstractComponent::Ptr, NodePtr>::Slot       _targetRemovedSlot;
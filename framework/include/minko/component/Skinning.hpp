@@ -24,6 +24,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include <minko/component/AbstractAnimation.hpp>
 #include <minko/render/VertexBuffer.hpp>
 #include <minko/component/SkinningMethod.hpp>
+#include <minko/async/ThreadPool.hpp>
 
 namespace minko
 {
@@ -52,27 +53,52 @@ namespace minko
 			typedef std::shared_ptr<geometry::Geometry>				GeometryPtr;
 			typedef std::shared_ptr<geometry::Skin>					SkinPtr;
 			typedef std::shared_ptr<geometry::Bone>					BonePtr;
+            typedef std::shared_ptr<geometry::SkinClip>             SkinClipPtr;
+            typedef std::shared_ptr<geometry::SkinPoseCache>        SkinPoseCachePtr;
             typedef std::shared_ptr<data::Provider>                 ProviderPtr;
             typedef std::shared_ptr<data::ArrayProvider>            ArrayProviderPtr;
+            typedef std::shared_ptr<render::AbstractTexture>        AbsTexturePtr;
+            typedef std::shared_ptr<render::FloatTexture>           FloatTexturePtr;
 
             typedef Signal<AbsCmpPtr, NodePtr>                      TargetAddedOrRemovedSignal;
             typedef Signal<NodePtr, NodePtr, NodePtr>               AddedOrRemovedSignal;
             typedef Signal<SceneManagerPtr>                         SceneManagerSignal;
+            typedef Signal<SceneManagerPtr, uint, AbsTexturePtr>    RenderingSignal;
+
+        public:
+            // interleaved streams of a software skinned geometry, the pointers are on the attribute of the first vertex
+            struct VertexStreams
+            {
+                const float*                                        inputPositions;
+                float*                                              outputPositions;
+                unsigned int                                        positionStride;
+                const float*                                        inputNormals;       // nullptr when there is no normal
+                float*                                              outputNormals;
+                unsigned int                                        normalStride;
+            };
 
         public:
             static const std::string                                PNAME_NUM_BONES;
             static const std::string                                PNAME_BONE_MATRICES;
+            static const std::string                                PNAME_BONE_TEXTURE;
+            static const std::string                                PNAME_BONE_TEXTURE_SIZE;
+            static const std::string                                PNAME_BONE_TEXTURE_OFFSET;
             static const std::string                                ATTRNAME_BONE_IDS_A;
             static const std::string                                ATTRNAME_BONE_IDS_B;
             static const std::string                                ATTRNAME_BONE_WEIGHTS_A;
             static const std::string                                ATTRNAME_BONE_WEIGHTS_B;
             static const unsigned int                               MAX_NUM_BONES_PER_VERTEX;
+            static const unsigned int                               MAX_BONE_TEXTURE_WIDTH;
 
         private:
             static const std::string                                ATTRNAME_POSITION;
             static const std::string                                ATTRNAME_NORMAL;
 
         private:
+            // shared by all the instances, see parallelSkinning()
+            static std::shared_ptr<async::ThreadPool>               _skinningThreadPool;
+            static unsigned int                                     _parallelSkinningMinNumVertices;
+
 			SkinPtr													_skin;
             AbstractContextPtr                                      _context;
             SkinningMethod                                          _method;
@@ -86,6 +112,26 @@ namespace minko
             std::unordered_map<NodePtr,    std::vector<float>>      _targetInputPositions;  // only for software skinning
             std::unordered_map<NodePtr,    std::vector<float>>      _targetInputNormals;    // only for software skinning
 
+            // only for compressed skins
+            SkinClipPtr                                             _clip;
+            SkinClipPtr                                             _fadeClip;
+            float                                                   _fadeStartTime;         // in scene time, < 0 until the fade starts
+            uint                                                    _fadeDuration;
+            std::vector<std::pair<SkinClipPtr, float>>              _additiveClips;         // clip and weight
+            SkinPoseCachePtr                                        _poseCache;
+            std::shared_ptr<const std::vector<float>>               _cachedPose;            // held while the geometries point to it
+            std::vector<float>                                      _poseMatrices;
+            std::vector<float>                                      _poseWorldMatrices;
+            std::vector<float>                                      _localPose;
+            std::vector<float>                                      _blendedLocalPose;
+            std::vector<float>                                      _referenceLocalPose;
+
+            // only for SkinningMethod::TEXTURE
+            FloatTexturePtr                                         _boneTexture;
+            uint                                                    _boneTextureOffset;     // in matrices
+            SceneManagerPtr                                         _boneTextureSceneManager;
+            RenderingSignal::Slot                                   _renderingBeginSlot;
+
             TargetAddedOrRemovedSignal::Slot                        _targetAddedSlot;
 
         public:
@@ -108,6 +154,107 @@ namespace minko
 			AbsCmpPtr
 			clone(const CloneOption& option);
 
+            // SkinningMethod::TEXTURE falls back to HARDWARE without float textures, and any method to SOFTWARE
+            // when vertices have more than MAX_NUM_BONES_PER_VERTEX bones
+            inline
+            SkinningMethod
+            method() const
+            {
+                return _method;
+            }
+
+            // texture holding the bone matrices with SkinningMethod::TEXTURE, nullptr otherwise
+            inline
+            FloatTexturePtr
+            boneTexture() const
+            {
+                return _boneTexture;
+            }
+
+            // index of the first bone matrix of this instance in boneTexture()
+            inline
+            uint
+            boneTextureOffset() const
+            {
+                return _boneTextureOffset;
+            }
+
+            // Writes the bone matrices from the 'offset'-th matrix of 'texture', so that several instances
+            // share one texture uploaded once per frame. Only for SkinningMethod::TEXTURE.
+            void
+            boneTexture(FloatTexturePtr texture, uint offset);
+
+            // Texture with room for 'numMatrices' bone matrices of 4 texels (one per column) each.
+            static
+            FloatTexturePtr
+            createBoneTexture(AbstractContextPtr context, uint numMatrices);
+
+            // clip played by a skin created from a SkinClip, nullptr otherwise
+            inline
+            SkinClipPtr
+            clip() const
+            {
+                return _clip;
+            }
+
+            // Fades from the clip played to 'clip', a clip of the same rig, over 'duration' milliseconds of
+            // scene time. A fade in progress is completed first. Only for skins created from a SkinClip.
+            void
+            crossFade(SkinClipPtr clip, uint duration);
+
+            // Adds the difference between the pose of 'clip' and its first frame, times 'weight', on top of
+            // the clip played. A null weight removes the clip. Only for skins created from a SkinClip.
+            void
+            additiveClip(SkinClipPtr clip, float weight);
+
+            // Instances sharing a cache share the pose of their clip when they play it at the same (rounded)
+            // time, without blending. Clones share the cache of their source.
+            inline
+            SkinPoseCachePtr
+            poseCache() const
+            {
+                return _poseCache;
+            }
+
+            inline
+            void
+            poseCache(SkinPoseCachePtr poseCache)
+            {
+                _poseCache = poseCache;
+            }
+
+            // Opt-in: software skinned geometries holding at least 'minNumVertices' vertices are skinned
+            // using 'numThreads' extra worker threads. 0 thread restores the single-threaded skinning.
+            static
+            void
+            parallelSkinning(unsigned int numThreads, unsigned int minNumVertices = 4096);
+
+            inline static
+            unsigned int
+            numSkinningThreads()
+            {
+                return _skinningThreadPool ? _skinningThreadPool->numThreads() : 0;
+            }
+
+            // Skins the vertices [firstVertex, lastVertex) using the packed influences of the skin, 4 or 8
+            // vertices at a time when SIMD is available. Positions are transformed by the weighted bone
+            // matrices, normals by their 3x3 part.
+            static
+            void
+            skinVertices(const geometry::Skin&     skin,
+                         const float*              boneMatrices,
+                         const VertexStreams&      streams,
+                         unsigned int              firstVertex,
+                         unsigned int              lastVertex);
+
+            static
+            void
+            skinVerticesScalar(const geometry::Skin&     skin,
+                               const float*              boneMatrices,
+                               const VertexStreams&      streams,
+                               unsigned int              firstVertex,
+                               unsigned int              lastVertex);
+
         private:
             Skinning(const SkinPtr,
                      SkinningMethod,
@@ -132,20 +279,31 @@ namespace minko
             update();
 
             void
-            updateFrame(uint frameId, NodePtr);
+            updateFrame(const std::vector<float>& boneMatrices, NodePtr);
 
             void
-            targetAddedHandler(AbsCmpPtr, NodePtr);
+            updateBoneTexture(const std::vector<float>& boneMatrices);
 
             void
-            performSoftwareSkinning(NodePtr, const std::vector<float>&);
+            setBoneTextureProperties(GeometryPtr geometry);
 
             void
-            performSoftwareSkinning(render::VertexBuffer::AttributePtr,
-                                    render::VertexBuffer::Ptr,
-                                    const std::vector<float>&,
-                                    const std::vector<float>&,
-                                    bool doDeltaTransform);
+            updateBoneTextureSceneManager();
+
+            void
+            renderingBeginHandler(SceneManagerPtr, uint, AbsTexturePtr);
+
+            const std::vector<float>&
+            evaluatePose();
+
+            uint
+            clipTime(SkinClipPtr clip) const;
+
+            void
+            targetAddedHandler(AbsCmpPtr, NodePtr);
+
+            void
+            performSoftwareSkinning(NodePtr, const std::vector<float>&);
 
             render::VertexBuffer::Ptr
             createVertexBufferForBones() const;
@@ -28,7 +28,8 @@ namespace minko
         enum class SkinningMethod
         {
             SOFTWARE = 0,
-            HARDWARE
+            HARDWARE,   // bone matrices in a uniform array, bounded by the number of uniforms of the GPU
+            TEXTURE     // bone matrices in a float texture read by the vertex shader, falls back to HARDWARE
         };
     }
 }
@@ -0,0 +1,108 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+#include "minko/component/AbstractComponent.hpp"
+#include "minko/Signal.hpp"
+
+namespace minko
+{
+    namespace component
+    {
+        // Keeps the nodes of a scene that have a Transform and belong to the CULLING layout group in
+        // a math::OctTree, following them as they are added, removed or moved. It is meant to be
+        // added to the root of the scene: Culling adds a default one when the root has none, add one
+        // beforehand to choose the world bounds.
+        class SpatialIndex :
+            public AbstractComponent
+        {
+        public:
+            typedef std::shared_ptr<SpatialIndex>                               Ptr;
+
+        private:
+            typedef std::shared_ptr<scene::Node>                                NodePtr;
+
+        private:
+            std::shared_ptr<math::OctTree>                                      _octTree;
+
+            Signal<AbstractComponent::Ptr, NodePtr>::Slot                       _targetAddedSlot;
+            Signal<AbstractComponent::Ptr, NodePtr>::Slot                       _targetRemovedSlot;
+            Signal<NodePtr, NodePtr, NodePtr>::Slot                             _addedSlot;
+            Signal<NodePtr, NodePtr, NodePtr>::Slot                             _removedSlot;
+            Signal<NodePtr, NodePtr>::Slot                                      _layoutsChangedSlot;
+            Signal<NodePtr, NodePtr, AbstractComponent::Ptr>::Slot              _componentAddedSlot;
+            Signal<NodePtr, NodePtr, AbstractComponent::Ptr>::Slot              _componentRemovedSlot;
+
+        public:
+            // worldSize is the edge length of the cube centered on center (the origin by default)
+            // that the octree subdivides
+            inline static
+            Ptr
+            create(float                            worldSize   = 1000.f,
+                   uint                             maxDepth    = 8,
+                   std::shared_ptr<math::Vector3>   center      = nullptr)
+            {
+                Ptr spatialIndex = std::shared_ptr<SpatialIndex>(new SpatialIndex(worldSize, maxDepth, center));
+
+                spatialIndex->initialize();
+
+                return spatialIndex;
+            }
+
+            inline
+            std::shared_ptr<math::OctTree>
+            octTree() const
+            {
+                return _octTree;
+            }
+
+        private:
+            SpatialIndex(float worldSize, uint maxDepth, std::shared_ptr<math::Vector3> center);
+
+            void
+            initialize();
+
+            void
+            targetAddedHandler(AbstractComponent::Ptr ctrl, NodePtr target);
+
+            void
+            targetRemovedHandler(AbstractComponent::Ptr ctrl, NodePtr target);
+
+            void
+            addedHandler(NodePtr node, NodePtr target, NodePtr ancestor);
+
+            void
+            removedHandler(NodePtr node, NodePtr target, NodePtr ancestor);
+
+            void
+            layoutsChangedHandler(NodePtr node, NodePtr target);
+
+            void
+            componentAddedHandler(NodePtr node, NodePtr target, AbstractComponent::Ptr ctrl);
+
+            void
+            componentRemovedHandler(NodePtr node, NodePtr target, AbstractComponent::Ptr ctrl);
+
+            bool
+            indexed(NodePtr node);
+        };
+    }
+}
@@ -0,0 +1,152 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+#include "minko/component/AbstractComponent.hpp"
+#include "minko/Signal.hpp"
+#include "minko/math/Vec3.hpp"
+
+namespace minko
+{
+    namespace component
+    {
+        // Merges the surfaces below its target that share the same material, effect, technique and
+        // vertex layout into a few large geometries, pre-transformed into the target's space. It is
+        // opt-in and meant for non-moving content: the original surfaces are detached until the
+        // component is removed, and their transforms are no longer tracked.
+        class StaticBatching :
+            public AbstractComponent
+        {
+        public:
+            typedef std::shared_ptr<StaticBatching>                 Ptr;
+
+        private:
+            typedef std::shared_ptr<scene::Node>                    NodePtr;
+            typedef std::shared_ptr<Surface>                        SurfacePtr;
+            typedef std::shared_ptr<geometry::Geometry>             GeometryPtr;
+
+        public:
+            // triangles [firstTriangle, firstTriangle + numTriangles[ of a batch come from 'surface'
+            struct Range
+            {
+                uint                firstTriangle;
+                uint                numTriangles;
+                SurfacePtr          surface;
+                NodePtr             node;
+                math::Vec3          min;
+                math::Vec3          max;
+            };
+
+            struct Batch
+            {
+                NodePtr             node;
+                SurfacePtr          surface;
+                std::vector<Range>  ranges;
+            };
+
+        private:
+            std::vector<Batch>                                      _batches;
+            std::unordered_map<SurfacePtr, SurfacePtr>              _sourceToBatch;
+
+            Signal<AbstractComponent::Ptr, NodePtr>::Slot           _targetAddedSlot;
+            Signal<AbstractComponent::Ptr, NodePtr>::Slot           _targetRemovedSlot;
+
+        public:
+            inline static
+            Ptr
+            create()
+            {
+                Ptr staticBatching = std::shared_ptr<StaticBatching>(new StaticBatching());
+
+                staticBatching->initialize();
+
+                return staticBatching;
+            }
+
+            inline
+            const std::vector<Batch>&
+            batches() const
+            {
+                return _batches;
+            }
+
+            inline
+            uint
+            numBatchedSurfaces() const
+            {
+                return _sourceToBatch.size();
+            }
+
+            // the batch surface 'source' was merged into, nullptr if it was left untouched
+            inline
+            SurfacePtr
+            batchSurface(SurfacePtr source) const
+            {
+                auto it = _sourceToBatch.find(source);
+
+                return it != _sourceToBatch.end() ? it->second : nullptr;
+            }
+
+            // the range of the original surface 'triangle' of 'batchSurface' belongs to, nullptr if
+            // 'batchSurface' is not a batch of this component
+            const Range*
+            source(SurfacePtr batchSurface, uint triangle) const;
+
+            // restores the original surfaces and merges them again, to be called after the static
+            // content below the target changed
+            void
+            rebuild();
+
+        private:
+            StaticBatching();
+
+            void
+            initialize();
+
+            void
+            targetAddedHandler(AbstractComponent::Ptr ctrl, NodePtr target);
+
+            void
+            targetRemovedHandler(AbstractComponent::Ptr ctrl, NodePtr target);
+
+            void
+            batch(NodePtr target);
+
+            void
+            restore(NodePtr target);
+
+            static
+            bool
+            batchable(SurfacePtr surface);
+
+            static
+            std::string
+            vertexLayout(GeometryPtr geometry);
+
+            void
+            createBatch(NodePtr                         target,
+                        const float*                    targetToLocal,
+                        const std::vector<SurfacePtr>&  surfaces,
+                        uint                            begin,
+                        uint                            end);
+        };
+    }
+}
@@ -49,6 +49,10 @@ namespace minko
 
 
         private:
+            static std::vector<uint>                                                _freeIds;
+            static uint                                                             _numIds;
+
+            uint                                                                    _id;
             std::string                                                             _name;
 
             std::shared_ptr<geometry::Geometry>                                     _geometry;
@@ -58,7 +62,6 @@ namespace minko
 
             bool                                                                    _visible;
             std::unordered_map<std::shared_ptr<component::Renderer>, bool>          _rendererToVisibility;
-            std::unordered_map<std::shared_ptr<component::Renderer>, bool>          _rendererToComputedVisibility;
 
             TechniqueChangedSignal::Ptr                                             _techniqueChanged;
             VisibilityChangedSignal::Ptr                                            _visibilityChanged;
@@ -97,8 +100,15 @@ namespace minko
 			AbstractComponent::Ptr
 			clone(const CloneOption& option);
 
-            ~Surface()
+            ~Surface();
+
+            // compact id, reused once the surface is destroyed: indexes the visibility set of the
+            // renderers (see Renderer::computedVisibility())
+            inline
+            uint
+            id() const
             {
+                return _id;
             }
 
             inline
@@ -183,14 +193,9 @@ namespace minko
             void
             visible(std::shared_ptr<component::Renderer>, bool value);
 
-            inline
+            // visibility computed by culling, stored by the renderer itself
             bool
-            computedVisibility(std::shared_ptr<component::Renderer> renderer)
-            {
-                if (_rendererToComputedVisibility.find(renderer) == _rendererToComputedVisibility.end())
-                    _rendererToComputedVisibility[renderer] = true;
-                return _rendererToComputedVisibility[renderer];
-            }
+            computedVisibility(std::shared_ptr<component::Renderer> renderer);
 
             void
             computedVisibility(std::shared_ptr<component::Renderer>, bool value);
@@ -225,6 +230,10 @@ namespace minko
 
             Surface(const Surface& surface, const CloneOption& option);
 
+            static
+            uint
+            allocateId();
+
             void
             initialize();
 
@@ -21,6 +21,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 #include "minko/Common.hpp"
 
+#include "minko/AlignedAllocator.hpp"
+#include "minko/async/ThreadPool.hpp"
 #include "minko/scene/Node.hpp"
 #include "minko/component/AbstractComponent.hpp"
 #include "minko/component/Renderer.hpp"
@@ -53,6 +55,9 @@ namespace minko
             Signal<NodePtr, NodePtr, NodePtr>::Slot         _addedSlot;
             Signal<NodePtr, NodePtr, NodePtr>::Slot         _removedSlot;
 
+            static std::shared_ptr<async::ThreadPool>       _updateThreadPool;
+            static uint                                     _parallelUpdateMinNumNodes;
+
         public:
             inline static
             Ptr
@@ -138,6 +143,41 @@ namespace minko
                 return _modelToWorld;
             }
 
+            // number of world matrices recomputed by the last update of this node's hierarchy
+            inline
+            uint
+            numVisitedTransforms()
+            {
+                return targets()[0]->root()->component<RootTransform>()->numVisitedNodes();
+            }
+
+            // number of world matrices left untouched by that same update
+            inline
+            uint
+            numSkippedTransforms()
+            {
+                return targets()[0]->root()->component<RootTransform>()->numSkippedNodes();
+            }
+
+            // Updates the world matrices of all the transforms in the scene of 'node' at once:
+            // modelToWorldMatrix(false) then returns up-to-date matrices without forcing another update.
+            static
+            void
+            updateModelToWorldMatrices(NodePtr node);
+
+            // Opt-in: the world matrices of hierarchies holding at least 'minNumNodes' transforms are
+            // updated using 'numThreads' extra worker threads. 0 thread restores the single-threaded update.
+            static
+            void
+            parallelUpdate(uint numThreads, uint minNumNodes = 4096);
+
+            inline static
+            uint
+            numUpdateThreads()
+            {
+                return _updateThreadPool ? _updateThreadPool->numThreads() : 0;
+            }
+
             inline
             float
             x()
@@ -190,6 +230,8 @@ namespace minko
                 typedef std::shared_ptr<render::AbstractTexture>    AbsTexPtr;
                 typedef std::shared_ptr<SceneManager>               SceneMgrPtr;
                 typedef Signal<RendererCtrlPtr>::Slot               EnterFrameCallback;
+                typedef std::vector<float, AlignedAllocator<float>> MatrixArray;
+                typedef Signal<std::shared_ptr<data::Value>>::Slot  TransformChangedSlot;
 
             public:
                 inline static
@@ -209,21 +251,57 @@ namespace minko
                 void
                 forceUpdate(NodePtr node, bool updateTransformLists = false);
 
+                void
+                forceUpdate();
+
+                inline
+                uint
+                numVisitedNodes() const
+                {
+                    return _numVisitedNodes;
+                }
+
+                inline
+                uint
+                numSkippedNodes() const
+                {
+                    return _numSkippedNodes;
+                }
+
             private:
                 std::vector<std::shared_ptr<math::Matrix4x4>>   _transforms;
                 std::vector<std::shared_ptr<math::Matrix4x4>>   _modelToWorld;
 
-                std::map<NodePtr, unsigned int>                 _nodeToId;
+                // flat, 16-byte aligned copies of the matrices above (16 floats per node id)
+                MatrixArray                                     _localMatrices;
+                MatrixArray                                     _worldMatrices;
+                std::vector<unsigned char>                      _worldChanged;
+
+                std::unordered_map<NodePtr, unsigned int>       _nodeToId;
                 std::vector<NodePtr>                            _idToNode;
                 std::vector<int>                                _parentId;
-                std::vector<unsigned int>                       _firstChildId;
-                std::vector<unsigned int>                       _numChildren;
+                std::vector<int>                                _firstChildId;
+                std::vector<int>                                _nextSiblingId;
+                std::vector<int>                                _previousSiblingId;
+                unsigned int                                    _numRemovedIds;
                 bool                                            _invalidLists;
 
+                std::vector<TransformChangedSlot>               _transformChangedSlots;
+                std::vector<unsigned int>                       _dirtyIds;
+                std::vector<unsigned int>                       _updatedIds;
+                std::vector<unsigned int>                       _nodeStack;
+                std::vector<unsigned int>                       _subtreeRootIds;
+                std::vector<std::vector<unsigned int>>          _threadNodeStacks;
+                std::vector<std::vector<unsigned int>>          _threadUpdatedIds;
+                unsigned int                                    _numVisitedNodes;
+                unsigned int                                    _numSkippedNodes;
+
                 std::list<Any>                                  _targetSlots;
                 Signal<SceneMgrPtr, uint, AbsTexPtr>::Slot      _renderingBeginSlot;
 
             private:
+                RootTransform();
+
                 void
                 initialize();
 
@@ -248,20 +326,60 @@ namespace minko
                 void
                 updateTransformsList();
 
+                void
+                insertNodes(NodePtr subtreeRoot);
+
+                void
+                removeNodes(NodePtr subtreeRoot);
+
+                void
+                removeNode(NodePtr node, bool reparentDescendants = false);
+
+                unsigned int
+                appendNode(NodePtr node, int parentId);
+
+                void
+                linkNode(int nodeId, int parentId);
+
+                void
+                unlinkNode(int nodeId);
+
+                void
+                watchTransform(unsigned int nodeId);
+
+                void
+                invalidateWorldMatrix(unsigned int nodeId);
+
+                void
+                compactTransformsList();
+
                 void
                 updateTransforms();
 
                 void
-                updateTransformPath(const std::vector<unsigned int>& path);
+                updateAllWorldMatrices();
+
+                void
+                updateAllWorldMatricesInParallel(async::ThreadPool& threadPool);
+
+                void
+                updateSubtreeWorldMatrices(unsigned int                 subtreeRootId,
+                                           std::vector<unsigned int>&   nodeStack,
+                                           std::vector<unsigned int>&   updatedIds);
+
+                bool
+                computeWorldMatrix(unsigned int nodeId);
+
+                void
+                updateWorldMatrix(unsigned int nodeId);
+
+                void
+                commitWorldMatrix(unsigned int nodeId);
 
                 void
                 renderingBeginHandler(std::shared_ptr<SceneManager>             sceneManager,
                                       uint                                      frameId,
                                       std::shared_ptr<render::AbstractTexture>  abstractTexture);
-
-                static
-                void
-                juxtaposeSiblings(std::vector<NodePtr>&);
             };
         };
     }
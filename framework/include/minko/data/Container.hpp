@@ -39,11 +39,21 @@ namespace minko
 
             typedef std::shared_ptr<Provider>                               ProviderPtr;
             typedef std::shared_ptr<data::AbstractFilter>                   AbsFilterPtr;
-            typedef Signal<ProviderPtr, const std::string&>                 ProviderPropertyChangedSignal;
+            typedef Signal<ProviderPtr, uint>                               ProviderPropertyChangedSignal;
             typedef ProviderPropertyChangedSignal::Slot                     ProviderPropertyChangedSlot;
 
+            // where a property of the container is stored: 'propertyId' is the id of the name the
+            // provider uses, without the array prefix the container adds to 'name'
+            struct PropertySlot
+            {
+                ProviderPtr provider;
+                uint        propertyId;
+                std::string name;
+            };
+
             std::list<ProviderPtr>                                          _providers;
-            std::unordered_map<std::string, ProviderPtr>                    _propertyNameToProvider;
+            std::unordered_map<uint, PropertySlot>                          _properties;
+            std::unordered_map<ProviderPtr, std::unordered_map<uint, uint>> _providerToPropertyIds;
             std::unordered_map<ProviderPtr, uint>                           _providersToNumUse;
             std::unordered_map<ProviderPtr, uint>                           _providerToIndex;
 
@@ -51,8 +61,8 @@ namespace minko
 
             PropertyChangedSignalPtr                                        _propertyAdded;
             PropertyChangedSignalPtr                                        _propertyRemoved;
-            std::unordered_map<std::string, PropertyChangedSignalPtr>       _propValueChanged;
-            std::unordered_map<std::string, PropertyChangedSignalPtr>       _propReferenceChanged;
+            std::unordered_map<uint, PropertyChangedSignalPtr>              _propValueChanged;
+            std::unordered_map<uint, PropertyChangedSignalPtr>              _propReferenceChanged;
 
             std::unordered_map<ProviderPtr, std::list<Any>>                 _propertyAddedOrRemovedSlots;
             std::unordered_map<ProviderPtr, ProviderPropertyChangedSlot>    _providerValueChangedSlot;
@@ -61,6 +71,9 @@ namespace minko
             Signal<Ptr, ProviderPtr>::Ptr                                   _providerAdded;
             Signal<Ptr, ProviderPtr>::Ptr                                   _providerRemoved;
 
+            uint                                                            _updateDepth;
+            std::vector<ProviderPtr>                                        _updatingProviders;
+
             static uint                                                     CONTAINER_ID;
 
 
@@ -95,9 +108,24 @@ namespace minko
             bool
             hasProvider(std::shared_ptr<Provider> provider) const;
 
+            // Provider::beginUpdate() on every provider of the container: changes are dispatched
+            // once per modified property by the matching endUpdate()
+            void
+            beginUpdate();
+
+            void
+            endUpdate();
+
             bool
             hasProperty(const std::string&) const;
 
+            inline
+            bool
+            hasProperty(uint propertyId) const
+            {
+                return _properties.count(propertyId) != 0;
+            }
+
             bool
             isLengthProperty(const std::string&) const;
 
@@ -112,39 +140,54 @@ namespace minko
 
             template <typename T>
             T
+            get(uint propertyId) const
+            {
+                const auto& property = this->property(propertyId);
+
+                return property.provider->template get<T>(property.propertyId);
+            }
+
+            template <typename T>
+            inline
+            T
             get(const std::string& propertyName) const
             {
-                assertPropertyExists(propertyName);
+                return get<T>(PropertyId::find(propertyName));
+            }
 
-                const auto& provider = _propertyNameToProvider.find(propertyName)->second;
-                auto unformatedPropertyName = unformatPropertyName(provider, propertyName);
+            template <typename T>
+            void
+            set(uint propertyId, T value)
+            {
+                const auto& property = this->property(propertyId);
 
-                return provider->get<T>(unformatedPropertyName, true);
+                property.provider->template set<T>(property.propertyId, value);
             }
 
             template <typename T>
+            inline
             void
             set(const std::string& propertyName, T value)
             {
-                assertPropertyExists(propertyName);
+                set<T>(PropertyId::find(propertyName), value);
+            }
 
-                auto provider = _propertyNameToProvider[propertyName];
-                auto unformatedPropertyName = unformatPropertyName(provider, propertyName);
+            template <typename T>
+            bool
+            propertyHasType(uint propertyId) const
+            {
+                const auto& property = this->property(propertyId);
 
-                provider->set<T>(unformatedPropertyName, value);
+                return property.provider->template propertyHasType<T>(property.propertyId);
             }
 
+            // properties are resolved by id, 'skipPropertyNameFormatting' is kept for compatibility
             template <typename T>
+            inline
             bool
             propertyHasType(const std::string& propertyName, bool skipPropertyNameFormatting = false) const
             {
-                assertPropertyExists(propertyName);
-
-                const auto& provider = _propertyNameToProvider.find(propertyName)->second;
-
-                auto unformatedPropertyName = unformatPropertyName(provider, propertyName);
-
-                return provider->propertyHasType<T>(unformatedPropertyName, skipPropertyNameFormatting);
+                return propertyHasType<T>(PropertyId::find(propertyName));
             }
 
             inline
@@ -194,8 +237,8 @@ namespace minko
             {
                 std::vector<std::string> properties;
 
-                for (auto& kv : _propertyNameToProvider)
-                    properties.push_back(kv.first);
+                for (auto& kv : _properties)
+                    properties.push_back(PropertyId::name(kv.first));
 
                 return properties;
             }
@@ -206,8 +249,22 @@ namespace minko
         private:
             Container();
 
-            void
-            assertPropertyExists(const std::string& propertyName) const;
+            inline
+            const PropertySlot&
+            property(uint propertyId) const
+            {
+                auto foundIt = _properties.find(propertyId);
+
+                if (foundIt == _properties.end())
+                    throw std::invalid_argument(
+                        propertyId == PropertyId::UNDEFINED ? "propertyName" : PropertyId::name(propertyId)
+                    );
+
+                return foundIt->second;
+            }
+
+            uint
+            propertyId(ProviderPtr provider, uint providerPropertyId) const;
 
             void
             providerPropertyAddedHandler(ProviderPtr, const std::string& propertyName);
@@ -216,16 +273,14 @@ namespace minko
             providerPropertyRemovedHandler(ProviderPtr, const std::string& propertyName);
 
             void
-            providerValueChangedHandler(ProviderPtr, const std::string& propertyName);
+            providerValueChangedHandler(ProviderPtr, uint providerPropertyId);
 
             void
-            providerReferenceChangedHandler(ProviderPtr, const std::string& propertyName);
+            providerReferenceChangedHandler(ProviderPtr, uint providerPropertyId);
 
             std::string
             formatPropertyName(ProviderPtr  arrayProvider, const std::string&) const;
 
-            std::string
-            unformatPropertyName(ProviderPtr  arrayProvider, const std::string&) const;
 
             inline
             void
@@ -0,0 +1,72 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+#include <mutex>
+
+namespace minko
+{
+    namespace data
+    {
+        // Interns property names into small integers so that providers and containers can look
+        // properties up without hashing or formatting strings. Ids are never released. The registry
+        // is shared by all the threads, e.g. assets parsed by workers, and is guarded by a mutex.
+        class PropertyId
+        {
+        public:
+            static const uint UNDEFINED;
+
+        private:
+            struct Registry
+            {
+                std::unordered_map<std::string, uint>   ids;
+                // a deque keeps the references returned by name() valid when new names are interned
+                std::deque<std::string>                 names;
+                std::mutex                              mutex;
+            };
+
+        public:
+            // the id of 'name', interned on first use
+            static
+            uint
+            get(const std::string& name);
+
+            // the id of 'name' or UNDEFINED if it was never interned
+            static
+            uint
+            find(const std::string& name);
+
+            static
+            const std::string&
+            name(uint id);
+
+            static
+            uint
+            numIds();
+
+        private:
+            static
+            Registry&
+            registry();
+        };
+    }
+}
@@ -23,6 +23,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/Any.hpp"
 #include "minko/Signal.hpp"
 #include "minko/data/Value.hpp"
+#include "minko/data/PropertyId.hpp"
 
 namespace minko
 {
@@ -42,15 +43,24 @@ namespace minko
             typedef Signal<std::shared_ptr<Value>>::Slot ChangedSignalSlot;
 
         private:
+            // properties are stored in slots: _names[i], _ids[i] and _values[i] describe the same one
             std::vector<std::string>                                _names;
-            std::unordered_map<std::string, Any>                    _values;
-            std::unordered_map<std::string, ChangedSignalSlot>      _valueChangedSlots;
-            std::unordered_map<std::string, ChangedSignalSlot>      _referenceChangedSlots;
+            std::vector<uint>                                       _ids;
+            std::vector<Any>                                        _values;
+            std::unordered_map<uint, uint>                          _idToSlot;
+            std::unordered_map<uint, ChangedSignalSlot>             _valueChangedSlots;
+
+            // changes deferred by beginUpdate(): flags per property id, in first-write order
+            uint                                                    _updateDepth;
+            std::unordered_map<uint, unsigned char>                 _pendingChanges;
+            std::vector<uint>                                       _pendingChangesOrder;
 
             std::shared_ptr<Signal<Ptr, const std::string&>>        _propertyAdded;
             std::shared_ptr<Signal<Ptr, const std::string&>>        _propValueChanged;
             std::shared_ptr<Signal<Ptr, const std::string&>>        _propReferenceChanged;
             std::shared_ptr<Signal<Ptr, const std::string&>>        _propertyRemoved;
+            std::shared_ptr<Signal<Ptr, uint>>                      _propIdValueChanged;
+            std::shared_ptr<Signal<Ptr, uint>>                      _propIdReferenceChanged;
 
         public:
             static const std::string NO_STRUCT_SEP;
@@ -79,12 +89,27 @@ namespace minko
                 return _names;
             }
 
+            // the PropertyId of each stored (formatted) property name, in slot order
+            inline
+            const std::vector<uint>&
+            propertyIds() const
+            {
+                return _ids;
+            }
+
             virtual
             bool
             hasProperty(const std::string&, bool skipPropertyNameFormatting = false) const;
 
             inline
-            const std::unordered_map<std::string, Any>&
+            bool
+            hasProperty(uint propertyId) const
+            {
+                return _idToSlot.count(propertyId) != 0;
+            }
+
+            inline
+            const std::vector<Any>&
             values() const
             {
                 return _values;
@@ -97,6 +122,16 @@ namespace minko
                 return _names[propertyIndex];
             }
 
+            // the slot of the property, -1 if it is not set
+            inline
+            int
+            slot(uint propertyId) const
+            {
+                auto foundIt = _idToSlot.find(propertyId);
+
+                return foundIt != _idToSlot.end() ? foundIt->second : -1;
+            }
+
             inline
             std::shared_ptr<Signal<Ptr, const std::string&>>
             propertyValueChanged() const
@@ -111,6 +146,22 @@ namespace minko
                 return _propReferenceChanged;
             }
 
+            // same as propertyValueChanged() and propertyReferenceChanged(), with the id of the property
+            // instead of its name for the listeners indexing properties by id
+            inline
+            std::shared_ptr<Signal<Ptr, uint>>
+            propertyIdValueChanged() const
+            {
+                return _propIdValueChanged;
+            }
+
+            inline
+            std::shared_ptr<Signal<Ptr, uint>>
+            propertyIdReferenceChanged() const
+            {
+                return _propIdReferenceChanged;
+            }
+
             inline
             std::shared_ptr<Signal<Ptr, const std::string&>>
             propertyAdded() const
@@ -125,17 +176,31 @@ namespace minko
                 return _propertyRemoved;
             }
 
+            // 'propertyId' is the id of the stored name, i.e. after formatting
+            template <typename T>
+            T
+            get(uint propertyId) const
+            {
+                auto foundIt = _idToSlot.find(propertyId);
+
+                if (foundIt == _idToSlot.end())
+                    throw std::invalid_argument("propertyId");
+
+                return Any::unsafe_cast<T>(_values[foundIt->second]);
+            }
+
             template <typename T>
             T
             get(const std::string& propertyName, bool skipPropertyNameFormatting) const
             {
-                const std::string&    formattedName    = skipPropertyNameFormatting ? propertyName : formatPropertyName(propertyName);
-                auto                  foundIt          = values().find(formattedName);
+                auto propertyId = PropertyId::find(
+                    skipPropertyNameFormatting ? propertyName : formatPropertyName(propertyName)
+                );
 
-                if (foundIt == values().end())
+                if (propertyId == PropertyId::UNDEFINED || !hasProperty(propertyId))
                     throw std::invalid_argument("propertyName");
 
-                return Any::unsafe_cast<T>(foundIt->second);
+                return get<T>(propertyId);
             }
 
             template <typename T>
@@ -146,75 +211,92 @@ namespace minko
                 return get<T>(propertyName, false);
             }
 
+            template <typename T>
+            bool
+            propertyHasType(uint propertyId) const
+            {
+                auto foundIt = _idToSlot.find(propertyId);
+
+                if (foundIt == _idToSlot.end())
+                    throw std::invalid_argument("propertyId");
+
+                return Any::cast<T>(&_values[foundIt->second]) != nullptr;
+            }
+
             template <typename T>
             bool
             propertyHasType(const std::string& propertyName, bool skipPropertyNameFormatting = false) const
             {
-                const std::string&    formattedName    = skipPropertyNameFormatting ? propertyName : formatPropertyName(propertyName);
-                const auto            foundIt          = _values.find(formattedName);
+                auto propertyId = PropertyId::find(
+                    skipPropertyNameFormatting ? propertyName : formatPropertyName(propertyName)
+                );
 
-                if (foundIt == _values.end())
+                if (propertyId == PropertyId::UNDEFINED)
                     throw std::invalid_argument("propertyName");
 
-				return Any::cast<T>(&foundIt->second) != nullptr;
-
+                return propertyHasType<T>(propertyId);
             }
 
             template <typename T>
             typename std::enable_if<!std::is_convertible<T, Value::Ptr>::value, Provider::Ptr>::type
-            set(const std::string& propertyName, T value, bool skipPropertyNameFormatting)
+            set(uint propertyId, T value)
             {
-                auto          formattedName    = skipPropertyNameFormatting ? propertyName : formatPropertyName(propertyName);
-
-                const auto    foundValueIt     = _values.find(formattedName);
-                const bool    isNewValue       = foundValueIt == _values.end();
-
-                _values[formattedName] = value;
+                auto        foundSlotIt = _idToSlot.find(propertyId);
+                const bool  isNewValue  = foundSlotIt == _idToSlot.end();
 
                 if (isNewValue)
                 {
-                    _names.push_back(formattedName);
+                    addSlot(propertyId, value);
 
-                    _propertyAdded->execute(shared_from_this(), formattedName);
+                    _propertyAdded->execute(shared_from_this(), _names.back());
                 }
+                else
+                    _values[foundSlotIt->second] = value;
 
-                _propReferenceChanged->execute(shared_from_this(), formattedName);
-                _propValueChanged->execute(shared_from_this(), formattedName);
+                propertyChanged(propertyId, true);
 
                 return shared_from_this();
             }
 
             template <typename T>
             typename std::enable_if<std::is_convertible<T, Value::Ptr>::value, Provider::Ptr>::type
-            set(const std::string& propertyName, T value, bool skipPropertyNameFormatting)
+            set(uint propertyId, T value)
             {
-                auto          formattedName    = skipPropertyNameFormatting ? propertyName : formatPropertyName(propertyName);
-
-                const auto    foundValueIt     = _values.find(formattedName);
-                const bool    isNewValue       = (foundValueIt == _values.end());
-
-                _values[formattedName] = value;
+                auto        foundSlotIt = _idToSlot.find(propertyId);
+                const bool  isNewValue  = foundSlotIt == _idToSlot.end();
 
                 if (isNewValue)
                 {
-                    _valueChangedSlots[formattedName] = value->changed()->connect(std::bind(
-                         &Signal<Provider::Ptr, const std::string&>::execute,
-                         _propValueChanged,
+                    addSlot(propertyId, value);
+
+                    _valueChangedSlots[propertyId] = value->changed()->connect(std::bind(
+                         &Provider::propertyChanged,
                          shared_from_this(),
-                         formattedName
+                         propertyId,
+                         false
                     ));
 
-                    _names.push_back(formattedName);
-
-                    _propertyAdded->execute(shared_from_this(), formattedName);
+                    _propertyAdded->execute(shared_from_this(), _names.back());
                 }
+                else
+                    _values[foundSlotIt->second] = value;
 
-                _propReferenceChanged->execute(shared_from_this(), formattedName);
-                _propValueChanged->execute(shared_from_this(), formattedName);
+                propertyChanged(propertyId, true);
 
                 return shared_from_this();
             }
 
+            template <typename T>
+            inline
+            Ptr
+            set(const std::string& propertyName, T value, bool skipPropertyNameFormatting)
+            {
+                return set<T>(
+                    PropertyId::get(skipPropertyNameFormatting ? propertyName : formatPropertyName(propertyName)),
+                    value
+                );
+            }
+
             template <typename T>
             inline
             Ptr
@@ -223,6 +305,26 @@ namespace minko
 				return Provider::set(propertyName, value, false);
             }
 
+            // Defers the reference/value changed signals of the following writes until the matching
+            // endUpdate(): each modified property is then notified once, whatever the number of writes.
+            // Calls can be nested, propertyAdded() and propertyRemoved() are never deferred.
+            inline
+            void
+            beginUpdate()
+            {
+                ++_updateDepth;
+            }
+
+            void
+            endUpdate();
+
+            inline
+            bool
+            updating() const
+            {
+                return _updateDepth != 0;
+            }
+
             virtual
             Ptr
             unset(const std::string& propertyName);
@@ -240,6 +342,21 @@ namespace minko
         protected:
             Provider();
 
+            void
+            propertyChanged(uint propertyId, bool referenceChanged);
+
+            void
+            notifyPropertyChanged(uint propertyId, bool referenceChanged);
+
+            template <typename T>
+            void
+            addSlot(uint propertyId, const T& value)
+            {
+                _idToSlot[propertyId] = _ids.size();
+                _names.push_back(PropertyId::name(propertyId));
+                _ids.push_back(propertyId);
+                _values.push_back(Any(value));
+            }
 
             virtual
             std::string
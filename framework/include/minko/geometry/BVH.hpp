@@ -0,0 +1,148 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+#include "minko/math/Vec3.hpp"
+
+namespace minko
+{
+    namespace geometry
+    {
+        // Bounding volume hierarchy over the triangles of an indexed mesh, used to cast rays
+        // without testing every triangle. It is built once with a binned surface area heuristic and
+        // stored flat: the two children of an inner node are consecutive, the triangles of a leaf
+        // are consecutive and their vertices are copied in leaf order.
+        // The hierarchy does not follow the changes of the data it was built from.
+        class BVH
+        {
+        public:
+            typedef std::shared_ptr<BVH> Ptr;
+
+            struct Node
+            {
+                float                   min[3];
+                uint                    first;      // first child if count is 0, first triangle otherwise
+                float                   max[3];
+                uint                    count;      // number of triangles of a leaf
+            };
+
+        private:
+            std::vector<Node>           _nodes;
+            std::vector<uint>           _triangles; // index of the first index of each triangle, in leaf order
+            std::vector<float>          _vertices;  // 9 floats per triangle, in leaf order
+
+        public:
+            // Positions are read at 'positionOffset' in vertices of 'vertexSize' floats, triangles
+            // are made of 3 consecutive indices.
+            inline static
+            Ptr
+            create(const float*             vertices,
+                   uint                     vertexSize,
+                   uint                     positionOffset,
+                   const unsigned short*    indices,
+                   uint                     numIndices,
+                   uint                     maxLeafSize = 4)
+            {
+                Ptr bvh = std::shared_ptr<BVH>(new BVH());
+
+                bvh->build(vertices, vertexSize, positionOffset, indices, numIndices, maxLeafSize);
+
+                return bvh;
+            }
+
+            inline
+            const std::vector<Node>&
+            nodes() const
+            {
+                return _nodes;
+            }
+
+            inline
+            uint
+            numTriangles() const
+            {
+                return _triangles.size();
+            }
+
+            // Nearest intersection along the ray origin + t * direction, t >= 0. 'triangle' is the
+            // index of the first index of the triangle hit, (u, v) the barycentric weights of its
+            // second and third vertices.
+            bool
+            cast(const math::Vec3&  origin,
+                 const math::Vec3&  direction,
+                 float&             distance,
+                 uint&              triangle,
+                 float&             u,
+                 float&             v) const;
+
+            // Moller-Trumbore ray/triangle intersection, shared with the brute force path of Geometry
+            inline static
+            bool
+            intersectTriangle(const math::Vec3& origin,
+                              const math::Vec3& direction,
+                              const math::Vec3& v0,
+                              const math::Vec3& v1,
+                              const math::Vec3& v2,
+                              float&            t,
+                              float&            u,
+                              float&            v)
+            {
+                static const float EPSILON = 0.00001f;
+
+                const auto edge1 = v1 - v0;
+                const auto edge2 = v2 - v0;
+                const auto pvec = direction.cross(edge2);
+                const auto dot = edge1.dot(pvec);
+
+                if (dot > -EPSILON && dot < EPSILON)
+                    return false;
+
+                const auto invDot = 1.f / dot;
+                const auto tvec = origin - v0;
+
+                u = tvec.dot(pvec) * invDot;
+                if (u < 0.f || u > 1.f)
+                    return false;
+
+                const auto qvec = tvec.cross(edge1);
+
+                v = direction.dot(qvec) * invDot;
+                if (v < 0.f || u + v > 1.f)
+                    return false;
+
+                t = edge2.dot(qvec) * invDot;
+
+                return t >= 0.f;
+            }
+
+        private:
+            BVH();
+
+            void
+            build(const float*              vertices,
+                  uint                      vertexSize,
+                  uint                      positionOffset,
+                  const unsigned short*     indices,
+                  uint                      numIndices,
+                  uint                      maxLeafSize);
+        };
+    }
+}
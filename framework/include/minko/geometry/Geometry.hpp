@@ -22,6 +22,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/Common.hpp"
 #include "minko/data/ArrayProvider.hpp"
 #include "minko/render/VertexBuffer.hpp"
+#include "minko/math/Vec3.hpp"
 
 namespace minko
 {
@@ -43,6 +44,8 @@ namespace minko
             unsigned int                                        _numVertices;
             std::list<VBPtr>                                    _vertexBuffers;
             std::shared_ptr<render::IndexBuffer>                _indexBuffer;
+            bool                                                _useBVH;
+            std::shared_ptr<BVH>                                _bvh;
 
             std::unordered_map<VBPtr, Signal<VBPtr, int>::Slot> _vbToVertexSizeChangedSlot;
 
@@ -112,6 +115,7 @@ namespace minko
             indices(std::shared_ptr<render::IndexBuffer> indices)
             {
                 _indexBuffer = indices;
+                _bvh = nullptr;
                 _data->set("indices", indices);
             }
 
@@ -160,6 +164,35 @@ namespace minko
                                      std::vector<std::vector<float>>&    vertices,
                                      uint                                numVertices);
 
+            // whether cast() uses a BVH of the triangles, built on the first call (true by default)
+            inline
+            bool
+            useBVH() const
+            {
+                return _useBVH;
+            }
+
+            inline
+            void
+            useBVH(bool value)
+            {
+                _useBVH = value;
+            }
+
+            // builds the BVH of the triangles if needed, the "position" and index buffers must hold their data
+            std::shared_ptr<BVH>
+            bvh();
+
+            // to be called when the positions or the indices are modified in place
+            inline
+            void
+            invalidateBVH()
+            {
+                _bvh = nullptr;
+            }
+
+            // Nearest intersection of the ray with the triangles of the geometry, in the space of the
+            // vertices. 'triangle' is the index of the first index of the triangle hit.
             bool
             cast(std::shared_ptr<math::Ray>        ray,
                  float&                            distance,
@@ -218,11 +251,19 @@ namespace minko
             void
             removeVertexBuffer(std::list<VBPtr>::iterator vertexBufferIt);
 
+            bool
+            castTriangles(const math::Vec3& origin,
+                          const math::Vec3& direction,
+                          float&            distance,
+                          uint&             triangle,
+                          float&            u,
+                          float&            v);
+
             void
-            getHitUv(uint triangle, std::shared_ptr<math::Vector2> lambda, std::shared_ptr<math::Vector2> hitUv);
+            getHitUv(uint triangle, float u, float v, std::shared_ptr<math::Vector2> hitUv);
 
             void
-            getHitNormal(uint triangle, std::shared_ptr<math::Vector3> hitNormal);
+            getHitNormal(uint triangle, float u, float v, std::shared_ptr<math::Vector3> hitNormal);
         };
     }
 }
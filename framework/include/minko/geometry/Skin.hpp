@@ -26,6 +26,7 @@ namespace minko
     namespace geometry
     {
         class Bone;
+        class SkinClip;
 
         class Skin:
             public std::enable_shared_from_this<Skin>
@@ -36,6 +37,7 @@ namespace minko
         private:
             typedef std::shared_ptr<Bone>               BonePtr;
             typedef std::shared_ptr<math::Matrix4x4>    Matrix4x4Ptr;
+            typedef std::shared_ptr<SkinClip>           SkinClipPtr;
 
         private:
             const unsigned int                          _numBones;
@@ -44,12 +46,17 @@ namespace minko
             const uint                                  _duration;               // in milliseconds
             const float                                 _timeFactor;
             std::vector<std::vector<float>>             _boneMatricesPerFrame;
+            SkinClipPtr                                 _clip;                   // replaces the baked frames when set
 
             unsigned int                                _maxNumVertexBones;
             std::vector<unsigned int>                   _numVertexBones;         // size = #vertices
             std::vector<unsigned int>                   _vertexBones;            // size = #vertices * #bones
             std::vector<float>                          _vertexBoneWeights;      // size = #vertices * #bones
 
+            unsigned int                                _packedNumVertices;
+            std::vector<unsigned int>                   _packedVertexBones;       // size = maxNumVertexBones * packedNumVertices
+            std::vector<float>                          _packedVertexBoneWeights; // size = maxNumVertexBones * packedNumVertices
+
         public:
             inline
             static
@@ -59,6 +66,12 @@ namespace minko
                 return std::shared_ptr<Skin>(new Skin(numBones, duration, numFrames));
             }
 
+            // Skin evaluating its pose from a compressed clip rather than from baked frames. The clip
+            // is shared by the clones of the skin.
+            static
+            Ptr
+            create(unsigned int numBones, SkinClipPtr clip);
+
 			Ptr
 			clone();
 
@@ -114,6 +127,13 @@ namespace minko
             uint
             getFrameId(uint) const;
 
+            inline
+            SkinClipPtr
+            clip() const
+            {
+                return _clip;
+            }
+
             inline
             unsigned int
             numFrames() const
@@ -169,6 +189,30 @@ namespace minko
             unsigned int
             vertexBoneId(unsigned int vertexId, unsigned int j) const;
 
+            // The bone ids and weights are also packed influence after influence for the software skinning
+            // kernels: the j-th influence of the vertex v is at j * packedNumVertices() + v. The number of
+            // vertices is rounded up to a multiple of 8 and missing influences have a null weight.
+            inline
+            unsigned int
+            packedNumVertices() const
+            {
+                return _packedNumVertices;
+            }
+
+            inline
+            const std::vector<unsigned int>&
+            packedVertexBoneIds() const
+            {
+                return _packedVertexBones;
+            }
+
+            inline
+            const std::vector<float>&
+            packedVertexBoneWeights() const
+            {
+                return _packedVertexBoneWeights;
+            }
+
             float
             vertexBoneWeight(unsigned int vertexId, unsigned int j) const;
 
@@ -0,0 +1,175 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+    namespace geometry
+    {
+        // Compressed skeletal animation of a rig, meant to be shared by all the skins of this rig.
+        // Each bone keeps its own translation, rotation and scale tracks: the sampled local matrices
+        // are decomposed, rotations are quantized with the "smallest three" encoding and the keys that
+        // a linear interpolation of their neighbours reproduces within a tolerance are dropped.
+        // The pose is evaluated at any time with a flat pass over the bones, parents first.
+        class SkinClip
+        {
+        public:
+            typedef std::shared_ptr<SkinClip>   Ptr;
+
+            // a local pose stores the translation (3 floats), rotation (x, y, z, w) and scale (3 floats)
+            // of each bone
+            static const uint                   LOCAL_POSE_SIZE = 10;
+
+        private:
+            struct Track
+            {
+                uint                            firstKey;
+                uint                            numKeys;
+            };
+
+        private:
+            uint                                _numBones;
+            uint                                _duration;      // in milliseconds
+            uint                                _numFrames;
+            float                               _timeFactor;
+            std::vector<int>                    _parentIds;
+            std::vector<float>                  _offsetMatrices;    // 12 floats per bone, row major
+
+            std::vector<Track>                  _translationTracks;
+            std::vector<unsigned short>         _translationTimes;  // frame of each key
+            std::vector<float>                  _translations;      // 3 floats per key
+            std::vector<Track>                  _rotationTracks;
+            std::vector<unsigned short>         _rotationTimes;
+            std::vector<unsigned short>         _rotations;         // 3 quantized components per key
+            std::vector<Track>                  _scaleTracks;
+            std::vector<unsigned short>         _scaleTimes;
+            std::vector<float>                  _scales;
+
+        public:
+            // 'parentIds' gives the parent of each bone (-1 for the roots) and must list parents before
+            // their children. 'offsetMatrices' holds the 16 floats of the offset matrix of each bone
+            // and 'localMatricesPerFrame' the 16 floats of the local matrix of each bone for each frame,
+            // all in row major order (as math::Matrix4x4::data()). Frames are evenly spread over 'duration'.
+            static
+            Ptr
+            create(const std::vector<int>&                  parentIds,
+                   const std::vector<float>&                offsetMatrices,
+                   uint                                     duration,
+                   const std::vector<std::vector<float>>&   localMatricesPerFrame,
+                   float                                    translationTolerance    = 1e-3f,
+                   float                                    rotationTolerance       = 1e-4f,
+                   float                                    scaleTolerance          = 1e-3f);
+
+            inline
+            uint
+            numBones() const
+            {
+                return _numBones;
+            }
+
+            inline
+            uint
+            duration() const
+            {
+                return _duration;
+            }
+
+            inline
+            uint
+            numFrames() const
+            {
+                return _numFrames;
+            }
+
+            inline
+            const std::vector<int>&
+            parentIds() const
+            {
+                return _parentIds;
+            }
+
+            // number of keys kept, all tracks included
+            inline
+            uint
+            numKeys() const
+            {
+                return _translationTimes.size() + _rotationTimes.size() + _scaleTimes.size();
+            }
+
+            // size of the animation data in bytes
+            uint
+            memorySize() const;
+
+            // Writes the 16 floats of the skinning matrix of each bone at 'time' (in milliseconds) in
+            // the layout of Skin::matrices(), using 'worldMatrices' as a scratch buffer.
+            void
+            pose(uint time, std::vector<float>& skinningMatrices, std::vector<float>& worldMatrices) const;
+
+            // Writes the 12 floats of the local matrix of 'boneId' at 'time', row major.
+            void
+            localMatrix(uint boneId, uint time, float* matrix) const;
+
+            // Writes the local pose of every bone at 'time' (LOCAL_POSE_SIZE floats per bone).
+            void
+            localPose(uint time, float* localPose) const;
+
+            // Same as pose(time, ...) but from a local pose, e.g. one blended from several clips of the rig.
+            void
+            pose(const float* localPose, std::vector<float>& skinningMatrices, std::vector<float>& worldMatrices) const;
+
+            // true if 'clip' animates the same hierarchy: its local poses can be blended with the ones of this clip
+            bool
+            hasSameRig(const SkinClip& clip) const;
+
+            // out = a * (1 - ratio) + b * ratio, rotations along the shortest arc
+            static
+            void
+            blendLocalPoses(const float* a, const float* b, float ratio, uint numBones, float* out);
+
+            // Adds weight * (additive - reference) to 'out': translations are offset, rotations composed
+            // and scales multiplied by the difference between the additive pose and its reference pose.
+            static
+            void
+            addLocalPoses(const float* additive, const float* reference, float weight, uint numBones, float* out);
+
+        private:
+            SkinClip(const std::vector<int>& parentIds, uint duration, uint numFrames);
+
+            void
+            compress(const std::vector<float>&                  offsetMatrices,
+                     const std::vector<std::vector<float>>&     localMatricesPerFrame,
+                     float                                      translationTolerance,
+                     float                                      rotationTolerance,
+                     float                                      scaleTolerance);
+
+            void
+            evaluateLocalPose(uint boneId, float frame, float* localPose) const;
+
+            float
+            frame(uint time) const;
+
+            void
+            computeSkinningMatrix(uint boneId, const float* local, float* worldMatrices, float* skinningMatrix) const;
+        };
+    }
+}
@@ -0,0 +1,142 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+    namespace geometry
+    {
+        class SkinClip;
+
+        // Skinning matrices of skin clips keyed by (clip, time rounded down to a time step), so that the
+        // instances of a crowd playing the same clip at about the same time evaluate a single pose.
+        // Poses are kept until clear() is called: once 'maxNumPoses' are cached, new poses are not
+        // cached anymore and the callers evaluate them on their own. The returned poses are shared:
+        // clear() only releases the ones no caller holds anymore.
+        class SkinPoseCache
+        {
+        public:
+            typedef std::shared_ptr<SkinPoseCache>              Ptr;
+            typedef std::shared_ptr<const std::vector<float>>   PosePtr;
+
+        private:
+            typedef std::shared_ptr<SkinClip>       SkinClipPtr;
+            typedef std::pair<const SkinClip*, uint> Key;
+
+            struct KeyHash
+            {
+                inline
+                std::size_t
+                operator()(const Key& key) const
+                {
+                    return std::hash<const SkinClip*>()(key.first) ^ (std::hash<uint>()(key.second) * 0x9e3779b9u);
+                }
+            };
+
+            struct Entry
+            {
+                SkinClipPtr                         clip;   // keeps the key valid
+                std::shared_ptr<std::vector<float>> matrices;
+            };
+
+        private:
+            uint                                    _timeStep;
+            uint                                    _maxNumPoses;
+            std::unordered_map<Key, Entry, KeyHash> _poses;
+            std::vector<float>                      _worldMatrices;
+            uint                                    _numHits;
+            uint                                    _numMisses;
+
+        public:
+            // 'timeStep' is in milliseconds
+            inline static
+            Ptr
+            create(uint timeStep = 16, uint maxNumPoses = 4096)
+            {
+                return std::shared_ptr<SkinPoseCache>(new SkinPoseCache(timeStep, maxNumPoses));
+            }
+
+            inline
+            uint
+            timeStep() const
+            {
+                return _timeStep;
+            }
+
+            inline
+            uint
+            numPoses() const
+            {
+                return _poses.size();
+            }
+
+            inline
+            uint
+            numHits() const
+            {
+                return _numHits;
+            }
+
+            inline
+            uint
+            numMisses() const
+            {
+                return _numMisses;
+            }
+
+            inline
+            float
+            hitRate() const
+            {
+                return _numHits + _numMisses > 0 ? _numHits / float(_numHits + _numMisses) : 0.f;
+            }
+
+            inline
+            void
+            resetStatistics()
+            {
+                _numHits = 0;
+                _numMisses = 0;
+            }
+
+            // time actually evaluated for 'time'
+            inline
+            uint
+            quantize(uint time) const
+            {
+                return time - time % _timeStep;
+            }
+
+            // Skinning matrices of 'clip' at quantize(time), or nullptr if the cache is full. The returned
+            // array remains valid as long as it is held, even after clear().
+            PosePtr
+            pose(SkinClipPtr clip, uint time);
+
+            void
+            clear();
+
+        private:
+            SkinPoseCache(uint timeStep, uint maxNumPoses);
+        };
+    }
+}
@@ -219,6 +219,13 @@ namespace minko
             Ptr
             isTransparent(bool transparent, bool zSort = false);
 
+            // render surfaces sharing this material and their geometry as hardware instances
+            Ptr
+            instancing(bool);
+
+            bool
+            instancing() const;
+
             Ptr
             target(AbsTexturePtr);
 
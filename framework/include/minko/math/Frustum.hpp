@@ -35,7 +35,7 @@ namespace minko
 
         private:
             std::vector<std::shared_ptr<math::Vector3>>   _points;
-            std::array<std::shared_ptr<math::Vector4>, 6> _planes;
+            std::array<float, 24>                         _planes; // (a, b, c, d) per PlanePosition, normalized
 
             std::array<bool, 6> _blfResult;
             std::array<bool, 6> _blbResult;
@@ -63,6 +63,43 @@ namespace minko
             ShapePosition
             testBoundingBox(std::shared_ptr<math::Box> box);
 
+            inline
+            const float*
+            planes() const
+            {
+                return _planes.data();
+            }
+
+            // Tests 'numBoxes' axis aligned boxes given as arrays of centers and half extents (one
+            // array per axis) against the frustum. Bit i of 'visibility' (32 boxes per word) is set
+            // when box i is inside or intersects the frustum. Returns the number of visible boxes.
+            inline
+            uint
+            testBoundingBoxes(const float* const    center[3],
+                              const float* const    extent[3],
+                              uint                  numBoxes,
+                              uint*                 visibility) const
+            {
+                return testBoxes(_planes.data(), center, extent, numBoxes, visibility);
+            }
+
+            // batch kernel working on raw planes: 4 (SSE2) or 8 (AVX2) boxes per iteration
+            static
+            uint
+            testBoxes(const float*          planes,
+                      const float* const    center[3],
+                      const float* const    extent[3],
+                      uint                  numBoxes,
+                      uint*                 visibility);
+
+            static
+            uint
+            testBoxesScalar(const float*        planes,
+                            const float* const  center[3],
+                            const float* const  extent[3],
+                            uint                numBoxes,
+                            uint*               visibility);
+
         private:
             Frustum();
         };
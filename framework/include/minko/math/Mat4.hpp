@@ -0,0 +1,314 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+#include "minko/math/Vec3.hpp"
+#include "minko/math/Vec4.hpp"
+
+#if defined(MINKO_AVX2)
+# include <immintrin.h>
+#elif defined(MINKO_SSE2)
+# include <emmintrin.h>
+#endif
+
+namespace minko
+{
+    namespace math
+    {
+        // Plain 4x4 matrix value, stored row-major like math::Matrix4x4 (translation in m[3], m[7], m[11]).
+        // The static kernels below work on raw float[16] pointers so they also apply to the storage of a
+        // math::Matrix4x4, which does not have to be aligned.
+        struct MINKO_ALIGN(16) Mat4
+        {
+            float m[16];
+
+            inline static
+            Mat4
+            identity()
+            {
+                Mat4 result = {{
+                    1.f, 0.f, 0.f, 0.f,
+                    0.f, 1.f, 0.f, 0.f,
+                    0.f, 0.f, 1.f, 0.f,
+                    0.f, 0.f, 0.f, 1.f
+                }};
+
+                return result;
+            }
+
+            inline static
+            Mat4
+            load(const float* values)
+            {
+                Mat4 result;
+
+                std::copy(values, values + 16, result.m);
+
+                return result;
+            }
+
+            inline
+            void
+            store(float* values) const
+            {
+                std::copy(m, m + 16, values);
+            }
+
+            static
+            Mat4
+            perspective(float fov, float ratio, float zNear, float zFar);
+
+            inline
+            Mat4
+            operator*(const Mat4& value) const
+            {
+                Mat4 result;
+
+                multiply(m, value.m, result.m);
+
+                return result;
+            }
+
+            inline
+            bool
+            operator==(const Mat4& value) const
+            {
+                return std::equal(m, m + 16, value.m);
+            }
+
+            inline
+            Vec3
+            transformPoint(const Vec3& v) const
+            {
+                return transformPoint(m, v);
+            }
+
+            inline
+            Vec3
+            transformVector(const Vec3& v) const
+            {
+                return transformVector(m, v);
+            }
+
+            inline
+            Vec4
+            transform(const Vec4& v) const
+            {
+                return transform(m, v);
+            }
+
+            // output = a * b, 'output' may point to 'a' or 'b'
+            inline static
+            void
+            multiply(const float* a, const float* b, float* output)
+            {
+                // each output row is a linear combination of the rows of 'b' weighted by the matching row of 'a'
+#if defined(MINKO_AVX2)
+                // two output rows per iteration: each 128-bit lane holds one of them
+                const __m256 row0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b));
+                const __m256 row1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 4));
+                const __m256 row2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 8));
+                const __m256 row3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 12));
+
+                for (unsigned int i = 0; i < 16; i += 8)
+                {
+                    const __m256 rowsA = _mm256_loadu_ps(a + i);
+                    __m256 r = _mm256_mul_ps(_mm256_shuffle_ps(rowsA, rowsA, 0x00), row0);
+
+                    r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_shuffle_ps(rowsA, rowsA, 0x55), row1));
+                    r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_shuffle_ps(rowsA, rowsA, 0xaa), row2));
+                    r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_shuffle_ps(rowsA, rowsA, 0xff), row3));
+
+                    _mm256_storeu_ps(output + i, r);
+                }
+#elif defined(MINKO_SSE2)
+                const __m128 row0 = _mm_loadu_ps(b);
+                const __m128 row1 = _mm_loadu_ps(b + 4);
+                const __m128 row2 = _mm_loadu_ps(b + 8);
+                const __m128 row3 = _mm_loadu_ps(b + 12);
+
+                for (unsigned int i = 0; i < 16; i += 4)
+                {
+                    __m128 r = _mm_mul_ps(_mm_set1_ps(a[i]), row0);
+
+                    r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(a[i + 1]), row1));
+                    r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(a[i + 2]), row2));
+                    r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(a[i + 3]), row3));
+
+                    _mm_storeu_ps(output + i, r);
+                }
+#else
+                multiplyScalar(a, b, output);
+#endif
+            }
+
+            // scalar reference implementation, always available
+            inline static
+            void
+            multiplyScalar(const float* a, const float* b, float* output)
+            {
+                float rows[16];
+
+                std::copy(b, b + 16, rows);
+
+                for (unsigned int i = 0; i < 16; i += 4)
+                {
+                    const float a0 = a[i];
+                    const float a1 = a[i + 1];
+                    const float a2 = a[i + 2];
+                    const float a3 = a[i + 3];
+
+                    output[i]       = a0 * rows[0] + a1 * rows[4] + a2 * rows[8]  + a3 * rows[12];
+                    output[i + 1]   = a0 * rows[1] + a1 * rows[5] + a2 * rows[9]  + a3 * rows[13];
+                    output[i + 2]   = a0 * rows[2] + a1 * rows[6] + a2 * rows[10] + a3 * rows[14];
+                    output[i + 3]   = a0 * rows[3] + a1 * rows[7] + a2 * rows[11] + a3 * rows[15];
+                }
+            }
+
+            // output[i] = a[i] * b[i] for 'numMatrices' consecutive float[16] matrices
+            static
+            void
+            multiply(const float* a, const float* b, float* output, unsigned int numMatrices);
+
+            // returns false, leaving 'output' untouched, when 'm' is not invertible
+            static
+            bool
+            invert(const float* m, float* output);
+
+            static
+            bool
+            invertScalar(const float* m, float* output);
+
+            inline static
+            void
+            transpose(const float* m, float* output)
+            {
+#ifdef MINKO_SSE2
+                __m128 row0 = _mm_loadu_ps(m);
+                __m128 row1 = _mm_loadu_ps(m + 4);
+                __m128 row2 = _mm_loadu_ps(m + 8);
+                __m128 row3 = _mm_loadu_ps(m + 12);
+
+                _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+                _mm_storeu_ps(output, row0);
+                _mm_storeu_ps(output + 4, row1);
+                _mm_storeu_ps(output + 8, row2);
+                _mm_storeu_ps(output + 12, row3);
+#else
+                float t[16] = {
+                    m[0], m[4], m[8],  m[12],
+                    m[1], m[5], m[9],  m[13],
+                    m[2], m[6], m[10], m[14],
+                    m[3], m[7], m[11], m[15]
+                };
+
+                std::copy(t, t + 16, output);
+#endif
+            }
+
+            // Transforms 'numPoints' points whose coordinates start every 'stride' floats. Only the first
+            // three floats of each point are read and written, 'output' may be 'points'.
+            static
+            void
+            transformPoints(const float*    m,
+                            const float*    points,
+                            float*          output,
+                            unsigned int    numPoints,
+                            unsigned int    stride = 3);
+
+            static
+            void
+            transformPointsScalar(const float*  m,
+                                  const float*  points,
+                                  float*        output,
+                                  unsigned int  numPoints,
+                                  unsigned int  stride = 3);
+
+            inline static
+            Vec3
+            transformPoint(const float* m, const Vec3& v)
+            {
+                Vec3 result = {
+                    v.x * m[0] + v.y * m[1] + v.z * m[2]  + m[3],
+                    v.x * m[4] + v.y * m[5] + v.z * m[6]  + m[7],
+                    v.x * m[8] + v.y * m[9] + v.z * m[10] + m[11]
+                };
+
+                return result;
+            }
+
+            inline static
+            Vec3
+            transformVector(const float* m, const Vec3& v)
+            {
+                Vec3 result = {
+                    v.x * m[0] + v.y * m[1] + v.z * m[2],
+                    v.x * m[4] + v.y * m[5] + v.z * m[6],
+                    v.x * m[8] + v.y * m[9] + v.z * m[10]
+                };
+
+                return result;
+            }
+
+            inline static
+            Vec4
+            transform(const float* m, const Vec4& v)
+            {
+#ifdef MINKO_SSE2
+                // sum the rows' products into the lanes of the result with a 4x4 transpose
+                __m128 vv    = _mm_loadu_ps(&v.x);
+                __m128 r0    = _mm_mul_ps(_mm_loadu_ps(m), vv);
+                __m128 r1    = _mm_mul_ps(_mm_loadu_ps(m + 4), vv);
+                __m128 r2    = _mm_mul_ps(_mm_loadu_ps(m + 8), vv);
+                __m128 r3    = _mm_mul_ps(_mm_loadu_ps(m + 12), vv);
+                Vec4   result;
+
+                _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+                _mm_store_ps(&result.x, _mm_add_ps(_mm_add_ps(r0, r1), _mm_add_ps(r2, r3)));
+
+                return result;
+#else
+                Vec4 result = {
+                    v.x * m[0]  + v.y * m[1]  + v.z * m[2]  + v.w * m[3],
+                    v.x * m[4]  + v.y * m[5]  + v.z * m[6]  + v.w * m[7],
+                    v.x * m[8]  + v.y * m[9]  + v.z * m[10] + v.w * m[11],
+                    v.x * m[12] + v.y * m[13] + v.z * m[14] + v.w * m[15]
+                };
+
+                return result;
+#endif
+            }
+
+            inline static
+            Vec3
+            project(const float* m, const Vec3& v)
+            {
+                float w     = v.x * m[12] + v.y * m[13] + v.z * m[14] + m[15];
+                Vec3  p     = transformPoint(m, v);
+
+                return p * (1.f / w);
+            }
+        };
+
+        static_assert(std::is_trivial<Mat4>::value, "math::Mat4 must remain a trivial type");
+    }
+}
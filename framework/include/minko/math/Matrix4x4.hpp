@@ -21,6 +21,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 #include "minko/Common.hpp"
 #include "minko/data/Value.hpp"
+#include "minko/math/Mat4.hpp"
 #include "minko/math/Vector3.hpp"
 #include "minko/math/Vector4.hpp"
 #include "minko/math/Quaternion.hpp"
@@ -91,7 +92,14 @@ namespace minko
             initialize(std::vector<float> m);
 
             Ptr
-            initialize(float* m);
+            initialize(const float* m);
+
+            inline
+            Ptr
+            initialize(const Mat4& m)
+            {
+                return initialize(m.m);
+            }
 
             Ptr
             initialize(Quaternion::Ptr, Vector3::Ptr);
@@ -103,6 +111,13 @@ namespace minko
                 return _m;
             }
 
+            inline
+            Mat4
+            toMat4() const
+            {
+                return Mat4::load(&_m[0]);
+            }
+
             std::string
             toString()
             {
@@ -383,6 +398,13 @@ namespace minko
             Ptr
             copyFrom(Matrix4x4::Ptr source);
 
+            inline
+            Ptr
+            copyFrom(const Mat4& source)
+            {
+                return initialize(source.m);
+            }
+
         private:
             Matrix4x4();
 
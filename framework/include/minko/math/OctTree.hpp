@@ -22,11 +22,18 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/Common.hpp"
 #include "minko/data/Container.hpp"
 #include "minko/Signal.hpp"
+#include "minko/math/Vec3.hpp"
 
 namespace minko
 {
     namespace math
     {
+        // Loose octree indexing scene nodes by the world space box of their BoundingBox.
+        // An octant holds the nodes whose center lies in its cell and whose half size is at most
+        // the cell's half size, so that its loose bounds are twice as large as the cell. Nodes whose
+        // center lies outside of the world bounds are kept in the root octant.
+        // Nodes are moved lazily: a change of their model to world matrix only flags them, update()
+        // then moves them to their new octant.
         class OctTree :
             public std::enable_shared_from_this<OctTree>
         {
@@ -34,90 +41,170 @@ namespace minko
             typedef std::shared_ptr<OctTree> Ptr;
 
         private:
-            typedef std::shared_ptr<scene::Node> NodePtr;
+            typedef std::shared_ptr<scene::Node>                    NodePtr;
+            typedef std::shared_ptr<component::BoundingBox>         BoundingBoxPtr;
 
-        private:
-            static const uint _k = 2;
+            static const int NO_OCTANT = -1;
+
+            struct Octant
+            {
+                Vec3                                                center;
+                float                                               halfSize;
+                uint                                                depth;
+                int                                                 parent;
+                int                                                 firstChild; // 8 consecutive octants, child index : x + y << 1 + z << 2
+                uint                                                numNodes;   // in this octant and its descendants
+                std::vector<uint>                                   objects;
+                std::shared_ptr<math::Box>                          looseBox;
+            };
+
+            struct Object
+            {
+                NodePtr                                             node;
+                BoundingBoxPtr                                      boundingBox;
+                int                                                 octant;
+                uint                                                indexInOctant;
+                bool                                                invalid;
+                data::Container::PropertyChangedSignal::Slot        modelToWorldChangedSlot;
+                Signal<BoundingBoxPtr>::Slot                        boundingBoxChangedSlot;     // surfaces or geometry
+            };
 
         private:
-            uint                                                                        _maxDepth;
-            uint                                                                        _depth;
-            bool                                                                        _splitted;
-            Ptr                                                                         _parent;
-            std::vector<Ptr>                                                            _children; //x, y, z in {0, 1}, child index : x + y << 1 + z << 2
-            std::list<NodePtr>                                                          _content;
-            std::list<NodePtr>                                                          _childrenContent;
-            float                                                                       _worldSize;
-            std::shared_ptr<math::Vector3>                                              _center;
-            std::unordered_map<NodePtr, Ptr>                                            _nodeToOctant;
-            std::unordered_map<NodePtr, data::Container::PropertyChangedSignal::Slot>   _nodeToTransformChangedSlot;
-            std::unordered_map<std::shared_ptr<math::Matrix4x4>, NodePtr>               _matrixToNode;
-            std::shared_ptr<math::Box>                                                  _octantBox;
-
-
-            bool _inside;
-            NodePtr debugNode;
+            uint                                                    _maxDepth;
+            std::vector<Octant>                                     _octants;
+            std::vector<Object>                                     _objects;
+            std::vector<uint>                                       _freeObjects;
+            std::unordered_map<NodePtr, uint>                       _nodeToObject;
+            std::vector<uint>                                       _invalidObjects;
+            uint                                                    _revision;
+
+            // world space boxes of the objects as centers and half extents, indexed by object id
+            std::array<std::vector<float>, 3>                       _centers;
+            std::array<std::vector<float>, 3>                       _extents;
+            std::vector<uint>                                       _visibility;
+            std::vector<uint>                                       _octantStack;
 
         public:
+            // worldSize is the edge length of the root cell, centered on center
             inline static
             Ptr
             create(float                            worldSize,
                    uint                             maxDepth,
-                   std::shared_ptr<math::Vector3>   center,
-                   uint                             depth = 0)
+                   std::shared_ptr<math::Vector3>   center)
             {
-                return std::shared_ptr<OctTree>(new OctTree(worldSize, maxDepth, center, depth));
+                return std::shared_ptr<OctTree>(new OctTree(worldSize, maxDepth, center));
             }
 
+            inline
+            uint
+            numNodes() const
+            {
+                return _nodeToObject.size();
+            }
+
+            inline
+            uint
+            numOctants() const
+            {
+                return _octants.size();
+            }
+
+            // incremented whenever a node is inserted, removed or moved: results computed against
+            // an older revision must be computed again
+            inline
+            uint
+            revision() const
+            {
+                return _revision;
+            }
+
+            inline
+            bool
+            contains(NodePtr node) const
+            {
+                return _nodeToObject.count(node) != 0;
+            }
+
+            // adds a BoundingBox to the node if it has none
             Ptr
             insert(NodePtr node);
 
             Ptr
             remove(NodePtr node);
 
-            uint
-            computeDepth(NodePtr node);
+            Ptr
+            clear();
+
+            // moves the nodes whose model to world matrix changed since the last call
+            Ptr
+            update();
+
+            // depth of the octant holding the node, -1 if the node is not in the tree
+            int
+            depth(NodePtr node) const;
 
             NodePtr
             generateVisual(std::shared_ptr<file::AssetLibrary>              assetLibrary,
                            NodePtr                                          rootNode = nullptr);
 
-            uint
-            testFrustum(std::shared_ptr<math::Frustum>                      frustum);
-
             void
             testFrustum(std::shared_ptr<math::AbstractShape>                frustum,
                         std::function<void(std::shared_ptr<scene::Node>)>   insideFrustumCallback,
                         std::function<void(std::shared_ptr<scene::Node>)>   outsideFustumCallback);
 
+            // calls 'callback' for each node of the tree, octant by octant
+            void
+            visit(std::function<void(std::shared_ptr<scene::Node>)>            callback);
+
+            // tests the boxes of all the nodes at once with Frustum::testBoundingBoxes instead of
+            // walking the octants, returns the number of visible nodes
+            uint
+            testFrustumBatch(std::shared_ptr<math::Frustum>                     frustum,
+                             std::function<void(std::shared_ptr<scene::Node>)>  insideFrustumCallback,
+                             std::function<void(std::shared_ptr<scene::Node>)>  outsideFustumCallback);
+
+            // Nodes whose world space box is hit by the ray within maxDistance, sorted by the distance
+            // at which the ray enters their box. Returns the number of nodes hit.
+            uint
+            cast(std::shared_ptr<math::Ray>                                     ray,
+                 std::vector<std::pair<float, std::shared_ptr<scene::Node>>>&   hits,
+                 float                                                          maxDistance = std::numeric_limits<float>::infinity());
+
         private:
+            OctTree(float                                                   worldSize,
+                    uint                                                    maxDepth,
+                    std::shared_ptr<math::Vector3>                          center);
 
-            bool
-            nodeChangedOctant(NodePtr node);
+            uint
+            createOctant(const Vec3& center, float halfSize, uint depth, int parent);
 
             void
-            nodeModelToWorldChanged(std::shared_ptr<data::Container>        data,
-                                    const std::string&                      propertyName);
+            split(uint octantId);
 
             void
-            split();
+            updateBounds(uint objectId);
 
-            float
-            computeRadius(std::shared_ptr<component::BoundingBox>           boundingBox);
+            int
+            findOctant(uint objectId);
 
             void
-            addChildContent(NodePtr                                         node);
+            attach(uint objectId, int octantId);
 
             void
-            removeChildContent(NodePtr                                      node);
+            detach(uint objectId);
 
-            float
-            edgeLength();
+            void
+            invalidate(uint objectId);
 
-            OctTree(float                                                   worldSize,
-                     uint                                                   maxDepth,
-                     std::shared_ptr<math::Vector3>                         center,
-                     uint                                                   depth);
+            void
+            testOctant(uint                                                 octantId,
+                       std::shared_ptr<math::AbstractShape>                 frustum,
+                       std::function<void(std::shared_ptr<scene::Node>)>&   insideFrustumCallback,
+                       std::function<void(std::shared_ptr<scene::Node>)>&   outsideFustumCallback);
+
+            void
+            visitOctant(uint                                                octantId,
+                        std::function<void(std::shared_ptr<scene::Node>)>&  callback);
         };
     }
 }
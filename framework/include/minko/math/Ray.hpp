@@ -22,6 +22,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/Common.hpp"
 
 #include "minko/math/Vector3.hpp"
+#include "minko/math/Vec3.hpp"
 
 namespace minko
 {
@@ -68,6 +69,45 @@ namespace minko
                 return _origin;
             }
 
+            // Slab test of the ray origin + t * direction, t >= 0, against the box [min, max], given
+            // the inverse of the direction. On intersection, [near, far] is the range of t in the box.
+            // An infinite inverse component means the ray is parallel to that slab: the axis does not
+            // constrain t as long as the origin lies within the slab, planes included.
+            inline static
+            bool
+            intersectBox(const Vec3&    origin,
+                         const Vec3&    invDirection,
+                         const float*   min,
+                         const float*   max,
+                         float&         near,
+                         float&         far)
+            {
+                const float o[3]    = { origin.x, origin.y, origin.z };
+                const float inv[3]  = { invDirection.x, invDirection.y, invDirection.z };
+
+                near = 0.f;
+                far = std::numeric_limits<float>::infinity();
+
+                for (uint i = 0; i < 3; ++i)
+                {
+                    if (std::isinf(inv[i]))
+                    {
+                        if (o[i] < min[i] || o[i] > max[i])
+                            return false;
+
+                        continue;
+                    }
+
+                    const float t0 = (min[i] - o[i]) * inv[i];
+                    const float t1 = (max[i] - o[i]) * inv[i];
+
+                    near = std::max(near, std::min(t0, t1));
+                    far = std::min(far, std::max(t0, t1));
+                }
+
+                return near <= far;
+            }
+
         private:
             Ray(Vector3Ptr origin, Vector3Ptr direction) :
                 _origin(Vector3::create(origin)),
@@ -0,0 +1,111 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+    namespace math
+    {
+        // Plain 3D vector value: trivially copyable and never heap allocated, unlike math::Vector3.
+        struct Vec3
+        {
+            float x;
+            float y;
+            float z;
+
+            inline
+            float
+            dot(const Vec3& v) const
+            {
+                return x * v.x + y * v.y + z * v.z;
+            }
+
+            inline
+            Vec3
+            cross(const Vec3& v) const
+            {
+                Vec3 result = { y * v.z - z * v.y, z * v.x - x * v.z, x * v.y - y * v.x };
+
+                return result;
+            }
+
+            inline
+            float
+            lengthSquared() const
+            {
+                return dot(*this);
+            }
+
+            inline
+            float
+            length() const
+            {
+                return sqrtf(lengthSquared());
+            }
+
+            inline
+            Vec3
+            normalized() const
+            {
+                float length = this->length();
+
+                return length != 0.f ? *this * (1.f / length) : *this;
+            }
+
+            inline
+            Vec3
+            operator+(const Vec3& v) const
+            {
+                Vec3 result = { x + v.x, y + v.y, z + v.z };
+
+                return result;
+            }
+
+            inline
+            Vec3
+            operator-(const Vec3& v) const
+            {
+                Vec3 result = { x - v.x, y - v.y, z - v.z };
+
+                return result;
+            }
+
+            inline
+            Vec3
+            operator*(float scale) const
+            {
+                Vec3 result = { x * scale, y * scale, z * scale };
+
+                return result;
+            }
+
+            inline
+            bool
+            operator==(const Vec3& v) const
+            {
+                return x == v.x && y == v.y && z == v.z;
+            }
+        };
+
+        static_assert(std::is_trivial<Vec3>::value, "math::Vec3 must remain a trivial type");
+    }
+}
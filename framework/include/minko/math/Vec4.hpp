@@ -0,0 +1,63 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+#include "minko/math/Vec3.hpp"
+
+namespace minko
+{
+    namespace math
+    {
+        // Plain 4D vector value, 16-byte aligned so it can be loaded in a single SIMD register.
+        struct MINKO_ALIGN(16) Vec4
+        {
+            float x;
+            float y;
+            float z;
+            float w;
+
+            inline
+            float
+            dot(const Vec4& v) const
+            {
+                return x * v.x + y * v.y + z * v.z + w * v.w;
+            }
+
+            inline
+            Vec3
+            xyz() const
+            {
+                Vec3 result = { x, y, z };
+
+                return result;
+            }
+
+            inline
+            bool
+            operator==(const Vec4& v) const
+            {
+                return x == v.x && y == v.y && z == v.z && w == v.w;
+            }
+        };
+
+        static_assert(std::is_trivial<Vec4>::value, "math::Vec4 must remain a trivial type");
+    }
+}
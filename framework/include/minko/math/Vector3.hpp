@@ -21,6 +21,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 #include "minko/Common.hpp"
 #include "minko/math/Vector2.hpp"
+#include "minko/math/Vec3.hpp"
 
 namespace minko
 {
@@ -179,6 +180,22 @@ namespace minko
                 return setTo(*data, *(data + 1), *(data + 2));
             }
 
+            inline
+            Ptr
+            copyFrom(const Vec3& value)
+            {
+                return setTo(value.x, value.y, value.z);
+            }
+
+            inline
+            Vec3
+            toVec3() const
+            {
+                Vec3 value = { _x, _y, _z };
+
+                return value;
+            }
+
             inline
             Ptr
             setTo(float x, float y, float z)
@@ -21,6 +21,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 #include "minko/Common.hpp"
 #include "minko/math/Vector3.hpp"
+#include "minko/math/Vec4.hpp"
 
 namespace minko
 {
@@ -72,6 +73,22 @@ namespace minko
                 return setTo(value->_x, value->_y, value->_z, value->_w);
             }
 
+            inline
+            Ptr
+            copyFrom(const Vec4& value)
+            {
+                return setTo(value.x, value.y, value.z, value.w);
+            }
+
+            inline
+            Vec4
+            toVec4() const
+            {
+                Vec4 value = { _x, _y, _z, _w };
+
+                return value;
+            }
+
             inline
             Ptr
             setTo(float x, float y, float z, float w)
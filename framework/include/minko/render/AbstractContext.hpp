@@ -67,6 +67,16 @@ namespace minko
             uint
             currentProgram() = 0;
 
+            // number of state changes (program, uniforms, textures, render states...)
+            // sent to the driver/skipped as redundant during the last frame
+            virtual
+            uint
+            numIssuedStateChanges() = 0;
+
+            virtual
+            uint
+            numSkippedStateChanges() = 0;
+
             virtual
             void
             configureViewport(const uint x,
@@ -92,6 +102,19 @@ namespace minko
             void
             drawTriangles(const uint indexBuffer, const int numTriangles) = 0;
 
+            // hardware instancing: attributes with a non-zero divisor advance once per instance
+            virtual
+            bool
+            supportsInstancing() = 0;
+
+            virtual
+            void
+            drawInstancedTriangles(const uint indexBuffer, const int numTriangles, const uint numInstances) = 0;
+
+            virtual
+            void
+            setVertexAttributeDivisor(const uint position, const uint divisor) = 0;
+
             virtual
             const uint
             createVertexBuffer(const uint size) = 0;
@@ -104,6 +127,11 @@ namespace minko
                               const uint    stride,
                               const uint    offset) = 0;
 
+            // constant value of a vertex attribute that is not read from a vertex buffer
+            virtual
+            void
+            setVertexAttributeValue(const uint position, const float* values) = 0;
+
             virtual
             void
             uploadVertexBufferData(const uint     vertexBuffer,
@@ -154,6 +182,22 @@ namespace minko
                                 unsigned int    mipLevel,
                                 void*           data) = 0;
 
+            // RGBA textures of 32 bits floats, sampled without filtering from the vertex shader
+            virtual
+            bool
+            supportsFloatTextures() = 0;
+
+            virtual
+            uint
+            createFloatTexture(unsigned int width, unsigned int height) = 0;
+
+            virtual
+            void
+            uploadFloatTexture2dData(uint           texture,
+                                     unsigned int   width,
+                                     unsigned int   height,
+                                     const float*   data) = 0;
+
             virtual
             void
             uploadCubeTextureData(uint                texture,
@@ -356,6 +400,22 @@ namespace minko
             void
             readPixels(unsigned int x, unsigned int y, unsigned int width, unsigned int height, unsigned char* pixels) = 0;
 
+            // Asynchronous read back: readPixelsBegin() queues the copy of the pixels without waiting
+            // for the rendering to complete, readPixelsEnd() then returns them, ideally a frame later.
+            // Without support, the pixels are read synchronously by readPixelsBegin().
+            virtual
+            bool
+            supportsAsyncReadPixels() = 0;
+
+            virtual
+            void
+            readPixelsBegin(unsigned int x, unsigned int y, unsigned int width, unsigned int height) = 0;
+
+            // false when no read back was queued
+            virtual
+            bool
+            readPixelsEnd(unsigned char* pixels) = 0;
+
             virtual
             void
             setTriangleCulling(TriangleCulling triangleCulling) = 0;
@@ -31,6 +31,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/render/AbstractTexture.hpp"
 #include "minko/render/Priority.hpp"
 #include "minko/scene/Layout.hpp"
+#include "minko/math/Vec3.hpp"
 
 namespace minko
 {
@@ -60,6 +61,14 @@ namespace minko
             typedef std::tuple<int, int, int>                               Int3;
             typedef std::tuple<int, int, int, int>                          Int4;
 
+            // attribute bound to a per-node property instead of a vertex buffer: its value is constant
+            // for the whole draw call, or advances once per instance when the draw call is instanced
+            struct InstanceAttribute
+            {
+                std::shared_ptr<math::Matrix4x4>    matrix;
+                std::shared_ptr<math::Vector4>      vector;
+            };
+
         private:
             static const unsigned int                                       MAX_NUM_TEXTURES;
             static const unsigned int                                       MAX_NUM_VERTEXBUFFERS;
@@ -96,6 +105,11 @@ namespace minko
             std::vector<TextureType>                                        _textureTypes;
             uint                                                            _numIndices;
             uint                                                            _indexBuffer;
+            std::map<int, InstanceAttribute>                                _instanceAttributes;
+            std::vector<Ptr>                                                _instances;
+            uint                                                            _surfaceId;
+            std::vector<float>                                              _instanceData;
+            std::shared_ptr<VertexBuffer>                                   _instanceBuffer;
             AbsTexturePtr                                                   _target;
             render::Blending::Mode                                          _blendMode;
             bool                                                            _colorMask;
@@ -202,6 +216,20 @@ namespace minko
                 return _formatFunction ? _formatFunction(rawPropertyName) : rawPropertyName;
             }
 
+            inline
+            ProgramPtr
+            program() const
+            {
+                return _program;
+            }
+
+            inline
+            uint
+            indexBuffer() const
+            {
+                return _indexBuffer;
+            }
+
             inline
             AbsTexturePtr
             target() const
@@ -223,6 +251,23 @@ namespace minko
                 return _layouts;
             }
 
+            // Surface::id() of the surface the draw call was created for
+            inline
+            uint
+            surfaceId() const
+            {
+                return _surfaceId;
+            }
+
+            inline
+            Ptr
+            surfaceId(uint value)
+            {
+                _surfaceId = value;
+
+                return shared_from_this();
+            }
+
             inline
             bool
             zSorted() const
@@ -230,6 +275,25 @@ namespace minko
                 return _zsorted && Priority::LAST < _priority && !( _priority > Priority::TRANSPARENT);
             }
 
+            inline
+            bool
+            instanceable() const
+            {
+                return !_instanceAttributes.empty();
+            }
+
+            // other draw calls rendered by this one as additional instances, they must not be
+            // rendered on their own
+            inline
+            std::vector<Ptr>&
+            instances()
+            {
+                return _instances;
+            }
+
+            bool
+            canBeInstancedWith(Ptr drawCall) const;
+
 
             void
             configure(ProgramPtr,
@@ -256,6 +320,9 @@ namespace minko
             std::shared_ptr<math::Vector3>
             getEyeSpacePosition(std::shared_ptr<math::Vector3> output = nullptr);
 
+            math::Vec3
+            eyeSpacePosition();
+
             inline
             Signal<Ptr>::Ptr
             zsortNeeded() const
@@ -307,12 +374,27 @@ namespace minko
             void
             bindVertexAttribute(const std::string& propertyName, int location, uint vertexBufferIndex);
 
+            void
+            bindInstanceAttribute(const std::string& propertyName, ContainerPtr, int location);
+
+            void
+            setInstanceAttributeValues(const AbsCtxPtr&, Ptr instance);
+
+            void
+            drawInstances(const AbsCtxPtr&);
+
+            void
+            drawTriangles(const AbsCtxPtr&, uint numInstances = 1);
+
             void
             bindTextureSampler(const std::string& propertyName, int location, uint textureIndex, const SamplerState&);
 
             void
             bindUniform(const std::string& propertyName, ProgramInputs::Type, int location);
 
+            void
+            bindUniformValue(ContainerPtr, uint propertyId, ProgramInputs::Type, int location);
+
             void
             bindUniformArray(const std::string& propertyName, ContainerPtr, ProgramInputs::Type, int location);
 
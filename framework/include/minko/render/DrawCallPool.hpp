@@ -72,10 +72,13 @@ namespace minko
             typedef Signal<ArrayProviderPtr, uint>                                                      ArrayIndexChanged;
             typedef Signal<RendererPtr, AbstractFilterPtr, data::BindingSource, SurfacePtr>             RendererFilterChanged;
 
+        public:
+            // render target field of the sort keys of the draw calls rendering to the back buffer
+            static const uint                                                                           NO_TARGET_RANK;
+
         private:
             static const unsigned int                                                                   NUM_FALLBACK_ATTEMPTS;
             static std::unordered_map<std::string, std::pair<std::string, int>>                         _variablePropertyNameToPosition;
-            static std::unordered_map<DrawCallPtr, Vector3Ptr>                                          _cachedDrawcallPositions; // in eye space
 
             RendererPtr                                                                                 _renderer;
 
@@ -90,7 +93,15 @@ namespace minko
             std::unordered_map<DrawCallPtr, ZSortNeeded::Slot>                                          _drawcallToZSortNeededSlot;
             std::unordered_map<SurfacePtr, ContainerPtr>                                                _surfaceToRootContainer;
             std::unordered_map<SurfacePtr, uint>                                                        _surfaceToMaterialProviderIndex;
-            std::list<DrawCallPtr>                                                                      _drawCalls;
+            std::vector<DrawCallPtr>                                                                    _drawCalls;
+
+            // per frame sorting buffers, see sortDrawCalls()
+            std::vector<std::pair<uint64_t, uint>>                                                      _sortKeys;
+            std::vector<std::pair<uint64_t, uint>>                                                      _sortKeysTmp;
+            std::vector<int>                                                                            _targetIds;     // decreasing
+            std::vector<DrawCallPtr>                                                                    _sortedDrawCalls;
+            // sorted draw calls minus the ones rendered as instances of the previous one
+            std::vector<DrawCallPtr>                                                                    _instancedDrawCalls;
 
             std::set<DrawCallPtr>                                                                       _dirtyDrawCalls;
             bool                                                                                        _mustZSort; // forces z-sorting at next frame
@@ -116,7 +127,7 @@ namespace minko
                 return ptr;
             }
 
-            const std::list<std::shared_ptr<DrawCall>>&
+            const std::vector<std::shared_ptr<DrawCall>>&
             drawCalls();
 
             void
@@ -125,6 +136,13 @@ namespace minko
             void
             removeSurface(SurfacePtr);
 
+            // Render target field of the sort key of a draw call rendering to 'targetId', 'targetIds' being
+            // the distinct ids of the render targets of the sorted draw calls in decreasing order: render
+            // targets get dense ranks, the highest id first, whatever the values of their ids.
+            static
+            uint
+            getTargetRank(const std::vector<int>& targetIds, int targetId);
+
         private:
             explicit
             DrawCallPool(RendererPtr renderer);
@@ -189,13 +207,19 @@ namespace minko
             formatPropertyName(const std::string&                               rawPropertyName,
                                std::unordered_map<std::string, std::string>&    variablesToValue);
 
+            void
+            sortDrawCalls();
+
+            bool
+            groupInstances();
+
             static
-            Vector3Ptr
-            getDrawcallEyePosition(DrawCallPtr, Vector3Ptr output = nullptr);
+            uint64_t
+            getDrawCallSortKey(DrawCallPtr, uint targetRank);
 
             static
-            bool
-            compareDrawCalls(DrawCallPtr, DrawCallPtr);
+            void
+            radixSort(std::vector<std::pair<uint64_t, uint>>& keys, std::vector<std::pair<uint64_t, uint>>& tmp);
         };
     }
 }
@@ -0,0 +1,126 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+#include "minko/render/AbstractTexture.hpp"
+
+namespace minko
+{
+    namespace render
+    {
+        // 2D texture of RGBA 32 bits floats, written on the CPU and read without filtering by the shaders.
+        // Requires AbstractContext::supportsFloatTextures().
+        class FloatTexture :
+            public AbstractTexture
+        {
+        public:
+            typedef std::shared_ptr<FloatTexture>       Ptr;
+
+        private:
+            typedef std::shared_ptr<AbstractContext>    AbstractContextPtr;
+
+        private:
+            std::vector<float>                          _data;      // 4 floats per texel, row after row
+            bool                                        _isDirty;
+
+        public:
+            inline static
+            Ptr
+            create(AbstractContextPtr    context,
+                   unsigned int          width,
+                   unsigned int          height,
+                   const std::string&    filename = "")
+            {
+                return std::shared_ptr<FloatTexture>(new FloatTexture(context, width, height, filename));
+            }
+
+            // call invalidate() once the data are modified so that the next uploadIfDirty() sends them
+            inline
+            std::vector<float>&
+            data()
+            {
+                return _data;
+            }
+
+            inline
+            const std::vector<float>&
+            data() const
+            {
+                return _data;
+            }
+
+            // 'data' points to width * height RGBA texels of 4 floats
+            void
+            data(unsigned char* data,
+                 int            widthGPU    = -1,
+                 int            heightGPU   = -1);
+
+            inline
+            void
+            invalidate()
+            {
+                _isDirty = true;
+            }
+
+            inline
+            bool
+            isDirty() const
+            {
+                return _isDirty;
+            }
+
+            // texels are kept where both sizes overlap, the others are zeroed: floats are never interpolated
+            void
+            resize(unsigned int width, unsigned int height, bool resizeSmoothly);
+
+            void
+            dispose();
+
+            void
+            disposeData();
+
+            void
+            upload();
+
+            // uploads the data only when they were invalidated since the last upload
+            inline
+            void
+            uploadIfDirty()
+            {
+                if (_isDirty || _id == -1)
+                    upload();
+            }
+
+            ~FloatTexture()
+            {
+                dispose();
+            }
+
+        private:
+            FloatTexture(AbstractContextPtr  context,
+                         unsigned int        width,
+                         unsigned int        height,
+                         const std::string&  filename);
+        };
+    }
+}
@@ -0,0 +1,125 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+#include "minko/math/Vec3.hpp"
+#include "minko/math/Vec4.hpp"
+
+namespace minko
+{
+    namespace render
+    {
+        // Low resolution depth buffer rasterized on the CPU, used to test whether boxes are hidden
+        // behind a few large occluders. Depths are normalized device depths in [0, 1], the depth
+        // buffer is cleared to 1. Each level of the hierarchy stores the farthest depth of the 2x2
+        // texels it covers in the previous level, so that a box can be tested against a handful of
+        // texels whatever its size on screen.
+        class OcclusionBuffer :
+            public std::enable_shared_from_this<OcclusionBuffer>
+        {
+        public:
+            typedef std::shared_ptr<OcclusionBuffer> Ptr;
+
+        private:
+            uint                                _width;
+            uint                                _height;
+            std::vector<std::vector<float>>     _levels;
+            std::vector<uint>                   _levelWidths;
+            std::vector<uint>                   _levelHeights;
+            std::vector<math::Vec4>             _clipVertices;
+
+        public:
+            // the width is rounded up to a multiple of 4 for the SIMD rasterizer
+            inline static
+            Ptr
+            create(uint width = 256, uint height = 128)
+            {
+                return std::shared_ptr<OcclusionBuffer>(new OcclusionBuffer(width, height));
+            }
+
+            inline
+            uint
+            width() const
+            {
+                return _width;
+            }
+
+            inline
+            uint
+            height() const
+            {
+                return _height;
+            }
+
+            inline
+            uint
+            numLevels() const
+            {
+                return _levels.size();
+            }
+
+            inline
+            const std::vector<float>&
+            depth(uint level = 0) const
+            {
+                return _levels[level];
+            }
+
+            Ptr
+            clear();
+
+            // Rasterizes indexed triangles. 'modelToScreen' is a row-major float[16] matrix (see
+            // math::Mat4) from the space of the vertices to clip space; positions are read at
+            // 'positionOffset' in vertices of 'vertexSize' floats. Triangles crossing the near plane
+            // are skipped: not rasterizing an occluder never hides anything.
+            Ptr
+            rasterize(const float*              modelToScreen,
+                      const float*              vertices,
+                      uint                      numVertices,
+                      uint                      vertexSize,
+                      uint                      positionOffset,
+                      const unsigned short*     indices,
+                      uint                      numIndices);
+
+            // to be called once all the occluders were rasterized, before testing boxes
+            Ptr
+            buildHierarchy();
+
+            // false when the world space box [min, max] is entirely hidden by the rasterized occluders
+            bool
+            testBox(const float* worldToScreen, const math::Vec3& min, const math::Vec3& max) const;
+
+            // Rasterizes a triangle of screen space vertices (x and y in pixels, z in depth) into a
+            // width x height depth buffer, keeping the nearest depth. With SSE2, 4 pixels of a row are
+            // processed at once: 'width' must then be a multiple of 4.
+            static
+            void
+            rasterizeTriangle(const math::Vec3& a, const math::Vec3& b, const math::Vec3& c, float* depth, uint width, uint height);
+
+            static
+            void
+            rasterizeTriangleScalar(const math::Vec3& a, const math::Vec3& b, const math::Vec3& c, float* depth, uint width, uint height);
+
+        private:
+            OcclusionBuffer(uint width, uint height);
+        };
+    }
+}
@@ -42,6 +42,7 @@ namespace minko
             typedef std::unordered_map<StencilOperation, unsigned int>    StencilOperationMap;
             typedef std::unordered_map<unsigned int, unsigned int>        TextureToBufferMap;
             typedef std::pair<uint, uint>                                TextureSize;
+            typedef std::unordered_map<uint, std::vector<uint>>            UniformValues;
 
         protected:
             static BlendFactorsMap                    _blendingFactors;
@@ -52,6 +53,13 @@ namespace minko
                                       unsigned int>   _availableTextureFormats;
 
             bool                                      _errorsEnabled;
+            bool                                      _supportsInstancing;
+            bool                                      _supportsAsyncReadPixels;
+            bool                                      _supportsFloatTextures;
+            uint                                      _readPixelsBuffer;
+            uint                                      _readPixelsSize;
+            bool                                      _readPixelsPending;
+            std::vector<unsigned char>                _readPixelsData;
 
             std::list<uint>                           _textures;
             std::unordered_map<uint, TextureSize>     _textureSizes;
@@ -84,6 +92,7 @@ namespace minko
             std::vector<int>                          _currentVertexSize;
             std::vector<int>                          _currentVertexStride;
             std::vector<int>                          _currentVertexOffset;
+            std::vector<uint>                         _currentVertexDivisor;
             uint                                      _currentBoundTexture;
             std::vector<int>                          _currentTexture;
             std::unordered_map<uint, WrapMode>        _currentWrapMode;
@@ -101,6 +110,17 @@ namespace minko
             StencilOperation                        _currentStencilFailOp;
             StencilOperation                        _currentStencilZFailOp;
             StencilOperation                        _currentStencilZPassOp;
+            bool                                    _currentScissorTest;
+            render::ScissorBox                        _currentScissorBox;
+
+            // last values uploaded for each uniform location, per program
+            std::unordered_map<uint, UniformValues>    _uniformValues;
+            UniformValues*                            _currentUniformValues;
+
+            uint                                    _numIssuedStateChanges;
+            uint                                    _numSkippedStateChanges;
+            uint                                    _lastFrameNumIssuedStateChanges;
+            uint                                    _lastFrameNumSkippedStateChanges;
 
         public:
             ~OpenGLES2Context();
@@ -165,6 +185,20 @@ namespace minko
                 return _currentProgram;
             }
 
+            inline
+            uint
+            numIssuedStateChanges()
+            {
+                return _lastFrameNumIssuedStateChanges;
+            }
+
+            inline
+            uint
+            numSkippedStateChanges()
+            {
+                return _lastFrameNumSkippedStateChanges;
+            }
+
             void
             configureViewport(const uint x,
                               const uint y,
@@ -186,6 +220,22 @@ namespace minko
             void
             drawTriangles(const uint indexBuffer, const int numTriangles);
 
+            inline
+            bool
+            supportsInstancing()
+            {
+                return _supportsInstancing;
+            }
+
+            void
+            drawInstancedTriangles(const uint indexBuffer, const int numTriangles, const uint numInstances);
+
+            void
+            setVertexAttributeDivisor(const uint position, const uint divisor);
+
+            void
+            setVertexAttributeValue(const uint position, const float* values);
+
             const uint
             createVertexBuffer(const uint size);
 
@@ -238,6 +288,22 @@ namespace minko
                                 unsigned int     mipLevel,
                                 void*            data);
 
+            inline
+            bool
+            supportsFloatTextures()
+            {
+                return _supportsFloatTextures;
+            }
+
+            uint
+            createFloatTexture(unsigned int width, unsigned int height);
+
+            void
+            uploadFloatTexture2dData(uint           texture,
+                                     unsigned int   width,
+                                     unsigned int   height,
+                                     const float*   data);
+
             void
             uploadCubeTextureData(uint                texture,
                                   CubeTexture::Face face,
@@ -405,6 +471,19 @@ namespace minko
             void
             readPixels(unsigned char* pixels);
 
+            inline
+            bool
+            supportsAsyncReadPixels()
+            {
+                return _supportsAsyncReadPixels;
+            }
+
+            void
+            readPixelsBegin(unsigned int x, unsigned int y, unsigned int width, unsigned int height);
+
+            bool
+            readPixelsEnd(unsigned char* pixels);
+
             void
             setTriangleCulling(TriangleCulling triangleCulling);
 
@@ -463,6 +542,23 @@ namespace minko
             getShaderSource(unsigned int    shader,
                             std::string&    output);
 
+            inline
+            bool
+            countStateChange(bool changed)
+            {
+                if (changed)
+                    ++_numIssuedStateChanges;
+                else
+                    ++_numSkippedStateChanges;
+
+                return changed;
+            }
+
+            // Returns true and records the values when they differ from the ones last
+            // uploaded at this location for the current program.
+            bool
+            uniformChanged(uint location, const void* values, uint numWords);
+
             inline
             void
             checkForErrors()
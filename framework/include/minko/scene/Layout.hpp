@@ -40,6 +40,7 @@ namespace minko
                 static const Layouts CULLING;
                 static const Layouts PICKING;
                 static const Layouts REFLECTION;
+                static const Layouts OCCLUDER;
             };
 
             class Mask
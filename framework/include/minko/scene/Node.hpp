@@ -34,10 +34,15 @@ namespace minko
         public:
             typedef std::shared_ptr<Node>                           Ptr;
 
+            static const uint                                       MAX_NUM_COMPONENT_TYPES = 128;
+
+            typedef std::bitset<MAX_NUM_COMPONENT_TYPES>            ComponentMask;
+
         private:
 			typedef std::shared_ptr<component::AbstractComponent>	AbsCmpPtr;
 
             static uint                                             _lastId;
+            static uint                                             _numComponentTypes;
             uint                                                    _id;
 
         protected:
@@ -51,6 +56,12 @@ namespace minko
             std::shared_ptr<data::Provider>                         _data;
 			std::list<AbsCmpPtr>									_components;
 
+            // first component of each type id already looked up, stored as a pointer to the type itself:
+            // _resolvedComponentTypes tells which entries are up to date, _componentTypes which are set
+            std::vector<std::shared_ptr<void>>                      _componentsByType;
+            ComponentMask                                           _resolvedComponentTypes;
+            ComponentMask                                           _componentTypes;
+
             uint                                                    _depth;
 
             std::shared_ptr<Signal<Ptr, Ptr, Ptr>>                  _added;
@@ -258,7 +269,52 @@ namespace minko
             bool
             hasComponent()
             {
-                return component<T>() != nullptr;
+                const auto typeId = componentTypeId<T>();
+
+                if (!_resolvedComponentTypes[typeId])
+                    resolveComponentType<T>(typeId);
+
+                return _componentTypes[typeId];
+            }
+
+            template <typename... T>
+            bool
+            hasComponents()
+            {
+                static const auto mask = componentMask<T...>();
+
+                if ((mask & ~_resolvedComponentTypes).any())
+                {
+                    int resolved[] = { (hasComponent<T>(), 0)... };
+
+                    (void)resolved;
+                }
+
+                return (_componentTypes & mask) == mask;
+            }
+
+            // a small integer identifying T, assigned the first time T is looked up on any node
+            template <typename T>
+            static
+            uint
+            componentTypeId()
+            {
+                static const uint typeId = nextComponentTypeId();
+
+                return typeId;
+            }
+
+            template <typename... T>
+            static
+            ComponentMask
+            componentMask()
+            {
+                ComponentMask mask;
+                int bits[] = { (mask.set(componentTypeId<T>()), 0)... };
+
+                (void)bits;
+
+                return mask;
             }
 
             template <typename T>
@@ -282,6 +338,16 @@ namespace minko
             std::shared_ptr<T>
             component(const unsigned int position = 0)
             {
+                if (position == 0)
+                {
+                    const auto typeId = componentTypeId<T>();
+
+                    if (!_resolvedComponentTypes[typeId])
+                        resolveComponentType<T>(typeId);
+
+                    return std::static_pointer_cast<T>(_componentsByType[typeId]);
+                }
+
                 unsigned int counter = 0;
 
                 for (auto component : _components)
@@ -324,6 +390,35 @@ namespace minko
         private:
             void
             initialize();
+
+            static
+            uint
+            nextComponentTypeId();
+
+            void
+            invalidateComponentTypes();
+
+            template <typename T>
+            void
+            resolveComponentType(uint typeId)
+            {
+                std::shared_ptr<T> typedComponent;
+
+                for (auto& component : _components)
+                {
+                    typedComponent = std::dynamic_pointer_cast<T>(component);
+
+                    if (typedComponent != nullptr)
+                        break;
+                }
+
+                if (_componentsByType.size() <= typeId)
+                    _componentsByType.resize(typeId + 1);
+
+                _componentsByType[typeId] = typedComponent;
+                _resolvedComponentTypes.set(typeId);
+                _componentTypes.set(typeId, typedComponent != nullptr);
+            }
         };
     }
 }
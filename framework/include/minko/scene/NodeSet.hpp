@@ -21,6 +21,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 #include "minko/Common.hpp"
 
+#include "minko/scene/Node.hpp"
+
 namespace minko
 {
     namespace scene
@@ -100,6 +102,21 @@ namespace minko
             Ptr
             where(std::function<bool(std::shared_ptr<Node>)> filter, Ptr result = nullptr);
 
+            // the nodes holding at least one component of each of the types T
+            template <typename... T>
+            Ptr
+            withComponents(Ptr result = nullptr)
+            {
+                if (result == nullptr)
+                    result = create();
+
+                for (auto& node : _nodes)
+                    if (node->hasComponents<T...>())
+                        result->_nodes.push_back(node);
+
+                return result;
+            }
+
             Ptr
             roots(Ptr result = nullptr);
 
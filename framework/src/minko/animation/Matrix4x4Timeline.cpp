@@ -33,21 +33,25 @@ Matrix4x4Timeline::Matrix4x4Timeline(const std::string& propertyName,
                                      const std::vector<Matrix4x4Ptr>& matrices,
                                      bool interpolate):
     AbstractTimeline(propertyName, duration),
+    _timetable(),
     _matrices(),
-    _interpolate(interpolate)
+    _interpolate(interpolate),
+    _keyId(0),
+    _nextKey(Matrix4x4::create()),
+    _value(Matrix4x4::create())
 {
     initializeMatrixTimetable(timetable, matrices);
 }
 
 Matrix4x4Timeline::Matrix4x4Timeline(const Matrix4x4Timeline& matrix) :
     AbstractTimeline(matrix._propertyName, matrix._duration),
-    _matrices(matrix._matrices.size()),
-    _interpolate(matrix._interpolate)
+    _timetable(matrix._timetable),
+    _matrices(matrix._matrices),
+    _interpolate(matrix._interpolate),
+    _keyId(0),
+    _nextKey(Matrix4x4::create()),
+    _value(Matrix4x4::create())
 {
-    for (uint keyId = 0; keyId < matrix._matrices.size(); ++keyId)
-    {
-        _matrices[keyId] = matrix._matrices[keyId];
-    }
 }
 
 AbstractTimeline::Ptr
@@ -68,17 +72,43 @@ Matrix4x4Timeline::initializeMatrixTimetable(const std::vector<uint>& timetable,
         throw std::logic_error("The number of keys must match in both the 'timetable' and 'matrices' parameters.");
 
     const uint numKeys = timetable.size();
+    std::vector<uint> keyIds(numKeys);
+
+    for (uint keyId = 0; keyId < numKeys; ++keyId)
+        keyIds[keyId] = keyId;
+    std::stable_sort(keyIds.begin(), keyIds.end(), [&](uint a, uint b) { return timetable[a] < timetable[b]; });
 
-    _matrices.clear();
-    _matrices.resize(numKeys);
+    _timetable.resize(numKeys);
+    _matrices.resize(numKeys << 4);
 
     for (uint keyId = 0; keyId < numKeys; ++keyId)
     {
-        _matrices[keyId].first    = timetable[keyId];
-        _matrices[keyId].second    = matrices[keyId];
+        const auto& matrix = matrices[keyIds[keyId]]->data();
+
+        _timetable[keyId] = timetable[keyIds[keyId]];
+        std::copy(matrix.begin(), matrix.end(), _matrices.begin() + (keyId << 4));
+    }
+
+    _keyId = 0;
+}
+
+uint
+Matrix4x4Timeline::keyId(uint time) const
+{
+    const uint numKeys = _timetable.size();
+
+    // playing forward mostly stays on the same key or moves to the next one
+    if (_keyId < numKeys && _timetable[_keyId] <= time)
+    {
+        if (_keyId + 1 == numKeys || time < _timetable[_keyId + 1])
+            return _keyId;
+        if (_keyId + 2 == numKeys || time < _timetable[_keyId + 2])
+            return ++_keyId;
     }
 
-    std::sort(_matrices.begin(), _matrices.end());
+    _keyId = getIndexForTime(time, _timetable);
+
+    return _keyId;
 }
 
 void
@@ -86,28 +116,29 @@ Matrix4x4Timeline::update(uint time,
                           UpdateTargetPtr data,
                           bool /*skipPropertyNameFormatting*/)
 {
-    if (_isLocked || _duration == 0 || _matrices.empty())
-        return;
-
     if (data == nullptr || !data->hasProperty(_propertyName))
         return;
 
-    auto matrix    = data->get<Matrix4x4::Ptr>(_propertyName);
+    evaluate(time, data->get<Matrix4x4::Ptr>(_propertyName));
+}
 
-    if (matrix == nullptr)
+void
+Matrix4x4Timeline::evaluate(uint             time,
+                            Matrix4x4::Ptr   output)
+{
+    if (_isLocked || _duration == 0 || _timetable.empty() || output == nullptr)
         return;
 
+    const float* value;
+
     if (_interpolate)
-    {
-        matrix = interpolate(time, matrix);
-    }
+        value = &(interpolate(time, _value)->data()[0]);
     else
-    {
-        const uint    t        = getTimeInRange(time, _duration + 1);
-        const uint    keyId    = getIndexForTime(t, _matrices);
+        value = &_matrices[keyId(getTimeInRange(time, _duration + 1)) << 4];
 
-        matrix->copyFrom(_matrices[keyId].second);
-    }
+    // a held key does not notify the matrix listeners again
+    if (!std::equal(value, value + 16, output->data().begin()))
+        output->initialize(value);
 }
 
 Matrix4x4::Ptr
@@ -115,28 +146,30 @@ Matrix4x4Timeline::interpolate(uint             time,
                                Matrix4x4::Ptr   output) const
 {
     const uint    t        = getTimeInRange(time, _duration + 1);
-    const uint    keyId    = getIndexForTime(t, _matrices);
+    const uint    keyId    = this->keyId(t);
 
     if (output == nullptr)
         output = Matrix4x4::create();
 
     // all matrices are sorted in order of increasing time
-    if (t < _matrices.front().first || t >= _matrices.back().first)
-        output->copyFrom(_matrices[keyId].second);
+    if (t < _timetable.front() || t >= _timetable.back())
+        output->initialize(&_matrices[keyId << 4]);
     else
     {
-        assert(keyId + 1 < (int)_matrices.size());
+        assert(keyId + 1 < _timetable.size());
 
-        const auto& current    = _matrices[keyId];
-        const auto& next    = _matrices[keyId + 1];
+        const uint current    = _timetable[keyId];
+        const uint next       = _timetable[keyId + 1];
 
-        const float ratio    = current.first < next.first
-            ? (t - current.first) / (float)(next.first - current.first)
+        const float ratio    = current < next
+            ? (t - current) / (float)(next - current)
             : 0.0f;
 
+        _nextKey->initialize(&_matrices[(keyId + 1) << 4]);
+
         output
-            ->copyFrom(current.second)
-            ->interpolateTo(next.second, ratio);
+            ->initialize(&_matrices[keyId << 4])
+            ->interpolateTo(_nextKey, ratio);
     }
 
     return output;
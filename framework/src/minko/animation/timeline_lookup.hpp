@@ -12,6 +12,9 @@ namespace minko
         template<typename T>
         uint
         getIndexForTime(uint time, const std::vector<std::pair<uint,T>>& timetable);
+
+        uint
+        getIndexForTime(uint time, const std::vector<uint>& timetable);
     }
 
     uint
@@ -53,7 +56,17 @@ namespace minko
 
         return lowerId;
     }
-}
 
+    uint
+    animation::getIndexForTime(uint time, const std::vector<uint>& timetable)
+    {
+        const uint numKeys = timetable.size();
+        if (numKeys == 0)
+            return 0;
 
+        // last key starting before 'time'
+        const uint upperId = std::upper_bound(timetable.begin(), timetable.end(), time) - timetable.begin();
 
+        return upperId > 0 ? upperId - 1 : 0;
+    }
+}
@@ -0,0 +1,117 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/async/ThreadPool.hpp"
+
+using namespace minko;
+using namespace minko::async;
+
+ThreadPool::ThreadPool(uint numThreads) :
+    _jobId(0),
+    _stopped(false),
+    _task(nullptr),
+    _numTasks(0),
+    _nextTaskId(0),
+    _numBusyThreads(0)
+{
+#if MINKO_PLATFORM != MINKO_PLATFORM_HTML5
+    for (uint threadId = 1; threadId <= numThreads; ++threadId)
+        _threads.push_back(std::thread(&ThreadPool::workerLoop, this, threadId));
+#endif
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        _stopped = true;
+    }
+
+    _jobStarted.notify_all();
+
+    for (auto& thread : _threads)
+        thread.join();
+}
+
+void
+ThreadPool::parallelFor(uint numTasks, const Task& task)
+{
+    if (_threads.empty() || numTasks < 2)
+    {
+        for (uint taskId = 0; taskId < numTasks; ++taskId)
+            task(taskId, 0);
+
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        _task = &task;
+        _numTasks = numTasks;
+        _nextTaskId = 0;
+        _numBusyThreads = _threads.size();
+        ++_jobId;
+    }
+
+    _jobStarted.notify_all();
+
+    runTasks(0);
+
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    // every worker has to acknowledge the job, even the ones that arrive once all the tasks are taken
+    _jobDone.wait(lock, [&]() { return _numBusyThreads == 0; });
+    _task = nullptr;
+}
+
+void
+ThreadPool::workerLoop(uint threadId)
+{
+    uint jobId = 0;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+
+            _jobStarted.wait(lock, [&]() { return _stopped || _jobId != jobId; });
+
+            if (_stopped)
+                return;
+
+            jobId = _jobId;
+        }
+
+        runTasks(threadId);
+
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if (--_numBusyThreads == 0)
+            _jobDone.notify_one();
+    }
+}
+
+void
+ThreadPool::runTasks(uint threadId)
+{
+    for (uint taskId = _nextTaskId++; taskId < _numTasks; taskId = _nextTaskId++)
+        (*_task)(taskId, threadId);
+}
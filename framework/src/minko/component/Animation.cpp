@@ -22,6 +22,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/animation/AbstractTimeline.hpp"
 #include "minko/animation/Matrix4x4Timeline.hpp"
 #include "minko/scene/Node.hpp"
+#include "minko/data/Container.hpp"
+#include "minko/math/Matrix4x4.hpp"
 
 using namespace minko;
 using namespace minko::component;
@@ -30,13 +32,25 @@ using namespace minko::animation;
 Animation::Animation(const std::vector<AbstractTimeline::Ptr>& timelines,
                      bool isLooping):
     AbstractAnimation(isLooping),
-    _timelines(timelines)
+    _timelines(timelines),
+    _matrixTimelines(),
+    _otherTimelines(),
+    _boundMatrices(),
+    _bindingSlots(),
+    _unbindSlot(nullptr),
+    _isDrivenByMaster(false)
 {
 }
 
 Animation::Animation(const Animation& anim, const CloneOption& option) :
     AbstractAnimation(anim),
-    _timelines(anim._timelines.size())
+    _timelines(anim._timelines.size()),
+    _matrixTimelines(),
+    _otherTimelines(),
+    _boundMatrices(),
+    _bindingSlots(),
+    _unbindSlot(nullptr),
+    _isDrivenByMaster(false)
 {
     for (std::size_t i = 0; i < anim._timelines.size(); i++)
     {
@@ -62,10 +76,29 @@ Animation::initialize()
 
     _maxTime = 0;
 
+    _matrixTimelines.clear();
+    _otherTimelines.clear();
+
     for (auto& timeline : _timelines)
+    {
+        auto matrixTimeline = std::dynamic_pointer_cast<Matrix4x4Timeline>(timeline);
+
+        if (matrixTimeline != nullptr)
+            _matrixTimelines.push_back(matrixTimeline);
+        else
+            _otherTimelines.push_back(timeline);
+
         _maxTime = std::max(_maxTime, timeline->duration());
+    }
 
     setPlaybackWindow(0, _maxTime)->seek(0);
+
+    _unbindSlot = targetRemoved()->connect(std::bind(
+        &Animation::unbind,
+        std::dynamic_pointer_cast<Animation>(shared_from_this()),
+        std::placeholders::_1,
+        std::placeholders::_2
+    ));
 }
 
 void
@@ -73,17 +106,95 @@ Animation::update()
 {
     for (auto& target : targets())
     {
-        auto container = target->data();
+        auto        container   = target->data();
+        const auto& matrices    = boundMatrices(target);
+
+        // each animated property is notified once, after all the timelines were evaluated
+        container->beginUpdate();
+        for (uint i = 0; i < _matrixTimelines.size(); ++i)
+        {
+            const auto& timeline = _matrixTimelines[i];
 
-        for (auto& timeline : _timelines)
+            if (matrices[i] != nullptr)
+                timeline->evaluate(_currentTime % (timeline->duration() + 1), matrices[i]);
+        }
+        for (auto& timeline : _otherTimelines)
         {
             const uint currentTime = _currentTime % (timeline->duration() + 1); // Warning: bounds!
 
-            timeline->update(currentTime, target->data());
+            timeline->update(currentTime, container);
         }
+        container->endUpdate();
     }
 }
 
+const std::vector<math::Matrix4x4::Ptr>&
+Animation::boundMatrices(NodePtr target)
+{
+    auto bindingIt = _boundMatrices.find(target);
+
+    if (bindingIt != _boundMatrices.end())
+        return bindingIt->second;
+
+    auto    container   = target->data();
+    auto&   matrices    = _boundMatrices[target];
+
+    for (auto& timeline : _matrixTimelines)
+        matrices.push_back(
+            container->hasProperty(timeline->propertyName())
+                ? container->get<math::Matrix4x4::Ptr>(timeline->propertyName())
+                : nullptr
+        );
+
+    // the matrices are resolved again when a provider brings, replaces or takes away an animated property
+    if (_bindingSlots.count(target) == 0)
+    {
+        auto  that  = std::dynamic_pointer_cast<Animation>(shared_from_this());
+        auto& slots = _bindingSlots[target];
+
+        slots.push_back(container->propertyAdded()->connect(std::bind(
+            &Animation::propertyAddedOrRemovedHandler, that, std::placeholders::_1, std::placeholders::_2
+        )));
+        slots.push_back(container->propertyRemoved()->connect(std::bind(
+            &Animation::propertyAddedOrRemovedHandler, that, std::placeholders::_1, std::placeholders::_2
+        )));
+        for (auto& timeline : _matrixTimelines)
+            slots.push_back(container->propertyReferenceChanged(timeline->propertyName())->connect(std::bind(
+                &Animation::propertyReferenceChangedHandler, that, std::placeholders::_1, std::placeholders::_2
+            )));
+    }
+
+    return matrices;
+}
+
+void
+Animation::propertyAddedOrRemovedHandler(data::Container::Ptr container, const std::string& propertyName)
+{
+    for (auto& timeline : _matrixTimelines)
+        if (timeline->propertyName() == propertyName)
+        {
+            _boundMatrices.clear();
+            return;
+        }
+}
+
+void
+Animation::propertyReferenceChangedHandler(data::Container::Ptr container, const std::string& propertyName)
+{
+    for (auto bindingIt = _boundMatrices.begin(); bindingIt != _boundMatrices.end(); )
+        if (bindingIt->first->data() == container)
+            bindingIt = _boundMatrices.erase(bindingIt);
+        else
+            ++bindingIt;
+}
+
+void
+Animation::unbind(AbstractComponent::Ptr, NodePtr target)
+{
+    _boundMatrices.erase(target);
+    _bindingSlots.erase(target);
+}
+
 void
 Animation::rebindDependencies(std::map<AbstractComponent::Ptr, AbstractComponent::Ptr>& componentsMap, std::map<NodePtr, NodePtr>& nodeMap, CloneOption option)
 {
@@ -38,7 +38,8 @@ BoundingBox::BoundingBox(Vector3::Ptr topRight, Vector3::Ptr bottomLeft) :
     _box(math::Box::create(topRight, bottomLeft)),
     _worldSpaceBox(math::Box::create(topRight, bottomLeft)),
     _invalidBox(true),
-    _invalidWorldSpaceBox(true)
+    _invalidWorldSpaceBox(true),
+    _changed(Signal<Ptr>::create())
 {
 
 }
@@ -48,7 +49,8 @@ BoundingBox::BoundingBox() :
     _box(math::Box::create()),
     _worldSpaceBox(math::Box::create()),
     _invalidBox(true),
-    _invalidWorldSpaceBox(true)
+    _invalidWorldSpaceBox(true),
+    _changed(Signal<Ptr>::create())
 {
 
 }
@@ -58,7 +60,8 @@ _fixed(bbox._fixed),
 _box(option == CloneOption::SHALLOW ? bbox._box : math::Box::create(bbox._box->topRight(), bbox._box->bottomLeft())),
 _worldSpaceBox(option == CloneOption::SHALLOW ? bbox._worldSpaceBox : math::Box::create(bbox._worldSpaceBox->topRight(), bbox._worldSpaceBox->bottomLeft())),
 _invalidBox(bbox._invalidBox),
-_invalidWorldSpaceBox(bbox._invalidWorldSpaceBox)
+_invalidWorldSpaceBox(bbox._invalidWorldSpaceBox),
+_changed(Signal<Ptr>::create())
 {
 
 }
@@ -94,11 +97,12 @@ BoundingBox::initialize()
             {
                 _invalidBox = true;
                 _invalidWorldSpaceBox = true;
+                _changed->execute(std::static_pointer_cast<BoundingBox>(shared_from_this()));
             }
         };
 
         _componentAddedSlot = target->componentAdded()->connect(componentAddedOrRemovedCallback);
-        _componentRemovedSlot = target->componentAdded()->connect(componentAddedOrRemovedCallback);
+        _componentRemovedSlot = target->componentRemoved()->connect(componentAddedOrRemovedCallback);
 
         _invalidBox = true;
     });
@@ -154,6 +158,14 @@ BoundingBox::computeBox(const std::vector<component::Surface::Ptr>& surfaces, ma
 
 void
 BoundingBox::update()
+{
+    updateBox();
+
+    _changed->execute(std::static_pointer_cast<BoundingBox>(shared_from_this()));
+}
+
+void
+BoundingBox::updateBox()
 {
     _invalidBox = false;
 
@@ -209,7 +221,7 @@ void
 BoundingBox::updateWorldSpaceBox()
 {
     if (_invalidBox)
-        update();
+        updateBox();
 
     _invalidWorldSpaceBox = false;
 
@@ -220,39 +232,32 @@ BoundingBox::updateWorldSpaceBox()
     }
     else
     {
-        auto t = targets()[0]->data()->get<Matrix4x4::Ptr>("transform.modelToWorldMatrix");
-        auto vertices = _box->getVertices();
-
-        for (auto& vertex : vertices)
-            t->transform(vertex, vertex);
+        auto t          = targets()[0]->data()->get<Matrix4x4::Ptr>("transform.modelToWorldMatrix");
+        auto bottomLeft = _box->bottomLeft();
+        auto topRight   = _box->topRight();
+        float vertices[24];
 
-        auto max = _worldSpaceBox->topRight()->setTo(
-            -std::numeric_limits<float>::max(),
-            -std::numeric_limits<float>::max(),
-            -std::numeric_limits<float>::max()
-        );
-        auto min = _worldSpaceBox->bottomLeft()->setTo(
-            std::numeric_limits<float>::max(),
-            std::numeric_limits<float>::max(),
-            std::numeric_limits<float>::max()
-        );
-
-        for (auto& vertex : vertices)
+        // the 8 corners of the box, transformed at once
+        for (unsigned int i = 0; i < 8; ++i)
         {
-            if (vertex->x() > max->x())
-                max->x(vertex->x());
-            if (vertex->x() < min->x())
-                min->x(vertex->x());
-
-            if (vertex->y() > max->y())
-                max->y(vertex->y());
-            if (vertex->y() < min->y())
-                min->y(vertex->y());
-
-            if (vertex->z() > max->z())
-                max->z(vertex->z());
-            if (vertex->z() < min->z())
-                min->z(vertex->z());
+            vertices[i * 3]     = i & 1 ? topRight->x() : bottomLeft->x();
+            vertices[i * 3 + 1] = i & 2 ? topRight->y() : bottomLeft->y();
+            vertices[i * 3 + 2] = i & 4 ? topRight->z() : bottomLeft->z();
         }
+
+        Mat4::transformPoints(&t->data()[0], vertices, vertices, 8);
+
+        float min[3] = { vertices[0], vertices[1], vertices[2] };
+        float max[3] = { vertices[0], vertices[1], vertices[2] };
+
+        for (unsigned int i = 3; i < 24; i += 3)
+            for (unsigned int k = 0; k < 3; ++k)
+            {
+                min[k] = std::min(min[k], vertices[i + k]);
+                max[k] = std::max(max[k], vertices[i + k]);
+            }
+
+        _worldSpaceBox->bottomLeft()->setTo(min[0], min[1], min[2]);
+        _worldSpaceBox->topRight()->setTo(max[0], max[1], max[2]);
     }
 }
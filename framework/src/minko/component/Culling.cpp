@@ -21,23 +21,27 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/scene/Node.hpp"
 #include "minko/data/Container.hpp"
 #include "minko/math/Frustum.hpp"
-#include "minko/scene/NodeSet.hpp"
 #include "minko/math/OctTree.hpp"
-#include "minko/math/Vector3.hpp"
 #include "minko/component/PerspectiveCamera.hpp"
 #include "minko/component/SceneManager.hpp"
+#include "minko/component/SpatialIndex.hpp"
 #include "minko/component/Surface.hpp"
 #include "minko/component/Renderer.hpp"
 
 using namespace minko;
 using namespace minko::component;
 
-/*static*/ std::shared_ptr<math::OctTree>    Culling::_octTree;
-
 Culling::Culling(ShapePtr shape,
                  const std::string& bindProperty):
     AbstractComponent(scene::Layout::Group::CULLING),
     _frustum(shape),
+    _spatialIndex(nullptr),
+    _frustumChanged(false),
+    _culledRevision(0),
+    _batch(false),
+    _numVisible(0),
+    _numCulled(0),
+    _renderers(),
     _bindProperty(bindProperty)
 {
 }
@@ -51,8 +55,8 @@ Culling::initialize()
         std::placeholders::_1,
         std::placeholders::_2
     ));
-    _targetRemovedSlot = targetAdded()->connect(std::bind(
-        &Culling::targetAddedHandler,
+    _targetRemovedSlot = targetRemoved()->connect(std::bind(
+        &Culling::targetRemovedHandler,
         std::static_pointer_cast<Culling>(shared_from_this()),
         std::placeholders::_1,
         std::placeholders::_2
@@ -67,12 +71,6 @@ Culling::targetAddedHandler(AbstractComponent::Ptr ctrl, NodePtr target)
     if (target->components<component::PerspectiveCamera>().size() < 1)
         throw std::logic_error("Culling must be added to a camera");
 
-
-    // compute scene bounding box
-
-    if (_octTree == nullptr)
-        _octTree = math::OctTree::create(50, 7, math::Vector3::create(0, 0, 0));
-
     if (target->root()->hasComponent<SceneManager>())
         targetAddedToSceneHandler(nullptr, target, nullptr);
     else
@@ -89,76 +87,115 @@ Culling::targetAddedHandler(AbstractComponent::Ptr ctrl, NodePtr target)
         std::static_pointer_cast<Culling>(shared_from_this()),
         std::placeholders::_1,
         std::placeholders::_2));
+
+    if (target->data()->hasProperty(_bindProperty))
+        worldToScreenChangedHandler(target->data(), _bindProperty);
 }
 
 void
 Culling::targetRemovedHandler(AbstractComponent::Ptr ctrl, NodePtr target)
 {
-    _addedSlot            = nullptr;
-    _layoutChangedSlot    = nullptr;
+    _addedToSceneSlot       = nullptr;
+    _viewMatrixChangedSlot  = nullptr;
+    _renderingBeginSlot     = nullptr;
+    _spatialIndex           = nullptr;
+
+    // nothing is culled for this camera anymore
+    for (auto& renderer : _renderers)
+        renderer->resetComputedVisibility();
+    _renderers.clear();
 }
 
 void
 Culling::targetAddedToSceneHandler(NodePtr node, NodePtr target, NodePtr ancestor)
 {
-    if (target->root()->hasComponent<SceneManager>())
-    {
-        _addedToSceneSlot = nullptr;
+    auto root           = target->root();
+    auto sceneManager   = root->component<SceneManager>();
 
-        _layoutChangedSlot = target->root()->layoutsChanged()->connect(std::bind(
-            &Culling::layoutChangedHandler,
-            std::static_pointer_cast<Culling>(shared_from_this()),
-            std::placeholders::_1,
-            std::placeholders::_2
-        ));
+    if (sceneManager == nullptr)
+        return;
 
-        _addedSlot = target->root()->added()->connect(std::bind(
-            &Culling::addedHandler,
-            std::static_pointer_cast<Culling>(shared_from_this()),
-            std::placeholders::_1,
-            std::placeholders::_2,
-            std::placeholders::_3
-        ));
-    }
-}
+    _addedToSceneSlot = nullptr;
 
-void
-Culling::addedHandler(NodePtr node, NodePtr target, NodePtr ancestor)
-{
-    auto layoutMask = this->layoutMask();
-    scene::NodeSet::Ptr nodeSet = scene::NodeSet::create(target)->descendants(true)->where([layoutMask](NodePtr descendant)
+    // the octree is shared by all the cameras of the scene
+    _spatialIndex = root->component<SpatialIndex>();
+    if (_spatialIndex == nullptr)
     {
-        return (descendant->layouts() & layoutMask) != 0;
-    });
+        _spatialIndex = SpatialIndex::create();
+        root->addComponent(_spatialIndex);
+    }
+
+    // culls once the world matrices were updated (RootTransform listens with a priority of 1000)
+    _renderingBeginSlot = sceneManager->renderingBegin()->connect(std::bind(
+        &Culling::renderingBeginHandler,
+        std::static_pointer_cast<Culling>(shared_from_this()),
+        std::placeholders::_1,
+        std::placeholders::_2,
+        std::placeholders::_3
+    ), 500.f);
 
-    for (auto n : nodeSet->nodes())
-        _octTree->insert(n);
+    _frustumChanged = true;
 }
 
 void
-Culling::layoutChangedHandler(NodePtr node, NodePtr target)
+Culling::worldToScreenChangedHandler(std::shared_ptr<data::Container> data, const std::string& propertyName)
 {
-    if ((target->layouts() & layoutMask()) != 0)
-        _octTree->insert(target);
-    else
-        _octTree->remove(target);
+    _frustum->updateFromMatrix(data->get<std::shared_ptr<math::Matrix4x4>>(propertyName));
+    _frustumChanged = true;
 }
 
 void
-Culling::worldToScreenChangedHandler(std::shared_ptr<data::Container> data, const std::string& propertyName)
+Culling::renderingBeginHandler(std::shared_ptr<SceneManager>                sceneManager,
+                               uint                                         frameId,
+                               std::shared_ptr<render::AbstractTexture>     renderTarget)
 {
-    _frustum->updateFromMatrix(data->get<std::shared_ptr<math::Matrix4x4>>(propertyName));
+    auto octTree    = _spatialIndex->octTree();
+    auto renderers  = targets()[0]->components<Renderer>();
+
+    octTree->update();
+
+    // each renderer of the camera (split screen, shadow cascades...) has its own visibility set
+    if (!_frustumChanged && octTree->revision() == _culledRevision && renderers == _renderers)
+        return;
 
-    auto renderer = targets()[0]->component<Renderer>();
-
-    _octTree->testFrustum(
-        _frustum,
-        [&](NodePtr node)
-        {
-            node->component<Surface>()->computedVisibility(renderer, true);
-        },
-        [&](NodePtr node)
-        {
-            node->component<Surface>()->computedVisibility(renderer, false);
-        });
-}
\ No newline at end of file
+    _frustumChanged = false;
+    _culledRevision = octTree->revision();
+    _renderers      = renderers;
+
+    if (renderers.empty())
+        return;
+
+    auto layoutMask = this->layoutMask();
+
+    _numVisible = 0;
+    _numCulled = 0;
+
+    auto inside = [&](NodePtr node)
+    {
+        auto surface = node->component<Surface>();
+
+        if (surface == nullptr || (node->layouts() & layoutMask) == 0)
+            return;
+
+        for (auto& renderer : renderers)
+            renderer->computedVisibility(surface->id(), true);
+        ++_numVisible;
+    };
+    auto outside = [&](NodePtr node)
+    {
+        auto surface = node->component<Surface>();
+
+        if (surface == nullptr || (node->layouts() & layoutMask) == 0)
+            return;
+
+        for (auto& renderer : renderers)
+            renderer->computedVisibility(surface->id(), false);
+        ++_numCulled;
+    };
+    auto frustum = _batch ? std::dynamic_pointer_cast<math::Frustum>(_frustum) : nullptr;
+
+    if (frustum != nullptr)
+        octTree->testFrustumBatch(frustum, inside, outside);
+    else
+        octTree->testFrustum(_frustum, inside, outside);
+}
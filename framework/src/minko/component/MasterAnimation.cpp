@@ -29,13 +29,15 @@ using namespace minko::component;
 
 MasterAnimation::MasterAnimation(bool isLooping) :
 	AbstractAnimation(isLooping),
-	_animations()
+	_animations(),
+	_timelineAnimations()
 {
 }
 
 MasterAnimation::MasterAnimation(const MasterAnimation& masterAnim, const CloneOption& option) :
 	AbstractAnimation(masterAnim, option),
-	_animations()
+	_animations(),
+	_timelineAnimations()
 {
 }
 
@@ -101,6 +103,8 @@ MasterAnimation::targetAddedHandler(AbstractComponent::Ptr cmp,
 void
 MasterAnimation::initAnimations()
 {
+	releaseAnimations();
+
 	auto descendants = NodeSet::create(_target->parent())->descendants(true);
 	for (auto descendant : descendants->nodes())
 	{
@@ -108,6 +112,13 @@ MasterAnimation::initAnimations()
 		{
 			_animations.push_back(descendant->component<Skinning>());
 		}
+		for (auto& animation : descendant->components<Animation>())
+		{
+			// the master now advances the time of the Animation and evaluates its timelines
+			animation->_isDrivenByMaster = true;
+			_animations.push_back(animation);
+			_timelineAnimations.push_back(animation);
+		}
 	}
 
 	_maxTime = 0;
@@ -120,10 +131,21 @@ MasterAnimation::initAnimations()
 	setPlaybackWindow(0, _maxTime)->seek(0)->play();
 }
 
+void
+MasterAnimation::releaseAnimations()
+{
+	for (auto& animation : _timelineAnimations)
+		animation->_isDrivenByMaster = false;
+
+	_animations.clear();
+	_timelineAnimations.clear();
+}
+
 void
 MasterAnimation::targetRemovedHandler(AbstractComponent::Ptr cmp,
 										Node::Ptr node)
 {
+	releaseAnimations();
 }
 
 /*virtual*/
@@ -276,17 +298,38 @@ MasterAnimation::resetPlaybackWindow()
 	return std::dynamic_pointer_cast<AbstractAnimation>(shared_from_this());
 }
 
+void
+MasterAnimation::crossFade(std::shared_ptr<geometry::SkinClip> clip, uint duration)
+{
+	for (auto& animation : _animations)
+	{
+		auto skinning = std::dynamic_pointer_cast<Skinning>(animation);
+
+		if (skinning != nullptr && skinning->clip() != nullptr)
+			skinning->crossFade(clip, duration);
+	}
+}
+
+void
+MasterAnimation::additiveClip(std::shared_ptr<geometry::SkinClip> clip, float weight)
+{
+	for (auto& animation : _animations)
+	{
+		auto skinning = std::dynamic_pointer_cast<Skinning>(animation);
+
+		if (skinning != nullptr && skinning->clip() != nullptr)
+			skinning->additiveClip(clip, weight);
+	}
+}
+
 /*virtual*/
 void
 MasterAnimation::update()
 {
-	for (auto& animation : _animations)
+	for (auto& animation : _timelineAnimations)
 	{
-		auto anim = std::dynamic_pointer_cast<Animation>(animation);
-		if (anim != nullptr) {
-			anim->_currentTime = _currentTime;
-			anim->update();
-		}		
+		animation->_currentTime = _currentTime;
+		animation->update();
 	}
 }
 
@@ -319,4 +362,12 @@ MasterAnimation::rebindDependencies(std::map<AbstractComponent::Ptr, AbstractCom
 	}
 
 	_animations = newAnimations;
+
+	std::vector<AnimationPtr> newTimelineAnimations;
+
+	for (auto& animation : _timelineAnimations)
+		if (componentsMap.count(animation) != 0)
+			newTimelineAnimations.push_back(animation);
+
+	_timelineAnimations = newTimelineAnimations;
 }
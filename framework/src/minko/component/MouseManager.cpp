@@ -79,7 +79,7 @@ MouseManager::pick(std::shared_ptr<math::Ray> ray)
     auto target = targets()[0];
     auto descendants = scene::NodeSet::create(target->root())
         ->descendants(true)
-        ->where([&](scene::Node::Ptr node) { return node->hasComponent<BoundingBox>(); });
+        ->withComponents<BoundingBox>();
 
     std::unordered_map<scene::Node::Ptr, float> distance;
     math::Ray::Ptr localRay = math::Ray::create();
@@ -0,0 +1,261 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/component/OcclusionCulling.hpp"
+#include "minko/scene/Node.hpp"
+#include "minko/data/Container.hpp"
+#include "minko/math/Box.hpp"
+#include "minko/math/Mat4.hpp"
+#include "minko/math/Matrix4x4.hpp"
+#include "minko/math/OctTree.hpp"
+#include "minko/component/BoundingBox.hpp"
+#include "minko/component/PerspectiveCamera.hpp"
+#include "minko/component/Renderer.hpp"
+#include "minko/component/SceneManager.hpp"
+#include "minko/component/SpatialIndex.hpp"
+#include "minko/component/Surface.hpp"
+#include "minko/component/Transform.hpp"
+#include "minko/geometry/Geometry.hpp"
+#include "minko/render/IndexBuffer.hpp"
+#include "minko/render/OcclusionBuffer.hpp"
+#include "minko/render/VertexBuffer.hpp"
+
+using namespace minko;
+using namespace minko::component;
+
+OcclusionCulling::OcclusionCulling(const std::string& bindProperty, uint width, uint height) :
+    AbstractComponent(scene::Layout::Group::CULLING),
+    _buffer(render::OcclusionBuffer::create(width, height)),
+    _spatialIndex(nullptr),
+    _bindProperty(bindProperty),
+    _viewChanged(false),
+    _testedRevision(0),
+    _renderers(),
+    _numOccluders(0),
+    _numOccluded(0),
+    _occluders(),
+    _occludees()
+{
+}
+
+void
+OcclusionCulling::initialize()
+{
+    _targetAddedSlot = targetAdded()->connect(std::bind(
+        &OcclusionCulling::targetAddedHandler,
+        std::static_pointer_cast<OcclusionCulling>(shared_from_this()),
+        std::placeholders::_1,
+        std::placeholders::_2
+    ));
+    _targetRemovedSlot = targetRemoved()->connect(std::bind(
+        &OcclusionCulling::targetRemovedHandler,
+        std::static_pointer_cast<OcclusionCulling>(shared_from_this()),
+        std::placeholders::_1,
+        std::placeholders::_2
+    ));
+}
+
+void
+OcclusionCulling::targetAddedHandler(AbstractComponent::Ptr ctrl, NodePtr target)
+{
+    if (target->components<OcclusionCulling>().size() > 1)
+        throw std::logic_error("The same camera node cannot have more than one OcclusionCulling.");
+    if (target->components<component::PerspectiveCamera>().size() < 1)
+        throw std::logic_error("OcclusionCulling must be added to a camera");
+
+    if (target->root()->hasComponent<SceneManager>())
+        targetAddedToSceneHandler(nullptr, target, nullptr);
+    else
+        _addedToSceneSlot = target->added()->connect(std::bind(
+            &OcclusionCulling::targetAddedToSceneHandler,
+            std::static_pointer_cast<OcclusionCulling>(shared_from_this()),
+            std::placeholders::_1,
+            std::placeholders::_2,
+            std::placeholders::_3
+        ));
+
+    _viewMatrixChangedSlot = target->data()->propertyValueChanged(_bindProperty)->connect(
+        [&](std::shared_ptr<data::Container>, const std::string&)
+        {
+            _viewChanged = true;
+        }
+    );
+    _viewChanged = true;
+}
+
+void
+OcclusionCulling::targetRemovedHandler(AbstractComponent::Ptr ctrl, NodePtr target)
+{
+    _addedToSceneSlot       = nullptr;
+    _viewMatrixChangedSlot  = nullptr;
+    _renderingBeginSlot     = nullptr;
+    _spatialIndex           = nullptr;
+
+    for (auto& renderer : _renderers)
+        renderer->resetOcclusion();
+    _renderers.clear();
+}
+
+void
+OcclusionCulling::targetAddedToSceneHandler(NodePtr node, NodePtr target, NodePtr ancestor)
+{
+    auto root           = target->root();
+    auto sceneManager   = root->component<SceneManager>();
+
+    if (sceneManager == nullptr)
+        return;
+
+    _addedToSceneSlot = nullptr;
+
+    _spatialIndex = root->component<SpatialIndex>();
+    if (_spatialIndex == nullptr)
+    {
+        _spatialIndex = SpatialIndex::create();
+        root->addComponent(_spatialIndex);
+    }
+
+    // right after frustum culling (Culling listens with a priority of 500)
+    _renderingBeginSlot = sceneManager->renderingBegin()->connect(std::bind(
+        &OcclusionCulling::renderingBeginHandler,
+        std::static_pointer_cast<OcclusionCulling>(shared_from_this()),
+        std::placeholders::_1,
+        std::placeholders::_2,
+        std::placeholders::_3
+    ), 400.f);
+
+    _viewChanged = true;
+}
+
+void
+OcclusionCulling::renderingBeginHandler(std::shared_ptr<SceneManager>               sceneManager,
+                                        uint                                        frameId,
+                                        std::shared_ptr<render::AbstractTexture>    renderTarget)
+{
+    auto target     = targets()[0];
+    auto octTree    = _spatialIndex->octTree();
+    auto renderers  = target->components<Renderer>();
+
+    octTree->update();
+
+    if (!_viewChanged && octTree->revision() == _testedRevision && renderers == _renderers)
+        return;
+
+    if (!target->data()->hasProperty(_bindProperty))
+        return;
+
+    _viewChanged    = false;
+    _testedRevision = octTree->revision();
+
+    for (auto& renderer : _renderers)
+        renderer->resetOcclusion();
+    _renderers = renderers;
+
+    _numOccluders = 0;
+    _numOccluded = 0;
+
+    if (renderers.empty())
+        return;
+
+    const float* worldToScreen  = target->data()->get<std::shared_ptr<math::Matrix4x4>>(_bindProperty)->data().data();
+    auto layoutMask             = this->layoutMask();
+    auto renderer               = renderers[0];
+
+    // the surfaces culled by the frustum are neither occluders nor tested
+    octTree->visit([&](NodePtr node)
+    {
+        auto surface = node->component<Surface>();
+
+        if (surface == nullptr || (node->layouts() & layoutMask) == 0 || !renderer->computedVisibility(surface->id()))
+            return;
+
+        _occludees.push_back(node);
+        if ((node->layouts() & scene::Layout::Group::OCCLUDER) != 0)
+            _occluders.push_back(node);
+    });
+
+    _buffer->clear();
+    for (auto& occluder : _occluders)
+        rasterizeOccluder(occluder, worldToScreen);
+    _buffer->buildHierarchy();
+    _numOccluders = _occluders.size();
+
+    for (auto& node : _occludees)
+    {
+        auto box        = node->component<BoundingBox>()->box();
+        auto bottomLeft = box->bottomLeft();
+        auto topRight   = box->topRight();
+        math::Vec3 min  = {
+            std::min(bottomLeft->x(), topRight->x()),
+            std::min(bottomLeft->y(), topRight->y()),
+            std::min(bottomLeft->z(), topRight->z())
+        };
+        math::Vec3 max  = {
+            std::max(bottomLeft->x(), topRight->x()),
+            std::max(bottomLeft->y(), topRight->y()),
+            std::max(bottomLeft->z(), topRight->z())
+        };
+
+        if (!_buffer->testBox(worldToScreen, min, max))
+        {
+            auto surfaceId = node->component<Surface>()->id();
+
+            for (auto& r : renderers)
+                r->occluded(surfaceId, true);
+            ++_numOccluded;
+        }
+    }
+
+    _occluders.clear();
+    _occludees.clear();
+}
+
+void
+OcclusionCulling::rasterizeOccluder(NodePtr node, const float* worldToScreen)
+{
+    auto geometry = node->component<Surface>()->geometry();
+
+    if (geometry == nullptr || geometry->indices() == nullptr || !geometry->hasVertexAttribute("position"))
+        return;
+
+    auto vertexBuffer   = geometry->vertexBuffer("position");
+    auto& vertices      = vertexBuffer->data();
+    auto& indices       = geometry->indices()->data();
+
+    // the data of the buffers might have been disposed once uploaded
+    if (vertices.empty() || indices.empty())
+        return;
+
+    auto transform = node->component<Transform>();
+    math::Mat4 modelToScreen;
+
+    if (transform != nullptr)
+        math::Mat4::multiply(worldToScreen, transform->modelToWorldMatrix()->data().data(), modelToScreen.m, 1);
+    else
+        modelToScreen = math::Mat4::load(worldToScreen);
+
+    _buffer->rasterize(
+        modelToScreen.m,
+        vertices.data(),
+        vertexBuffer->numVertices(),
+        vertexBuffer->vertexSize(),
+        std::get<2>(*vertexBuffer->attribute("position")),
+        indices.data(),
+        indices.size()
+    );
+}
@@ -31,6 +31,15 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/math/Matrix4x4.hpp"
 #include "minko/component/Surface.hpp"
 #include "minko/math/Vector4.hpp"
+#include "minko/math/Mat4.hpp"
+#include "minko/math/Ray.hpp"
+#include "minko/math/Box.hpp"
+#include "minko/math/OctTree.hpp"
+#include "minko/component/BoundingBox.hpp"
+#include "minko/component/SpatialIndex.hpp"
+#include "minko/geometry/Geometry.hpp"
+#include "minko/render/IndexBuffer.hpp"
+#include "minko/render/VertexBuffer.hpp"
 
 #include "minko/material/BasicMaterial.hpp"
 #include "minko/component/Transform.hpp"
@@ -44,25 +53,30 @@ using namespace component;
 
 Picking::Picking() :
     _sceneManager(nullptr),
-    _context(nullptr),
     _mouse(nullptr),
     _touch(nullptr),
     _camera(nullptr),
-    _pickingId(0),
     _pickingProjection(math::Matrix4x4::create()),
+    _pickingId(0),
+    _context(nullptr),
     _pickingProvider(data::StructureProvider::create("picking")),
-    _mouseMove(Signal<NodePtr>::create()),
-    _mouseLeftClick(Signal<NodePtr>::create()),
-    _mouseRightClick(Signal<NodePtr>::create()),
-    _mouseLeftDown(Signal<NodePtr>::create()),
+    _method(PickingMethod::RENDERING),
+    _pickingRequested(false),
+    _readPixelsPending(false),
+    _ray(math::Ray::create()),
+    _modelRay(math::Ray::create()),
+    _mouseOver(Signal<NodePtr>::create()),
     _mouseRightDown(Signal<NodePtr>::create()),
-    _mouseLeftUp(Signal<NodePtr>::create()),
+    _mouseLeftDown(Signal<NodePtr>::create()),
     _mouseRightUp(Signal<NodePtr>::create()),
+    _mouseLeftUp(Signal<NodePtr>::create()),
+    _mouseRightClick(Signal<NodePtr>::create()),
+    _mouseLeftClick(Signal<NodePtr>::create()),
     _mouseOut(Signal<NodePtr>::create()),
-    _mouseOver(Signal<NodePtr>::create()),
+    _mouseMove(Signal<NodePtr>::create()),
     _touchDown(Signal<NodePtr>::create()),
-    _touchMove(Signal<NodePtr>::create()),
     _touchUp(Signal<NodePtr>::create()),
+    _touchMove(Signal<NodePtr>::create()),
     _tap(Signal<NodePtr>::create()),
     _doubleTap(Signal<NodePtr>::create()),
     _longHold(Signal<NodePtr>::create()),
@@ -73,10 +87,12 @@ Picking::Picking() :
 
 void
 Picking::initialize(NodePtr             camera,
-                    bool                addPickingLayout, 
-                    bool                emulateMouseWithTouch)
+                    bool                addPickingLayout,
+                    bool                emulateMouseWithTouch,
+                    PickingMethod       method)
 {
     _camera = camera;
+    _method = method;
     _emulateMouseWithTouch = emulateMouseWithTouch;
     _addPickingLayout = addPickingLayout;
 
@@ -100,6 +116,24 @@ Picking::initialize(NodePtr             camera,
 void
 Picking::bindSignals()
 {
+    _executeMoveHandler = false;
+    _executeRightClickHandler = false;
+    _executeLeftClickHandler = false;
+    _executeRightDownHandler = false;
+    _executeLeftDownHandler = false;
+    _executeRightUpHandler = false;
+    _executeLeftUpHandler = false;
+    _executeTouchDownHandler = false;
+    _executeTouchUpHandler = false;
+    _executeTouchMoveHandler = false;
+    _executeTapHandler = false;
+    _executeDoubleTapHandler = false;
+    _executeLongHoldHandler = false;
+
+    // headless canvases have neither a mouse nor a touch screen: pick() remains available
+    if (_mouse == nullptr || _touch == nullptr)
+        return;
+
     _mouseMoveSlot = _mouse->move()->connect(std::bind(
         &Picking::mouseMoveHandler,
         std::static_pointer_cast<Picking>(shared_from_this()),
@@ -182,20 +216,6 @@ Picking::bindSignals()
         std::placeholders::_1,
         std::placeholders::_2,
         std::placeholders::_3));
-
-        _executeMoveHandler = false;
-        _executeRightClickHandler = false;
-        _executeLeftClickHandler = false;
-        _executeRightDownHandler = false;
-        _executeLeftDownHandler = false;
-        _executeRightUpHandler = false;
-        _executeLeftUpHandler = false;
-        _executeTouchDownHandler = false;
-        _executeTouchUpHandler = false;
-        _executeTouchMoveHandler = false;
-        _executeTapHandler = false;
-        _executeDoubleTapHandler = false;
-        _executeLongHoldHandler = false;
 }
 
 void
@@ -212,10 +232,14 @@ Picking::targetAddedHandler(AbsCtrlPtr ctrl, NodePtr target)
     _context = canvas->context();
 
     bindSignals();
-    
-    _renderer = Renderer::create(0xFFFF00FF, nullptr, _sceneManager->assets()->effect("effect/Picking.effect"), 1000.f, "Picking Renderer");
-    _renderer->scissor(0, 0, 1, 1);
-    _renderer->layoutMask(scene::Layout::Group::PICKING);
+
+    // ray casting does not render anything
+    if (_method != PickingMethod::RAY_CAST)
+    {
+        _renderer = Renderer::create(0xFFFF00FF, nullptr, _sceneManager->assets()->effect("effect/Picking.effect"), 1000.f, "Picking Renderer");
+        _renderer->scissor(0, 0, 1, 1);
+        _renderer->layoutMask(scene::Layout::Group::PICKING);
+    }
     
     updateDescendants(target);
 
@@ -238,12 +262,15 @@ Picking::targetAddedHandler(AbsCtrlPtr ctrl, NodePtr target)
     if (target->parent() != nullptr || target->hasComponent<SceneManager>())
         addedHandler(target, target, target->parent());
 
-    target->addComponent(_renderer);
+    if (_renderer != nullptr)
+    {
+        target->addComponent(_renderer);
 
-    auto perspectiveCamera = _camera->component<component::PerspectiveCamera>();
+        auto perspectiveCamera = _camera->component<component::PerspectiveCamera>();
 
-    target->data()->addProvider(_pickingProvider);
-    target->data()->addProvider(perspectiveCamera->data());
+        target->data()->addProvider(_pickingProvider);
+        target->data()->addProvider(perspectiveCamera->data());
+    }
 
     addSurfacesForNode(target);
 }
@@ -268,17 +295,36 @@ Picking::addedHandler(NodePtr target, NodePtr child, NodePtr parent)
     if (std::find(_descendants.begin(), _descendants.end(), child) == _descendants.end())
         return;
 
-    if (child == target && _renderingBeginSlot == nullptr)
-    {
-        _renderingBeginSlot = _renderer->renderingBegin()->connect(std::bind(
-            &Picking::renderingBegin,
-            std::static_pointer_cast<Picking>(shared_from_this()),
-            std::placeholders::_1));
+    if (child == target && _componentAddedSlot == nullptr)
+    {
+        if (_method == PickingMethod::RAY_CAST)
+            // once the transforms are up to date
+            _sceneRenderingBeginSlot = _sceneManager->renderingBegin()->connect(std::bind(
+                &Picking::sceneRenderingBeginHandler,
+                std::static_pointer_cast<Picking>(shared_from_this()),
+                std::placeholders::_1,
+                std::placeholders::_2,
+                std::placeholders::_3));
+        else
+        {
+            _renderingBeginSlot = _renderer->renderingBegin()->connect(std::bind(
+                &Picking::renderingBegin,
+                std::static_pointer_cast<Picking>(shared_from_this()),
+                std::placeholders::_1));
+
+            _renderingEndSlot = _renderer->beforePresent()->connect(std::bind(
+                &Picking::renderingEnd,
+                std::static_pointer_cast<Picking>(shared_from_this()),
+                std::placeholders::_1));
+        }
 
-        _renderingEndSlot = _renderer->beforePresent()->connect(std::bind(
-            &Picking::renderingEnd,
-            std::static_pointer_cast<Picking>(shared_from_this()),
-            std::placeholders::_1));
+        if (_method == PickingMethod::RENDERING_ASYNC)
+            _frameBeginSlot = _sceneManager->frameBegin()->connect(std::bind(
+                &Picking::frameBeginHandler,
+                std::static_pointer_cast<Picking>(shared_from_this()),
+                std::placeholders::_1,
+                std::placeholders::_2,
+                std::placeholders::_3));
 
         _componentAddedSlot = child->componentAdded()->connect(std::bind(
             &Picking::componentAddedHandler,
@@ -399,6 +445,10 @@ Picking::removedHandler(NodePtr target, NodePtr child, NodePtr parent)
     {
         _renderingBeginSlot = nullptr;
         _renderingEndSlot = nullptr;
+        _frameBeginSlot = nullptr;
+        _sceneRenderingBeginSlot = nullptr;
+        _componentAddedSlot = nullptr;
+        _componentRemovedSlot = nullptr;
     }
 
     removeSurfacesForNode(child);
@@ -411,10 +461,7 @@ Picking::addSurfacesForNode(NodePtr node)
 {
     auto surfaces = scene::NodeSet::create(node)
         ->descendants(true)
-        ->where([](scene::Node::Ptr node)
-    {
-        return node->hasComponent<Surface>();
-    });
+        ->withComponents<Surface>();
 
     for (auto surfaceNode : surfaces->nodes())
         for (auto surface : surfaceNode->components<Surface>())
@@ -426,10 +473,7 @@ Picking::removeSurfacesForNode(NodePtr node)
 {
     auto surfaces = scene::NodeSet::create(node)
         ->descendants(true)
-        ->where([](scene::Node::Ptr node)
-    {
-        return node->hasComponent<Surface>();
-    });
+        ->withComponents<Surface>();
 
     for (auto surfaceNode : surfaces->nodes())
     {
@@ -447,29 +491,195 @@ Picking::renderingBegin(RendererPtr renderer)
     float mouseY = (float)_mouse->y();
 
     auto perspectiveCamera    = _camera->component<component::PerspectiveCamera>();
-    auto projection            = math::Matrix4x4::create()->perspective(perspectiveCamera->fieldOfView(), perspectiveCamera->aspectRatio(), perspectiveCamera->zNear(), perspectiveCamera->zFar());
-
-    std::vector<float> pickingProjectionData(projection->data());
+    auto projection            = math::Mat4::perspective(perspectiveCamera->fieldOfView(), perspectiveCamera->aspectRatio(), perspectiveCamera->zNear(), perspectiveCamera->zFar());
 
-    pickingProjectionData[2] = mouseX / _context->viewportWidth() * 2.f;
-    pickingProjectionData[6] = (_context->viewportHeight() - mouseY) / _context->viewportHeight() * 2.f;
+    projection.m[2] = mouseX / _context->viewportWidth() * 2.f;
+    projection.m[6] = (_context->viewportHeight() - mouseY) / _context->viewportHeight() * 2.f;
 
-    _pickingProjection->initialize(pickingProjectionData);
+    _pickingProjection->initialize(projection);
 }
 
 void
 Picking::renderingEnd(RendererPtr renderer)
 {
+    if (_method == PickingMethod::RENDERING_ASYNC)
+    {
+        // the pixel is read at the beginning of the next frame, see frameBeginHandler()
+        _context->readPixelsBegin(0, 0, 1, 1);
+        _readPixelsPending = true;
+
+        return;
+    }
+
     _context->readPixels(0, 0, 1, 1, &_lastColor[0]);
 
     uint pickedSurfaceId = (_lastColor[0] << 16) + (_lastColor[1] << 8) + _lastColor[2];
 
-    if (_lastPickedSurface != _pickingIdToSurface[pickedSurfaceId])
+    updatePickedSurface(_pickingIdToSurface[pickedSurfaceId]);
+}
+
+void
+Picking::frameBeginHandler(SceneManagerPtr sceneManager, float time, float deltaTime)
+{
+    if (!_readPixelsPending || !_context->readPixelsEnd(&_lastColor[0]))
+        return;
+
+    _readPixelsPending = false;
+
+    uint pickedSurfaceId = (_lastColor[0] << 16) + (_lastColor[1] << 8) + _lastColor[2];
+
+    updatePickedSurface(_pickingIdToSurface[pickedSurfaceId]);
+}
+
+void
+Picking::sceneRenderingBeginHandler(SceneManagerPtr sceneManager, uint frameId, AbsTexturePtr renderTarget)
+{
+    if (!_pickingRequested || _mouse == nullptr)
+        return;
+
+    auto canvas = sceneManager->canvas();
+
+    updatePickedSurface(pick(
+        (float)_mouse->x() / canvas->width() * 2.f - 1.f,
+        (float)_mouse->y() / canvas->height() * 2.f - 1.f
+    ));
+}
+
+Picking::SurfacePtr
+Picking::pick(float x, float y)
+{
+    auto perspectiveCamera = _camera->component<component::PerspectiveCamera>();
+    auto root = targets().empty() ? nullptr : targets()[0]->root();
+    auto spatialIndex = root != nullptr ? root->component<SpatialIndex>() : nullptr;
+    auto octTree = spatialIndex != nullptr ? spatialIndex->octTree() : nullptr;
+
+    perspectiveCamera->unproject(x, y, _ray);
+
+    // the nodes indexed by the spatial index are found by walking its octree, the others are tested
+    // one by one: candidates are then sorted by the distance at which the ray enters their box
+    if (octTree != nullptr)
+        octTree->cast(_ray, _candidates);
+    else
+        _candidates.clear();
+
+    auto origin = _ray->origin()->toVec3();
+    auto direction = _ray->direction()->toVec3();
+    math::Vec3 invDirection = { 1.f / direction.x, 1.f / direction.y, 1.f / direction.z };
+
+    _testedNodes.clear();
+    for (auto& surfaceAndId : _surfaceToPickingId)
+    {
+        auto node = surfaceAndId.first->targets()[0];
+
+        if ((octTree != nullptr && octTree->contains(node)) || !_testedNodes.insert(node).second)
+            continue;
+
+        auto boundingBox = node->component<BoundingBox>();
+        float near = 0.f;
+        float far;
+
+        if (boundingBox != nullptr)
+        {
+            auto box = boundingBox->box();
+            auto topRight = box->topRight();
+            auto bottomLeft = box->bottomLeft();
+            float min[3] = {
+                std::min(topRight->x(), bottomLeft->x()),
+                std::min(topRight->y(), bottomLeft->y()),
+                std::min(topRight->z(), bottomLeft->z())
+            };
+            float max[3] = {
+                std::max(topRight->x(), bottomLeft->x()),
+                std::max(topRight->y(), bottomLeft->y()),
+                std::max(topRight->z(), bottomLeft->z())
+            };
+
+            if (!math::Ray::intersectBox(origin, invDirection, min, max, near, far))
+                continue;
+        }
+
+        _candidates.push_back(std::make_pair(near, node));
+    }
+
+    std::sort(
+        _candidates.begin(),
+        _candidates.end(),
+        [](const std::pair<float, NodePtr>& a, const std::pair<float, NodePtr>& b) { return a.first < b.first; }
+    );
+
+    SurfacePtr pickedSurface = nullptr;
+    auto minDistance = std::numeric_limits<float>::infinity();
+
+    for (auto& candidate : _candidates)
+    {
+        if (candidate.first > minDistance)
+            break;
+
+        auto& node = candidate.second;
+
+        if ((node->layouts() & scene::Layout::Group::PICKING) == 0)
+            continue;
+
+        for (auto& surface : node->components<Surface>())
+        {
+            auto distance = candidate.first;
+
+            if (_surfaceToPickingId.count(surface) != 0 && castSurface(surface, distance) && distance < minDistance)
+            {
+                minDistance = distance;
+                pickedSurface = surface;
+            }
+        }
+    }
+
+    return pickedSurface;
+}
+
+bool
+Picking::castSurface(SurfacePtr surface, float& distance)
+{
+    auto geometry = surface->geometry();
+
+    // without CPU side data, the bounding box hit is the best guess
+    if (geometry->indices() == nullptr || geometry->indices()->data().empty()
+        || !geometry->hasVertexAttribute("position") || geometry->vertexBuffer("position")->data().empty())
+        return surface->targets()[0]->hasComponent<BoundingBox>();
+
+    auto transform = surface->targets()[0]->component<Transform>();
+    auto origin = _ray->origin()->toVec3();
+    auto direction = _ray->direction()->toVec3();
+
+    if (transform != nullptr)
+    {
+        math::Mat4 worldToModel;
+
+        if (!math::Mat4::invert(transform->modelToWorldMatrix()->data().data(), worldToModel.m))
+            return false;
+
+        // the direction is not normalized so that distances remain the same as in world space
+        origin = worldToModel.transformPoint(origin);
+        direction = worldToModel.transformVector(direction);
+    }
+
+    _modelRay->origin()->copyFrom(origin);
+    _modelRay->direction()->copyFrom(direction);
+
+    uint triangle;
+
+    return geometry->cast(_modelRay, distance, triangle);
+}
+
+void
+Picking::updatePickedSurface(SurfacePtr pickedSurface)
+{
+    _pickingRequested = false;
+
+    if (_lastPickedSurface != pickedSurface)
     {
         if (_lastPickedSurface && _mouseOut->numCallbacks() > 0)
             _mouseOut->execute(_lastPickedSurface->targets()[0]);
 
-        _lastPickedSurface = _pickingIdToSurface[pickedSurfaceId];
+        _lastPickedSurface = pickedSurface;
 
         if (_lastPickedSurface && _mouseOver->numCallbacks() > 0)
             _mouseOver->execute(_lastPickedSurface->targets()[0]);
@@ -540,7 +750,7 @@ Picking::renderingEnd(RendererPtr renderer)
         _longHold->execute(_lastPickedSurface->targets()[0]);
     }
 
-    if (!(_mouseOver->numCallbacks() > 0 || _mouseOut->numCallbacks() > 0))
+    if (_renderer != nullptr && !(_mouseOver->numCallbacks() > 0 || _mouseOut->numCallbacks() > 0))
         _renderer->enabled(false);
 
     _executeMoveHandler = false;
@@ -550,6 +760,12 @@ Picking::renderingEnd(RendererPtr renderer)
     _executeLeftClickHandler = false;
     _executeRightUpHandler = false;
     _executeLeftUpHandler = false;
+    _executeTouchDownHandler = false;
+    _executeTouchUpHandler = false;
+    _executeTouchMoveHandler = false;
+    _executeTapHandler = false;
+    _executeDoubleTapHandler = false;
+    _executeLongHoldHandler = false;
 }
 
 void
@@ -558,7 +774,7 @@ Picking::mouseMoveHandler(MousePtr mouse, int dx, int dy)
     if (_mouseOver->numCallbacks() > 0 || _mouseOut->numCallbacks() > 0)
     {
         _executeMoveHandler = true;
-        _renderer->enabled(true);
+        requestPicking();
     }
 }
 
@@ -568,7 +784,7 @@ Picking::mouseRightUpHandler(MousePtr mouse)
     if (_mouseRightUp->numCallbacks() > 0)
     {
         _executeRightUpHandler = true;
-        _renderer->enabled(true);
+        requestPicking();
     }
 }
 
@@ -578,7 +794,7 @@ Picking::mouseLeftUpHandler(MousePtr mouse)
     if (_mouseLeftUp->numCallbacks() > 0)
     {
         _executeLeftUpHandler = true;
-        _renderer->enabled(true);
+        requestPicking();
     }
 }
 
@@ -588,7 +804,7 @@ Picking::mouseRightClickHandler(MousePtr mouse)
     if (_mouseRightClick->numCallbacks() > 0)
     {
         _executeRightClickHandler = true;
-        _renderer->enabled(true);
+        requestPicking();
     }
 }
 
@@ -598,7 +814,7 @@ Picking::mouseLeftClickHandler(MousePtr mouse)
     if (_mouseLeftClick->numCallbacks() > 0)
     {
         _executeLeftClickHandler = true;
-        _renderer->enabled(true);
+        requestPicking();
     }
 }
 
@@ -609,7 +825,7 @@ Picking::mouseRightDownHandler(MousePtr mouse)
     if (_mouseRightDown->numCallbacks() > 0)
     {
         _executeRightDownHandler = true;
-        _renderer->enabled(true);
+        requestPicking();
     }
 }
 
@@ -619,7 +835,7 @@ Picking::mouseLeftDownHandler(MousePtr mouse)
     if (_mouseLeftDown->numCallbacks() > 0)
     {
         _executeLeftDownHandler = true;
-        _renderer->enabled(true);
+        requestPicking();
     }
 }
 
@@ -629,12 +845,12 @@ Picking::touchDownHandler(TouchPtr touch, int identifier, float x, float y)
     if (_touchDown->numCallbacks() > 0)
     {
         _executeTouchDownHandler = true;
-        _renderer->enabled(true);
+        requestPicking();
     }
     if (_emulateMouseWithTouch && _touch->numTouches() == 1 && _mouseLeftDown->numCallbacks() > 0)
     {
         _executeLeftDownHandler = true;
-        _renderer->enabled(true);
+        requestPicking();
     }
 }
 
@@ -644,12 +860,12 @@ Picking::touchUpHandler(TouchPtr touch, int identifier, float x, float y)
     if (_touchUp->numCallbacks() > 0)
     {
         _executeTouchUpHandler = true;
-        _renderer->enabled(true);
+        requestPicking();
     }
     if (_emulateMouseWithTouch && _touch->numTouches() == 1 && _mouseLeftUp->numCallbacks() > 0)
     {
         _executeLeftUpHandler = true;
-        _renderer->enabled(true);
+        requestPicking();
     }
 }
 
@@ -659,12 +875,12 @@ Picking::touchMoveHandler(TouchPtr touch, int identifier, float x, float y)
     if (_touchMove->numCallbacks() > 0)
     {
         _executeTouchMoveHandler = true;
-        _renderer->enabled(true);
+        requestPicking();
     }
     if (_emulateMouseWithTouch && _touch->numTouches() == 1 && _mouseMove->numCallbacks() > 0)
     {
         _executeMoveHandler = true;
-        _renderer->enabled(true);
+        requestPicking();
     }
 }
 
@@ -674,12 +890,12 @@ Picking::touchTapHandler(TouchPtr touch, float x, float y)
     if (_tap->numCallbacks() > 0)
     {
         _executeTapHandler = true;
-        _renderer->enabled(true);
+        requestPicking();
     }
     if (_emulateMouseWithTouch && _mouseLeftClick->numCallbacks() > 0)
     {
         _executeLeftClickHandler = true;
-        _renderer->enabled(true);
+        requestPicking();
     }
 }
 
@@ -689,7 +905,7 @@ Picking::touchDoubleTapHandler(TouchPtr touch, float x, float y)
     if (_doubleTap->numCallbacks() > 0)
     {
         _executeDoubleTapHandler = true;
-        _renderer->enabled(true);
+        requestPicking();
     }
 }
 
@@ -699,15 +915,24 @@ Picking::touchLongHoldHandler(TouchPtr touch, float x, float y)
     if (_doubleTap->numCallbacks() > 0)
     {
         _executeDoubleTapHandler = true;
-        _renderer->enabled(true);
+        requestPicking();
     }
     if (_emulateMouseWithTouch && _mouseRightClick->numCallbacks() > 0)
     {
         _executeRightClickHandler = true;
-        _renderer->enabled(true);
+        requestPicking();
     }
 }
 
+void
+Picking::requestPicking()
+{
+    if (_renderer != nullptr)
+        _renderer->enabled(true);
+    else
+        _pickingRequested = true;
+}
+
 void
 Picking::updateDescendants(NodePtr target)
 {
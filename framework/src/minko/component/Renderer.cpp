@@ -44,25 +44,27 @@ const unsigned int Renderer::NUM_FALLBACK_ATTEMPTS = 32;
 Renderer::Renderer(std::shared_ptr<render::AbstractTexture> renderTarget,
                    EffectPtr                                effect,
                    float                                    priority) :
+    _surfaceDrawCalls(),
     _backgroundColor(0),
     _viewportBox(),
     _scissorBox(),
-    _enabled(true),
     _renderingBegin(Signal<Ptr>::create()),
     _renderingEnd(Signal<Ptr>::create()),
     _beforePresent(Signal<Ptr>::create()),
-    _surfaceDrawCalls(),
-    _surfaceTechniqueChangedSlot(),
-    _effect(effect),
     _clearBeforeRender(true),
+    _culledSurfaces(),
+    _occludedSurfaces(),
+    _effect(effect),
     _priority(priority),
+    _enabled(true),
+    _surfaceTechniqueChangedSlot(),
     _targetDataFilters(),
     _rendererDataFilters(),
     _rootDataFilters(),
+    _lightMaskFilter(data::LightMaskFilter::create()),
     _targetDataFilterChangedSlots(),
     _rendererDataFilterChangedSlots(),
     _rootDataFilterChangedSlots(),
-    _lightMaskFilter(data::LightMaskFilter::create()),
     _filterChanged(Signal<Ptr, data::AbstractFilter::Ptr, data::BindingSource, SurfacePtr>::create())
 {
     if (renderTarget)
@@ -73,25 +75,27 @@ Renderer::Renderer(std::shared_ptr<render::AbstractTexture> renderTarget,
 }
 
 Renderer::Renderer(const Renderer& renderer, const CloneOption& option) :
+	_surfaceDrawCalls(),
 	_backgroundColor(renderer._backgroundColor),
 	_viewportBox(),
 	_scissorBox(),
-	_enabled(renderer._enabled),
 	_renderingBegin(Signal<Ptr>::create()),
 	_renderingEnd(Signal<Ptr>::create()),
 	_beforePresent(Signal<Ptr>::create()),
-	_surfaceDrawCalls(),
-	_surfaceTechniqueChangedSlot(),
-	_effect(nullptr),
     _clearBeforeRender(true),
+	_culledSurfaces(),
+	_occludedSurfaces(),
+	_effect(nullptr),
 	_priority(renderer._priority),
+	_enabled(renderer._enabled),
+	_surfaceTechniqueChangedSlot(),
 	_targetDataFilters(),
 	_rendererDataFilters(),
 	_rootDataFilters(),
+	_lightMaskFilter(data::LightMaskFilter::create()),
 	_targetDataFilterChangedSlots(),
 	_rendererDataFilterChangedSlots(),
 	_rootDataFilterChangedSlots(),
-	_lightMaskFilter(data::LightMaskFilter::create()),
 	_filterChanged(Signal<Ptr, data::AbstractFilter::Ptr, data::BindingSource, SurfacePtr>::create())
 {
 	if (renderer._renderTarget)
@@ -240,10 +244,7 @@ Renderer::rootDescendantAddedHandler(std::shared_ptr<Node> node,
 {
     auto surfaceNodes = NodeSet::create(target)
         ->descendants(true)
-        ->where([](scene::Node::Ptr node)
-        {
-            return node->hasComponent<Surface>();
-        });
+        ->withComponents<Surface>();
 
     for (auto surfaceNode : surfaceNodes->nodes())
         for (auto surface : surfaceNode->components<Surface>())
@@ -257,10 +258,7 @@ Renderer::rootDescendantRemovedHandler(std::shared_ptr<Node> node,
 {
     auto surfaceNodes = NodeSet::create(target)
         ->descendants(true)
-        ->where([](scene::Node::Ptr node)
-        {
-            return node->hasComponent<Surface>();
-        });
+        ->withComponents<Surface>();
 
     for (auto surfaceNode : surfaceNodes->nodes())
         for (auto surface : surfaceNode->components<Surface>())
@@ -298,6 +296,9 @@ Renderer::componentRemovedHandler(std::shared_ptr<Node>                    node,
 void
 Renderer::addSurface(Surface::Ptr surface)
 {
+    // the id might have been used by a surface that was culled
+    computedVisibility(surface->id(), true);
+    occluded(surface->id(), false);
     _drawCallPool->addSurface(surface);
 }
 
@@ -342,7 +343,7 @@ Renderer::render(render::AbstractContext::Ptr    context,
        );
 
     for (auto& drawCall : _drawCalls)
-        if ((drawCall->layouts() & layoutMask()) != 0)
+        if ((drawCall->layouts() & layoutMask()) != 0 && renderable(drawCall->surfaceId()))
             drawCall->render(context, rt, _viewportBox);
 
     _beforePresent->execute(std::static_pointer_cast<Renderer>(shared_from_this()));
@@ -40,7 +40,8 @@ SceneManager::SceneManager(const std::shared_ptr<AbstractCanvas>& canvas) :
     _cullEnd(Signal<Ptr>::create()),
     _renderBegin(Signal<Ptr, uint, render::AbstractTexture::Ptr>::create()),
     _renderEnd(Signal<Ptr, uint, render::AbstractTexture::Ptr>::create()),
-    _data(data::StructureProvider::create("scene"))
+    _data(data::StructureProvider::create("scene")),
+    _timePropertyId(data::PropertyId::get("scene.time"))
 {
 }
 
@@ -100,7 +101,7 @@ void
 SceneManager::nextFrame(float time, float deltaTime, render::AbstractTexture::Ptr renderTarget)
 {
     _time = time;
-    _data->set("time", _time);
+    _data->set(_timePropertyId, _time);
 
     _frameBegin->execute(std::static_pointer_cast<SceneManager>(shared_from_this()), time, deltaTime);
     _cullBegin->execute(std::static_pointer_cast<SceneManager>(shared_from_this()));
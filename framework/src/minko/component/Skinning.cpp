@@ -26,7 +26,11 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include <minko/geometry/Geometry.hpp>
 #include <minko/geometry/Bone.hpp>
 #include <minko/geometry/Skin.hpp>
+#include <minko/geometry/SkinClip.hpp>
+#include <minko/geometry/SkinPoseCache.hpp>
 #include <minko/render/AbstractContext.hpp>
+#include <minko/render/FloatTexture.hpp>
+#include <minko/math/Vector2.hpp>
 #include <minko/math/Matrix4x4.hpp>
 #include <minko/component/Surface.hpp>
 #include <minko/component/SceneManager.hpp>
@@ -34,6 +38,12 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include <minko/component/Animation.hpp>
 #include <minko/component/Transform.hpp>
 
+#if defined(MINKO_AVX2)
+# include <immintrin.h>
+#elif defined(MINKO_SSE2)
+# include <emmintrin.h>
+#endif
+
 using namespace minko;
 using namespace minko::data;
 using namespace minko::scene;
@@ -45,6 +55,10 @@ using namespace minko::render;
 /*static*/ const unsigned int    Skinning::MAX_NUM_BONES_PER_VERTEX    = 8;
 /*static*/ const std::string    Skinning::PNAME_NUM_BONES            = "numBones";
 /*static*/ const std::string    Skinning::PNAME_BONE_MATRICES        = "boneMatrices";
+/*static*/ const std::string    Skinning::PNAME_BONE_TEXTURE         = "boneTexture";
+/*static*/ const std::string    Skinning::PNAME_BONE_TEXTURE_SIZE    = "boneTextureSize";
+/*static*/ const std::string    Skinning::PNAME_BONE_TEXTURE_OFFSET  = "boneTextureOffset";
+/*static*/ const unsigned int   Skinning::MAX_BONE_TEXTURE_WIDTH     = 1024;
 /*static*/ const std::string    Skinning::ATTRNAME_POSITION            = "position";
 /*static*/ const std::string    Skinning::ATTRNAME_NORMAL            = "normal";
 /*static*/ const std::string    Skinning::ATTRNAME_BONE_IDS_A        = "boneIdsA";
@@ -52,6 +66,35 @@ using namespace minko::render;
 /*static*/ const std::string    Skinning::ATTRNAME_BONE_WEIGHTS_A    = "boneWeightsA";
 /*static*/ const std::string    Skinning::ATTRNAME_BONE_WEIGHTS_B    = "boneWeightsB";
 
+/*static*/ async::ThreadPool::Ptr   Skinning::_skinningThreadPool               = nullptr;
+/*static*/ unsigned int             Skinning::_parallelSkinningMinNumVertices   = 0;
+
+namespace
+{
+#ifdef MINKO_SSE2
+    // writes the 'numLanes' lanes of x, y and z to 'numLanes' vertices of an interleaved stream
+    inline
+    void
+    storeLanes(const float* x, const float* y, const float* z, unsigned int numLanes, float* output, unsigned int stride)
+    {
+        for (unsigned int lane = 0; lane < numLanes; ++lane, output += stride)
+        {
+            output[0] = x[lane];
+            output[1] = y[lane];
+            output[2] = z[lane];
+        }
+    }
+#endif
+}
+
+/*static*/
+void
+Skinning::parallelSkinning(unsigned int numThreads, unsigned int minNumVertices)
+{
+    _skinningThreadPool = numThreads > 0 ? async::ThreadPool::create(numThreads) : nullptr;
+    _parallelSkinningMinNumVertices = minNumVertices;
+}
+
 Skinning::Skinning(const Skin::Ptr                        skin,
                    SkinningMethod                        method,
                    AbstractContext::Ptr                    context,
@@ -68,6 +111,22 @@ Skinning::Skinning(const Skin::Ptr                        skin,
     _targetGeometry(),
     _targetInputPositions(),
     _targetInputNormals(),
+    _clip(nullptr),
+    _fadeClip(nullptr),
+    _fadeStartTime(-1.f),
+    _fadeDuration(0),
+    _additiveClips(),
+    _poseCache(nullptr),
+    _cachedPose(nullptr),
+    _poseMatrices(),
+    _poseWorldMatrices(),
+    _localPose(),
+    _blendedLocalPose(),
+    _referenceLocalPose(),
+    _boneTexture(nullptr),
+    _boneTextureOffset(0),
+    _boneTextureSceneManager(nullptr),
+    _renderingBeginSlot(nullptr),
     _targetAddedSlot(nullptr)
 {
 }
@@ -83,6 +142,22 @@ Skinning::Skinning(const Skinning& skinning, const CloneOption& option) :
 	_targetGeometry(),
 	_targetInputPositions(),
 	_targetInputNormals(),
+	_clip(skinning._clip),
+	_fadeClip(skinning._fadeClip),
+	_fadeStartTime(skinning._fadeStartTime),
+	_fadeDuration(skinning._fadeDuration),
+	_additiveClips(skinning._additiveClips),
+	_poseCache(skinning._poseCache),
+	_cachedPose(nullptr),
+	_poseMatrices(),
+	_poseWorldMatrices(),
+	_localPose(),
+	_blendedLocalPose(),
+	_referenceLocalPose(),
+	_boneTexture(nullptr),
+	_boneTextureOffset(0),
+	_boneTextureSceneManager(nullptr),
+	_renderingBeginSlot(nullptr),
 	_targetAddedSlot(nullptr)
 {	
 	_skin = skinning._skin->clone();
@@ -116,6 +191,17 @@ Skinning::initialize()
     if (_context == nullptr)
         throw std::invalid_argument("context");
 
+    if (_clip == nullptr)
+        _clip = _skin->clip();
+
+    if (_method == SkinningMethod::TEXTURE && !_context->supportsFloatTextures())
+    {
+        std::cerr << "Float textures are not supported: bone matrices are stored in a uniform array"
+            << std::endl;
+
+        _method    = SkinningMethod::HARDWARE;
+    }
+
     if (_method != SkinningMethod::SOFTWARE && _skin->maxNumVertexBones() > MAX_NUM_BONES_PER_VERTEX)
     {
         std::cerr << "The maximum number of bones per vertex gets too high (" << _skin->maxNumVertexBones()
@@ -129,6 +215,9 @@ Skinning::initialize()
         ? nullptr
         : createVertexBufferForBones();
 
+    if (_method == SkinningMethod::TEXTURE)
+        _boneTexture = createBoneTexture(_context, _skin->numBones());
+
     _maxTime = _skin->duration();
 
     setPlaybackWindow(0, _maxTime)->seek(0);
@@ -148,6 +237,7 @@ void
 Skinning::addedHandler(Node::Ptr node, Node::Ptr target, Node::Ptr parent)
 {
     AbstractAnimation::addedHandler(node, target, parent);
+    updateBoneTextureSceneManager();
 
     if (_skin->duration() == 0)
         return; // incorrect animation
@@ -175,8 +265,13 @@ Skinning::addedHandler(Node::Ptr node, Node::Ptr target, Node::Ptr parent)
             {
                 geometry->addVertexBuffer(_boneVertexBuffer);
 
-                UniformArrayPtr<float>    uniformArray(new UniformArray<float>(0, nullptr));
-                geometry->data()->set<UniformArrayPtr<float>>(PNAME_BONE_MATRICES,    uniformArray);
+                if (_method == SkinningMethod::TEXTURE)
+                    setBoneTextureProperties(geometry);
+                else
+                {
+                    UniformArrayPtr<float>    uniformArray(new UniformArray<float>(0, nullptr));
+                    geometry->data()->set<UniformArrayPtr<float>>(PNAME_BONE_MATRICES,    uniformArray);
+                }
 				geometry->data()->set<int>(PNAME_NUM_BONES, _skin->numBones());
             }
         }
@@ -187,6 +282,7 @@ void
 Skinning::removedHandler(Node::Ptr node, Node::Ptr target, Node::Ptr parent)
 {
     AbstractAnimation::removedHandler(node, target, parent);
+    updateBoneTextureSceneManager();
 
     if (_targetGeometry.count(target) > 0)
     {
@@ -195,7 +291,14 @@ Skinning::removedHandler(Node::Ptr node, Node::Ptr target, Node::Ptr parent)
         if (_method != SkinningMethod::SOFTWARE)
         {
             geometry->removeVertexBuffer(_boneVertexBuffer);
-            geometry->data()->unset(PNAME_BONE_MATRICES);
+            if (_method == SkinningMethod::TEXTURE)
+            {
+                geometry->data()->unset(PNAME_BONE_TEXTURE);
+                geometry->data()->unset(PNAME_BONE_TEXTURE_SIZE);
+                geometry->data()->unset(PNAME_BONE_TEXTURE_OFFSET);
+            }
+            else
+                geometry->data()->unset(PNAME_BONE_MATRICES);
             geometry->data()->unset(PNAME_NUM_BONES);
         }
 
@@ -256,23 +359,239 @@ Skinning::createVertexBufferForBones() const
 void
 Skinning::update()
 {
-    const uint frameId = _skin->getFrameId(_currentTime);
+    // compressed skins evaluate their pose at the current time instead of picking the nearest baked frame
+    const std::vector<float>& boneMatrices = _clip != nullptr
+        ? evaluatePose()
+        : _skin->matrices(_skin->getFrameId(_currentTime));
+
+    if (_method == SkinningMethod::TEXTURE)
+        updateBoneTexture(boneMatrices);
 
     for (auto& target : targets())
-        updateFrame(frameId, target);
+        updateFrame(boneMatrices, target);
 }
 
 void
-Skinning::updateFrame(unsigned int    frameId,
-                      Node::Ptr        target)
+Skinning::updateBoneTexture(const std::vector<float>& boneMatrices)
 {
-    if (_targetGeometry.count(target) == 0)
+    // the columns of the bone matrices are stored as they are, one texel each
+    std::copy(boneMatrices.begin(), boneMatrices.end(), _boneTexture->data().begin() + (_boneTextureOffset << 4));
+    _boneTexture->invalidate();
+}
+
+void
+Skinning::updateBoneTextureSceneManager()
+{
+    // the texture is uploaded once all the animations of the frame were updated, even when it is shared
+    auto sceneManager = _method == SkinningMethod::TEXTURE ? this->sceneManager() : nullptr;
+
+    if (sceneManager == _boneTextureSceneManager)
         return;
 
-    assert(frameId < _skin->numFrames());
+    _boneTextureSceneManager = sceneManager;
+    _renderingBeginSlot = sceneManager == nullptr
+        ? nullptr
+        : sceneManager->renderingBegin()->connect(std::bind(
+            &Skinning::renderingBeginHandler,
+            this,
+            std::placeholders::_1,
+            std::placeholders::_2,
+            std::placeholders::_3
+        ));
+}
+
+void
+Skinning::renderingBeginHandler(SceneManager::Ptr        sceneManager,
+                                uint                     frameId,
+                                AbstractTexture::Ptr     renderTarget)
+{
+    _boneTexture->uploadIfDirty();
+}
+
+/*static*/
+FloatTexture::Ptr
+Skinning::createBoneTexture(AbstractContext::Ptr context, uint numMatrices)
+{
+    if (numMatrices == 0)
+        throw std::invalid_argument("numMatrices");
+
+    // a row holds a whole number of matrices, so that the 4 texels of a matrix share the same row
+    const uint numTexels    = numMatrices << 2;
+    const uint width        = std::min(math::clp2(numTexels), MAX_BONE_TEXTURE_WIDTH);
+    const uint height       = math::clp2((numTexels + width - 1) / width);
+
+    if (height > AbstractTexture::MAX_SIZE)
+        throw std::invalid_argument("numMatrices");
+
+    auto texture = FloatTexture::create(context, width, height);
+
+    // draw calls may bind the texture before the first update of the skinning
+    texture->upload();
+
+    return texture;
+}
+
+void
+Skinning::boneTexture(FloatTexture::Ptr texture, uint offset)
+{
+    if (_method != SkinningMethod::TEXTURE)
+        throw std::logic_error("The bone matrices are stored in a texture only with SkinningMethod::TEXTURE.");
+    if (texture == nullptr || (texture->width() & 3) != 0)
+        throw std::invalid_argument("texture");
+    if (((offset + _skin->numBones()) << 2) > texture->width() * texture->height())
+        throw std::invalid_argument("offset");
+
+    _boneTexture        = texture;
+    _boneTextureOffset  = offset;
+
+    for (auto& targetGeometry : _targetGeometry)
+        setBoneTextureProperties(targetGeometry.second);
+
+    // fills the new texture even when the animation is stopped
+    update();
+    _boneTexture->uploadIfDirty();
+}
+
+void
+Skinning::setBoneTextureProperties(Geometry::Ptr geometry)
+{
+    auto data = geometry->data();
+
+    data->set<AbstractTexture::Ptr>(PNAME_BONE_TEXTURE, _boneTexture);
+    data->set<Vector2::Ptr>(
+        PNAME_BONE_TEXTURE_SIZE, Vector2::create(float(_boneTexture->width()), float(_boneTexture->height()))
+    );
+    data->set<float>(PNAME_BONE_TEXTURE_OFFSET, float(_boneTextureOffset));
+}
+
+uint
+Skinning::clipTime(SkinClip::Ptr clip) const
+{
+    return _currentTime % (clip->duration() + 1);
+}
+
+const std::vector<float>&
+Skinning::evaluatePose()
+{
+    float fadeRatio = 0.f;
+
+    if (_fadeClip != nullptr)
+    {
+        auto        sceneManager    = this->sceneManager();
+        const float time            = sceneManager != nullptr ? sceneManager->time() : 0.f;
+
+        // the fade starts with the first update following crossFade()
+        if (_fadeStartTime < 0.f)
+            _fadeStartTime = time;
+
+        fadeRatio = _fadeDuration > 0 ? (time - _fadeStartTime) / _fadeDuration : 1.f;
+
+        if (fadeRatio >= 1.f)
+        {
+            _clip       = _fadeClip;
+            _fadeClip   = nullptr;
+        }
+    }
+
+    // a single clip: the pose can be shared with the other instances playing it
+    if (_fadeClip == nullptr && _additiveClips.empty())
+    {
+        if (_poseCache != nullptr)
+        {
+            auto pose = _poseCache->pose(_clip, clipTime(_clip));
+
+            if (pose != nullptr)
+            {
+                _cachedPose = pose;
+
+                return *_cachedPose;
+            }
+        }
+
+        _clip->pose(clipTime(_clip), _poseMatrices, _poseWorldMatrices);
+
+        return _poseMatrices;
+    }
+
+    const uint numBones = _skin->numBones();
+
+    _localPose.resize(numBones * SkinClip::LOCAL_POSE_SIZE);
+    _blendedLocalPose.resize(_localPose.size());
+    _referenceLocalPose.resize(_localPose.size());
+
+    _clip->localPose(clipTime(_clip), &_localPose[0]);
+
+    if (_fadeClip != nullptr)
+    {
+        _fadeClip->localPose(clipTime(_fadeClip), &_blendedLocalPose[0]);
+        SkinClip::blendLocalPoses(&_localPose[0], &_blendedLocalPose[0], fadeRatio, numBones, &_localPose[0]);
+    }
+
+    for (auto& additiveClip : _additiveClips)
+    {
+        additiveClip.first->localPose(clipTime(additiveClip.first), &_blendedLocalPose[0]);
+        additiveClip.first->localPose(0, &_referenceLocalPose[0]);
+        SkinClip::addLocalPoses(
+            &_blendedLocalPose[0], &_referenceLocalPose[0], additiveClip.second, numBones, &_localPose[0]
+        );
+    }
+
+    _clip->pose(&_localPose[0], _poseMatrices, _poseWorldMatrices);
+
+    return _poseMatrices;
+}
+
+void
+Skinning::crossFade(SkinClip::Ptr clip, uint duration)
+{
+    if (_clip == nullptr)
+        throw std::logic_error("Only skins created from a SkinClip can be cross-faded.");
+
+    if (clip == nullptr || !clip->hasSameRig(*_clip))
+        throw std::invalid_argument("clip");
+
+    if (_fadeClip != nullptr)
+        _clip = _fadeClip;
+
+    _fadeClip       = clip;
+    _fadeDuration   = duration;
+    _fadeStartTime  = -1.f;
+}
+
+void
+Skinning::additiveClip(SkinClip::Ptr clip, float weight)
+{
+    if (_clip == nullptr)
+        throw std::logic_error("Only skins created from a SkinClip can be blended.");
+
+    if (clip == nullptr || !clip->hasSameRig(*_clip))
+        throw std::invalid_argument("clip");
+
+    auto it = std::find_if(
+        _additiveClips.begin(),
+        _additiveClips.end(),
+        [&](const std::pair<SkinClip::Ptr, float>& additiveClip) { return additiveClip.first == clip; }
+    );
+
+    if (weight == 0.f)
+    {
+        if (it != _additiveClips.end())
+            _additiveClips.erase(it);
+    }
+    else if (it != _additiveClips.end())
+        it->second = weight;
+    else
+        _additiveClips.push_back(std::make_pair(clip, weight));
+}
+
+void
+Skinning::updateFrame(const std::vector<float>&    boneMatrices,
+                      Node::Ptr                    target)
+{
+    if (_targetGeometry.count(target) == 0)
+        return;
 
-    auto&                        geometry        = _targetGeometry[target];
-    const std::vector<float>&    boneMatrices    = _skin->matrices(frameId);
+    auto& geometry = _targetGeometry[target];
 
     if (_method == SkinningMethod::HARDWARE)
     {
@@ -284,7 +603,7 @@ Skinning::updateFrame(unsigned int    frameId,
         uniformArray->first            = _skin->numBones();
         uniformArray->second        = &(boneMatrices[0]);
     }
-    else
+    else if (_method == SkinningMethod::SOFTWARE)
         performSoftwareSkinning(target, boneMatrices);
 }
 
@@ -294,102 +613,328 @@ Skinning::performSoftwareSkinning(Node::Ptr                    target,
 {
 #ifdef DEBUG_SKINNING
     assert(target && _targetGeometry.count(target) > 0 && _targetInputPositions.count(target) > 0);
+    assert(boneMatrices.size() == (_skin->numBones() << 4));
 #endif //DEBUG_SKINNING
 
-    auto geometry    = _targetGeometry[target];
-
-    // transform positions
-    auto                        xyzBuffer    = geometry->vertexBuffer(ATTRNAME_POSITION);
-    VertexBuffer::AttributePtr    xyzAttr        = nullptr;
-    for (auto& attr : xyzBuffer->attributes())
-        if (std::get<0>(*attr) == ATTRNAME_POSITION)
-            xyzAttr = attr;
+    auto                geometry        = _targetGeometry[target];
+    auto                xyzBuffer       = geometry->vertexBuffer(ATTRNAME_POSITION);
+    const unsigned int  xyzOffset       = std::get<2>(*xyzBuffer->attribute(ATTRNAME_POSITION));
+    VertexBuffer::Ptr   normalBuffer    = nullptr;
+    VertexStreams       streams;
 
-    performSoftwareSkinning(xyzAttr, xyzBuffer, _targetInputPositions[target], boneMatrices, false);
+    streams.inputPositions  = &(_targetInputPositions[target][xyzOffset]);
+    streams.outputPositions = &(xyzBuffer->data()[xyzOffset]);
+    streams.positionStride  = xyzBuffer->vertexSize();
+    streams.inputNormals    = nullptr;
+    streams.outputNormals   = nullptr;
+    streams.normalStride    = 0;
 
-    // transform normals
     if (geometry->hasVertexAttribute(ATTRNAME_NORMAL) && _targetInputNormals.count(target) > 0)
     {
-        auto                        normalBuffer    = geometry->vertexBuffer(ATTRNAME_NORMAL);
-        VertexBuffer::AttributePtr    normalAttr        = nullptr;
-        for (auto& attr : normalBuffer->attributes())
-            if (std::get<0>(*attr) == ATTRNAME_NORMAL)
-                normalAttr = attr;
+        normalBuffer = geometry->vertexBuffer(ATTRNAME_NORMAL);
 
-        performSoftwareSkinning(normalAttr, normalBuffer, _targetInputNormals[target], boneMatrices, true);
+        const unsigned int normalOffset = std::get<2>(*normalBuffer->attribute(ATTRNAME_NORMAL));
+
+        streams.inputNormals    = &(_targetInputNormals[target][normalOffset]);
+        streams.outputNormals   = &(normalBuffer->data()[normalOffset]);
+        streams.normalStride    = normalBuffer->vertexSize();
     }
+
+    const unsigned int  numVertices = _skin->numVertices();
+    auto                threadPool  = _skinningThreadPool;
+
+    if (threadPool != nullptr && numVertices >= _parallelSkinningMinNumVertices)
+    {
+        // one range per thread, ranges are multiples of 8 vertices so that SIMD blocks never span two of them
+        const unsigned int numRanges = threadPool->numThreads() + 1;
+        const unsigned int rangeSize = ((numVertices + numRanges - 1) / numRanges + 7) & ~7u;
+
+        threadPool->parallelFor((numVertices + rangeSize - 1) / rangeSize, [&](uint taskId, uint threadId)
+        {
+            skinVertices(
+                *_skin, &(boneMatrices[0]), streams, taskId * rangeSize, std::min(numVertices, (taskId + 1) * rangeSize)
+            );
+        });
+    }
+    else
+        skinVertices(*_skin, &(boneMatrices[0]), streams, 0, numVertices);
+
+    // positions and normals are often interleaved in the same buffer: each buffer is uploaded once
+    xyzBuffer->upload();
+    if (normalBuffer != nullptr && normalBuffer != xyzBuffer)
+        normalBuffer->upload();
 }
 
+/*static*/
 void
-Skinning::performSoftwareSkinning(VertexBuffer::AttributePtr        attr,
-                                 VertexBuffer::Ptr                    vertexBuffer,
-                                 const std::vector<float>&            inputData,
-                                 const std::vector<float>&            boneMatrices,
-                                 bool                                doDeltaTransform)
+Skinning::skinVertices(const Skin&             skin,
+                       const float*            boneMatrices,
+                       const VertexStreams&    streams,
+                       unsigned int            firstVertex,
+                       unsigned int            lastVertex)
 {
-#ifdef DEBUG_SKINNING
-    assert(vertexBuffer && vertexBuffer->data().size() == inputData.size());
-    assert(attr && std::get<1>(*attr) == 3);
-    assert(boneMatrices.size() == (_skin->numBones() << 4));
-#endif // DEBUG_SKINNING
+    unsigned int vId = firstVertex;
+
+#ifdef MINKO_SSE2
+    const unsigned int  numInfluences   = skin.maxNumVertexBones();
+    const unsigned int  packedSize      = skin.packedNumVertices();
+    const unsigned int* boneIds         = skin.packedVertexBoneIds().empty() ? nullptr : &(skin.packedVertexBoneIds()[0]);
+    const float*        boneWeights     = skin.packedVertexBoneWeights().empty() ? nullptr : &(skin.packedVertexBoneWeights()[0]);
+    const unsigned int  ps              = streams.positionStride;
+    const unsigned int  ns              = streams.normalStride;
+    const bool          hasNormals      = streams.inputNormals != nullptr;
+    MINKO_ALIGN(32) float outX[8];
+    MINKO_ALIGN(32) float outY[8];
+    MINKO_ALIGN(32) float outZ[8];
+
+# if defined(MINKO_AVX2)
+    // 8 vertices per iteration: the 12 coefficients of the bones are gathered, one influence after the other
+    for (; vId + 8 <= lastVertex; vId += 8)
+    {
+        const float*    p   = streams.inputPositions + vId * ps;
+        const __m256    px  = _mm256_set_ps(p[7 * ps], p[6 * ps], p[5 * ps], p[4 * ps], p[3 * ps], p[2 * ps], p[ps], p[0]);
+        const __m256    py  = _mm256_set_ps(p[7 * ps + 1], p[6 * ps + 1], p[5 * ps + 1], p[4 * ps + 1], p[3 * ps + 1], p[2 * ps + 1], p[ps + 1], p[1]);
+        const __m256    pz  = _mm256_set_ps(p[7 * ps + 2], p[6 * ps + 2], p[5 * ps + 2], p[4 * ps + 2], p[3 * ps + 2], p[2 * ps + 2], p[ps + 2], p[2]);
+        __m256          nx  = _mm256_setzero_ps();
+        __m256          ny  = nx;
+        __m256          nz  = nx;
+        __m256          x   = _mm256_setzero_ps();
+        __m256          y   = x;
+        __m256          z   = x;
+        __m256          x2  = x;
+        __m256          y2  = x;
+        __m256          z2  = x;
+
+        if (hasNormals)
+        {
+            const float* n = streams.inputNormals + vId * ns;
 
-    const unsigned int    vertexSize        = vertexBuffer->vertexSize();
-    std::vector<float>&    outputData        = vertexBuffer->data();
-    const unsigned int    numVertices        = outputData.size() / vertexSize;
+            nx = _mm256_set_ps(n[7 * ns], n[6 * ns], n[5 * ns], n[4 * ns], n[3 * ns], n[2 * ns], n[ns], n[0]);
+            ny = _mm256_set_ps(n[7 * ns + 1], n[6 * ns + 1], n[5 * ns + 1], n[4 * ns + 1], n[3 * ns + 1], n[2 * ns + 1], n[ns + 1], n[1]);
+            nz = _mm256_set_ps(n[7 * ns + 2], n[6 * ns + 2], n[5 * ns + 2], n[4 * ns + 2], n[3 * ns + 2], n[2 * ns + 2], n[ns + 2], n[2]);
+        }
 
-#ifdef DEBUG_SKINNING
-    assert(numVertices == _skin->numVertices());
-#endif // DEBUG_SKINNING
+        for (unsigned int j = 0; j < numInfluences; ++j)
+        {
+            const __m256 w = _mm256_loadu_ps(boneWeights + j * packedSize + vId);
+
+            if (_mm256_movemask_ps(_mm256_cmp_ps(w, _mm256_setzero_ps(), _CMP_NEQ_OQ)) == 0)
+                continue;
+
+            const __m256i   offsets = _mm256_slli_epi32(
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(boneIds + j * packedSize + vId)), 4
+            );
+            const __m256    m0      = _mm256_i32gather_ps(boneMatrices, offsets, 4);
+            const __m256    m1      = _mm256_i32gather_ps(boneMatrices + 1, offsets, 4);
+            const __m256    m2      = _mm256_i32gather_ps(boneMatrices + 2, offsets, 4);
+            const __m256    m4      = _mm256_i32gather_ps(boneMatrices + 4, offsets, 4);
+            const __m256    m5      = _mm256_i32gather_ps(boneMatrices + 5, offsets, 4);
+            const __m256    m6      = _mm256_i32gather_ps(boneMatrices + 6, offsets, 4);
+            const __m256    m8      = _mm256_i32gather_ps(boneMatrices + 8, offsets, 4);
+            const __m256    m9      = _mm256_i32gather_ps(boneMatrices + 9, offsets, 4);
+            const __m256    m10     = _mm256_i32gather_ps(boneMatrices + 10, offsets, 4);
+            const __m256    m12     = _mm256_i32gather_ps(boneMatrices + 12, offsets, 4);
+            const __m256    m13     = _mm256_i32gather_ps(boneMatrices + 13, offsets, 4);
+            const __m256    m14     = _mm256_i32gather_ps(boneMatrices + 14, offsets, 4);
+
+            x = _mm256_add_ps(x, _mm256_mul_ps(w, _mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(m0, px), _mm256_mul_ps(m4, py)), _mm256_add_ps(_mm256_mul_ps(m8, pz), m12)
+            )));
+            y = _mm256_add_ps(y, _mm256_mul_ps(w, _mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(m1, px), _mm256_mul_ps(m5, py)), _mm256_add_ps(_mm256_mul_ps(m9, pz), m13)
+            )));
+            z = _mm256_add_ps(z, _mm256_mul_ps(w, _mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(m2, px), _mm256_mul_ps(m6, py)), _mm256_add_ps(_mm256_mul_ps(m10, pz), m14)
+            )));
+
+            if (hasNormals)
+            {
+                x2 = _mm256_add_ps(x2, _mm256_mul_ps(w, _mm256_add_ps(
+                    _mm256_add_ps(_mm256_mul_ps(m0, nx), _mm256_mul_ps(m4, ny)), _mm256_mul_ps(m8, nz)
+                )));
+                y2 = _mm256_add_ps(y2, _mm256_mul_ps(w, _mm256_add_ps(
+                    _mm256_add_ps(_mm256_mul_ps(m1, nx), _mm256_mul_ps(m5, ny)), _mm256_mul_ps(m9, nz)
+                )));
+                z2 = _mm256_add_ps(z2, _mm256_mul_ps(w, _mm256_add_ps(
+                    _mm256_add_ps(_mm256_mul_ps(m2, nx), _mm256_mul_ps(m6, ny)), _mm256_mul_ps(m10, nz)
+                )));
+            }
+        }
 
-    unsigned int index = std::get<2>(*attr);
-    for (unsigned int vId = 0; vId < numVertices; ++vId)
+        _mm256_store_ps(outX, x);
+        _mm256_store_ps(outY, y);
+        _mm256_store_ps(outZ, z);
+        storeLanes(outX, outY, outZ, 8, streams.outputPositions + vId * ps, ps);
+
+        if (hasNormals)
+        {
+            _mm256_store_ps(outX, x2);
+            _mm256_store_ps(outY, y2);
+            _mm256_store_ps(outZ, z2);
+            storeLanes(outX, outY, outZ, 8, streams.outputNormals + vId * ns, ns);
+        }
+    }
+# endif
+    // 4 vertices per iteration: the columns of the 4 bone matrices are loaded and transposed
+    for (; vId + 4 <= lastVertex; vId += 4)
     {
-        const float x1 = inputData[index];
-        const float y1 = inputData[index+1];
-        const float z1 = inputData[index+2];
+        const float*    p   = streams.inputPositions + vId * ps;
+        const __m128    px  = _mm_set_ps(p[3 * ps], p[2 * ps], p[ps], p[0]);
+        const __m128    py  = _mm_set_ps(p[3 * ps + 1], p[2 * ps + 1], p[ps + 1], p[1]);
+        const __m128    pz  = _mm_set_ps(p[3 * ps + 2], p[2 * ps + 2], p[ps + 2], p[2]);
+        __m128          nx  = _mm_setzero_ps();
+        __m128          ny  = nx;
+        __m128          nz  = nx;
+        __m128          x   = _mm_setzero_ps();
+        __m128          y   = x;
+        __m128          z   = x;
+        __m128          x2  = x;
+        __m128          y2  = x;
+        __m128          z2  = x;
+
+        if (hasNormals)
+        {
+            const float* n = streams.inputNormals + vId * ns;
 
-        float x2 = 0.0f;
-        float y2 = 0.0f;
-        float z2 = 0.0f;
+            nx = _mm_set_ps(n[3 * ns], n[2 * ns], n[ns], n[0]);
+            ny = _mm_set_ps(n[3 * ns + 1], n[2 * ns + 1], n[ns + 1], n[1]);
+            nz = _mm_set_ps(n[3 * ns + 2], n[2 * ns + 2], n[ns + 2], n[2]);
+        }
 
-        const unsigned int numVertexBones = _skin->numVertexBones(vId);
-        for (unsigned int j = 0; j < numVertexBones; ++j)
+        for (unsigned int j = 0; j < numInfluences; ++j)
         {
-            unsigned int    boneId        = 0;
-            float            boneWeight    = 0.0f;
+            const unsigned int  index   = j * packedSize + vId;
+            const __m128        w       = _mm_loadu_ps(boneWeights + index);
 
-            _skin->vertexBoneData(vId, j, boneId, boneWeight);
+            if (_mm_movemask_ps(_mm_cmpneq_ps(w, _mm_setzero_ps())) == 0)
+                continue;
 
-            const float*    boneMatrix    = &(boneMatrices[boneId << 4]);
+            const float*    b0  = boneMatrices + (boneIds[index] << 4);
+            const float*    b1  = boneMatrices + (boneIds[index + 1] << 4);
+            const float*    b2  = boneMatrices + (boneIds[index + 2] << 4);
+            const float*    b3  = boneMatrices + (boneIds[index + 3] << 4);
+            __m128          m[16];
 
-            if (!doDeltaTransform)
+            for (unsigned int column = 0; column < 16; column += 4)
             {
-                x2 += boneWeight * (boneMatrix[0] * x1 + boneMatrix[4] * y1 + boneMatrix[8]  * z1 + boneMatrix[12]);
-                y2 += boneWeight * (boneMatrix[1] * x1 + boneMatrix[5] * y1 + boneMatrix[9]  * z1 + boneMatrix[13]);
-                z2 += boneWeight * (boneMatrix[2] * x1 + boneMatrix[6] * y1 + boneMatrix[10] * z1 + boneMatrix[14]);
+                m[column]       = _mm_loadu_ps(b0 + column);
+                m[column + 1]   = _mm_loadu_ps(b1 + column);
+                m[column + 2]   = _mm_loadu_ps(b2 + column);
+                m[column + 3]   = _mm_loadu_ps(b3 + column);
+                _MM_TRANSPOSE4_PS(m[column], m[column + 1], m[column + 2], m[column + 3]);
             }
-            else
+
+            x = _mm_add_ps(x, _mm_mul_ps(w, _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(m[0], px), _mm_mul_ps(m[4], py)), _mm_add_ps(_mm_mul_ps(m[8], pz), m[12])
+            )));
+            y = _mm_add_ps(y, _mm_mul_ps(w, _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(m[1], px), _mm_mul_ps(m[5], py)), _mm_add_ps(_mm_mul_ps(m[9], pz), m[13])
+            )));
+            z = _mm_add_ps(z, _mm_mul_ps(w, _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(m[2], px), _mm_mul_ps(m[6], py)), _mm_add_ps(_mm_mul_ps(m[10], pz), m[14])
+            )));
+
+            if (hasNormals)
             {
-                x2 += boneWeight * (boneMatrix[0] * x1 + boneMatrix[4] * y1 + boneMatrix[8]  * z1);
-                y2 += boneWeight * (boneMatrix[1] * x1 + boneMatrix[5] * y1 + boneMatrix[9]  * z1);
-                z2 += boneWeight * (boneMatrix[2] * x1 + boneMatrix[6] * y1 + boneMatrix[10] * z1);
+                x2 = _mm_add_ps(x2, _mm_mul_ps(w, _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(m[0], nx), _mm_mul_ps(m[4], ny)), _mm_mul_ps(m[8], nz)
+                )));
+                y2 = _mm_add_ps(y2, _mm_mul_ps(w, _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(m[1], nx), _mm_mul_ps(m[5], ny)), _mm_mul_ps(m[9], nz)
+                )));
+                z2 = _mm_add_ps(z2, _mm_mul_ps(w, _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(m[2], nx), _mm_mul_ps(m[6], ny)), _mm_mul_ps(m[10], nz)
+                )));
             }
         }
 
-        outputData[index]    = x2;
-        outputData[index+1]    = y2;
-        outputData[index+2]    = z2;
+        _mm_store_ps(outX, x);
+        _mm_store_ps(outY, y);
+        _mm_store_ps(outZ, z);
+        storeLanes(outX, outY, outZ, 4, streams.outputPositions + vId * ps, ps);
 
-        index += vertexSize;
+        if (hasNormals)
+        {
+            _mm_store_ps(outX, x2);
+            _mm_store_ps(outY, y2);
+            _mm_store_ps(outZ, z2);
+            storeLanes(outX, outY, outZ, 4, streams.outputNormals + vId * ns, ns);
+        }
     }
+#endif
 
-    vertexBuffer->upload();
+    skinVerticesScalar(skin, boneMatrices, streams, vId, lastVertex);
+}
+
+/*static*/
+void
+Skinning::skinVerticesScalar(const Skin&           skin,
+                             const float*          boneMatrices,
+                             const VertexStreams&  streams,
+                             unsigned int          firstVertex,
+                             unsigned int          lastVertex)
+{
+    const unsigned int  numInfluences   = skin.maxNumVertexBones();
+    const unsigned int  packedSize      = skin.packedNumVertices();
+    const auto&         boneIds         = skin.packedVertexBoneIds();
+    const auto&         boneWeights     = skin.packedVertexBoneWeights();
+    const bool          hasNormals      = streams.inputNormals != nullptr;
+
+    for (unsigned int vId = firstVertex; vId < lastVertex; ++vId)
+    {
+        const float*    p   = streams.inputPositions + vId * streams.positionStride;
+        const float*    n   = hasNormals ? streams.inputNormals + vId * streams.normalStride : nullptr;
+        float           x   = 0.0f;
+        float           y   = 0.0f;
+        float           z   = 0.0f;
+        float           x2  = 0.0f;
+        float           y2  = 0.0f;
+        float           z2  = 0.0f;
+
+        for (unsigned int j = 0; j < numInfluences; ++j)
+        {
+            const unsigned int  index       = j * packedSize + vId;
+            const float         boneWeight  = boneWeights[index];
+
+            if (boneWeight == 0.0f)
+                continue;
+
+            const float* boneMatrix = boneMatrices + (boneIds[index] << 4);
+
+            x += boneWeight * (boneMatrix[0] * p[0] + boneMatrix[4] * p[1] + boneMatrix[8]  * p[2] + boneMatrix[12]);
+            y += boneWeight * (boneMatrix[1] * p[0] + boneMatrix[5] * p[1] + boneMatrix[9]  * p[2] + boneMatrix[13]);
+            z += boneWeight * (boneMatrix[2] * p[0] + boneMatrix[6] * p[1] + boneMatrix[10] * p[2] + boneMatrix[14]);
+
+            if (hasNormals)
+            {
+                x2 += boneWeight * (boneMatrix[0] * n[0] + boneMatrix[4] * n[1] + boneMatrix[8]  * n[2]);
+                y2 += boneWeight * (boneMatrix[1] * n[0] + boneMatrix[5] * n[1] + boneMatrix[9]  * n[2]);
+                z2 += boneWeight * (boneMatrix[2] * n[0] + boneMatrix[6] * n[1] + boneMatrix[10] * n[2]);
+            }
+        }
+
+        float* output = streams.outputPositions + vId * streams.positionStride;
+
+        output[0] = x;
+        output[1] = y;
+        output[2] = z;
+
+        if (hasNormals)
+        {
+            output = streams.outputNormals + vId * streams.normalStride;
+            output[0] = x2;
+            output[1] = y2;
+            output[2] = z2;
+        }
+    }
 }
 
 void
 Skinning::targetAddedHandler(component::AbstractComponent::Ptr,
                              Node::Ptr target)
 {
+    updateBoneTextureSceneManager();
+
     // FIXME: in certain circumstances (deserialization from minko studio)
     // it may be necessary to move the target directly below the skeleton root
     // for which the skinning matrices have been computed.
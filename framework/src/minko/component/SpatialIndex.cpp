@@ -0,0 +1,157 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/component/SpatialIndex.hpp"
+#include "minko/component/Transform.hpp"
+#include "minko/scene/Node.hpp"
+#include "minko/scene/NodeSet.hpp"
+#include "minko/math/OctTree.hpp"
+#include "minko/math/Vector3.hpp"
+
+using namespace minko;
+using namespace minko::component;
+
+SpatialIndex::SpatialIndex(float worldSize, uint maxDepth, std::shared_ptr<math::Vector3> center) :
+    AbstractComponent(),
+    _octTree(math::OctTree::create(worldSize, maxDepth, center != nullptr ? center : math::Vector3::create(0.f, 0.f, 0.f)))
+{
+}
+
+void
+SpatialIndex::initialize()
+{
+    _targetAddedSlot = targetAdded()->connect(std::bind(
+        &SpatialIndex::targetAddedHandler,
+        std::static_pointer_cast<SpatialIndex>(shared_from_this()),
+        std::placeholders::_1,
+        std::placeholders::_2
+    ));
+    _targetRemovedSlot = targetRemoved()->connect(std::bind(
+        &SpatialIndex::targetRemovedHandler,
+        std::static_pointer_cast<SpatialIndex>(shared_from_this()),
+        std::placeholders::_1,
+        std::placeholders::_2
+    ));
+}
+
+void
+SpatialIndex::targetAddedHandler(AbstractComponent::Ptr ctrl, NodePtr target)
+{
+    if (targets().size() > 1)
+        throw std::logic_error("SpatialIndex cannot have more than one target.");
+    if (target->components<SpatialIndex>().size() > 1)
+        throw std::logic_error("A node cannot have more than one SpatialIndex.");
+
+    _addedSlot = target->added()->connect(std::bind(
+        &SpatialIndex::addedHandler,
+        std::static_pointer_cast<SpatialIndex>(shared_from_this()),
+        std::placeholders::_1,
+        std::placeholders::_2,
+        std::placeholders::_3
+    ));
+    _removedSlot = target->removed()->connect(std::bind(
+        &SpatialIndex::removedHandler,
+        std::static_pointer_cast<SpatialIndex>(shared_from_this()),
+        std::placeholders::_1,
+        std::placeholders::_2,
+        std::placeholders::_3
+    ));
+    _layoutsChangedSlot = target->layoutsChanged()->connect(std::bind(
+        &SpatialIndex::layoutsChangedHandler,
+        std::static_pointer_cast<SpatialIndex>(shared_from_this()),
+        std::placeholders::_1,
+        std::placeholders::_2
+    ));
+    _componentAddedSlot = target->componentAdded()->connect(std::bind(
+        &SpatialIndex::componentAddedHandler,
+        std::static_pointer_cast<SpatialIndex>(shared_from_this()),
+        std::placeholders::_1,
+        std::placeholders::_2,
+        std::placeholders::_3
+    ));
+    _componentRemovedSlot = target->componentRemoved()->connect(std::bind(
+        &SpatialIndex::componentRemovedHandler,
+        std::static_pointer_cast<SpatialIndex>(shared_from_this()),
+        std::placeholders::_1,
+        std::placeholders::_2,
+        std::placeholders::_3
+    ));
+
+    addedHandler(nullptr, target, nullptr);
+}
+
+void
+SpatialIndex::targetRemovedHandler(AbstractComponent::Ptr ctrl, NodePtr target)
+{
+    _addedSlot = nullptr;
+    _removedSlot = nullptr;
+    _layoutsChangedSlot = nullptr;
+    _componentAddedSlot = nullptr;
+    _componentRemovedSlot = nullptr;
+
+    _octTree->clear();
+}
+
+bool
+SpatialIndex::indexed(NodePtr node)
+{
+    return (node->layouts() & scene::Layout::Group::CULLING) != 0 && node->hasComponent<Transform>();
+}
+
+void
+SpatialIndex::addedHandler(NodePtr node, NodePtr target, NodePtr ancestor)
+{
+    auto descendants = scene::NodeSet::create(target)->descendants(true);
+
+    for (auto& descendant : descendants->nodes())
+        if (indexed(descendant))
+            _octTree->insert(descendant);
+}
+
+void
+SpatialIndex::removedHandler(NodePtr node, NodePtr target, NodePtr ancestor)
+{
+    auto descendants = scene::NodeSet::create(target)->descendants(true);
+
+    for (auto& descendant : descendants->nodes())
+        _octTree->remove(descendant);
+}
+
+void
+SpatialIndex::layoutsChangedHandler(NodePtr node, NodePtr target)
+{
+    if (indexed(target))
+        _octTree->insert(target);
+    else
+        _octTree->remove(target);
+}
+
+void
+SpatialIndex::componentAddedHandler(NodePtr node, NodePtr target, AbstractComponent::Ptr ctrl)
+{
+    if (std::dynamic_pointer_cast<Transform>(ctrl) != nullptr && indexed(target))
+        _octTree->insert(target);
+}
+
+void
+SpatialIndex::componentRemovedHandler(NodePtr node, NodePtr target, AbstractComponent::Ptr ctrl)
+{
+    if (std::dynamic_pointer_cast<Transform>(ctrl) != nullptr)
+        _octTree->remove(target);
+}
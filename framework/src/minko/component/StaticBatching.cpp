@@ -0,0 +1,443 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/component/StaticBatching.hpp"
+
+#include "minko/scene/Node.hpp"
+#include "minko/scene/NodeSet.hpp"
+#include "minko/component/Surface.hpp"
+#include "minko/component/Transform.hpp"
+#include "minko/geometry/Geometry.hpp"
+#include "minko/render/VertexBuffer.hpp"
+#include "minko/render/IndexBuffer.hpp"
+#include "minko/math/Matrix4x4.hpp"
+#include "minko/math/Mat4.hpp"
+
+using namespace minko;
+using namespace minko::component;
+
+// index buffers store unsigned shorts
+static const uint MAX_BATCH_VERTICES = 65536;
+
+static
+void
+getModelToWorld(scene::Node::Ptr node, float* output)
+{
+    // the world matrix of a node without transform is the one of its first transformed ancestor
+    while (node != nullptr && !node->hasComponent<Transform>())
+        node = node->parent();
+
+    if (node == nullptr)
+    {
+        auto identity = math::Mat4::identity();
+
+        identity.store(output);
+    }
+    else
+    {
+        // up-to-date, see Transform::updateModelToWorldMatrices() in StaticBatching::batch()
+        const auto& modelToWorld = node->component<Transform>()->modelToWorldMatrix(false)->data();
+
+        std::copy(modelToWorld.begin(), modelToWorld.end(), output);
+    }
+}
+
+static
+void
+transformDirections(const float* matrix, float* vertices, uint numVertices, uint vertexSize, int offset)
+{
+    if (offset < 0)
+        return;
+
+    for (uint vertexId = 0; vertexId < numVertices; ++vertexId)
+    {
+        float*      v       = vertices + vertexId * vertexSize + offset;
+        math::Vec3  vector  = { v[0], v[1], v[2] };
+
+        vector = math::Mat4::transformVector(matrix, vector).normalized();
+        v[0] = vector.x;
+        v[1] = vector.y;
+        v[2] = vector.z;
+    }
+}
+
+StaticBatching::StaticBatching() :
+    AbstractComponent()
+{
+}
+
+void
+StaticBatching::initialize()
+{
+    _targetAddedSlot = targetAdded()->connect(std::bind(
+        &StaticBatching::targetAddedHandler,
+        std::static_pointer_cast<StaticBatching>(shared_from_this()),
+        std::placeholders::_1,
+        std::placeholders::_2
+    ));
+    _targetRemovedSlot = targetRemoved()->connect(std::bind(
+        &StaticBatching::targetRemovedHandler,
+        std::static_pointer_cast<StaticBatching>(shared_from_this()),
+        std::placeholders::_1,
+        std::placeholders::_2
+    ));
+}
+
+void
+StaticBatching::targetAddedHandler(AbstractComponent::Ptr ctrl, NodePtr target)
+{
+    if (target->components<StaticBatching>().size() > 1)
+        throw std::logic_error("The same node cannot have more than one StaticBatching.");
+
+    batch(target);
+}
+
+void
+StaticBatching::targetRemovedHandler(AbstractComponent::Ptr ctrl, NodePtr target)
+{
+    restore(target);
+}
+
+void
+StaticBatching::rebuild()
+{
+    if (targets().empty())
+        return;
+
+    auto target = targets()[0];
+
+    restore(target);
+    batch(target);
+}
+
+const StaticBatching::Range*
+StaticBatching::source(SurfacePtr batchSurface, uint triangle) const
+{
+    for (auto& batch : _batches)
+    {
+        if (batch.surface != batchSurface)
+            continue;
+
+        auto rangeIt = std::upper_bound(
+            batch.ranges.begin(),
+            batch.ranges.end(),
+            triangle,
+            [](uint t, const Range& range) { return t < range.firstTriangle; }
+        );
+
+        if (rangeIt == batch.ranges.begin())
+            return nullptr;
+
+        --rangeIt;
+
+        return triangle < rangeIt->firstTriangle + rangeIt->numTriangles ? &*rangeIt : nullptr;
+    }
+
+    return nullptr;
+}
+
+/*static*/
+bool
+StaticBatching::batchable(SurfacePtr surface)
+{
+    auto geometry = surface->geometry();
+
+    // skinned geometries are re-computed every frame and cannot be merged
+    if (geometry == nullptr
+        || geometry->indices() == nullptr
+        || geometry->indices()->data().empty()
+        || geometry->vertexBuffers().empty()
+        || !geometry->hasVertexAttribute("position")
+        || geometry->hasVertexAttribute("boneIdsA"))
+        return false;
+
+    // buffers whose data was disposed after upload cannot be read back
+    for (auto& vertexBuffer : geometry->vertexBuffers())
+        if (vertexBuffer->data().empty())
+            return false;
+
+    return geometry->numVertices() <= MAX_BATCH_VERTICES;
+}
+
+/*static*/
+std::string
+StaticBatching::vertexLayout(GeometryPtr geometry)
+{
+    std::string layout;
+
+    for (auto& vertexBuffer : geometry->vertexBuffers())
+    {
+        for (auto& attribute : vertexBuffer->attributes())
+            layout += std::get<0>(*attribute) + ":" + std::to_string(std::get<1>(*attribute))
+                + ":" + std::to_string(std::get<2>(*attribute)) + ";";
+        layout += "|";
+    }
+
+    return layout;
+}
+
+void
+StaticBatching::batch(NodePtr target)
+{
+    struct Group
+    {
+        std::shared_ptr<material::Material> material;
+        std::shared_ptr<render::Effect>     effect;
+        std::string                         technique;
+        std::string                         layout;
+        std::vector<SurfacePtr>             surfaces;
+    };
+
+    std::vector<Group>  groups;
+    auto                descendants = scene::NodeSet::create(target)->descendants(true);
+
+    for (auto& node : descendants->nodes())
+    {
+        for (auto& surface : node->components<Surface>())
+        {
+            if (!batchable(surface))
+                continue;
+
+            auto layout     = vertexLayout(surface->geometry());
+            auto groupIt    = std::find_if(groups.begin(), groups.end(), [&](const Group& group)
+            {
+                return group.material == surface->material()
+                    && group.effect == surface->effect()
+                    && group.technique == surface->technique()
+                    && group.layout == layout;
+            });
+
+            if (groupIt == groups.end())
+            {
+                Group group = { surface->material(), surface->effect(), surface->technique(), layout };
+
+                groups.push_back(group);
+                groupIt = groups.end() - 1;
+            }
+
+            groupIt->surfaces.push_back(surface);
+        }
+    }
+
+    float targetToWorld[16];
+    float worldToTarget[16];
+
+    // a single update of the scene, rather than one forced for each batched surface
+    Transform::updateModelToWorldMatrices(target);
+    getModelToWorld(target, targetToWorld);
+    if (!math::Mat4::invert(targetToWorld, worldToTarget))
+        return;
+
+    for (auto& group : groups)
+    {
+        // merging a single surface would not save any draw call
+        if (group.surfaces.size() < 2)
+            continue;
+
+        uint begin          = 0;
+        uint numVertices    = 0;
+
+        for (uint i = 0; i < group.surfaces.size(); ++i)
+        {
+            auto surfaceNumVertices = group.surfaces[i]->geometry()->numVertices();
+
+            if (numVertices + surfaceNumVertices > MAX_BATCH_VERTICES)
+            {
+                createBatch(target, worldToTarget, group.surfaces, begin, i);
+                begin       = i;
+                numVertices = 0;
+            }
+            numVertices += surfaceNumVertices;
+        }
+        createBatch(target, worldToTarget, group.surfaces, begin, group.surfaces.size());
+    }
+}
+
+void
+StaticBatching::createBatch(NodePtr                         target,
+                            const float*                    worldToTarget,
+                            const std::vector<SurfacePtr>&  surfaces,
+                            uint                            begin,
+                            uint                            end)
+{
+    if (end - begin < 2)
+        return;
+
+    auto reference      = surfaces[begin];
+    auto context        = reference->geometry()->indices()->context();
+    auto vertexBuffer   = render::VertexBuffer::create(context);
+    auto indexBuffer    = render::IndexBuffer::create(context);
+    auto ready          = true;
+    int  positionOffset = -1;
+    int  normalOffset   = -1;
+    int  tangentOffset  = -1;
+    uint offset         = 0;
+
+    for (auto& sourceBuffer : reference->geometry()->vertexBuffers())
+    {
+        for (auto& attribute : sourceBuffer->attributes())
+        {
+            const auto& name            = std::get<0>(*attribute);
+            auto        attributeOffset = offset + std::get<2>(*attribute);
+
+            vertexBuffer->addAttribute(name, std::get<1>(*attribute), attributeOffset);
+
+            if (name == "position")
+                positionOffset = attributeOffset;
+            else if (name == "normal")
+                normalOffset = attributeOffset;
+            else if (name == "tangent")
+                tangentOffset = attributeOffset;
+        }
+        offset += sourceBuffer->vertexSize();
+    }
+
+    const uint  vertexSize  = vertexBuffer->vertexSize();
+    auto&       vertexData  = vertexBuffer->data();
+    auto&       indexData   = indexBuffer->data();
+    Batch       batch;
+
+    for (uint i = begin; i < end; ++i)
+    {
+        auto surface            = surfaces[i];
+        auto geometry           = surface->geometry();
+        auto node               = surface->targets()[0];
+        auto numVertices        = geometry->numVertices();
+        auto baseVertex         = vertexData.size() / vertexSize;
+        auto firstIndex         = indexData.size();
+        auto& sourceIndices     = geometry->indices()->data();
+        float modelToWorld[16];
+        float modelToTarget[16];
+        float inverse[16];
+        float normalMatrix[16];
+
+        getModelToWorld(node, modelToWorld);
+        math::Mat4::multiply(worldToTarget, modelToWorld, modelToTarget);
+        // normals are transformed by the inverse transpose to remain orthogonal to non-uniformly scaled surfaces,
+        // tangents lie in the surface and follow it like positions do
+        if (math::Mat4::invert(modelToTarget, inverse))
+            math::Mat4::transpose(inverse, normalMatrix);
+        else
+            std::copy(modelToTarget, modelToTarget + 16, normalMatrix);
+
+        ready = ready && geometry->indices()->isReady();
+
+        // interleave the vertex streams of the source geometry
+        vertexData.resize(vertexData.size() + numVertices * vertexSize);
+        offset = 0;
+        for (auto& sourceBuffer : geometry->vertexBuffers())
+        {
+            const auto  sourceSize  = sourceBuffer->vertexSize();
+            const auto& sourceData  = sourceBuffer->data();
+
+            for (uint vertexId = 0; vertexId < numVertices; ++vertexId)
+                std::copy(
+                    sourceData.begin() + vertexId * sourceSize,
+                    sourceData.begin() + (vertexId + 1) * sourceSize,
+                    vertexData.begin() + (baseVertex + vertexId) * vertexSize + offset
+                );
+            offset += sourceSize;
+            ready = ready && sourceBuffer->isReady();
+        }
+
+        float* vertices = &vertexData[baseVertex * vertexSize];
+
+        math::Mat4::transformPoints(modelToTarget, vertices + positionOffset, vertices + positionOffset, numVertices, vertexSize);
+
+        transformDirections(normalMatrix, vertices, numVertices, vertexSize, normalOffset);
+        transformDirections(modelToTarget, vertices, numVertices, vertexSize, tangentOffset);
+
+        Range range;
+
+        range.firstTriangle = firstIndex / 3;
+        range.numTriangles  = sourceIndices.size() / 3;
+        range.surface       = surface;
+        range.node          = node;
+        range.min.x = range.min.y = range.min.z = std::numeric_limits<float>::max();
+        range.max.x = range.max.y = range.max.z = -std::numeric_limits<float>::max();
+
+        for (uint vertexId = 0; vertexId < numVertices; ++vertexId)
+        {
+            const float* p = vertices + vertexId * vertexSize + positionOffset;
+
+            range.min.x = std::min(range.min.x, p[0]);
+            range.min.y = std::min(range.min.y, p[1]);
+            range.min.z = std::min(range.min.z, p[2]);
+            range.max.x = std::max(range.max.x, p[0]);
+            range.max.y = std::max(range.max.y, p[1]);
+            range.max.z = std::max(range.max.z, p[2]);
+        }
+
+        indexData.reserve(indexData.size() + sourceIndices.size());
+        for (auto index : sourceIndices)
+            indexData.push_back(static_cast<unsigned short>(index + baseVertex));
+
+        batch.ranges.push_back(range);
+    }
+
+    // buffers are only sent to the GPU if the source ones were, so that batching can be done
+    // before the context is available
+    if (ready)
+    {
+        vertexBuffer->upload();
+        indexBuffer->upload();
+    }
+
+    auto geometry = geometry::Geometry::create();
+
+    geometry->addVertexBuffer(vertexBuffer);
+    geometry->indices(indexBuffer);
+
+    batch.surface = Surface::create(
+        reference->name(),
+        geometry,
+        reference->material(),
+        reference->effect(),
+        reference->technique()
+    );
+    batch.node = scene::Node::create(target->name() + "_staticBatch" + std::to_string(_batches.size()))
+        ->addComponent(Transform::create())
+        ->addComponent(batch.surface);
+
+    for (auto& range : batch.ranges)
+    {
+        range.node->removeComponent(range.surface);
+        _sourceToBatch[range.surface] = batch.surface;
+    }
+
+    target->addChild(batch.node);
+    _batches.push_back(batch);
+}
+
+void
+StaticBatching::restore(NodePtr target)
+{
+    for (auto& batch : _batches)
+    {
+        if (batch.node->parent() != nullptr)
+            batch.node->parent()->removeChild(batch.node);
+        batch.node->removeComponent(batch.surface);
+
+        for (auto& range : batch.ranges)
+            range.node->addComponent(range.surface);
+    }
+
+    _batches.clear();
+    _sourceToBatch.clear();
+}
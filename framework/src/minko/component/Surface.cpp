@@ -39,12 +39,16 @@ using namespace minko::component;
 using namespace minko::geometry;
 using namespace minko::render;
 
+std::vector<uint>   Surface::_freeIds;
+uint                Surface::_numIds = 0;
+
 Surface::Surface(std::string                name,
                  Geometry::Ptr                 geometry,
 				 material::Material::Ptr	material,
                  Effect::Ptr                effect,
                  const std::string&            technique) :
     AbstractComponent(),
+    _id(0),
     _name(name),
     _geometry(geometry),
     _material(material),
@@ -52,7 +56,6 @@ Surface::Surface(std::string                name,
     _technique(technique),
     _visible(true),
     _rendererToVisibility(),
-    _rendererToComputedVisibility(),
     _techniqueChanged(TechniqueChangedSignal::create()),
     _visibilityChanged(VisibilityChangedSignal::create()),
     _computedVisibilityChanged(VisibilityChangedSignal::create()),
@@ -65,10 +68,13 @@ Surface::Surface(std::string                name,
         throw std::invalid_argument("effect");
     if (!_effect->hasTechnique(_technique))
         throw std::logic_error("Effect does not provide a '" + _technique + "' technique.");
+
+    _id = allocateId();
 }
 
 Surface::Surface(const Surface& surface, const CloneOption& option) :
 	AbstractComponent(surface, option),
+	_id(0),
 	_name(surface._name),
 	_geometry(surface._geometry), //needed for skinning: option == CloneOption::SHALLOW ? surface._geometry : surface._geometry->clone()
 	_material(option == CloneOption::SHALLOW ? surface._material : std::static_pointer_cast<Material>(surface._material->clone())),
@@ -76,7 +82,6 @@ Surface::Surface(const Surface& surface, const CloneOption& option) :
 	_technique(surface._technique),
 	_visible(surface._visible),
 	_rendererToVisibility(surface._rendererToVisibility),
-	_rendererToComputedVisibility(surface._rendererToComputedVisibility),
 	_techniqueChanged(TechniqueChangedSignal::create()),
 	_visibilityChanged(VisibilityChangedSignal::create()),
 	_computedVisibilityChanged(VisibilityChangedSignal::create()),
@@ -89,6 +94,27 @@ Surface::Surface(const Surface& surface, const CloneOption& option) :
 		throw std::invalid_argument("effect");
 	if (!_effect->hasTechnique(_technique))
 		throw std::logic_error("Effect does not provide a '" + _technique + "' technique.");
+
+	_id = allocateId();
+}
+
+Surface::~Surface()
+{
+    _freeIds.push_back(_id);
+}
+
+/*static*/
+uint
+Surface::allocateId()
+{
+    if (_freeIds.empty())
+        return _numIds++;
+
+    auto id = _freeIds.back();
+
+    _freeIds.pop_back();
+
+    return id;
 }
 
 AbstractComponent::Ptr
@@ -212,13 +238,19 @@ Surface::visible(component::Renderer::Ptr    renderer,
     }
 }
 
+bool
+Surface::computedVisibility(component::Renderer::Ptr renderer)
+{
+    return renderer->computedVisibility(_id);
+}
+
 void
 Surface::computedVisibility(component::Renderer::Ptr    renderer,
                             bool                        value)
 {
-    if (computedVisibility(renderer) != value)
+    if (renderer->computedVisibility(_id) != value)
     {
-        _rendererToComputedVisibility[renderer] = value;
+        renderer->computedVisibility(_id, value);
         _computedVisibilityChanged->execute(
             std::static_pointer_cast<Surface>(shared_from_this()),
             renderer,
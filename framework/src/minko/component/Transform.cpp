@@ -30,6 +30,9 @@ using namespace minko;
 using namespace minko::component;
 using namespace minko::math;
 
+async::ThreadPool::Ptr  Transform::_updateThreadPool            = nullptr;
+uint                    Transform::_parallelUpdateMinNumNodes   = 0;
+
 Transform::Transform() :
     minko::component::AbstractComponent(),
     _matrix(Matrix4x4::create()),
@@ -67,6 +70,24 @@ Transform::initialize()
     //_data->set("transform/worldToModelMatrix", _worldToModel);
 }
 
+/*static*/
+void
+Transform::updateModelToWorldMatrices(scene::Node::Ptr node)
+{
+    auto root = node->root();
+
+    if (root->hasComponent<RootTransform>())
+        root->component<RootTransform>()->forceUpdate();
+}
+
+/*static*/
+void
+Transform::parallelUpdate(uint numThreads, uint minNumNodes)
+{
+    _updateThreadPool = numThreads > 0 ? async::ThreadPool::create(numThreads) : nullptr;
+    _parallelUpdateMinNumNodes = minNumNodes;
+}
+
 void
 Transform::targetAddedHandler(AbstractComponent::Ptr    ctrl,
                               scene::Node::Ptr            target)
@@ -111,6 +132,15 @@ Transform::targetRemovedHandler(AbstractComponent::Ptr ctrl,
     _removedSlot = nullptr;
 }
 
+Transform::RootTransform::RootTransform() :
+    minko::component::AbstractComponent(),
+    _numRemovedIds(0),
+    _invalidLists(true),
+    _numVisitedNodes(0),
+    _numSkippedNodes(0)
+{
+}
+
 AbstractComponent::Ptr
 Transform::RootTransform::clone(const CloneOption& option)
 {
@@ -180,6 +210,8 @@ Transform::RootTransform::targetAddedHandler(AbstractComponent::Ptr     ctrl,
             std::placeholders::_3
         ), 1000.f);
 
+    _invalidLists = true;
+
     addedHandler(nullptr, target, target->parent());
 }
 
@@ -189,6 +221,9 @@ Transform::RootTransform::targetRemovedHandler(AbstractComponent::Ptr     ctrl,
 {
     _targetSlots.clear();
     _renderingBeginSlot = nullptr;
+
+    _transformChangedSlots.clear();
+    _invalidLists = true;
 }
 
 void
@@ -206,8 +241,8 @@ Transform::RootTransform::componentAddedHandler(scene::Node::Ptr        node,
             std::placeholders::_2,
             std::placeholders::_3
         ), 1000.f);
-    else if (std::dynamic_pointer_cast<Transform>(ctrl) != nullptr)
-        _invalidLists = true;
+    else if (std::dynamic_pointer_cast<Transform>(ctrl) != nullptr && !_invalidLists)
+        insertNodes(target);
 }
 
 void
@@ -219,8 +254,8 @@ Transform::RootTransform::componentRemovedHandler(scene::Node::Ptr            no
 
     if (sceneManager)
         _renderingBeginSlot = nullptr;
-    else if (std::dynamic_pointer_cast<Transform>(ctrl) != nullptr)
-        _invalidLists = true;
+    else if (std::dynamic_pointer_cast<Transform>(ctrl) != nullptr && !_invalidLists)
+        removeNode(target, true);
 }
 
 void
@@ -228,16 +263,25 @@ Transform::RootTransform::addedHandler(scene::Node::Ptr node,
                                        scene::Node::Ptr target,
                                        scene::Node::Ptr ancestor)
 {
-    auto descendants = scene::NodeSet::create(target->root())->descendants(false);
+    // our own target is not a root anymore: the RootTransform of the new root removes (or has removed) this one
+    if (targets().empty() || targets()[0]->root() != targets()[0])
+        return;
+
+    auto self = targets()[0];
+
+    // only the added subtree can hold other RootTransform components
+    auto descendants = scene::NodeSet::create(target)->descendants(true);
+
     for (auto descendant : descendants->nodes())
     {
         auto rootTransformCtrl = descendant->component<RootTransform>();
 
-        if (rootTransformCtrl)
+        if (rootTransformCtrl && descendant != self)
             descendant->removeComponent(rootTransformCtrl);
     }
 
-    _invalidLists = true;
+    if (!_invalidLists)
+        insertNodes(target);
 }
 
 void
@@ -245,184 +289,511 @@ Transform::RootTransform::removedHandler(scene::Node::Ptr node,
                                          scene::Node::Ptr target,
                                          scene::Node::Ptr ancestor)
 {
-    _invalidLists = true;
+    if (!_invalidLists)
+        removeNodes(target);
 }
 
 void
 Transform::RootTransform::updateTransformsList()
 {
-    _transforms        .clear();
-    _modelToWorld    .clear();
-    _nodeToId        .clear();
-    _idToNode        .clear();
-    _parentId        .clear();
-    _firstChildId    .clear();
-    _numChildren    .clear();
+    _transforms             .clear();
+    _modelToWorld           .clear();
+    _localMatrices          .clear();
+    _worldMatrices          .clear();
+    _worldChanged           .clear();
+    _nodeToId               .clear();
+    _idToNode               .clear();
+    _parentId               .clear();
+    _firstChildId           .clear();
+    _nextSiblingId          .clear();
+    _previousSiblingId      .clear();
+    _transformChangedSlots  .clear();
+    _dirtyIds               .clear();
+    _numRemovedIds          = 0;
+
+    for (auto target : targets())
+        insertNodes(target);
 
-    auto withTransforms            = scene::NodeSet::create(targets())
-        ->descendants(true, false)
-        ->where([](scene::Node::Ptr n){ return n->hasComponent<Transform>(); });
+    _invalidLists = false;
+}
 
-    auto nodesWithTransform    = withTransforms->nodes();
+void
+Transform::RootTransform::insertNodes(scene::Node::Ptr subtreeRoot)
+{
+    // breadth-first order: every node is appended after its closest ancestor with a Transform
+    auto descendants = scene::NodeSet::create(subtreeRoot)->descendants(true, false)->nodes();
 
-    juxtaposeSiblings(nodesWithTransform); // make sure siblings are at contiguous positions in the vector
+    // nodes of the subtree that are already registered must be moved after their (possibly new) ancestors
+    for (auto descendant : descendants)
+        if (_nodeToId.count(descendant) != 0)
+            removeNode(descendant);
+
+    int subtreeParentId = -1;
+
+    for (auto ancestor = subtreeRoot->parent(); ancestor != nullptr; ancestor = ancestor->parent())
+    {
+        auto ancestorIt = _nodeToId.find(ancestor);
+
+        if (ancestorIt != _nodeToId.end())
+        {
+            subtreeParentId = ancestorIt->second;
+            break;
+        }
+    }
 
-    _transforms        .resize(nodesWithTransform.size());
-    _modelToWorld    .resize(nodesWithTransform.size());
-    _idToNode        .resize(nodesWithTransform.size());
-    _parentId        .resize(nodesWithTransform.size(), -1);
-    _firstChildId    .resize(nodesWithTransform.size(), 0);
-    _numChildren    .resize(nodesWithTransform.size(), 0);
+    std::unordered_map<scene::Node*, int> closestAncestorId;
 
-    for (uint nodeId = 0; nodeId < nodesWithTransform.size(); ++nodeId)
+    for (auto descendant : descendants)
     {
-        auto    node        = nodesWithTransform[nodeId];
-        auto    transform    = node->component<Transform>();
-        auto    ancestor    = node->parent();
+        auto parentId = descendant == subtreeRoot
+            ? subtreeParentId
+            : closestAncestorId[descendant->parent().get()];
+
+        if (descendant->hasComponent<Transform>())
+            parentId = appendNode(descendant, parentId);
+
+        closestAncestorId[descendant.get()] = parentId;
+    }
+}
+
+void
+Transform::RootTransform::removeNodes(scene::Node::Ptr subtreeRoot)
+{
+    auto descendants = scene::NodeSet::create(subtreeRoot)->descendants(true);
+
+    for (auto descendant : descendants->nodes())
+        if (_nodeToId.count(descendant) != 0)
+            removeNode(descendant);
+}
+
+void
+Transform::RootTransform::removeNode(scene::Node::Ptr node, bool reparentDescendants)
+{
+    auto nodeIt = _nodeToId.find(node);
+
+    if (nodeIt == _nodeToId.end())
+        return;
 
-        while (ancestor != nullptr && _nodeToId.count(ancestor) == 0)
-            ancestor = ancestor->parent();
+    int nodeId = nodeIt->second;
 
-        _nodeToId[node]            = nodeId;
+    unlinkNode(nodeId);
 
-        _transforms[nodeId]        = transform->_matrix;
-        _modelToWorld[nodeId]    = transform->_modelToWorld;
-        _idToNode[nodeId]        = node;
+    if (reparentDescendants)
+    {
+        // the node lost its Transform: its children now hang from its own closest ancestor
+        auto childId = _firstChildId[nodeId];
 
-        if (ancestor)
+        while (childId != -1)
         {
-            assert(_nodeToId.count(ancestor) > 0);
-            auto ancestorId = _nodeToId[ancestor];
+            auto nextChildId = _nextSiblingId[childId];
 
-            _parentId[nodeId]    = ancestorId;
+            linkNode(childId, _parentId[nodeId]);
+            invalidateWorldMatrix(childId);
 
-            if (_numChildren[ancestorId] == 0)
-                _firstChildId[ancestorId] = nodeId;
-            ++_numChildren[ancestorId];
+            childId = nextChildId;
         }
+
+        _firstChildId[nodeId] = -1;
     }
 
-    _invalidLists = false;
+    // ids are never reused until the next compaction, so parents always have lower ids than their children
+    _nodeToId.erase(nodeIt);
+    _idToNode[nodeId]               = nullptr;
+    _transforms[nodeId]             = nullptr;
+    _modelToWorld[nodeId]           = nullptr;
+    _transformChangedSlots[nodeId]  = nullptr;
+    _parentId[nodeId]               = -1;
+    _worldChanged[nodeId]           = 0;
+
+    ++_numRemovedIds;
+}
+
+unsigned int
+Transform::RootTransform::appendNode(scene::Node::Ptr node, int parentId)
+{
+    auto transform  = node->component<Transform>();
+    auto nodeId     = _idToNode.size();
+    auto& local     = transform->_matrix->_m;
+
+    _nodeToId[node] = nodeId;
+    _idToNode               .push_back(node);
+    _transforms             .push_back(transform->_matrix);
+    _modelToWorld           .push_back(transform->_modelToWorld);
+    _parentId               .push_back(-1);
+    _firstChildId           .push_back(-1);
+    _nextSiblingId          .push_back(-1);
+    _previousSiblingId      .push_back(-1);
+    _worldChanged           .push_back(0);
+    _transformChangedSlots  .push_back(nullptr);
+    _localMatrices          .insert(_localMatrices.end(), local.begin(), local.end());
+    _worldMatrices          .resize(_worldMatrices.size() + 16);
+
+    linkNode(nodeId, parentId);
+    watchTransform(nodeId);
+    invalidateWorldMatrix(nodeId);
+
+    return nodeId;
 }
 
-/*static*/
 void
-Transform::RootTransform::juxtaposeSiblings(std::vector<NodePtr>& nodes)
+Transform::RootTransform::linkNode(int nodeId, int parentId)
 {
-    // assumes 'nodes' is the result of a breadth-first search from the nodes
-    std::unordered_map<scene::Node::Ptr, unsigned int>    firstChild;
+    _parentId[nodeId]           = parentId;
+    _previousSiblingId[nodeId]  = -1;
+    _nextSiblingId[nodeId]      = -1;
+
+    if (parentId == -1)
+        return;
+
+    auto firstChildId = _firstChildId[parentId];
 
-    for (unsigned int nodeId = 0; nodeId < nodes.size(); ++nodeId)
+    _nextSiblingId[nodeId] = firstChildId;
+    if (firstChildId != -1)
+        _previousSiblingId[firstChildId] = nodeId;
+    _firstChildId[parentId] = nodeId;
+}
+
+void
+Transform::RootTransform::unlinkNode(int nodeId)
+{
+    auto parentId           = _parentId[nodeId];
+    auto previousSiblingId  = _previousSiblingId[nodeId];
+    auto nextSiblingId      = _nextSiblingId[nodeId];
+
+    if (previousSiblingId != -1)
+        _nextSiblingId[previousSiblingId] = nextSiblingId;
+    else if (parentId != -1)
+        _firstChildId[parentId] = nextSiblingId;
+
+    if (nextSiblingId != -1)
+        _previousSiblingId[nextSiblingId] = previousSiblingId;
+
+    _previousSiblingId[nodeId]  = -1;
+    _nextSiblingId[nodeId]      = -1;
+}
+
+void
+Transform::RootTransform::watchTransform(unsigned int nodeId)
+{
+    _transformChangedSlots[nodeId] = _transforms[nodeId]->changed()->connect(std::bind(
+        &Transform::RootTransform::invalidateWorldMatrix,
+        std::static_pointer_cast<RootTransform>(shared_from_this()),
+        nodeId
+    ));
+}
+
+void
+Transform::RootTransform::invalidateWorldMatrix(unsigned int nodeId)
+{
+    // 1 = pending, 2 = computed by the current update but not committed yet
+    if (_worldChanged[nodeId] != 1)
     {
-        auto it            = nodes.begin() + nodeId;
-        auto node        = *it;
-        auto ancestor    = node->parent();
-        while (ancestor != nullptr
-            && std::find(nodes.begin(), it, ancestor) == nodes.end())
-            ancestor = ancestor->parent();
-
-        if (firstChild.count(ancestor) == 0)
-            firstChild[ancestor] = nodeId;
-        else
+        _worldChanged[nodeId] = 1;
+        _dirtyIds.push_back(nodeId);
+    }
+}
+
+void
+Transform::RootTransform::compactTransformsList()
+{
+    unsigned int        numIds  = _idToNode.size();
+    unsigned int        newId   = 0;
+    std::vector<int>    newIds(numIds, -1);
+
+    // stable compaction: the relative order of the remaining nodes, hence the parent < child invariant, is kept
+    for (unsigned int nodeId = 0; nodeId < numIds; ++nodeId)
+    {
+        if (_idToNode[nodeId] == nullptr)
+            continue;
+
+        newIds[nodeId] = newId;
+
+        if (newId != nodeId)
         {
-            assert(firstChild[ancestor] <= nodeId);
+            _idToNode[newId]        = std::move(_idToNode[nodeId]);
+            _transforms[newId]      = std::move(_transforms[nodeId]);
+            _modelToWorld[newId]    = std::move(_modelToWorld[nodeId]);
+            _worldChanged[newId]    = _worldChanged[nodeId];
+
+            std::copy(_localMatrices.begin() + (nodeId << 4), _localMatrices.begin() + ((nodeId + 1) << 4), _localMatrices.begin() + (newId << 4));
+            std::copy(_worldMatrices.begin() + (nodeId << 4), _worldMatrices.begin() + ((nodeId + 1) << 4), _worldMatrices.begin() + (newId << 4));
 
-            nodes.erase(it);
-            nodes.insert(nodes.begin() + firstChild[ancestor], node);
+            watchTransform(newId);
+            _transformChangedSlots[nodeId] = nullptr;
         }
+
+        _nodeToId[_idToNode[newId]] = newId;
+
+        ++newId;
     }
+
+    // links only ever point to nodes that are still registered
+    for (unsigned int nodeId = 0; nodeId < numIds; ++nodeId)
+    {
+        auto id = newIds[nodeId];
+
+        if (id == -1)
+            continue;
+
+        _parentId[id]           = _parentId[nodeId] == -1 ? -1 : newIds[_parentId[nodeId]];
+        _firstChildId[id]       = _firstChildId[nodeId] == -1 ? -1 : newIds[_firstChildId[nodeId]];
+        _nextSiblingId[id]      = _nextSiblingId[nodeId] == -1 ? -1 : newIds[_nextSiblingId[nodeId]];
+        _previousSiblingId[id]  = _previousSiblingId[nodeId] == -1 ? -1 : newIds[_previousSiblingId[nodeId]];
+    }
+
+    std::vector<unsigned int> dirtyIds;
+
+    for (auto nodeId : _dirtyIds)
+        if (newIds[nodeId] != -1)
+            dirtyIds.push_back(newIds[nodeId]);
+    _dirtyIds.swap(dirtyIds);
+
+    _idToNode               .resize(newId);
+    _transforms             .resize(newId);
+    _modelToWorld           .resize(newId);
+    _parentId               .resize(newId);
+    _firstChildId           .resize(newId);
+    _nextSiblingId          .resize(newId);
+    _previousSiblingId      .resize(newId);
+    _worldChanged           .resize(newId);
+    _transformChangedSlots  .resize(newId);
+    _localMatrices          .resize(newId << 4);
+    _worldMatrices          .resize(newId << 4);
+
+    _numRemovedIds = 0;
 }
 
 void
 Transform::RootTransform::updateTransforms()
 {
-    unsigned int numNodes     = _transforms.size();
-    unsigned int nodeId     = 0;
+    unsigned int numNodes       = _idToNode.size();
+    unsigned int numLiveNodes   = numNodes - _numRemovedIds;
 
-    while (nodeId < numNodes)
-    {
-        auto parentModelToWorldMatrix     = _modelToWorld[nodeId];
-        auto numChildren                 = _numChildren[nodeId];
-        auto firstChildId                 = _firstChildId[nodeId];
-        auto lastChildId                 = firstChildId + numChildren;
-        auto parentId                     = _parentId[nodeId];
-        auto parentTransformChanged     = parentModelToWorldMatrix->_hasChanged;
+    _updatedIds.clear();
 
-        parentModelToWorldMatrix->_hasChanged = false;
+    // gather the local matrices that changed since the last update into the flat storage
+    for (auto nodeId : _dirtyIds)
+    {
+        auto& transform = _transforms[nodeId];
 
-        if (parentId == -1)
+        if (transform != nullptr && transform->_hasChanged)
         {
-            auto parentTransform = _transforms[nodeId];
-
-            if (_transforms[nodeId]->_hasChanged)
-            {
-                parentModelToWorldMatrix->copyFrom(parentTransform);
-                parentModelToWorldMatrix->_hasChanged = false;
-                parentTransform->_hasChanged = false;
-                parentTransformChanged = true;
-            }
+            std::copy(transform->_m.begin(), transform->_m.end(), _localMatrices.begin() + (nodeId << 4));
+            transform->_hasChanged = false;
         }
+    }
 
-        for (auto childId = firstChildId; childId < lastChildId; ++childId)
-        {
-            auto modelToWorld   = _modelToWorld[childId];
-            auto transform      = _transforms[childId];
-
-            if (transform->_hasChanged || parentTransformChanged)
-            {
-                modelToWorld->lock()->copyFrom(transform)->append(parentModelToWorldMatrix)->unlock();
-                transform->_hasChanged = false;
-            }
-        }
+    if (_dirtyIds.size() > (numLiveNodes >> 3))
+    {
+        auto threadPool = _updateThreadPool;
 
-        ++nodeId;
+        if (threadPool != nullptr && numLiveNodes >= _parallelUpdateMinNumNodes)
+            updateAllWorldMatricesInParallel(*threadPool);
+        else
+            updateAllWorldMatrices();
+    }
+    else
+    {
+        // dirty subtrees are walked from their topmost dirty node: parents have lower ids than their children
+        std::sort(_dirtyIds.begin(), _dirtyIds.end());
+
+        for (auto nodeId : _dirtyIds)
+            if (_worldChanged[nodeId] == 1)
+                updateSubtreeWorldMatrices(nodeId, _nodeStack, _updatedIds);
+    }
+
+    _dirtyIds.clear();
+
+    _numVisitedNodes = _updatedIds.size();
+    _numSkippedNodes = numLiveNodes - _numVisitedNodes;
+
+    // scatter the updated world matrices back into the Matrix4x4 objects, parents first
+    for (auto nodeId : _updatedIds)
+    {
+        // a listener might have touched a transform again: it then stays pending for the next update
+        if (_worldChanged[nodeId] == 2)
+            _worldChanged[nodeId] = 0;
+
+        if (_modelToWorld[nodeId] != nullptr)
+            commitWorldMatrix(nodeId);
     }
 }
 
+void
+Transform::RootTransform::updateAllWorldMatrices()
+{
+    unsigned int numNodes = _idToNode.size();
+
+    for (unsigned int nodeId = 0; nodeId < numNodes; ++nodeId)
+        if (computeWorldMatrix(nodeId))
+            _updatedIds.push_back(nodeId);
+}
+
+void
+Transform::RootTransform::updateAllWorldMatricesInParallel(async::ThreadPool& threadPool)
+{
+    unsigned int numNodes           = _idToNode.size();
+    unsigned int numThreads         = threadPool.numThreads() + 1;
+    unsigned int minNumSubtrees     = numThreads << 2;
+    unsigned int firstSubtreeRoot   = 0;
+
+    _subtreeRootIds.clear();
+
+    for (unsigned int nodeId = 0; nodeId < numNodes; ++nodeId)
+        if (_parentId[nodeId] == -1 && _idToNode[nodeId] != nullptr)
+            _subtreeRootIds.push_back(nodeId);
+
+    // split the hierarchies until there are enough independent subtrees to balance the load between
+    // the threads: the nodes above those subtrees are updated right away, breadth first
+    while (firstSubtreeRoot < _subtreeRootIds.size()
+           && _subtreeRootIds.size() - firstSubtreeRoot < minNumSubtrees)
+    {
+        auto nodeId = _subtreeRootIds[firstSubtreeRoot++];
+
+        if (computeWorldMatrix(nodeId))
+            _updatedIds.push_back(nodeId);
+
+        for (auto childId = _firstChildId[nodeId]; childId != -1; childId = _nextSiblingId[childId])
+            _subtreeRootIds.push_back(childId);
+    }
+
+    _threadNodeStacks.resize(numThreads);
+    _threadUpdatedIds.resize(numThreads);
+
+    for (auto& updatedIds : _threadUpdatedIds)
+        updatedIds.clear();
+
+    // each subtree only writes its own nodes and reads the world matrix of a parent computed above
+    threadPool.parallelFor(_subtreeRootIds.size() - firstSubtreeRoot, [&](uint taskId, uint threadId)
+    {
+        updateSubtreeWorldMatrices(
+            _subtreeRootIds[firstSubtreeRoot + taskId], _threadNodeStacks[threadId], _threadUpdatedIds[threadId]
+        );
+    });
+
+    for (auto& updatedIds : _threadUpdatedIds)
+        _updatedIds.insert(_updatedIds.end(), updatedIds.begin(), updatedIds.end());
+}
+
+void
+Transform::RootTransform::updateSubtreeWorldMatrices(unsigned int                 subtreeRootId,
+                                                     std::vector<unsigned int>&   nodeStack,
+                                                     std::vector<unsigned int>&   updatedIds)
+{
+    nodeStack.clear();
+    nodeStack.push_back(subtreeRootId);
+
+    while (!nodeStack.empty())
+    {
+        auto nodeId = nodeStack.back();
+
+        nodeStack.pop_back();
+
+        if (computeWorldMatrix(nodeId))
+            updatedIds.push_back(nodeId);
+
+        for (auto childId = _firstChildId[nodeId]; childId != -1; childId = _nextSiblingId[childId])
+            nodeStack.push_back(childId);
+    }
+}
+
+bool
+Transform::RootTransform::computeWorldMatrix(unsigned int nodeId)
+{
+    const float*    localMatrices   = _localMatrices.data();
+    float*          worldMatrices   = _worldMatrices.data();
+    auto            parentId        = _parentId[nodeId];
+
+    // a world matrix is recomputed when its local matrix or its parent's world matrix changed
+    if (parentId == -1)
+    {
+        if (!_worldChanged[nodeId])
+            return false;
+
+        std::copy(localMatrices + (nodeId << 4), localMatrices + ((nodeId + 1) << 4), worldMatrices + (nodeId << 4));
+    }
+    else if (_worldChanged[nodeId] || _worldChanged[parentId])
+        Mat4::multiply(worldMatrices + (parentId << 4), localMatrices + (nodeId << 4), worldMatrices + (nodeId << 4));
+    else
+        return false;
+
+    _worldChanged[nodeId] = 2;
+
+    return true;
+}
+
+void
+Transform::RootTransform::updateWorldMatrix(unsigned int nodeId)
+{
+    auto& transform = _transforms[nodeId];
+    auto  parentId  = _parentId[nodeId];
+    auto  local     = _localMatrices.data() + (nodeId << 4);
+    auto  world     = _worldMatrices.data() + (nodeId << 4);
+
+    // the local matrix is kept flagged as changed so the next full update also refreshes its descendants
+    std::copy(transform->_m.begin(), transform->_m.end(), local);
+
+    if (parentId == -1)
+        std::copy(local, local + 16, world);
+    else
+        Mat4::multiply(_worldMatrices.data() + (parentId << 4), local, world);
+
+    commitWorldMatrix(nodeId);
+}
+
+void
+Transform::RootTransform::commitWorldMatrix(unsigned int nodeId)
+{
+    auto& modelToWorld  = _modelToWorld[nodeId];
+    auto  world         = _worldMatrices.data() + (nodeId << 4);
+
+    std::copy(world, world + 16, modelToWorld->_m.begin());
+    modelToWorld->_hasChanged = false;
+    modelToWorld->changed()->execute(modelToWorld);
+}
+
 void
 Transform::RootTransform::forceUpdate(scene::Node::Ptr node, bool updateTransformLists)
 {
     if (_invalidLists || updateTransformLists)
         updateTransformsList();
 
-    auto                targetNodeId    = _nodeToId[node];
-    int                    nodeId            = targetNodeId;
-    auto                dirtyRoot        = -1;
-    std::vector<uint>    path;
+    auto nodeIt = _nodeToId.find(node);
+
+    if (nodeIt == _nodeToId.end())
+        return;
+
+    int                 nodeId  = nodeIt->second;
+    std::vector<uint>   path;
 
-    // find the "dirty" root and build the path to get back to the target node
+    // build the path from the target node up to its root
     while (nodeId >= 0)
     {
-        if ((_transforms[nodeId]->_hasChanged)
-            || (nodeId != targetNodeId && _modelToWorld[nodeId]->_hasChanged))
-            dirtyRoot = nodeId;
-
         path.push_back(nodeId);
 
         nodeId = _parentId[nodeId];
     }
 
-    // update that path starting from the dirty root
+    // update that path starting from the root
     for (int i = path.size() - 1; i >= 0; --i)
-    {
-        auto dirtyNodeId    = path[i];
-        auto parentId        = _parentId[dirtyNodeId];
-        auto modelToWorld    = _modelToWorld[dirtyNodeId];
-
-        modelToWorld->copyFrom(_transforms[dirtyNodeId]);
-        if (parentId != -1)
-            modelToWorld->append(_modelToWorld[parentId]);
-        modelToWorld->_hasChanged = false;
-    }
+        updateWorldMatrix(path[i]);
 }
 
 void
-Transform::RootTransform::renderingBeginHandler(std::shared_ptr<SceneManager>               sceneManager,
-                                                uint                                        frameId,
-                                                std::shared_ptr<render::AbstractTexture>    abstractTexture)
+Transform::RootTransform::forceUpdate()
 {
     if (_invalidLists)
         updateTransformsList();
+    else if (_numRemovedIds * 2 > _idToNode.size())
+        compactTransformsList();
 
     updateTransforms();
 }
+
+void
+Transform::RootTransform::renderingBeginHandler(std::shared_ptr<SceneManager>               sceneManager,
+                                                uint                                        frameId,
+                                                std::shared_ptr<render::AbstractTexture>    abstractTexture)
+{
+    forceUpdate();
+}
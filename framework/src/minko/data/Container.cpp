@@ -31,7 +31,8 @@ uint Container::CONTAINER_ID = 0;
 Container::Container() :
     std::enable_shared_from_this<Container>(),
     _providers(),
-    _propertyNameToProvider(),
+    _properties(),
+    _providerToPropertyIds(),
     _arrayLengths(data::Provider::create()),
     _propertyAdded(Container::PropertyChangedSignal::create()),
     _propertyRemoved(Container::PropertyChangedSignal::create()),
@@ -42,6 +43,8 @@ Container::Container() :
     _providerReferenceChangedSlot(),
     _providerAdded(Signal<Ptr, Provider::Ptr>::create()),
     _providerRemoved(Signal<Ptr, Provider::Ptr>::create()),
+    _updateDepth(0),
+    _updatingProviders(),
     _containerId(CONTAINER_ID++)
 {
 }
@@ -77,15 +80,15 @@ Container::addProvider(Provider::Ptr provider)
             std::placeholders::_2
         )));
 
-        _providerReferenceChangedSlot[provider] = provider->propertyReferenceChanged()->connect(std::bind(
+        _providerReferenceChangedSlot[provider] = provider->propertyIdReferenceChanged()->connect(std::bind(
             &Container::providerReferenceChangedHandler,
             shared_from_this(),
             std::placeholders::_1,
             std::placeholders::_2
         ));
 
-        for (auto property : provider->values())
-            providerPropertyAddedHandler(provider, property.first);
+        for (auto& propertyName : provider->propertyNames())
+            providerPropertyAddedHandler(provider, propertyName);
 
         _providerAdded->execute(shared_from_this(), provider);
     }
@@ -102,9 +105,12 @@ Container::removeProvider(Provider::Ptr provider)
     _providersToNumUse[provider]--;
     if (_providersToNumUse[provider] == 0)
     {
-        for (auto property : provider->values())
-            providerPropertyRemovedHandler(provider, property.first);
+        auto propertyNames = provider->propertyNames();
 
+        for (auto& propertyName : propertyNames)
+            providerPropertyRemovedHandler(provider, propertyName);
+
+        _providerToPropertyIds.erase(provider);
         _propertyAddedOrRemovedSlots.erase(provider);
         _providerValueChangedSlot.erase(provider);
         _providerReferenceChangedSlot.erase(provider);
@@ -118,7 +124,7 @@ Container::removeProvider(Provider::Ptr provider)
 
     /*
     for (auto property : provider->values())
-        _propertyNameToProvider.erase(property.first);
+        _properties.erase(property.first);
 
     if (_providerValueChangedSlot.count(provider) != 0)
         _providerValueChangedSlot.erase(provider);
@@ -210,104 +216,166 @@ Container::hasProvider(std::shared_ptr<Provider> provider) const
     return std::find(_providers.begin(), _providers.end(), provider) != _providers.end();
 }
 
+void
+Container::beginUpdate()
+{
+    if (_updateDepth++ != 0)
+        return;
+
+    // the providers are kept so that the ones added or removed meanwhile are ended properly
+    _updatingProviders.assign(_providers.begin(), _providers.end());
+    for (auto& provider : _updatingProviders)
+        provider->beginUpdate();
+}
+
+void
+Container::endUpdate()
+{
+    if (_updateDepth == 0)
+        throw std::logic_error("endUpdate() called without a matching beginUpdate().");
+
+    if (--_updateDepth != 0)
+        return;
+
+    auto providers = std::move(_updatingProviders);
+
+    _updatingProviders.clear();
+    for (auto& provider : providers)
+        provider->endUpdate();
+}
+
 bool
 Container::hasProperty(const std::string& propertyName) const
 {
-    return _propertyNameToProvider.count(propertyName) != 0;
+    return hasProperty(PropertyId::find(propertyName));
 }
 
 Container::PropertyChangedSignalPtr
 Container::propertyValueChanged(const std::string& propertyName)
 {
-    //assertPropertyExists(propertyName);
+    auto propertyId = PropertyId::get(propertyName);
+    auto foundIt    = _propValueChanged.find(propertyId);
 
-    if (_propValueChanged.count(propertyName) == 0)
-    {
-        _propValueChanged[propertyName] = Signal<Container::Ptr, const std::string&>::create();
+    if (foundIt != _propValueChanged.end())
+        return foundIt->second;
 
-        if (_propertyNameToProvider.count(propertyName) != 0)
-        {
-            Provider::Ptr provider = _propertyNameToProvider[propertyName];
-
-            if (_providerValueChangedSlot.count(provider) == 0)
-                _providerValueChangedSlot[provider] = provider->propertyValueChanged()->connect(std::bind(
-                    &Container::providerValueChangedHandler,
-                    shared_from_this(),
-                    std::placeholders::_1,
-                    std::placeholders::_2
-                ));
-        }
+    auto signal = Signal<Container::Ptr, const std::string&>::create();
+
+    _propValueChanged[propertyId] = signal;
+
+    auto foundPropertyIt = _properties.find(propertyId);
+
+    if (foundPropertyIt != _properties.end())
+    {
+        Provider::Ptr provider = foundPropertyIt->second.provider;
+
+        if (_providerValueChangedSlot.count(provider) == 0)
+            _providerValueChangedSlot[provider] = provider->propertyIdValueChanged()->connect(std::bind(
+                &Container::providerValueChangedHandler,
+                shared_from_this(),
+                std::placeholders::_1,
+                std::placeholders::_2
+            ));
     }
 
-    return _propValueChanged[propertyName];
+    return signal;
 }
 
 Container::PropertyChangedSignalPtr
 Container::propertyReferenceChanged(const std::string& propertyName)
 {
-    if (_propReferenceChanged.count(propertyName) == 0)
+    auto propertyId = PropertyId::get(propertyName);
+    auto foundIt    = _propReferenceChanged.find(propertyId);
+
+    if (foundIt != _propReferenceChanged.end())
+        return foundIt->second;
+
+    auto signal = Signal<Container::Ptr, const std::string&>::create();
+
+    _propReferenceChanged[propertyId] = signal;
+
+    auto foundPropertyIt = _properties.find(propertyId);
+
+    if (foundPropertyIt != _properties.end())
     {
-        _propReferenceChanged[propertyName] = Signal<Container::Ptr, const std::string&>::create();
+        Provider::Ptr provider = foundPropertyIt->second.provider;
 
-        if (_propertyNameToProvider.count(propertyName) != 0)
+        if (_providerReferenceChangedSlot.count(provider) == 0)
         {
-            Provider::Ptr provider = _propertyNameToProvider[propertyName];
-
-            if (_providerReferenceChangedSlot.count(provider) == 0)
-            {
-                _providerReferenceChangedSlot[provider] = provider->propertyReferenceChanged()->connect(std::bind(
-                    &Container::providerReferenceChangedHandler,
-                    shared_from_this(),
-                    std::placeholders::_1,
-                    std::placeholders::_2
-                ));
-            }
+            _providerReferenceChangedSlot[provider] = provider->propertyIdReferenceChanged()->connect(std::bind(
+                &Container::providerReferenceChangedHandler,
+                shared_from_this(),
+                std::placeholders::_1,
+                std::placeholders::_2
+            ));
         }
     }
 
-    return _propReferenceChanged[propertyName];
+    return signal;
 }
 
-void
-Container::assertPropertyExists(const std::string& propertyName) const
+uint
+Container::propertyId(Provider::Ptr provider, uint providerPropertyId) const
 {
-    if (!hasProperty(propertyName))
-        throw std::invalid_argument(propertyName);
+    auto providerPropertyIdsIt = _providerToPropertyIds.find(provider);
+
+    if (providerPropertyIdsIt == _providerToPropertyIds.end())
+        return PropertyId::UNDEFINED;
+
+    auto propertyIdIt = providerPropertyIdsIt->second.find(providerPropertyId);
+
+    return propertyIdIt != providerPropertyIdsIt->second.end() ? propertyIdIt->second : PropertyId::UNDEFINED;
 }
 
 void
-Container::providerValueChangedHandler(Provider::Ptr        provider,
-                                       const std::string&     propertyName)
+Container::providerValueChangedHandler(Provider::Ptr    provider,
+                                       uint             providerPropertyId)
 {
-    auto formatedPropertyName = formatPropertyName(provider, propertyName);
+    auto propertyId = this->propertyId(provider, providerPropertyId);
+    auto foundIt    = _propValueChanged.find(propertyId);
+
+    if (foundIt != _propValueChanged.end())
+    {
+        auto signal         = foundIt->second;
+        auto propertyName   = _properties.at(propertyId).name;
 
-    if (_propValueChanged.count(formatedPropertyName) != 0)
-        propertyValueChanged(formatedPropertyName)->execute(shared_from_this(), formatedPropertyName);
+        signal->execute(shared_from_this(), propertyName);
+    }
 }
 
 void
-Container::providerReferenceChangedHandler(Provider::Ptr        provider,
-                                           const std::string&    propertyName)
+Container::providerReferenceChangedHandler(Provider::Ptr    provider,
+                                           uint             providerPropertyId)
 {
-    auto formatedPropertyName = formatPropertyName(provider, propertyName);
+    auto propertyId = this->propertyId(provider, providerPropertyId);
+    auto foundIt    = _propReferenceChanged.find(propertyId);
+
+    if (foundIt != _propReferenceChanged.end())
+    {
+        auto signal         = foundIt->second;
+        auto propertyName   = _properties.at(propertyId).name;
 
-    if (_propReferenceChanged.count(formatedPropertyName))
-        propertyReferenceChanged(formatedPropertyName)->execute(shared_from_this(), formatedPropertyName);
+        signal->execute(shared_from_this(), propertyName);
+    }
 }
 
 void
 Container::providerPropertyAddedHandler(std::shared_ptr<Provider>     provider,
                                         const std::string&             propertyName)
 {
-    auto formatedPropertyName = formatPropertyName(provider, propertyName);
+    auto formatedPropertyName   = formatPropertyName(provider, propertyName);
+    auto propertyId             = PropertyId::get(formatedPropertyName);
 
-    if (_propertyNameToProvider.count(formatedPropertyName) != 0)
+    if (_properties.count(propertyId) != 0)
         throw std::logic_error("duplicate property name: " + formatedPropertyName);
 
-    _propertyNameToProvider[formatedPropertyName] = provider;
+    PropertySlot property = { provider, PropertyId::get(propertyName), formatedPropertyName };
 
-    if (_propValueChanged.count(formatedPropertyName) != 0)
-        _providerValueChangedSlot[provider] = provider->propertyValueChanged()->connect(std::bind(
+    _properties[propertyId] = property;
+    _providerToPropertyIds[provider][property.propertyId] = propertyId;
+
+    if (_propValueChanged.count(propertyId) != 0)
+        _providerValueChangedSlot[provider] = provider->propertyIdValueChanged()->connect(std::bind(
             &Container::providerValueChangedHandler,
             shared_from_this(),
             std::placeholders::_1,
@@ -316,7 +384,7 @@ Container::providerPropertyAddedHandler(std::shared_ptr<Provider>     provider,
 
     _propertyAdded->execute(shared_from_this(), formatedPropertyName);
 
-    providerValueChangedHandler(provider, formatedPropertyName);
+    providerValueChangedHandler(provider, property.propertyId);
 }
 
 void
@@ -324,17 +392,19 @@ Container::providerPropertyRemovedHandler(std::shared_ptr<Provider> provider,
                                           const std::string&        propertyName)
 {
 
-    auto formatedPropertyName = formatPropertyName(provider, propertyName);
+    auto formatedPropertyName   = formatPropertyName(provider, propertyName);
+    auto propertyId             = PropertyId::find(formatedPropertyName);
 
-    if (_propertyNameToProvider.count(formatedPropertyName) != 0)
+    if (_properties.count(propertyId) != 0)
     {
-        _propertyNameToProvider.erase(formatedPropertyName);
+        _properties.erase(propertyId);
+        _providerToPropertyIds[provider].erase(PropertyId::find(propertyName));
 
-        if (_propValueChanged.count(formatedPropertyName) && _propValueChanged[formatedPropertyName]->numCallbacks() == 0)
-            _propValueChanged.erase(formatedPropertyName);
+        if (_propValueChanged.count(propertyId) && _propValueChanged[propertyId]->numCallbacks() == 0)
+            _propValueChanged.erase(propertyId);
 
-        if (_propReferenceChanged.count(formatedPropertyName) && _propReferenceChanged[formatedPropertyName]->numCallbacks() == 0)
-            _propReferenceChanged.erase(formatedPropertyName);
+        if (_propReferenceChanged.count(propertyId) && _propReferenceChanged[propertyId]->numCallbacks() == 0)
+            _propReferenceChanged.erase(propertyId);
 
         //_propValueChanged.erase(propertyName);
         //_propReferenceChanged.erase(propertyName);
@@ -374,42 +444,6 @@ Container::formatPropertyName(ProviderPtr provider, const std::string& propertyN
 #endif // MINKO_NO_GLSL_STRUCT
 }
 
-std::string
-Container::unformatPropertyName(ProviderPtr provider, const std::string& formattedPropertyName) const
-{
-
-    auto arrayProvider = std::dynamic_pointer_cast<ArrayProvider>(provider);
-
-    if (arrayProvider == nullptr)
-        return formattedPropertyName;
-
-    if (formattedPropertyName.substr(0, arrayProvider->arrayName().size()) != arrayProvider->arrayName())
-        return unformatPropertyName(provider, formattedPropertyName);
-
-#ifndef MINKO_NO_GLSL_STRUCT
-
-    std::size_t pos = formattedPropertyName.rfind("].");
-
-    if (pos == std::string::npos)
-        return unformatPropertyName(provider, formattedPropertyName);
-
-    return formattedPropertyName.substr(pos + 2);
-
-#else
-
-    std::size_t pos1 = formattedPropertyName.find_first_of(NO_STRUCT_SEP);
-    std::size_t pos2 = formattedPropertyName.find_first_of('[');
-
-    if (pos1 == std::string::npos || pos2 == std::string::npos)
-        return unformatPropertyName(provider, formattedPropertyName);
-
-    pos1 += NO_STRUCT_SEP.size();
-
-    return formattedPropertyName.substr(pos1, pos2 - pos1);
-
-#endif // MINKO_NO_GLSL_STRUCT
-}
-
 Container::Ptr
 Container::filter(const std::set<data::AbstractFilter::Ptr>&    filters,
                   Container::Ptr                                output) const
@@ -454,9 +488,9 @@ Container::filter(const std::set<data::AbstractFilter::Ptr>&    filters,
 bool
 Container::isLengthProperty(const std::string& propertyName) const
 {
-    auto foundProviderIt = _propertyNameToProvider.find(propertyName);
+    auto foundPropertyIt = _properties.find(PropertyId::find(propertyName));
 
-    return foundProviderIt == _propertyNameToProvider.end()
+    return foundPropertyIt == _properties.end()
         ? false
-        : foundProviderIt->second.get() == _arrayLengths.get();
+        : foundPropertyIt->second.provider.get() == _arrayLengths.get();
 }
\ No newline at end of file
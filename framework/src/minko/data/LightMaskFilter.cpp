@@ -111,7 +111,7 @@ LightMaskFilter::lightsChangedHandler()
 
     auto withLights    = NodeSet::create(_root)
         ->descendants(true)
-        ->where([](Node::Ptr n){ return n->hasComponent<AbstractLight>(); });
+        ->withComponents<AbstractLight>();
 
     for (auto& n : withLights->nodes())
     {
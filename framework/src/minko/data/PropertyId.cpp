@@ -0,0 +1,86 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/data/PropertyId.hpp"
+
+using namespace minko;
+using namespace minko::data;
+
+/*static*/ const uint PropertyId::UNDEFINED = -1;
+
+/*static*/
+PropertyId::Registry&
+PropertyId::registry()
+{
+    // function-local so that ids can be interned during the static initialization of other units
+    static Registry registry;
+
+    return registry;
+}
+
+/*static*/
+uint
+PropertyId::get(const std::string& name)
+{
+    auto& registry  = PropertyId::registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto  foundIt   = registry.ids.find(name);
+
+    if (foundIt != registry.ids.end())
+        return foundIt->second;
+
+    uint id = registry.names.size();
+
+    registry.ids[name] = id;
+    registry.names.push_back(name);
+
+    return id;
+}
+
+/*static*/
+uint
+PropertyId::find(const std::string& name)
+{
+    auto& registry  = PropertyId::registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto  foundIt   = registry.ids.find(name);
+
+    return foundIt != registry.ids.end() ? foundIt->second : UNDEFINED;
+}
+
+/*static*/
+const std::string&
+PropertyId::name(uint id)
+{
+    auto& registry  = PropertyId::registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    // the reference outlives the lock: the deque never moves its elements
+    return registry.names[id];
+}
+
+/*static*/
+uint
+PropertyId::numIds()
+{
+    auto& registry  = PropertyId::registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    return registry.names.size();
+}
@@ -27,27 +27,102 @@ using namespace minko::data;
 Provider::Provider() :
     enable_shared_from_this(),
     _names(),
+    _ids(),
     _values(),
+    _idToSlot(),
     _valueChangedSlots(),
-    _referenceChangedSlots(),
+    _updateDepth(0),
+    _pendingChanges(),
+    _pendingChangesOrder(),
     _propertyAdded(Signal<Ptr, const std::string&>::create()),
     _propValueChanged(Signal<Ptr, const std::string&>::create()),
     _propReferenceChanged(Signal<Ptr, const std::string&>::create()),
-    _propertyRemoved(Signal<Ptr, const std::string&>::create())
+    _propertyRemoved(Signal<Ptr, const std::string&>::create()),
+    _propIdValueChanged(Signal<Ptr, uint>::create()),
+    _propIdReferenceChanged(Signal<Ptr, uint>::create())
 {
 }
 
+static const unsigned char VALUE_CHANGED        = 1;
+static const unsigned char REFERENCE_CHANGED    = 2;
+
+void
+Provider::propertyChanged(uint propertyId, bool referenceChanged)
+{
+    if (_updateDepth != 0)
+    {
+        auto& flags = _pendingChanges[propertyId];
+
+        if (flags == 0)
+            _pendingChangesOrder.push_back(propertyId);
+        flags |= referenceChanged ? VALUE_CHANGED | REFERENCE_CHANGED : VALUE_CHANGED;
+
+        return;
+    }
+
+    notifyPropertyChanged(propertyId, referenceChanged);
+}
+
+void
+Provider::notifyPropertyChanged(uint propertyId, bool referenceChanged)
+{
+    auto that = shared_from_this();
+    // copied: the listeners might add or remove properties and move the slots around
+    auto name = _names[_idToSlot[propertyId]];
+
+    if (referenceChanged)
+    {
+        _propIdReferenceChanged->execute(that, propertyId);
+        _propReferenceChanged->execute(that, name);
+    }
+    _propIdValueChanged->execute(that, propertyId);
+    _propValueChanged->execute(that, name);
+}
+
+void
+Provider::endUpdate()
+{
+    if (_updateDepth == 0)
+        throw std::logic_error("endUpdate() called without a matching beginUpdate().");
+
+    if (--_updateDepth != 0 || _pendingChangesOrder.empty())
+        return;
+
+    // listeners might start a new update, so the pending changes are moved out first
+    auto pendingChanges         = std::move(_pendingChanges);
+    auto pendingChangesOrder    = std::move(_pendingChangesOrder);
+    auto that                   = shared_from_this(); // the listeners might release the provider
+
+    _pendingChanges.clear();
+    _pendingChangesOrder.clear();
+
+    for (auto propertyId : pendingChangesOrder)
+    {
+        // the property might have been unset since it was written
+        if (!hasProperty(propertyId))
+            continue;
+
+        notifyPropertyChanged(propertyId, (pendingChanges[propertyId] & REFERENCE_CHANGED) != 0);
+    }
+}
+
 Provider::Ptr
 Provider::unset(const std::string& propertyName)
 {
-    const auto& formattedPropertyName = formatPropertyName(propertyName);
+    auto propertyId = PropertyId::find(formatPropertyName(propertyName));
+    auto slot       = this->slot(propertyId);
 
-    if (_values.count(formattedPropertyName) != 0)
+    if (slot >= 0)
     {
-        _names.erase(std::find(_names.begin(), _names.end(), formattedPropertyName));
-        _values.erase(formattedPropertyName);
-        _valueChangedSlots.erase(formattedPropertyName);
-        _referenceChangedSlots.erase(formattedPropertyName);
+        const auto formattedPropertyName = _names[slot];
+
+        _names.erase(_names.begin() + slot);
+        _ids.erase(_ids.begin() + slot);
+        _values.erase(_values.begin() + slot);
+        _idToSlot.erase(propertyId);
+        for (uint i = slot; i < _ids.size(); ++i)
+            _idToSlot[_ids[i]] = i;
+        _valueChangedSlots.erase(propertyId);
 
         _propertyRemoved->execute(shared_from_this(), formattedPropertyName);
     }
@@ -60,37 +135,43 @@ Provider::swap(const std::string& propertyName1, const std::string& propertyName
 {
     auto formattedPropertyName1    = skipPropertyNameFormatting ? propertyName1 : formatPropertyName(propertyName1);
     auto formattedPropertyName2    = skipPropertyNameFormatting ? propertyName2 : formatPropertyName(propertyName2);
-    auto hasProperty1            = hasProperty(formattedPropertyName1, true);
-    auto hasProperty2            = hasProperty(formattedPropertyName2, true);
+    auto propertyId1               = PropertyId::get(formattedPropertyName1);
+    auto propertyId2               = PropertyId::get(formattedPropertyName2);
+    auto hasProperty1              = hasProperty(propertyId1);
+    auto hasProperty2              = hasProperty(propertyId2);
 
     if (!hasProperty1 && !hasProperty2)
         throw;
 
     if (!hasProperty1 || !hasProperty2)
     {
-        auto source = hasProperty1 ? formattedPropertyName1 : formattedPropertyName2;
-        auto destination = hasProperty1 ? formattedPropertyName2 : formattedPropertyName1;
-        auto namesIt = std::find(_names.begin(), _names.end(), source);
-
-        *namesIt = destination;
-
-        _values[destination] = _values[source];
-        _values.erase(source);
-
-        _valueChangedSlots[destination] = _valueChangedSlots[source];
-        _valueChangedSlots.erase(source);
+        auto source         = hasProperty1 ? formattedPropertyName1 : formattedPropertyName2;
+        auto destination    = hasProperty1 ? formattedPropertyName2 : formattedPropertyName1;
+        auto sourceId       = hasProperty1 ? propertyId1 : propertyId2;
+        auto destinationId  = hasProperty1 ? propertyId2 : propertyId1;
+        auto slot           = _idToSlot[sourceId];
+
+        _names[slot] = destination;
+        _ids[slot] = destinationId;
+        _idToSlot.erase(sourceId);
+        _idToSlot[destinationId] = slot;
+
+        if (_valueChangedSlots.count(sourceId) != 0)
+        {
+            _valueChangedSlots[destinationId] = _valueChangedSlots[sourceId];
+            _valueChangedSlots.erase(sourceId);
+        }
 
         _propertyRemoved->execute(shared_from_this(), source);
         _propertyAdded->execute(shared_from_this(), destination);
     }
     else
     {
-        const auto    value1    = _values[formattedPropertyName1];
-        const auto    value2    = _values[formattedPropertyName2];
+        auto&         value1    = _values[_idToSlot[propertyId1]];
+        auto&         value2    = _values[_idToSlot[propertyId2]];
         const bool    changed = true;//!( (*value1) == (*value2) );
 
-        _values[formattedPropertyName1] = value2;
-        _values[formattedPropertyName2] = value1;
+        value1.swap(value2);
 
         _propValueChanged->execute(shared_from_this(), formattedPropertyName1);
         _propValueChanged->execute(shared_from_this(), formattedPropertyName2);
@@ -108,13 +189,9 @@ Provider::swap(const std::string& propertyName1, const std::string& propertyName
 bool
 Provider::hasProperty(const std::string& name, bool skipPropertyNameFormatting) const
 {
-    auto it = std::find(
-        _names.begin(),
-        _names.end(),
-        skipPropertyNameFormatting ? name : formatPropertyName(name)
-    );
+    auto propertyId = PropertyId::find(skipPropertyNameFormatting ? name : formatPropertyName(name));
 
-    return it != _names.end();
+    return propertyId != PropertyId::UNDEFINED && hasProperty(propertyId);
 }
 
 /*virtual*/
@@ -132,8 +209,10 @@ Provider::clone()
 Provider::Ptr
 Provider::copyFrom(Provider::Ptr source)
 {
-    _names    = source->_names;
-    _values = source->_values;
+    _names      = source->_names;
+    _ids        = source->_ids;
+    _values     = source->_values;
+    _idToSlot   = source->_idToSlot;
 
     return shared_from_this();
 }
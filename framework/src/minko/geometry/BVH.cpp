@@ -0,0 +1,361 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/geometry/BVH.hpp"
+#include "minko/math/Ray.hpp"
+
+using namespace minko;
+using namespace minko::math;
+using namespace minko::geometry;
+
+namespace
+{
+    const uint NUM_BINS = 12;
+    // deeper nodes are made leaves, which bounds the size of the traversal stack
+    const uint MAX_DEPTH = 64;
+
+    struct Bounds
+    {
+        float min[3];
+        float max[3];
+
+        inline
+        void
+        reset()
+        {
+            min[0] = min[1] = min[2] = std::numeric_limits<float>::max();
+            max[0] = max[1] = max[2] = -std::numeric_limits<float>::max();
+        }
+
+        inline
+        void
+        grow(const float* point)
+        {
+            for (uint i = 0; i < 3; ++i)
+            {
+                min[i] = std::min(min[i], point[i]);
+                max[i] = std::max(max[i], point[i]);
+            }
+        }
+
+        inline
+        void
+        grow(const Bounds& bounds)
+        {
+            for (uint i = 0; i < 3; ++i)
+            {
+                min[i] = std::min(min[i], bounds.min[i]);
+                max[i] = std::max(max[i], bounds.max[i]);
+            }
+        }
+
+        inline
+        float
+        area() const
+        {
+            if (max[0] < min[0])
+                return 0.f;
+
+            const float x = max[0] - min[0];
+            const float y = max[1] - min[1];
+            const float z = max[2] - min[2];
+
+            return x * y + y * z + z * x;
+        }
+    };
+
+    struct BuildTask
+    {
+        uint nodeId;
+        uint begin;
+        uint end;
+        uint depth;
+    };
+}
+
+BVH::BVH() :
+    _nodes(),
+    _triangles(),
+    _vertices()
+{
+}
+
+void
+BVH::build(const float*             vertices,
+           uint                     vertexSize,
+           uint                     positionOffset,
+           const unsigned short*    indices,
+           uint                     numIndices,
+           uint                     maxLeafSize)
+{
+    const uint numTriangles = numIndices / 3;
+
+    _nodes.clear();
+    _triangles.clear();
+    _vertices.clear();
+
+    if (numTriangles == 0)
+        return;
+
+    maxLeafSize = std::max(maxLeafSize, 1u);
+
+    std::vector<Bounds> triangleBounds(numTriangles);
+    std::vector<float> centroids(numTriangles * 3);
+    std::vector<uint> order(numTriangles);
+
+    for (uint i = 0; i < numTriangles; ++i)
+    {
+        auto& bounds = triangleBounds[i];
+
+        bounds.reset();
+        for (uint j = 0; j < 3; ++j)
+            bounds.grow(vertices + indices[i * 3 + j] * vertexSize + positionOffset);
+
+        for (uint j = 0; j < 3; ++j)
+            centroids[i * 3 + j] = (bounds.min[j] + bounds.max[j]) * .5f;
+        order[i] = i;
+    }
+
+    _nodes.reserve(numTriangles * 2);
+    _nodes.resize(1);
+
+    std::vector<BuildTask> tasks;
+    BuildTask root = { 0, 0, numTriangles, 0 };
+
+    tasks.push_back(root);
+    while (!tasks.empty())
+    {
+        auto task = tasks.back();
+        Bounds bounds;
+        Bounds centroidBounds;
+
+        tasks.pop_back();
+        bounds.reset();
+        centroidBounds.reset();
+        for (auto i = task.begin; i < task.end; ++i)
+        {
+            bounds.grow(triangleBounds[order[i]]);
+            centroidBounds.grow(&centroids[order[i] * 3]);
+        }
+
+        auto& node = _nodes[task.nodeId];
+        const auto count = task.end - task.begin;
+
+        std::copy(bounds.min, bounds.min + 3, node.min);
+        std::copy(bounds.max, bounds.max + 3, node.max);
+        node.first = task.begin;
+        node.count = count;
+
+        if (count <= maxLeafSize || task.depth >= MAX_DEPTH)
+            continue;
+
+        uint axis = 0;
+
+        for (uint i = 1; i < 3; ++i)
+            if (centroidBounds.max[i] - centroidBounds.min[i] > centroidBounds.max[axis] - centroidBounds.min[axis])
+                axis = i;
+
+        const float axisMin = centroidBounds.min[axis];
+        const float axisExtent = centroidBounds.max[axis] - axisMin;
+
+        if (axisExtent <= 0.f)
+            continue;
+
+        // bin the centroids along the largest axis, then evaluate the surface area heuristic at
+        // the boundaries between bins
+        Bounds binBounds[NUM_BINS];
+        uint binCounts[NUM_BINS] = { 0 };
+        const float binScale = NUM_BINS / axisExtent;
+        auto binIndex = [&](uint triangle)
+        {
+            return std::min(NUM_BINS - 1, (uint)((centroids[triangle * 3 + axis] - axisMin) * binScale));
+        };
+
+        for (auto& binBound : binBounds)
+            binBound.reset();
+        for (auto i = task.begin; i < task.end; ++i)
+        {
+            auto bin = binIndex(order[i]);
+
+            binBounds[bin].grow(triangleBounds[order[i]]);
+            ++binCounts[bin];
+        }
+
+        float leftCosts[NUM_BINS - 1];
+        Bounds accumulated;
+        uint accumulatedCount = 0;
+
+        accumulated.reset();
+        for (uint i = 0; i < NUM_BINS - 1; ++i)
+        {
+            accumulated.grow(binBounds[i]);
+            accumulatedCount += binCounts[i];
+            leftCosts[i] = accumulated.area() * accumulatedCount;
+        }
+
+        float bestCost = std::numeric_limits<float>::max();
+        uint bestSplit = 0;
+
+        accumulated.reset();
+        accumulatedCount = 0;
+        for (uint i = NUM_BINS - 1; i > 0; --i)
+        {
+            accumulated.grow(binBounds[i]);
+            accumulatedCount += binCounts[i];
+
+            const float cost = leftCosts[i - 1] + accumulated.area() * accumulatedCount;
+
+            if (cost < bestCost)
+            {
+                bestCost = cost;
+                bestSplit = i;
+            }
+        }
+
+        // a traversal step costs about as much as a triangle test
+        const float area = bounds.area();
+
+        if (area > 0.f && 1.f + bestCost / area >= (float)count)
+            continue;
+
+        auto middle = std::partition(
+            order.begin() + task.begin,
+            order.begin() + task.end,
+            [&](uint triangle) { return binIndex(triangle) < bestSplit; }
+        ) - order.begin();
+
+        if (middle == task.begin || middle == task.end)
+            continue;
+
+        const uint firstChild = _nodes.size();
+
+        node.first = firstChild;
+        node.count = 0;
+        _nodes.resize(firstChild + 2);
+
+        BuildTask right = { firstChild + 1, (uint)middle, task.end, task.depth + 1 };
+        BuildTask left = { firstChild, task.begin, (uint)middle, task.depth + 1 };
+
+        tasks.push_back(right);
+        tasks.push_back(left);
+    }
+
+    _triangles.resize(numTriangles);
+    _vertices.resize(numTriangles * 9);
+    for (uint i = 0; i < numTriangles; ++i)
+    {
+        _triangles[i] = order[i] * 3;
+        for (uint j = 0; j < 3; ++j)
+        {
+            const float* position = vertices + indices[order[i] * 3 + j] * vertexSize + positionOffset;
+
+            std::copy(position, position + 3, &_vertices[i * 9 + j * 3]);
+        }
+    }
+}
+
+bool
+BVH::cast(const Vec3&   origin,
+          const Vec3&   direction,
+          float&        distance,
+          uint&         triangle,
+          float&        u,
+          float&        v) const
+{
+    if (_nodes.empty())
+        return false;
+
+    const Vec3 invDirection = { 1.f / direction.x, 1.f / direction.y, 1.f / direction.z };
+    std::pair<uint, float> stack[MAX_DEPTH + 2];
+    uint stackSize = 0;
+    float near;
+    float far;
+    auto hit = false;
+    auto minDistance = std::numeric_limits<float>::infinity();
+
+    if (!Ray::intersectBox(origin, invDirection, _nodes[0].min, _nodes[0].max, near, far))
+        return false;
+
+    stack[stackSize++] = std::make_pair(0u, near);
+    while (stackSize != 0)
+    {
+        const auto entry = stack[--stackSize];
+
+        if (entry.second > minDistance)
+            continue;
+
+        const auto& node = _nodes[entry.first];
+
+        if (node.count != 0)
+        {
+            for (auto i = node.first; i < node.first + node.count; ++i)
+            {
+                const float* p = &_vertices[i * 9];
+                const Vec3 v0 = { p[0], p[1], p[2] };
+                const Vec3 v1 = { p[3], p[4], p[5] };
+                const Vec3 v2 = { p[6], p[7], p[8] };
+                float t;
+                float hitU;
+                float hitV;
+
+                if (intersectTriangle(origin, direction, v0, v1, v2, t, hitU, hitV) && t < minDistance)
+                {
+                    minDistance = t;
+                    triangle = _triangles[i];
+                    u = hitU;
+                    v = hitV;
+                    hit = true;
+                }
+            }
+
+            continue;
+        }
+
+        // the nearest child is pushed last to be visited first
+        const auto& left = _nodes[node.first];
+        const auto& right = _nodes[node.first + 1];
+        float leftNear;
+        float rightNear;
+        const bool hitLeft = Ray::intersectBox(origin, invDirection, left.min, left.max, leftNear, far) && leftNear <= minDistance;
+        const bool hitRight = Ray::intersectBox(origin, invDirection, right.min, right.max, rightNear, far) && rightNear <= minDistance;
+
+        if (hitLeft && hitRight)
+        {
+            if (leftNear < rightNear)
+            {
+                stack[stackSize++] = std::make_pair(node.first + 1, rightNear);
+                stack[stackSize++] = std::make_pair(node.first, leftNear);
+            }
+            else
+            {
+                stack[stackSize++] = std::make_pair(node.first, leftNear);
+                stack[stackSize++] = std::make_pair(node.first + 1, rightNear);
+            }
+        }
+        else if (hitLeft)
+            stack[stackSize++] = std::make_pair(node.first, leftNear);
+        else if (hitRight)
+            stack[stackSize++] = std::make_pair(node.first + 1, rightNear);
+    }
+
+    if (hit)
+        distance = minDistance;
+
+    return hit;
+}
@@ -19,6 +19,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 #include "minko/geometry/Geometry.hpp"
 
+#include "minko/geometry/BVH.hpp"
 #include "minko/math/Vector2.hpp"
 #include "minko/math/Vector3.hpp"
 #include "minko/math/Ray.hpp"
@@ -34,7 +35,9 @@ Geometry::Geometry() :
     _data(data::ArrayProvider::create("geometry")),
     _vertexSize(0),
     _numVertices(0),
-    _indexBuffer(nullptr)
+    _indexBuffer(nullptr),
+    _useBVH(true),
+    _bvh(nullptr)
 {
 }
 
@@ -43,7 +46,9 @@ Geometry::Geometry(const Geometry& geometry) :
 	_vertexSize(geometry._vertexSize),
 	_numVertices(geometry._numVertices),
 	_vertexBuffers(geometry._vertexBuffers),
-	_indexBuffer(geometry._indexBuffer)
+	_indexBuffer(geometry._indexBuffer),
+	_useBVH(geometry._useBVH),
+	_bvh(geometry._bvh)
 {
 }
 
@@ -75,6 +80,7 @@ Geometry::addVertexBuffer(render::VertexBuffer::Ptr vertexBuffer)
         _numVertices = bufNumVertices;
 
     _vertexBuffers.push_back(vertexBuffer);
+    _bvh = nullptr;
 
     _vbToVertexSizeChangedSlot[vertexBuffer] = vertexBuffer->vertexSizeChanged()->connect(std::bind(
         &Geometry::vertexSizeChanged,
@@ -97,6 +103,7 @@ Geometry::removeVertexBuffer(std::list<render::VertexBuffer::Ptr>::iterator vert
     _data->set("vertex.size", _vertexSize);
 
     _vertexBuffers.erase(vertexBufferIt);
+    _bvh = nullptr;
 
     if (_vertexBuffers.size() == 0)
         _numVertices = 0;
@@ -295,6 +302,14 @@ Geometry::removeDuplicatedVertices()
         vertices.push_back(vb->data());
 
     removeDuplicatedVertices(_indexBuffer->data(),    vertices, numVertices());
+
+    auto vertexBufferData = vertices.begin();
+
+    for (auto vb : _vertexBuffers)
+        vb->data().swap(*vertexBufferData++);
+
+    _numVertices = _vertexBuffers.empty() ? 0 : _vertexBuffers.front()->numVertices();
+    _bvh = nullptr;
 }
 
 void
@@ -302,31 +317,53 @@ Geometry::removeDuplicatedVertices(std::vector<unsigned short>&        indices,
                                    std::vector<std::vector<float>>&    vertices,
                                    uint                                numVertices)
 {
-    auto newVertexCount = 0;
-    auto newLimit = 0;
-
-    std::unordered_map<std::string, uint> hashToNewVertexId;
-    std::unordered_map<uint, uint> oldVertexIdToNewVertexId;
+    if (numVertices == 0)
+        return;
 
-    for (uint oldVertexId = 0; oldVertexId < numVertices; ++oldVertexId)
+    // vertices are keyed by their id in the compacted buffers: a vertex is compared to the kept ones
+    // with the bits of its attributes instead of a string built from them
+    auto hashVertex = [&](uint vertexId)
     {
-        std::string hash;
+        std::size_t hash = 0;
 
         for (auto& vb : vertices)
         {
             auto vertexSize = vb.size() / numVertices;
+            auto values = reinterpret_cast<const uint*>(&vb[vertexId * vertexSize]);
 
             for (uint i = 0; i < vertexSize; ++i)
-                hash += std::to_string(vb[oldVertexId * vertexSize + i]) + " ";
+                hash ^= std::hash<uint>()(values[i]) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
         }
 
-        auto newVertexId = 0;
+        return hash;
+    };
+    auto equalVertices = [&](uint vertexId1, uint vertexId2)
+    {
+        for (auto& vb : vertices)
+        {
+            auto vertexSize = vb.size() / numVertices;
 
-        if (!hashToNewVertexId.count(hash))
+            if (std::memcmp(&vb[vertexId1 * vertexSize], &vb[vertexId2 * vertexSize], vertexSize * sizeof(float)) != 0)
+                return false;
+        }
+
+        return true;
+    };
+
+    std::unordered_set<uint, decltype(hashVertex), decltype(equalVertices)> newVertexIds(
+        numVertices, hashVertex, equalVertices
+    );
+    std::vector<uint> oldVertexIdToNewVertexId(numVertices);
+    uint newVertexCount = 0;
+
+    for (uint oldVertexId = 0; oldVertexId < numVertices; ++oldVertexId)
+    {
+        auto newVertexIt = newVertexIds.find(oldVertexId);
+        uint newVertexId;
+
+        if (newVertexIt == newVertexIds.end())
         {
             newVertexId = newVertexCount++;
-            hashToNewVertexId[hash] = newVertexId;
-            newLimit = 1 + newVertexId;
 
             if (newVertexId != oldVertexId)
             {
@@ -341,125 +378,122 @@ Geometry::removeDuplicatedVertices(std::vector<unsigned short>&        indices,
                     );
                 }
             }
+
+            newVertexIds.insert(newVertexId);
         }
         else
-            newVertexId = hashToNewVertexId[hash];
+            newVertexId = *newVertexIt;
 
         oldVertexIdToNewVertexId[oldVertexId] = newVertexId;
     }
 
     for (auto& vb : vertices)
-        vb.resize(newLimit * vb.size() / numVertices);
+        vb.resize(newVertexCount * vb.size() / numVertices);
 
     for (auto& index : indices)
         index = oldVertexIdToNewVertexId[index];
 }
 
+std::shared_ptr<BVH>
+Geometry::bvh()
+{
+    if (_bvh == nullptr)
+    {
+        auto xyzBuffer = vertexBuffer("position");
+        auto& indicesData = _indexBuffer->data();
+
+        _bvh = BVH::create(
+            xyzBuffer->data().data(),
+            xyzBuffer->vertexSize(),
+            std::get<2>(*xyzBuffer->attribute("position")),
+            indicesData.data(),
+            indicesData.size()
+        );
+    }
+
+    return _bvh;
+}
+
 bool
 Geometry::cast(std::shared_ptr<math::Ray>    ray,
                float&                        distance,
-               uint&                        triangle,
-               std::shared_ptr<Vector3>        hitXyz,
-               std::shared_ptr<Vector2>        hitUv,
-               std::shared_ptr<Vector3>        hitNormal)
+               uint&                         triangle,
+               std::shared_ptr<Vector3>      hitXyz,
+               std::shared_ptr<Vector2>      hitUv,
+               std::shared_ptr<Vector3>      hitNormal)
 {
-    static const auto EPSILON = 0.00001f;
+    auto origin = ray->origin()->toVec3();
+    auto direction = ray->direction()->toVec3();
+    auto u = 0.f;
+    auto v = 0.f;
+    auto hit = _useBVH
+        ? bvh()->cast(origin, direction, distance, triangle, u, v)
+        : castTriangles(origin, direction, distance, triangle, u, v);
+
+    if (!hit)
+        return false;
 
+    if (hitXyz)
+        hitXyz->copyFrom(origin + direction * distance);
+
+    if (hitUv)
+        getHitUv(triangle, u, v, hitUv);
+
+    if (hitNormal)
+        getHitNormal(triangle, u, v, hitNormal);
+
+    return true;
+}
+
+bool
+Geometry::castTriangles(const Vec3&     origin,
+                        const Vec3&     direction,
+                        float&          distance,
+                        uint&           triangle,
+                        float&          u,
+                        float&          v)
+{
     auto hit = false;
     auto& indicesData = _indexBuffer->data();
     auto numIndices = indicesData.size();
 
     auto xyzBuffer = vertexBuffer("position");
-    auto& xyzData = xyzBuffer->data();
-    auto xyzPtr = &xyzData[0];
+    auto xyzPtr = &xyzBuffer->data()[0] + std::get<2>(*xyzBuffer->attribute("position"));
     auto xyzVertexSize = xyzBuffer->vertexSize();
-    auto xyzOffset = std::get<2>(*xyzBuffer->attribute("position"));
 
     auto minDistance = std::numeric_limits<float>::infinity();
-    auto lambda = hitUv ? Vector2::create() : nullptr;
-    auto triangleIndice = -3;
-
-    auto v0 = Vector3::create();
-    auto v1 = Vector3::create();
-    auto v2 = Vector3::create();
-    auto edge1 = Vector3::create();
-    auto edge2 = Vector3::create();
-    auto pvec = Vector3::create();
-    auto tvec = Vector3::create();
-    auto qvec = Vector3::create();
-    auto dot = 0.f;
-    auto invDot = 0.f;
-    auto u = 0.f;
-    auto v = 0.f;
-    auto t = 0.f;
 
-    for (uint i = 0; i < numIndices; i += 3)
+    for (uint i = 0; i + 2 < numIndices; i += 3)
     {
-        v0->copyFrom(xyzPtr + indicesData[i] * xyzVertexSize);
-        v1->copyFrom(xyzPtr + indicesData[i + 1] * xyzVertexSize);
-        v2->copyFrom(xyzPtr + indicesData[i + 2] * xyzVertexSize);
-
-        edge1->copyFrom(v1)->subtract(v0);
-        edge2->copyFrom(v2)->subtract(v0);
-
-        pvec->copyFrom(ray->direction())->cross(edge2);
-        dot = edge1->dot(pvec);
-
-        if (dot > -EPSILON && dot < EPSILON)
-            continue;
-
-        invDot = 1.f / dot;
-
-        tvec->copyFrom(ray->origin())->subtract(v0);
-        u = tvec->dot(pvec) * invDot;
-        if (u < 0.f || u > 1.f)
-            continue;
-
-        qvec->copyFrom(tvec)->cross(edge1);
-        v = ray->direction()->dot(qvec) * invDot;
-        if (v < 0.f || u + v > 1.f)
-            continue;
-
-        t = edge2->dot(qvec) * invDot;
-        if (t < minDistance)
+        auto p0 = xyzPtr + indicesData[i] * xyzVertexSize;
+        auto p1 = xyzPtr + indicesData[i + 1] * xyzVertexSize;
+        auto p2 = xyzPtr + indicesData[i + 2] * xyzVertexSize;
+        Vec3 v0 = { p0[0], p0[1], p0[2] };
+        Vec3 v1 = { p1[0], p1[1], p1[2] };
+        Vec3 v2 = { p2[0], p2[1], p2[2] };
+        float t;
+        float hitU;
+        float hitV;
+
+        if (BVH::intersectTriangle(origin, direction, v0, v1, v2, t, hitU, hitV) && t < minDistance)
         {
             minDistance = t;
             distance = t;
             triangle = i;
+            u = hitU;
+            v = hitV;
             hit = true;
-
-            if (hitUv)
-            {
-                lambda->x(u);
-                lambda->y(v);
-            }
-
-            if (hitXyz)
-            {
-                hitXyz->setTo(
-                    ray->origin()->x() + minDistance * ray->direction()->x(),
-                    ray->origin()->y() + minDistance * ray->direction()->y(),
-                    ray->origin()->z() + minDistance * ray->direction()->z()
-                    );
-            }
         }
-
-        if (hitUv)
-            getHitUv(triangle, lambda, hitUv);
-
-        if (hitNormal)
-            getHitNormal(triangle, hitNormal);
     }
 
     return hit;
 }
 
 void
-Geometry::getHitUv(uint triangle, Vector2::Ptr lambda, Vector2::Ptr hitUv)
+Geometry::getHitUv(uint triangle, float u, float v, Vector2::Ptr hitUv)
 {
     auto uvBuffer = vertexBuffer("uv");
     auto& uvData = uvBuffer->data();
-    auto uvPtr = &uvData[0];
     auto uvVertexSize = uvBuffer->vertexSize();
     auto uvOffset = std::get<2>(*uvBuffer->attribute("uv"));
     auto& indicesData = _indexBuffer->data();
@@ -473,32 +507,35 @@ Geometry::getHitUv(uint triangle, Vector2::Ptr lambda, Vector2::Ptr hitUv)
     auto u2 = uvData[indicesData[triangle + 2] * uvVertexSize + uvOffset];
     auto v2 = uvData[indicesData[triangle + 2] * uvVertexSize + uvOffset + 1];
 
-    auto z = 1.f - lambda->x() - lambda->y();
+    auto z = 1.f - u - v;
 
     hitUv->setTo(
-        z * u0 + lambda->x() * u1 + lambda->y() * u2,
-        z * v0 + lambda->x() * v1 + lambda->y() * v2
+        z * u0 + u * u1 + v * u2,
+        z * v0 + u * v1 + v * v2
     );
 }
 
 void
-Geometry::getHitNormal(uint triangle, Vector3::Ptr hitNormal)
+Geometry::getHitNormal(uint triangle, float u, float v, Vector3::Ptr hitNormal)
 {
-    auto normalBuffer = vertexBuffer("normal");
-    auto& normalData = normalBuffer->data();
-    auto normalPtr = &normalData[0];
-    auto normalVertexSize = normalBuffer->vertexSize();
-    auto normalOffset = std::get<2>(*normalBuffer->attribute("normal"));
     auto& indicesData = _indexBuffer->data();
-
-    auto v0 = Vector3::create(normalPtr + indicesData[triangle] * normalVertexSize + normalOffset);
-    auto v1 = Vector3::create(normalPtr + indicesData[triangle] * normalVertexSize + normalOffset);
-    auto v2 = Vector3::create(normalPtr + indicesData[triangle] * normalVertexSize + normalOffset);
-
-    auto edge1 = Vector3::create(v1)->subtract(v0)->normalize();
-    auto edge2 = Vector3::create(v2)->subtract(v0)->normalize();
-
-    hitNormal->copyFrom(edge2)->cross(edge1);
+    auto hasNormals = hasVertexAttribute("normal");
+    auto attributeName = hasNormals ? "normal" : "position";
+    auto buffer = vertexBuffer(attributeName);
+    auto dataPtr = &buffer->data()[0] + std::get<2>(*buffer->attribute(attributeName));
+    auto vertexSize = buffer->vertexSize();
+    auto p0 = dataPtr + indicesData[triangle] * vertexSize;
+    auto p1 = dataPtr + indicesData[triangle + 1] * vertexSize;
+    auto p2 = dataPtr + indicesData[triangle + 2] * vertexSize;
+    Vec3 v0 = { p0[0], p0[1], p0[2] };
+    Vec3 v1 = { p1[0], p1[1], p1[2] };
+    Vec3 v2 = { p2[0], p2[1], p2[2] };
+
+    // vertex normals are interpolated, the face normal is used when there are none
+    if (hasNormals)
+        hitNormal->copyFrom((v0 * (1.f - u - v) + v1 * u + v2 * v).normalized());
+    else
+        hitNormal->copyFrom((v1 - v0).cross(v2 - v0).normalized());
 }
 
 void
@@ -22,6 +22,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include <minko/scene/Node.hpp>
 #include <minko/math/Matrix4x4.hpp>
 #include <minko/geometry/Bone.hpp>
+#include <minko/geometry/SkinClip.hpp>
 
 using namespace minko;
 using namespace minko::scene;
@@ -34,10 +35,14 @@ Skin::Skin(unsigned int numBones, unsigned int duration, unsigned int numFrames)
     _duration(duration),
     _timeFactor(duration > 0 ? numFrames / float(duration) : 0.0f),
     _boneMatricesPerFrame(numFrames, std::vector<float>(numBones << 4, 0.0f)),
+    _clip(nullptr),
     _maxNumVertexBones(0),
     _numVertexBones(),
     _vertexBones(),
-    _vertexBoneWeights()
+    _vertexBoneWeights(),
+    _packedNumVertices(0),
+    _packedVertexBones(),
+    _packedVertexBoneWeights()
 {
 
 }
@@ -48,14 +53,32 @@ Skin::Skin(const Skin& skin) :
 	_duration(skin._duration),
 	_timeFactor(skin._timeFactor),
 	_boneMatricesPerFrame(skin._boneMatricesPerFrame),
+	_clip(skin._clip),
 	_maxNumVertexBones(skin._maxNumVertexBones),
 	_numVertexBones(skin._numVertexBones),
 	_vertexBones(skin._vertexBones),
-	_vertexBoneWeights(skin._vertexBoneWeights)
+	_vertexBoneWeights(skin._vertexBoneWeights),
+	_packedNumVertices(skin._packedNumVertices),
+	_packedVertexBones(skin._packedVertexBones),
+	_packedVertexBoneWeights(skin._packedVertexBoneWeights)
 {
 
 }
 
+/*static*/
+Skin::Ptr
+Skin::create(unsigned int numBones, SkinClipPtr clip)
+{
+    if (clip == nullptr || clip->numBones() != numBones)
+        throw std::invalid_argument("clip");
+
+    auto skin = std::shared_ptr<Skin>(new Skin(numBones, clip->duration(), 0));
+
+    skin->_clip = clip;
+
+    return skin;
+}
+
 std::shared_ptr<Skin>
 Skin::clone()
 {
@@ -127,6 +150,19 @@ Skin::reorganizeByVertices()
     for (unsigned int vId = 0; vId < numVertices; ++vId)
         _maxNumVertexBones = std::max(_maxNumVertexBones, _numVertexBones[vId]);
 
+    _packedNumVertices = (numVertices + 7) & ~7u;
+    _packedVertexBones.assign(_maxNumVertexBones * _packedNumVertices, 0);
+    _packedVertexBoneWeights.assign(_maxNumVertexBones * _packedNumVertices, 0.0f);
+
+    for (unsigned int vId = 0; vId < numVertices; ++vId)
+        for (unsigned int j = 0; j < _numVertexBones[vId]; ++j)
+        {
+            const unsigned int index = vertexArraysIndex(vId, j);
+
+            _packedVertexBones[j * _packedNumVertices + vId]        = _vertexBones[index];
+            _packedVertexBoneWeights[j * _packedNumVertices + vId]  = _vertexBoneWeights[index];
+        }
+
     return shared_from_this();
 }
 
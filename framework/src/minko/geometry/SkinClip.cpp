@@ -0,0 +1,598 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "minko/geometry/SkinClip.hpp"
+
+using namespace minko;
+using namespace minko::geometry;
+
+namespace
+{
+    const float         SQRT2                   = 1.41421356f;
+    const unsigned int  QUANTIZATION_MAX        = 0x7fff;
+    const unsigned int  MAX_NUM_FRAMES          = 0x10000;
+    const unsigned int  MAX_KEY_INTERVAL        = 256;  // bounds the cost of the key reduction
+
+    // a = b * c for 3x4 row major affine matrices
+    inline
+    void
+    multiplyAffine(const float* b, const float* c, float* a)
+    {
+        for (unsigned int row = 0; row < 12; row += 4)
+        {
+            a[row]      = b[row] * c[0] + b[row + 1] * c[4] + b[row + 2] * c[8];
+            a[row + 1]  = b[row] * c[1] + b[row + 1] * c[5] + b[row + 2] * c[9];
+            a[row + 2]  = b[row] * c[2] + b[row + 1] * c[6] + b[row + 2] * c[10];
+            a[row + 3]  = b[row] * c[3] + b[row + 1] * c[7] + b[row + 2] * c[11] + b[row + 3];
+        }
+    }
+
+    // translation, rotation (x, y, z, w) and scale of a row major matrix without shear
+    void
+    decompose(const float* m, float* translation, float* rotation, float* scale)
+    {
+        translation[0] = m[3];
+        translation[1] = m[7];
+        translation[2] = m[11];
+
+        for (unsigned int column = 0; column < 3; ++column)
+            scale[column] = std::sqrt(
+                m[column] * m[column] + m[4 + column] * m[4 + column] + m[8 + column] * m[8 + column]
+            );
+
+        const float determinant = m[0] * (m[5] * m[10] - m[6] * m[9])
+            - m[1] * (m[4] * m[10] - m[6] * m[8])
+            + m[2] * (m[4] * m[9] - m[5] * m[8]);
+
+        if (determinant < 0.f)
+            scale[0] = -scale[0];
+
+        float r[9];
+
+        for (unsigned int row = 0; row < 3; ++row)
+            for (unsigned int column = 0; column < 3; ++column)
+                r[row * 3 + column] = scale[column] != 0.f ? m[row * 4 + column] / scale[column] : 0.f;
+
+        const float trace = r[0] + r[4] + r[8];
+
+        if (trace > 0.f)
+        {
+            const float s = .5f / std::sqrt(trace + 1.f);
+
+            rotation[0] = (r[7] - r[5]) * s;
+            rotation[1] = (r[2] - r[6]) * s;
+            rotation[2] = (r[3] - r[1]) * s;
+            rotation[3] = .25f / s;
+        }
+        else if (r[0] > r[4] && r[0] > r[8])
+        {
+            const float s = 2.f * std::sqrt(std::max(0.f, 1.f + r[0] - r[4] - r[8]));
+
+            rotation[0] = .25f * s;
+            rotation[1] = (r[1] + r[3]) / s;
+            rotation[2] = (r[2] + r[6]) / s;
+            rotation[3] = (r[7] - r[5]) / s;
+        }
+        else if (r[4] > r[8])
+        {
+            const float s = 2.f * std::sqrt(std::max(0.f, 1.f + r[4] - r[0] - r[8]));
+
+            rotation[0] = (r[1] + r[3]) / s;
+            rotation[1] = .25f * s;
+            rotation[2] = (r[5] + r[7]) / s;
+            rotation[3] = (r[2] - r[6]) / s;
+        }
+        else
+        {
+            const float s = 2.f * std::sqrt(std::max(0.f, 1.f + r[8] - r[0] - r[4]));
+
+            rotation[0] = (r[2] + r[6]) / s;
+            rotation[1] = (r[5] + r[7]) / s;
+            rotation[2] = .25f * s;
+            rotation[3] = (r[3] - r[1]) / s;
+        }
+    }
+
+    // "smallest three": the largest component is dropped and rebuilt from the 3 others, which lie in
+    // [-1/sqrt(2), 1/sqrt(2)] and are stored on 15 bits. The index of the dropped component uses the
+    // 16th bit of the first two values.
+    void
+    quantizeRotation(const float* q, unsigned short* out)
+    {
+        unsigned int largest = 0;
+
+        for (unsigned int i = 1; i < 4; ++i)
+            if (std::abs(q[i]) > std::abs(q[largest]))
+                largest = i;
+
+        const float sign = q[largest] < 0.f ? -1.f : 1.f;
+
+        for (unsigned int i = 0, j = 0; i < 4; ++i)
+        {
+            if (i == largest)
+                continue;
+
+            const float value = std::min(1.f, std::max(0.f, (sign * q[i] * SQRT2 + 1.f) * .5f));
+
+            out[j++] = (unsigned short)std::floor(value * QUANTIZATION_MAX + .5f);
+        }
+
+        out[0] |= (largest >> 1) << 15;
+        out[1] |= (largest & 1) << 15;
+    }
+
+    void
+    dequantizeRotation(const unsigned short* in, float* q)
+    {
+        const unsigned int  largest = ((in[0] >> 15) << 1) | (in[1] >> 15);
+        const unsigned int  values[3] = { in[0] & QUANTIZATION_MAX, in[1] & QUANTIZATION_MAX, in[2] };
+        float               sum = 0.f;
+
+        for (unsigned int i = 0, j = 0; i < 4; ++i)
+        {
+            if (i == largest)
+                continue;
+
+            q[i] = (values[j++] * (2.f / QUANTIZATION_MAX) - 1.f) / SQRT2;
+            sum += q[i] * q[i];
+        }
+
+        q[largest] = std::sqrt(std::max(0.f, 1.f - sum));
+    }
+
+    // lerp for translations and scales, normalized lerp along the shortest arc for rotations
+    inline
+    void
+    interpolate(const float* a, const float* b, float t, unsigned int size, float* out)
+    {
+        if (size == 4)
+        {
+            const float sign = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3] < 0.f ? -1.f : 1.f;
+            float       length = 0.f;
+
+            for (unsigned int i = 0; i < 4; ++i)
+            {
+                out[i] = a[i] + (sign * b[i] - a[i]) * t;
+                length += out[i] * out[i];
+            }
+
+            length = length > 0.f ? 1.f / std::sqrt(length) : 0.f;
+            for (unsigned int i = 0; i < 4; ++i)
+                out[i] *= length;
+        }
+        else
+            for (unsigned int i = 0; i < size; ++i)
+                out[i] = a[i] + (b[i] - a[i]) * t;
+    }
+
+    inline
+    float
+    distance(const float* a, const float* b, unsigned int size)
+    {
+        float result = 0.f;
+
+        // q and -q are the same rotation
+        if (size == 4 && a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3] < 0.f)
+        {
+            for (unsigned int i = 0; i < size; ++i)
+                result = std::max(result, std::abs(a[i] + b[i]));
+
+            return result;
+        }
+
+        for (unsigned int i = 0; i < size; ++i)
+            result = std::max(result, std::abs(a[i] - b[i]));
+
+        return result;
+    }
+
+    // Samples kept as keys so that interpolating between consecutive keys gives back every sample
+    // within 'tolerance': keys are added greedily, as late as possible.
+    void
+    reduceKeys(const std::vector<float>& samples, unsigned int size, float tolerance, std::vector<unsigned int>& keys)
+    {
+        const unsigned int numSamples = samples.size() / size;
+
+        keys.clear();
+        keys.push_back(0);
+
+        bool isConstant = true;
+
+        for (unsigned int k = 1; k < numSamples && isConstant; ++k)
+            isConstant = distance(&samples[0], &samples[k * size], size) <= tolerance;
+
+        if (isConstant)
+            return;
+
+        float value[4];
+        unsigned int start = 0;
+
+        for (unsigned int end = 2; end < numSamples; ++end)
+        {
+            bool fits = end - start <= MAX_KEY_INTERVAL;
+
+            for (unsigned int k = start + 1; k < end && fits; ++k)
+            {
+                interpolate(&samples[start * size], &samples[end * size], float(k - start) / float(end - start), size, value);
+                fits = distance(value, &samples[k * size], size) <= tolerance;
+            }
+
+            if (!fits)
+            {
+                start = end - 1;
+                keys.push_back(start);
+            }
+        }
+
+        keys.push_back(numSamples - 1);
+    }
+
+    // a = b * c, (x, y, z, w) quaternions
+    inline
+    void
+    multiplyQuaternions(const float* b, const float* c, float* a)
+    {
+        a[0] = b[3] * c[0] + b[0] * c[3] + b[1] * c[2] - b[2] * c[1];
+        a[1] = b[3] * c[1] - b[0] * c[2] + b[1] * c[3] + b[2] * c[0];
+        a[2] = b[3] * c[2] + b[0] * c[1] - b[1] * c[0] + b[2] * c[3];
+        a[3] = b[3] * c[3] - b[0] * c[0] - b[1] * c[1] - b[2] * c[2];
+    }
+
+    // row major 3x4 matrix of a local pose
+    void
+    composeMatrix(const float* localPose, float* matrix)
+    {
+        const float* translation    = localPose;
+        const float* scale          = localPose + 7;
+        const float x               = localPose[3];
+        const float y               = localPose[4];
+        const float z               = localPose[5];
+        const float w               = localPose[6];
+
+        matrix[0]   = (1.f - 2.f * (y * y + z * z)) * scale[0];
+        matrix[1]   = 2.f * (x * y - z * w) * scale[1];
+        matrix[2]   = 2.f * (x * z + y * w) * scale[2];
+        matrix[3]   = translation[0];
+        matrix[4]   = 2.f * (x * y + z * w) * scale[0];
+        matrix[5]   = (1.f - 2.f * (x * x + z * z)) * scale[1];
+        matrix[6]   = 2.f * (y * z - x * w) * scale[2];
+        matrix[7]   = translation[1];
+        matrix[8]   = 2.f * (x * z - y * w) * scale[0];
+        matrix[9]   = 2.f * (y * z + x * w) * scale[1];
+        matrix[10]  = (1.f - 2.f * (x * x + y * y)) * scale[2];
+        matrix[11]  = translation[2];
+    }
+
+    template <typename T>
+    inline
+    uint
+    vectorSize(const std::vector<T>& vector)
+    {
+        return vector.size() * sizeof(T);
+    }
+}
+
+SkinClip::SkinClip(const std::vector<int>& parentIds, uint duration, uint numFrames) :
+    _numBones(parentIds.size()),
+    _duration(duration),
+    _numFrames(numFrames),
+    _timeFactor(duration > 0 ? numFrames / float(duration) : 0.f),
+    _parentIds(parentIds),
+    _offsetMatrices(),
+    _translationTracks(),
+    _translationTimes(),
+    _translations(),
+    _rotationTracks(),
+    _rotationTimes(),
+    _rotations(),
+    _scaleTracks(),
+    _scaleTimes(),
+    _scales()
+{
+}
+
+/*static*/
+SkinClip::Ptr
+SkinClip::create(const std::vector<int>&                    parentIds,
+                 const std::vector<float>&                  offsetMatrices,
+                 uint                                       duration,
+                 const std::vector<std::vector<float>>&     localMatricesPerFrame,
+                 float                                      translationTolerance,
+                 float                                      rotationTolerance,
+                 float                                      scaleTolerance)
+{
+    const uint numBones = parentIds.size();
+
+    for (uint boneId = 0; boneId < numBones; ++boneId)
+        if (parentIds[boneId] >= (int)boneId)
+            throw std::invalid_argument("parentIds");
+
+    if (offsetMatrices.size() != numBones << 4)
+        throw std::invalid_argument("offsetMatrices");
+
+    if (localMatricesPerFrame.empty() || localMatricesPerFrame.size() > MAX_NUM_FRAMES)
+        throw std::invalid_argument("localMatricesPerFrame");
+
+    for (auto& localMatrices : localMatricesPerFrame)
+        if (localMatrices.size() != numBones << 4)
+            throw std::invalid_argument("localMatricesPerFrame");
+
+    auto clip = std::shared_ptr<SkinClip>(new SkinClip(parentIds, duration, localMatricesPerFrame.size()));
+
+    clip->compress(offsetMatrices, localMatricesPerFrame, translationTolerance, rotationTolerance, scaleTolerance);
+
+    return clip;
+}
+
+void
+SkinClip::compress(const std::vector<float>&                offsetMatrices,
+                   const std::vector<std::vector<float>>&   localMatricesPerFrame,
+                   float                                    translationTolerance,
+                   float                                    rotationTolerance,
+                   float                                    scaleTolerance)
+{
+    _offsetMatrices.resize(_numBones * 12);
+    for (uint boneId = 0; boneId < _numBones; ++boneId)
+        std::copy(&offsetMatrices[boneId << 4], &offsetMatrices[boneId << 4] + 12, &_offsetMatrices[boneId * 12]);
+
+    std::vector<float>          translations(_numFrames * 3);
+    std::vector<float>          rotations(_numFrames * 4);
+    std::vector<float>          scales(_numFrames * 3);
+    std::vector<unsigned short> quantizedRotations(_numFrames * 3);
+    std::vector<unsigned int>   keys;
+
+    _translationTracks.resize(_numBones);
+    _rotationTracks.resize(_numBones);
+    _scaleTracks.resize(_numBones);
+
+    for (uint boneId = 0; boneId < _numBones; ++boneId)
+    {
+        for (uint frameId = 0; frameId < _numFrames; ++frameId)
+        {
+            float rotation[4];
+
+            decompose(
+                &localMatricesPerFrame[frameId][boneId << 4],
+                &translations[frameId * 3],
+                rotation,
+                &scales[frameId * 3]
+            );
+
+            // keys are reduced on the rotations as they will be decoded
+            quantizeRotation(rotation, &quantizedRotations[frameId * 3]);
+            dequantizeRotation(&quantizedRotations[frameId * 3], &rotations[frameId * 4]);
+        }
+
+        reduceKeys(translations, 3, translationTolerance, keys);
+        _translationTracks[boneId].firstKey = _translationTimes.size();
+        _translationTracks[boneId].numKeys = keys.size();
+        for (auto frameId : keys)
+        {
+            _translationTimes.push_back(frameId);
+            _translations.insert(_translations.end(), &translations[frameId * 3], &translations[frameId * 3] + 3);
+        }
+
+        reduceKeys(rotations, 4, rotationTolerance, keys);
+        _rotationTracks[boneId].firstKey = _rotationTimes.size();
+        _rotationTracks[boneId].numKeys = keys.size();
+        for (auto frameId : keys)
+        {
+            _rotationTimes.push_back(frameId);
+            _rotations.insert(_rotations.end(), &quantizedRotations[frameId * 3], &quantizedRotations[frameId * 3] + 3);
+        }
+
+        reduceKeys(scales, 3, scaleTolerance, keys);
+        _scaleTracks[boneId].firstKey = _scaleTimes.size();
+        _scaleTracks[boneId].numKeys = keys.size();
+        for (auto frameId : keys)
+        {
+            _scaleTimes.push_back(frameId);
+            _scales.insert(_scales.end(), &scales[frameId * 3], &scales[frameId * 3] + 3);
+        }
+    }
+
+    _translationTimes.shrink_to_fit();
+    _translations.shrink_to_fit();
+    _rotationTimes.shrink_to_fit();
+    _rotations.shrink_to_fit();
+    _scaleTimes.shrink_to_fit();
+    _scales.shrink_to_fit();
+}
+
+uint
+SkinClip::memorySize() const
+{
+    return vectorSize(_parentIds) + vectorSize(_offsetMatrices)
+        + vectorSize(_translationTracks) + vectorSize(_translationTimes) + vectorSize(_translations)
+        + vectorSize(_rotationTracks) + vectorSize(_rotationTimes) + vectorSize(_rotations)
+        + vectorSize(_scaleTracks) + vectorSize(_scaleTimes) + vectorSize(_scales);
+}
+
+float
+SkinClip::frame(uint time) const
+{
+    return std::min(time * _timeFactor, float(_numFrames - 1));
+}
+
+void
+SkinClip::localMatrix(uint boneId, uint time, float* matrix) const
+{
+    float localPose[LOCAL_POSE_SIZE];
+
+    evaluateLocalPose(boneId, frame(time), localPose);
+    composeMatrix(localPose, matrix);
+}
+
+void
+SkinClip::localPose(uint time, float* localPose) const
+{
+    const float f = frame(time);
+
+    for (uint boneId = 0; boneId < _numBones; ++boneId)
+        evaluateLocalPose(boneId, f, localPose + boneId * LOCAL_POSE_SIZE);
+}
+
+void
+SkinClip::evaluateLocalPose(uint boneId, float frame, float* localPose) const
+{
+    float* translation  = localPose;
+    float* rotation     = localPose + 3;
+    float* scale        = localPose + 7;
+
+    // key before the frame and interpolation ratio towards the next one, if any
+    auto findKey = [frame](const Track& track, const std::vector<unsigned short>& times, float& ratio) -> uint
+    {
+        const auto  begin   = times.begin() + track.firstKey;
+        const auto  end     = begin + track.numKeys;
+        const uint  key     = std::upper_bound(begin + 1, end, frame) - begin - 1;
+
+        ratio = key + 1 < track.numKeys
+            ? (frame - begin[key]) / float(begin[key + 1] - begin[key])
+            : 0.f;
+
+        return track.firstKey + key;
+    };
+
+    float ratio;
+    uint key = findKey(_translationTracks[boneId], _translationTimes, ratio);
+
+    if (ratio > 0.f)
+        interpolate(&_translations[key * 3], &_translations[key * 3 + 3], ratio, 3, translation);
+    else
+        std::copy(&_translations[key * 3], &_translations[key * 3] + 3, translation);
+
+    key = findKey(_rotationTracks[boneId], _rotationTimes, ratio);
+    dequantizeRotation(&_rotations[key * 3], rotation);
+    if (ratio > 0.f)
+    {
+        float next[4];
+
+        dequantizeRotation(&_rotations[key * 3 + 3], next);
+        interpolate(rotation, next, ratio, 4, rotation);
+    }
+
+    key = findKey(_scaleTracks[boneId], _scaleTimes, ratio);
+    if (ratio > 0.f)
+        interpolate(&_scales[key * 3], &_scales[key * 3 + 3], ratio, 3, scale);
+    else
+        std::copy(&_scales[key * 3], &_scales[key * 3] + 3, scale);
+}
+
+void
+SkinClip::pose(uint time, std::vector<float>& skinningMatrices, std::vector<float>& worldMatrices) const
+{
+    const float f = frame(time);
+
+    skinningMatrices.resize(_numBones << 4);
+    worldMatrices.resize(_numBones * 12);
+
+    // parents come first: their world matrix is ready when their children are evaluated
+    for (uint boneId = 0; boneId < _numBones; ++boneId)
+    {
+        float localPose[LOCAL_POSE_SIZE];
+        float local[12];
+
+        evaluateLocalPose(boneId, f, localPose);
+        composeMatrix(localPose, local);
+        computeSkinningMatrix(boneId, local, &worldMatrices[0], &skinningMatrices[boneId << 4]);
+    }
+}
+
+void
+SkinClip::pose(const float* localPose, std::vector<float>& skinningMatrices, std::vector<float>& worldMatrices) const
+{
+    skinningMatrices.resize(_numBones << 4);
+    worldMatrices.resize(_numBones * 12);
+
+    for (uint boneId = 0; boneId < _numBones; ++boneId)
+    {
+        float local[12];
+
+        composeMatrix(localPose + boneId * LOCAL_POSE_SIZE, local);
+        computeSkinningMatrix(boneId, local, &worldMatrices[0], &skinningMatrices[boneId << 4]);
+    }
+}
+
+void
+SkinClip::computeSkinningMatrix(uint boneId, const float* local, float* worldMatrices, float* out) const
+{
+    float*  world   = worldMatrices + boneId * 12;
+    float   skinning[12];
+
+    if (_parentIds[boneId] < 0)
+        std::copy(local, local + 12, world);
+    else
+        multiplyAffine(worldMatrices + _parentIds[boneId] * 12, local, world);
+
+    multiplyAffine(world, &_offsetMatrices[boneId * 12], skinning);
+
+    // column major, as the transposed matrices of Skin
+    out[0] = skinning[0];   out[4] = skinning[1];   out[8] = skinning[2];    out[12] = skinning[3];
+    out[1] = skinning[4];   out[5] = skinning[5];   out[9] = skinning[6];    out[13] = skinning[7];
+    out[2] = skinning[8];   out[6] = skinning[9];   out[10] = skinning[10];  out[14] = skinning[11];
+    out[3] = 0.f;           out[7] = 0.f;           out[11] = 0.f;           out[15] = 1.f;
+}
+
+bool
+SkinClip::hasSameRig(const SkinClip& clip) const
+{
+    return _parentIds == clip._parentIds;
+}
+
+/*static*/
+void
+SkinClip::blendLocalPoses(const float* a, const float* b, float ratio, uint numBones, float* out)
+{
+    for (uint i = 0; i < numBones * LOCAL_POSE_SIZE; i += LOCAL_POSE_SIZE)
+    {
+        interpolate(a + i, b + i, ratio, 3, out + i);
+        interpolate(a + i + 3, b + i + 3, ratio, 4, out + i + 3);
+        interpolate(a + i + 7, b + i + 7, ratio, 3, out + i + 7);
+    }
+}
+
+/*static*/
+void
+SkinClip::addLocalPoses(const float* additive, const float* reference, float weight, uint numBones, float* out)
+{
+    static const float identity[4] = { 0.f, 0.f, 0.f, 1.f };
+
+    for (uint i = 0; i < numBones * LOCAL_POSE_SIZE; i += LOCAL_POSE_SIZE)
+    {
+        const float*    r       = reference + i + 3;
+        const float*    a       = additive + i + 3;
+        float           conjugate[4] = { -r[0], -r[1], -r[2], r[3] };
+        float           delta[4];
+        float           rotation[4];
+
+        for (uint j = 0; j < 3; ++j)
+        {
+            out[i + j] += weight * (additive[i + j] - reference[i + j]);
+            if (reference[i + 7 + j] != 0.f)
+                out[i + 7 + j] *= 1.f + weight * (additive[i + 7 + j] / reference[i + 7 + j] - 1.f);
+        }
+
+        // delta = additive * reference^-1, applied on top of the current rotation
+        multiplyQuaternions(a, conjugate, delta);
+        interpolate(identity, delta, weight, 4, delta);
+        multiplyQuaternions(delta, out + i + 3, rotation);
+        std::copy(rotation, rotation + 4, out + i + 3);
+    }
+}
@@ -0,0 +1,69 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "minko/geometry/SkinPoseCache.hpp"
+
+#include "minko/geometry/SkinClip.hpp"
+
+using namespace minko;
+using namespace minko::geometry;
+
+SkinPoseCache::SkinPoseCache(uint timeStep, uint maxNumPoses) :
+    _timeStep(std::max(timeStep, 1u)),
+    _maxNumPoses(maxNumPoses),
+    _poses(),
+    _worldMatrices(),
+    _numHits(0),
+    _numMisses(0)
+{
+}
+
+SkinPoseCache::PosePtr
+SkinPoseCache::pose(SkinClipPtr clip, uint time)
+{
+    const Key key(clip.get(), time / _timeStep);
+    auto it = _poses.find(key);
+
+    if (it != _poses.end())
+    {
+        ++_numHits;
+
+        return it->second.matrices;
+    }
+
+    ++_numMisses;
+
+    if (_poses.size() >= _maxNumPoses)
+        return nullptr;
+
+    auto& entry = _poses[key];
+
+    entry.clip = clip;
+    entry.matrices = std::make_shared<std::vector<float>>();
+    clip->pose(quantize(time), *entry.matrices, _worldMatrices);
+
+    return entry.matrices;
+}
+
+void
+SkinPoseCache::clear()
+{
+    _poses.clear();
+}
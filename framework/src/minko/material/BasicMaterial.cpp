@@ -499,3 +499,21 @@ BasicMaterial::isTransparent(bool transparent, bool zSort)
         ->blendingMode(transparent ? Blending::Mode::ALPHA : Blending::Mode::DEFAULT);
 }
 
+BasicMaterial::Ptr
+BasicMaterial::instancing(bool value)
+{
+    // the INSTANCING macro is bound to the existence of the property
+    if (value)
+        set("instancing", true);
+    else if (hasProperty("instancing"))
+        unset("instancing");
+
+    return std::static_pointer_cast<BasicMaterial>(shared_from_this());
+}
+
+bool
+BasicMaterial::instancing() const
+{
+    return hasProperty("instancing");
+}
+
@@ -18,25 +18,90 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 */
 
 #include "minko/math/Frustum.hpp"
-#include "minko/math/Vector4.hpp"
 #include "minko/math/Matrix4x4.hpp"
 #include "minko/math/Box.hpp"
 
+#if defined(MINKO_AVX2)
+# include <immintrin.h>
+#elif defined(MINKO_SSE2)
+# include <emmintrin.h>
+#endif
+
 using namespace minko;
 using namespace minko::math;
 
+namespace
+{
+    inline
+    void
+    setPlane(float* plane, float a, float b, float c, float d)
+    {
+        float l = sqrtf(a * a + b * b + c * c);
+
+        if (l != 0.f)
+        {
+            a /= l;
+            b /= l;
+            c /= l;
+            d /= l;
+        }
+
+        plane[0] = a;
+        plane[1] = b;
+        plane[2] = c;
+        plane[3] = d;
+    }
+
+    // A box is outside when it lies entirely on the negative side of one of the planes: its corner
+    // the furthest along the plane normal is center + extent * abs(normal).
+    inline
+    bool
+    boxVisible(const float* planes, const float* const center[3], const float* const extent[3], uint i)
+    {
+        for (uint planeId = 0; planeId < 6; ++planeId)
+        {
+            const float* p = planes + (planeId << 2);
+
+            if (p[0] * center[0][i] + p[1] * center[1][i] + p[2] * center[2][i] + p[3]
+                + std::abs(p[0]) * extent[0][i] + std::abs(p[1]) * extent[1][i] + std::abs(p[2]) * extent[2][i] < 0.f)
+                return false;
+        }
+
+        return true;
+    }
+
+    uint
+    testBoxRange(const float* planes, const float* const center[3], const float* const extent[3], uint begin, uint end, uint* visibility)
+    {
+        uint numVisible = 0;
+
+        for (uint i = begin; i < end; ++i)
+            if (boxVisible(planes, center, extent, i))
+            {
+                visibility[i >> 5] |= 1u << (i & 31);
+                ++numVisible;
+            }
+
+        return numVisible;
+    }
+
+#ifdef MINKO_SSE2
+    const uint BIT_COUNT[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+#endif
+}
+
 void
 Frustum::updateFromMatrix(std::shared_ptr<math::Matrix4x4> matrix)
 {
-    std::shared_ptr<math::Matrix4x4>    clone    = math::Matrix4x4::create(matrix);
-    std::vector<float>                    data    = clone->data();
-
-    _planes[(int)PlanePosition::LEFT]    ->setTo(data[12] + data[0], data[13] + data[1], data[14] + data[2], data[15] + data[3])->normalize();
-    _planes[(int)PlanePosition::TOP]    ->setTo(data[12] - data[4], data[13] - data[5], data[14] - data[6], data[15] - data[7])->normalize();
-    _planes[(int)PlanePosition::RIGHT]    ->setTo(data[12] - data[0], data[13] - data[1], data[14] - data[2], data[15] - data[3])->normalize();
-    _planes[(int)PlanePosition::BOTTOM]    ->setTo(data[12] + data[4], data[13] + data[5], data[14] + data[6], data[15] + data[7])->normalize();
-    _planes[(int)PlanePosition::FAR]    ->setTo(data[12] - data[8], data[13] - data[9], data[14] - data[10], data[15] - data[11])->normalize();
-    _planes[(int)PlanePosition::NEAR]    ->setTo(data[8], data[9], data[10], data[11])->normalize();
+    const float* m = matrix->data().data();
+    float* planes = _planes.data();
+
+    setPlane(planes + ((int)PlanePosition::LEFT << 2),      m[12] + m[0], m[13] + m[1], m[14] + m[2], m[15] + m[3]);
+    setPlane(planes + ((int)PlanePosition::TOP << 2),       m[12] - m[4], m[13] - m[5], m[14] - m[6], m[15] - m[7]);
+    setPlane(planes + ((int)PlanePosition::RIGHT << 2),     m[12] - m[0], m[13] - m[1], m[14] - m[2], m[15] - m[3]);
+    setPlane(planes + ((int)PlanePosition::BOTTOM << 2),    m[12] + m[4], m[13] + m[5], m[14] + m[6], m[15] + m[7]);
+    setPlane(planes + ((int)PlanePosition::FAR << 2),       m[12] - m[8], m[13] - m[9], m[14] - m[10], m[15] - m[11]);
+    setPlane(planes + ((int)PlanePosition::NEAR << 2),      m[8], m[9], m[10], m[11]);
 }
 
 ShapePosition
@@ -84,12 +149,12 @@ Frustum::testBoundingBox(math::Box::Ptr box)
     float ytrf = ytrb;
     float ztrf = zblf;
 
-    for (uint planeId = 0; planeId < _planes.size(); ++planeId)
+    for (uint planeId = 0; planeId < 6; ++planeId)
     {
-        float pa = _planes[planeId]->x();
-        float pb = _planes[planeId]->y();
-        float pc = _planes[planeId]->z();
-        float pd = _planes[planeId]->w();
+        float pa = _planes[(planeId << 2)];
+        float pb = _planes[(planeId << 2) + 1];
+        float pc = _planes[(planeId << 2) + 2];
+        float pd = _planes[(planeId << 2) + 3];
 
 
         _blfResult[planeId] = pa * xblf + pb * yblf + pc * zblf + pd < 0.;
@@ -109,7 +174,7 @@ Frustum::testBoundingBox(math::Box::Ptr box)
         (_blfResult[(int)PlanePosition::BOTTOM] && _trbResult[(int)PlanePosition::TOP]))
         return ShapePosition::AROUND;
 
-    for (uint planeId = 0; planeId < _planes.size(); ++planeId)
+    for (uint planeId = 0; planeId < 6; ++planeId)
     {
         if (_blfResult[planeId] &&
             _brfResult[planeId] &&
@@ -126,6 +191,106 @@ Frustum::testBoundingBox(math::Box::Ptr box)
     return ShapePosition::INSIDE;
 }
 
+/*static*/
+uint
+Frustum::testBoxes(const float*         planes,
+                   const float* const   center[3],
+                   const float* const   extent[3],
+                   uint                 numBoxes,
+                   uint*                visibility)
+{
+    std::fill(visibility, visibility + ((numBoxes + 31) >> 5), 0u);
+
+    uint i = 0;
+    uint numVisible = 0;
+
+#ifdef MINKO_SSE2
+    // each iteration tests a block of boxes against the 6 planes and accumulates the "outside" lanes,
+    // blocks are 4 or 8 boxes wide so that a block never spans two visibility words
+# if defined(MINKO_AVX2)
+    const __m256 zero256 = _mm256_setzero_ps();
+
+    for (; i + 8 <= numBoxes; i += 8)
+    {
+        const __m256 cx = _mm256_loadu_ps(center[0] + i);
+        const __m256 cy = _mm256_loadu_ps(center[1] + i);
+        const __m256 cz = _mm256_loadu_ps(center[2] + i);
+        const __m256 ex = _mm256_loadu_ps(extent[0] + i);
+        const __m256 ey = _mm256_loadu_ps(extent[1] + i);
+        const __m256 ez = _mm256_loadu_ps(extent[2] + i);
+        __m256 outside = zero256;
+
+        for (uint planeId = 0; planeId < 6; ++planeId)
+        {
+            const float* p = planes + (planeId << 2);
+            __m256 distance = _mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(p[0]), cx), _mm256_mul_ps(_mm256_set1_ps(p[1]), cy)),
+                _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(p[2]), cz), _mm256_set1_ps(p[3]))
+            );
+
+            distance = _mm256_add_ps(distance, _mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(std::abs(p[0])), ex), _mm256_mul_ps(_mm256_set1_ps(std::abs(p[1])), ey)),
+                _mm256_mul_ps(_mm256_set1_ps(std::abs(p[2])), ez)
+            ));
+            outside = _mm256_or_ps(outside, _mm256_cmp_ps(distance, zero256, _CMP_LT_OQ));
+        }
+
+        const uint mask = ~_mm256_movemask_ps(outside) & 0xff;
+
+        visibility[i >> 5] |= mask << (i & 31);
+        numVisible += BIT_COUNT[mask & 0xf] + BIT_COUNT[mask >> 4];
+    }
+# endif
+    const __m128 zero = _mm_setzero_ps();
+
+    for (; i + 4 <= numBoxes; i += 4)
+    {
+        const __m128 cx = _mm_loadu_ps(center[0] + i);
+        const __m128 cy = _mm_loadu_ps(center[1] + i);
+        const __m128 cz = _mm_loadu_ps(center[2] + i);
+        const __m128 ex = _mm_loadu_ps(extent[0] + i);
+        const __m128 ey = _mm_loadu_ps(extent[1] + i);
+        const __m128 ez = _mm_loadu_ps(extent[2] + i);
+        __m128 outside = zero;
+
+        for (uint planeId = 0; planeId < 6; ++planeId)
+        {
+            const float* p = planes + (planeId << 2);
+            __m128 distance = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(_mm_set1_ps(p[0]), cx), _mm_mul_ps(_mm_set1_ps(p[1]), cy)),
+                _mm_add_ps(_mm_mul_ps(_mm_set1_ps(p[2]), cz), _mm_set1_ps(p[3]))
+            );
+
+            distance = _mm_add_ps(distance, _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(_mm_set1_ps(std::abs(p[0])), ex), _mm_mul_ps(_mm_set1_ps(std::abs(p[1])), ey)),
+                _mm_mul_ps(_mm_set1_ps(std::abs(p[2])), ez)
+            ));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, zero));
+        }
+
+        const uint mask = ~_mm_movemask_ps(outside) & 0xf;
+
+        visibility[i >> 5] |= mask << (i & 31);
+        numVisible += BIT_COUNT[mask];
+    }
+#endif
+
+    return numVisible + testBoxRange(planes, center, extent, i, numBoxes, visibility);
+}
+
+/*static*/
+uint
+Frustum::testBoxesScalar(const float*       planes,
+                         const float* const center[3],
+                         const float* const extent[3],
+                         uint               numBoxes,
+                         uint*              visibility)
+{
+    std::fill(visibility, visibility + ((numBoxes + 31) >> 5), 0u);
+
+    return testBoxRange(planes, center, extent, 0, numBoxes, visibility);
+}
+
 bool
 Frustum::cast(std::shared_ptr<Ray> ray, float& distance)
 {
@@ -134,10 +299,5 @@ Frustum::cast(std::shared_ptr<Ray> ray, float& distance)
 
 Frustum::Frustum()
 {
-    _planes[(int)PlanePosition::LEFT]    = Vector4::create();
-    _planes[(int)PlanePosition::RIGHT]    = Vector4::create();
-    _planes[(int)PlanePosition::TOP]    = Vector4::create();
-    _planes[(int)PlanePosition::BOTTOM] = Vector4::create();
-    _planes[(int)PlanePosition::FAR]    = Vector4::create();
-    _planes[(int)PlanePosition::NEAR]    = Vector4::create();
+    _planes.fill(0.f);
 }
\ No newline at end of file
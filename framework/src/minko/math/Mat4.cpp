@@ -0,0 +1,277 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/math/Mat4.hpp"
+
+using namespace minko;
+using namespace minko::math;
+
+#ifdef MINKO_SSE2
+namespace
+{
+    // result = (a[x], a[y], b[z], b[w])
+    template <int x, int y, int z, int w>
+    inline
+    __m128
+    shuffle(__m128 a, __m128 b)
+    {
+        return _mm_shuffle_ps(a, b, _MM_SHUFFLE(w, z, y, x));
+    }
+
+    template <int x, int y, int z, int w>
+    inline
+    __m128
+    swizzle(__m128 a)
+    {
+        return _mm_shuffle_ps(a, a, _MM_SHUFFLE(w, z, y, x));
+    }
+
+    // the 2x2 helpers below work on row-major 2x2 matrices packed as (m00, m01, m10, m11)
+
+    // a * b
+    inline
+    __m128
+    mat2Mul(__m128 a, __m128 b)
+    {
+        return _mm_add_ps(
+            _mm_mul_ps(a, swizzle<0, 3, 0, 3>(b)),
+            _mm_mul_ps(swizzle<1, 0, 3, 2>(a), swizzle<2, 1, 2, 1>(b))
+        );
+    }
+
+    // adjugate(a) * b
+    inline
+    __m128
+    mat2AdjMul(__m128 a, __m128 b)
+    {
+        return _mm_sub_ps(
+            _mm_mul_ps(swizzle<3, 3, 0, 0>(a), b),
+            _mm_mul_ps(swizzle<1, 1, 2, 2>(a), swizzle<2, 3, 0, 1>(b))
+        );
+    }
+
+    // a * adjugate(b)
+    inline
+    __m128
+    mat2MulAdj(__m128 a, __m128 b)
+    {
+        return _mm_sub_ps(
+            _mm_mul_ps(a, swizzle<3, 0, 3, 0>(b)),
+            _mm_mul_ps(swizzle<1, 0, 3, 2>(a), swizzle<2, 1, 2, 1>(b))
+        );
+    }
+}
+#endif
+
+/*static*/
+Mat4
+Mat4::perspective(float fov, float ratio, float zNear, float zFar)
+{
+    const float invHalfFOV  = 1.0f / tanf(fov * .5f);
+    const float invZRange   = 1.0f / (zNear - zFar);
+
+    Mat4 result = {{
+        invHalfFOV / ratio, 0.f,        0.f,                        0.f,
+        0.f,                invHalfFOV, 0.f,                        0.f,
+        0.f,                0.f,        (zFar + zNear) * invZRange, 2.f * zNear * zFar * invZRange,
+        0.f,                0.f,        -1.f,                       0.f
+    }};
+
+    return result;
+}
+
+/*static*/
+bool
+Mat4::invertScalar(const float* m, float* output)
+{
+    float s0 = m[0] * m[5] - m[4] * m[1];
+    float s1 = m[0] * m[6] - m[4] * m[2];
+    float s2 = m[0] * m[7] - m[4] * m[3];
+    float s3 = m[1] * m[6] - m[5] * m[2];
+    float s4 = m[1] * m[7] - m[5] * m[3];
+    float s5 = m[2] * m[7] - m[6] * m[3];
+
+    float c5 = m[10] * m[15] - m[14] * m[11];
+    float c4 = m[9] * m[15] - m[13] * m[11];
+    float c3 = m[9] * m[14] - m[13] * m[10];
+    float c2 = m[8] * m[15] - m[12] * m[11];
+    float c1 = m[8] * m[14] - m[12] * m[10];
+    float c0 = m[8] * m[13] - m[12] * m[9];
+
+    float det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+
+    if (det == 0.f)
+        return false;
+
+    float invdet = 1.f / det;
+    float result[16] = {
+        (m[5] * c5 - m[6] * c4 + m[7] * c3) * invdet,
+        (-m[1] * c5 + m[2] * c4 - m[3] * c3) * invdet,
+        (m[13] * s5 - m[14] * s4 + m[15] * s3) * invdet,
+        (-m[9] * s5 + m[10] * s4 - m[11] * s3) * invdet,
+        (-m[4] * c5 + m[6] * c2 - m[7] * c1) * invdet,
+        (m[0] * c5 - m[2] * c2 + m[3] * c1) * invdet,
+        (-m[12] * s5 + m[14] * s2 - m[15] * s1) * invdet,
+        (m[8] * s5 - m[10] * s2 + m[11] * s1) * invdet,
+        (m[4] * c4 - m[5] * c2 + m[7] * c0) * invdet,
+        (-m[0] * c4 + m[1] * c2 - m[3] * c0) * invdet,
+        (m[12] * s4 - m[13] * s2 + m[15] * s0) * invdet,
+        (-m[8] * s4 + m[9] * s2 - m[11] * s0) * invdet,
+        (-m[4] * c3 + m[5] * c1 - m[6] * c0) * invdet,
+        (m[0] * c3 - m[1] * c1 + m[2] * c0) * invdet,
+        (-m[12] * s3 + m[13] * s1 - m[14] * s0) * invdet,
+        (m[8] * s3 - m[9] * s1 + m[10] * s0) * invdet
+    };
+
+    std::copy(result, result + 16, output);
+
+    return true;
+}
+
+/*static*/
+bool
+Mat4::invert(const float* m, float* output)
+{
+#ifdef MINKO_SSE2
+    // blockwise inversion: with M = | A B |, inverse(M) = 1 / |M| * | X Y |
+    //                               | C D |                        | Z W |
+    // where the adjugates of the X, Y, Z and W blocks are computed from 2x2 products only
+    const __m128 row0 = _mm_loadu_ps(m);
+    const __m128 row1 = _mm_loadu_ps(m + 4);
+    const __m128 row2 = _mm_loadu_ps(m + 8);
+    const __m128 row3 = _mm_loadu_ps(m + 12);
+
+    const __m128 a = _mm_movelh_ps(row0, row1);
+    const __m128 b = _mm_movehl_ps(row1, row0);
+    const __m128 c = _mm_movelh_ps(row2, row3);
+    const __m128 d = _mm_movehl_ps(row3, row2);
+
+    // (|A|, |B|, |C|, |D|)
+    const __m128 detSub = _mm_sub_ps(
+        _mm_mul_ps(shuffle<0, 2, 0, 2>(row0, row2), shuffle<1, 3, 1, 3>(row1, row3)),
+        _mm_mul_ps(shuffle<1, 3, 1, 3>(row0, row2), shuffle<0, 2, 0, 2>(row1, row3))
+    );
+    const __m128 detA = swizzle<0, 0, 0, 0>(detSub);
+    const __m128 detB = swizzle<1, 1, 1, 1>(detSub);
+    const __m128 detC = swizzle<2, 2, 2, 2>(detSub);
+    const __m128 detD = swizzle<3, 3, 3, 3>(detSub);
+
+    const __m128 adjDC = mat2AdjMul(d, c);
+    const __m128 adjAB = mat2AdjMul(a, b);
+
+    __m128 x = _mm_sub_ps(_mm_mul_ps(detD, a), mat2Mul(b, adjDC));
+    __m128 w = _mm_sub_ps(_mm_mul_ps(detA, d), mat2Mul(c, adjAB));
+    __m128 y = _mm_sub_ps(_mm_mul_ps(detB, c), mat2MulAdj(d, adjAB));
+    __m128 z = _mm_sub_ps(_mm_mul_ps(detC, b), mat2MulAdj(a, adjDC));
+
+    // |M| = |A| * |D| + |B| * |C| - trace(adjugate(A) * B * adjugate(D) * C)
+    __m128 trace = _mm_mul_ps(adjAB, swizzle<0, 2, 1, 3>(adjDC));
+
+    trace = _mm_add_ps(trace, swizzle<2, 3, 0, 1>(trace));
+    trace = _mm_add_ps(trace, swizzle<1, 0, 3, 2>(trace));
+
+    const __m128 det = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), trace);
+
+    if (_mm_cvtss_f32(det) == 0.f)
+        return false;
+
+    // the signs of the adjugates are applied along with 1 / |M|, their shuffles when storing the rows
+    const __m128 invDet = _mm_div_ps(_mm_setr_ps(1.f, -1.f, -1.f, 1.f), det);
+
+    x = _mm_mul_ps(x, invDet);
+    y = _mm_mul_ps(y, invDet);
+    z = _mm_mul_ps(z, invDet);
+    w = _mm_mul_ps(w, invDet);
+
+    _mm_storeu_ps(output,       shuffle<3, 1, 3, 1>(x, y));
+    _mm_storeu_ps(output + 4,   shuffle<2, 0, 2, 0>(x, y));
+    _mm_storeu_ps(output + 8,   shuffle<3, 1, 3, 1>(z, w));
+    _mm_storeu_ps(output + 12,  shuffle<2, 0, 2, 0>(z, w));
+
+    return true;
+#else
+    return invertScalar(m, output);
+#endif
+}
+
+/*static*/
+void
+Mat4::multiply(const float* a, const float* b, float* output, unsigned int numMatrices)
+{
+    for (unsigned int i = 0; i < numMatrices; ++i)
+        multiply(a + (i << 4), b + (i << 4), output + (i << 4));
+}
+
+/*static*/
+void
+Mat4::transformPoints(const float*  m,
+                      const float*  points,
+                      float*        output,
+                      unsigned int  numPoints,
+                      unsigned int  stride)
+{
+#ifdef MINKO_SSE2
+    // columns of 'm': the transformed point is x * col0 + y * col1 + z * col2 + col3
+    __m128 col0 = _mm_loadu_ps(m);
+    __m128 col1 = _mm_loadu_ps(m + 4);
+    __m128 col2 = _mm_loadu_ps(m + 8);
+    __m128 col3 = _mm_loadu_ps(m + 12);
+
+    _MM_TRANSPOSE4_PS(col0, col1, col2, col3);
+
+    for (unsigned int i = 0; i < numPoints; ++i)
+    {
+        const float* point = points + i * stride;
+        float*       result = output + i * stride;
+
+        __m128 r = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(_mm_set1_ps(point[0]), col0), _mm_mul_ps(_mm_set1_ps(point[1]), col1)),
+            _mm_add_ps(_mm_mul_ps(_mm_set1_ps(point[2]), col2), col3)
+        );
+
+        // store x, y and z only: the next point might start right after z
+        _mm_storel_pi(reinterpret_cast<__m64*>(result), r);
+        _mm_store_ss(result + 2, _mm_movehl_ps(r, r));
+    }
+#else
+    transformPointsScalar(m, points, output, numPoints, stride);
+#endif
+}
+
+/*static*/
+void
+Mat4::transformPointsScalar(const float*    m,
+                            const float*    points,
+                            float*          output,
+                            unsigned int    numPoints,
+                            unsigned int    stride)
+{
+    for (unsigned int i = 0; i < numPoints; ++i)
+    {
+        const float* point = points + i * stride;
+        float*       result = output + i * stride;
+        const float  x = point[0];
+        const float  y = point[1];
+        const float  z = point[2];
+
+        result[0] = x * m[0] + y * m[1] + z * m[2]  + m[3];
+        result[1] = x * m[4] + y * m[5] + z * m[6]  + m[7];
+        result[2] = x * m[8] + y * m[9] + z * m[10] + m[11];
+    }
+}
@@ -41,24 +41,17 @@ Matrix4x4::prepend(float m00, float m01, float m02, float m03,
                     float m20, float m21, float m22, float m23,
                     float m30, float m31, float m32, float m33)
 {
-    return initialize(
-        _m[0] * m00 + _m[1] * m10 + _m[2] * m20 + _m[3] * m30,
-        _m[0] * m01 + _m[1] * m11 + _m[2] * m21 + _m[3] * m31,
-        _m[0] * m02 + _m[1] * m12 + _m[2] * m22 + _m[3] * m32,
-        _m[0] * m03 + _m[1] * m13 + _m[2] * m23 + _m[3] * m33,
-        _m[4] * m00 + _m[5] * m10 + _m[6] * m20 + _m[7] * m30,
-        _m[4] * m01 + _m[5] * m11 + _m[6] * m21 + _m[7] * m31,
-        _m[4] * m02 + _m[5] * m12 + _m[6] * m22 + _m[7] * m32,
-        _m[4] * m03 + _m[5] * m13 + _m[6] * m23 + _m[7] * m33,
-        _m[8] * m00 + _m[9] * m10 + _m[10] * m20 + _m[11] * m30,
-        _m[8] * m01 + _m[9] * m11 + _m[10] * m21 + _m[11] * m31,
-        _m[8] * m02 + _m[9] * m12 + _m[10] * m22 + _m[11] * m32,
-        _m[8] * m03 + _m[9] * m13 + _m[10] * m23 + _m[11] * m33,
-        _m[12] * m00 + _m[13] * m10 + _m[14] * m20 + _m[15] * m30,
-        _m[12] * m01 + _m[13] * m11 + _m[14] * m21 + _m[15] * m31,
-        _m[12] * m02 + _m[13] * m12 + _m[14] * m22 + _m[15] * m32,
-        _m[12] * m03 + _m[13] * m13 + _m[14] * m23 + _m[15] * m33
-    );
+    Mat4 matrix = {{
+        m00, m01, m02, m03,
+        m10, m11, m12, m13,
+        m20, m21, m22, m23,
+        m30, m31, m32, m33
+    }};
+    Mat4 result;
+
+    Mat4::multiply(&_m[0], matrix.m, result.m);
+
+    return initialize(result.m);
 }
 
 Matrix4x4::Ptr
@@ -67,24 +60,17 @@ Matrix4x4::append(float m00, float m01, float m02, float m03,
                    float m20, float m21, float m22, float m23,
                    float m30, float m31, float m32, float m33)
 {
-    return initialize(
-        m00 * _m[0] + m01 * _m[4] + m02 * _m[8] + m03 * _m[12],
-        m00 * _m[1] + m01 * _m[5] + m02 * _m[9] + m03 * _m[13],
-        m00 * _m[2] + m01 * _m[6] + m02 * _m[10] + m03 * _m[14],
-        m00 * _m[3] + m01 * _m[7] + m02 * _m[11] + m03 * _m[15],
-        m10 * _m[0] + m11 * _m[4] + m12 * _m[8] + m13 * _m[12],
-        m10 * _m[1] + m11 * _m[5] + m12 * _m[9] + m13 * _m[13],
-        m10 * _m[2] + m11 * _m[6] + m12 * _m[10] + m13 * _m[14],
-        m10 * _m[3] + m11 * _m[7] + m12 * _m[11] + m13 * _m[15],
-        m20 * _m[0] + m21 * _m[4] + m22 * _m[8] + m23 * _m[12],
-        m20 * _m[1] + m21 * _m[5] + m22 * _m[9] + m23 * _m[13],
-        m20 * _m[2] + m21 * _m[6] + m22 * _m[10] + m23 * _m[14],
-        m20 * _m[3] + m21 * _m[7] + m22 * _m[11] + m23 * _m[15],
-        m30 * _m[0] + m31 * _m[4] + m32 * _m[8] + m33 * _m[12],
-        m30 * _m[1] + m31 * _m[5] + m32 * _m[9] + m33 * _m[13],
-        m30 * _m[2] + m31 * _m[6] + m32 * _m[10] + m33 * _m[14],
-        m30 * _m[3] + m31 * _m[7] + m32 * _m[11] + m33 * _m[15]
-    );
+    Mat4 matrix = {{
+        m00, m01, m02, m03,
+        m10, m11, m12, m13,
+        m20, m21, m22, m23,
+        m30, m31, m32, m33
+    }};
+    Mat4 result;
+
+    Mat4::multiply(matrix.m, &_m[0], result.m);
+
+    return initialize(result.m);
 }
 
 Matrix4x4::Ptr
@@ -115,7 +101,7 @@ Matrix4x4::initialize(std::vector<float> m)
 }
 
 Matrix4x4::Ptr
-Matrix4x4::initialize(float* m)
+Matrix4x4::initialize(const float* m)
 {
     return initialize(
         m[0], m[1], m[2], m[3],
@@ -164,56 +150,22 @@ Matrix4x4::determinant3x3() const
 Matrix4x4::Ptr
 Matrix4x4::invert()
 {
-    float s0 =_m[0] * _m[5] - _m[4] * _m[1];
-    float s1 =_m[0] * _m[6] - _m[4] * _m[2];
-    float s2 =_m[0] * _m[7] - _m[4] * _m[3];
-    float s3 =_m[1] * _m[6] - _m[5] * _m[2];
-    float s4 =_m[1] * _m[7] - _m[5] * _m[3];
-    float s5 =_m[2] * _m[7] - _m[6] * _m[3];
-
-    float c5 =_m[10] * _m[15] - _m[14] * _m[11];
-    float c4 =_m[9] * _m[15] - _m[13] * _m[11];
-    float c3 =_m[9] * _m[14] - _m[13] * _m[10];
-    float c2 =_m[8] * _m[15] - _m[12] * _m[11];
-    float c1 =_m[8] * _m[14] - _m[12] * _m[10];
-    float c0 =_m[8] * _m[13] - _m[12] * _m[9];
-
-    float det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+    Mat4 result;
 
-    if (det == 0.)
+    if (!Mat4::invert(&_m[0], result.m))
         throw std::logic_error("matrix is not invertible (determinant = 0).");
 
-    float invdet = 1.f / det;
-
-    return initialize(
-        (_m[5] * c5 - _m[6] * c4 + _m[7] * c3) * invdet,
-        (-_m[1] * c5 + _m[2] * c4 - _m[3] * c3) * invdet,
-        (_m[13] * s5 - _m[14] * s4 + _m[15] * s3) * invdet,
-        (-_m[9] * s5 + _m[10] * s4 - _m[11] * s3) * invdet,
-        (-_m[4] * c5 + _m[6] * c2 - _m[7] * c1) * invdet,
-        (_m[0] * c5 - _m[2] * c2 + _m[3] * c1) * invdet,
-        (-_m[12] * s5 + _m[14] * s2 - _m[15] * s1) * invdet,
-        (_m[8] * s5 - _m[10] * s2 + _m[11] * s1) * invdet,
-        (_m[4] * c4 - _m[5] * c2 + _m[7] * c0) * invdet,
-        (-_m[0] * c4 + _m[1] * c2 - _m[3] * c0) * invdet,
-        (_m[12] * s4 - _m[13] * s2 + _m[15] * s0) * invdet,
-        (-_m[8] * s4 + _m[9] * s2 - _m[11] * s0) * invdet,
-        (-_m[4] * c3 + _m[5] * c1 - _m[6] * c0) * invdet,
-        (_m[0] * c3 - _m[1] * c1 + _m[2] * c0) * invdet,
-        (-_m[12] * s3 + _m[13] * s1 - _m[14] * s0) * invdet,
-        (_m[8] * s3 - _m[9] * s1 + _m[10] * s0) * invdet
-    );
+    return initialize(result.m);
 }
 
 Matrix4x4::Ptr
 Matrix4x4::transpose()
 {
-    return initialize(
-        _m[0],    _m[4],     _m[8],     _m[12],
-        _m[1],     _m[5],     _m[9],     _m[13],
-        _m[2],     _m[6],     _m[10], _m[14],
-        _m[3],    _m[7],    _m[11],    _m[15]
-    );
+    Mat4 result;
+
+    Mat4::transpose(&_m[0], result.m);
+
+    return initialize(result.m);
 }
 
 std::shared_ptr<Vector3>
@@ -222,13 +174,7 @@ Matrix4x4::transform(std::shared_ptr<Vector3> v, std::shared_ptr<Vector3> output
     if (!output)
         output = Vector3::create();
 
-    output->setTo(
-        v->x() * _m[0] + v->y() * _m[1] + v->z() * _m[2] + _m[3],
-        v->x() * _m[4] + v->y() * _m[5] + v->z() * _m[6] + _m[7],
-        v->x() * _m[8] + v->y() * _m[9] + v->z() * _m[10] + _m[11]
-        );
-
-    return output;
+    return output->copyFrom(Mat4::transformPoint(&_m[0], v->toVec3()));
 }
 
 std::shared_ptr<Vector4>
@@ -237,14 +183,7 @@ Matrix4x4::transform(std::shared_ptr<Vector4> v, std::shared_ptr<Vector4> output
     if (!output)
         output = Vector4::create();
 
-    output->setTo(
-        v->x() * _m[0]  + v->y() * _m[1]  + v->z() * _m[2]  + v->w() * _m[3],
-        v->x() * _m[4]  + v->y() * _m[5]  + v->z() * _m[6]  + v->w() * _m[7],
-        v->x() * _m[8]  + v->y() * _m[9]  + v->z() * _m[10] + v->w() * _m[11],
-        v->x() * _m[12] + v->y() * _m[13] + v->z() * _m[14] + v->w() * _m[15]
-        );
-
-    return output;
+    return output->copyFrom(Mat4::transform(&_m[0], v->toVec4()));
 }
 
 std::shared_ptr<Vector3>
@@ -253,13 +192,7 @@ Matrix4x4::deltaTransform(std::shared_ptr<Vector3> v, std::shared_ptr<Vector3> o
     if (!output)
         output = Vector3::create();
 
-    output->setTo(
-        v->x() * _m[0] + v->y() * _m[1] + v->z() * _m[2],
-        v->x() * _m[4] + v->y() * _m[5] + v->z() * _m[6],
-        v->x() * _m[8] + v->y() * _m[9] + v->z() * _m[10]
-        );
-
-    return output;
+    return output->copyFrom(Mat4::transformVector(&_m[0], v->toVec3()));
 }
 
 std::shared_ptr<Vector3>
@@ -268,41 +201,27 @@ Matrix4x4::project(std::shared_ptr<Vector3> v, std::shared_ptr<Vector3> output)
     if (!output)
         output = Vector3::create();
 
-    float w = v->x() * _m[12] + v->y() * _m[13] + v->z() * _m[14] + _m[15];
-
-    output->setTo(
-        (v->x() * _m[0] + v->y() * _m[1] + v->z() * _m[2] + _m[3]) / w,
-        (v->x() * _m[4] + v->y() * _m[5] + v->z() * _m[6] + _m[7]) / w,
-        (v->x() * _m[8] + v->y() * _m[9] + v->z() * _m[10] + _m[11]) / w
-    );
-
-    return output;
+    return output->copyFrom(Mat4::project(&_m[0], v->toVec3()));
 }
 
 Matrix4x4::Ptr
 Matrix4x4::append(Matrix4x4::Ptr matrix)
 {
-    std::vector<float>& mv = matrix->_m;
+    Mat4 result;
 
-    return append(
-        mv[0],    mv[1],     mv[2],     mv[3],
-        mv[4],     mv[5],     mv[6],     mv[7],
-        mv[8],     mv[9],     mv[10], mv[11],
-        mv[12], mv[13], mv[14], mv[15]
-    );
+    Mat4::multiply(&matrix->_m[0], &_m[0], result.m);
+
+    return initialize(result.m);
 }
 
 Matrix4x4::Ptr
 Matrix4x4::prepend(Matrix4x4::Ptr matrix)
 {
-    std::vector<float>& mv = matrix->_m;
+    Mat4 result;
 
-    return prepend(
-        mv[0],    mv[1],     mv[2],     mv[3],
-        mv[4],     mv[5],     mv[6],     mv[7],
-        mv[8],     mv[9],     mv[10], mv[11],
-        mv[12], mv[13], mv[14], mv[15]
-    );
+    Mat4::multiply(&_m[0], &matrix->_m[0], result.m);
+
+    return initialize(result.m);
 }
 
 Matrix4x4::Ptr
@@ -446,11 +365,11 @@ Matrix4x4::perspective(float fov, // vertical FOV
                        float zNear,
                        float zFar)
 {
+    /*
+    // oculus rift's expected perspective transform
     const float invHalfFOV    = 1.0f / tanf(fov * .5f);
     const float    invZRange    = 1.0f / (zNear - zFar);
 
-    /*
-    // oculus rift's expected perspective transform
     return initialize(
         invHalfFOV / ratio,    0.f,        0.f,                0.f,
         0.f,                invHalfFOV,    0.f,                0.f,
@@ -459,13 +378,7 @@ Matrix4x4::perspective(float fov, // vertical FOV
     );
     */
 
-    return initialize(
-        invHalfFOV / ratio,    0.f,        0.f,                        0.f,
-        0.f,                invHalfFOV,    0.f,                        0.f,
-        0.f,                0.f,        (zFar + zNear) * invZRange,    2.f * zNear * zFar * invZRange,
-        0.f,                0.f,        -1.f,                        0.f
-    );
-
+    return initialize(Mat4::perspective(fov, ratio, zNear, zFar));
 }
 
 Matrix4x4::Ptr
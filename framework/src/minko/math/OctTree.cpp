@@ -31,181 +31,319 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/math/Matrix4x4.hpp"
 #include "minko/data/Container.hpp"
 #include "minko/math/Frustum.hpp"
+#include "minko/math/Ray.hpp"
 
 using namespace minko;
 using namespace minko::math;
 
-OctTree::OctTree(float                            worldSize,
-                  uint                            maxDepth,
-                 std::shared_ptr<math::Vector3>    center,
-                 uint                            depth)
+OctTree::OctTree(float                              worldSize,
+                 uint                               maxDepth,
+                 std::shared_ptr<math::Vector3>     center) :
+    _maxDepth(maxDepth),
+    _octants(),
+    _objects(),
+    _freeObjects(),
+    _nodeToObject(),
+    _invalidObjects(),
+    _revision(0),
+    _visibility()
 {
-    _worldSize  = worldSize;
-    _depth        = depth;
-    _center        = center;
-    _splitted    = false;
-    _maxDepth    = maxDepth;
+    Vec3 rootCenter = { center->x(), center->y(), center->z() };
 
-    float edgel = edgeLength();
+    createOctant(rootCenter, worldSize * .5f, 0, NO_OCTANT);
+}
 
-    _octantBox = math::Box::create(
-        math::Vector3::create(_center->x() + edgel, _center->y() + edgel, _center->z() + edgel),
-        math::Vector3::create(_center->x() - edgel, _center->y() - edgel, _center->z() - edgel));
+uint
+OctTree::createOctant(const Vec3& center, float halfSize, uint depth, int parent)
+{
+    Octant octant;
+    float looseHalfSize = halfSize * 2.f;
+
+    octant.center       = center;
+    octant.halfSize     = halfSize;
+    octant.depth        = depth;
+    octant.parent       = parent;
+    octant.firstChild   = NO_OCTANT;
+    octant.numNodes     = 0;
+    octant.looseBox     = math::Box::create(
+        math::Vector3::create(center.x + looseHalfSize, center.y + looseHalfSize, center.z + looseHalfSize),
+        math::Vector3::create(center.x - looseHalfSize, center.y - looseHalfSize, center.z - looseHalfSize)
+    );
+
+    _octants.push_back(std::move(octant));
+
+    return _octants.size() - 1;
 }
 
-std::shared_ptr<scene::Node>
-OctTree::generateVisual(std::shared_ptr<file::AssetLibrary>        assetLibrary,
-                        std::shared_ptr<scene::Node>            rootNode)
+void
+OctTree::split(uint octantId)
 {
-    if (!rootNode)
-        rootNode = scene::Node::create();
+    const auto center       = _octants[octantId].center;
+    const auto halfSize     = _octants[octantId].halfSize * .5f;
+    const auto depth        = _octants[octantId].depth + 1;
 
-    auto node = scene::Node::create();
+    _octants[octantId].firstChild = _octants.size();
 
-    if (_content.size() > 0)
+    for (uint i = 0; i < 8; ++i)
     {
-        node->addComponent(component::Transform::create(math::Matrix4x4::create()
-                        ->appendScale(edgeLength() * 2.f - 0.1f)
-                        ->appendTranslation(_center->x(), _center->y(), _center->z())))
-                    ->addComponent(component::Surface::create(
-                        geometry::CubeGeometry::create(assetLibrary->context()),
-                        material::BasicMaterial::create()
-                            ->diffuseColor(0x00FF0030)
-                            ->blendingMode(render::Blending::Mode::ALPHA)
-                            ->triangleCulling(render::TriangleCulling::NONE),
-                        assetLibrary->effect("effect/Basic.effect")
-                    ));
-        rootNode->addChild(node);
-        debugNode = node;
-    }
+        Vec3 childCenter = {
+            center.x + ((i & 1) ? halfSize : -halfSize),
+            center.y + ((i & 2) ? halfSize : -halfSize),
+            center.z + ((i & 4) ? halfSize : -halfSize)
+        };
 
-    if (_splitted)
-        for (auto octant : _children)
-            octant->generateVisual(assetLibrary, rootNode);
-
-    return rootNode;
+        createOctant(childCenter, halfSize, depth, octantId);
+    }
 }
 
 void
-OctTree::split()
+OctTree::updateBounds(uint objectId)
+{
+    auto box        = _objects[objectId].boundingBox->box();
+    auto bottomLeft = box->bottomLeft();
+    auto topRight   = box->topRight();
+
+    _centers[0][objectId] = (bottomLeft->x() + topRight->x()) * .5f;
+    _centers[1][objectId] = (bottomLeft->y() + topRight->y()) * .5f;
+    _centers[2][objectId] = (bottomLeft->z() + topRight->z()) * .5f;
+    _extents[0][objectId] = std::abs(topRight->x() - bottomLeft->x()) * .5f;
+    _extents[1][objectId] = std::abs(topRight->y() - bottomLeft->y()) * .5f;
+    _extents[2][objectId] = std::abs(topRight->z() - bottomLeft->z()) * .5f;
+}
+
+int
+OctTree::findOctant(uint objectId)
 {
-    this->_children.resize(8);
+    Vec3 center     = { _centers[0][objectId], _centers[1][objectId], _centers[2][objectId] };
+    float radius    = std::max(_extents[0][objectId], std::max(_extents[1][objectId], _extents[2][objectId]));
+    auto& root      = _octants[0];
 
-    float size = (float)_k * _worldSize / (powf(2.f, (float)_depth));
+    if (std::abs(center.x - root.center.x) > root.halfSize
+        || std::abs(center.y - root.center.y) > root.halfSize
+        || std::abs(center.z - root.center.z) > root.halfSize)
+        return 0;
 
-    for (uint x = 0; x < 2; ++x)
+    uint octantId = 0;
+
+    // descend while the node still fits in the loose bounds of the child containing its center
+    while (_octants[octantId].depth < _maxDepth && radius <= _octants[octantId].halfSize * .5f)
     {
-        for (uint y = 0; y < 2; ++y)
-        {
-            for (uint z = 0; z < 2; ++z)
-            {
-                uint index = x + (y << 1) + (z << 2);
-
-                _children[index] = OctTree::create(
-                    _worldSize,
-                    _maxDepth,
-                    math::Vector3::create(
-                        _center->x() + (x == 0 ? -size / 2 : size / 2),
-                        _center->y() + (y == 0 ? -size / 2 : size / 2),
-                        _center->z() + (z == 0 ? -size / 2 : size / 2)),
-                    _depth + 1);
-                _children[index]->_parent = shared_from_this();
-            }
-        }
+        if (_octants[octantId].firstChild == NO_OCTANT)
+            split(octantId);
+
+        const auto& octant = _octants[octantId];
+
+        octantId = octant.firstChild
+            + (center.x > octant.center.x ? 1 : 0)
+            + (center.y > octant.center.y ? 2 : 0)
+            + (center.z > octant.center.z ? 4 : 0);
     }
-    _splitted = true;
+
+    return octantId;
+}
+
+void
+OctTree::attach(uint objectId, int octantId)
+{
+    auto& object = _objects[objectId];
+    auto& octant = _octants[octantId];
+
+    object.octant = octantId;
+    object.indexInOctant = octant.objects.size();
+    octant.objects.push_back(objectId);
+
+    for (auto id = octantId; id != NO_OCTANT; id = _octants[id].parent)
+        ++_octants[id].numNodes;
+}
+
+void
+OctTree::detach(uint objectId)
+{
+    auto& object    = _objects[objectId];
+    auto& objects   = _octants[object.octant].objects;
+    auto lastId     = objects.back();
+
+    objects[object.indexInOctant] = lastId;
+    _objects[lastId].indexInOctant = object.indexInOctant;
+    objects.pop_back();
+
+    for (auto id = object.octant; id != NO_OCTANT; id = _octants[id].parent)
+        --_octants[id].numNodes;
+
+    object.octant = NO_OCTANT;
 }
 
 OctTree::Ptr
 OctTree::insert(std::shared_ptr<scene::Node> node)
 {
-    // already reference by the octTree
-    if (_nodeToOctant.find(node) != _nodeToOctant.end())
+    // already referenced by the octTree
+    if (_nodeToObject.find(node) != _nodeToObject.end())
         return shared_from_this();
 
     if (!node->hasComponent<component::BoundingBox>())
         node->addComponent(component::BoundingBox::create());
 
-    std::shared_ptr<component::BoundingBox> nodeBoundingBox = node->component<component::BoundingBox>();
-    std::shared_ptr<math::Matrix4x4>        modelToWorld    = node->component<component::Transform>()->modelToWorldMatrix(true);
+    uint objectId;
 
-    // insert
-    uint                                optimalDepth    = std::min(computeDepth(node), _maxDepth);
-    uint                                currentDepth    = 0;
-    OctTree::Ptr                        octant            = shared_from_this();
+    if (_freeObjects.empty())
+    {
+        objectId = _objects.size();
+        _objects.resize(objectId + 1);
+        for (uint i = 0; i < 3; ++i)
+        {
+            _centers[i].push_back(0.f);
+            _extents[i].push_back(0.f);
+        }
+    }
+    else
+    {
+        objectId = _freeObjects.back();
+        _freeObjects.pop_back();
+    }
+
+    auto& object = _objects[objectId];
+
+    object.node         = node;
+    object.boundingBox  = node->component<component::BoundingBox>();
+    object.invalid      = false;
+    object.modelToWorldChangedSlot = node->data()->propertyValueChanged("transform.modelToWorldMatrix")->connect(std::bind(
+        &OctTree::invalidate,
+        shared_from_this(),
+        objectId
+    ));
+    object.boundingBoxChangedSlot = object.boundingBox->changed()->connect(std::bind(
+        &OctTree::invalidate,
+        shared_from_this(),
+        objectId
+    ));
+
+    _nodeToObject[node] = objectId;
+    updateBounds(objectId);
+    attach(objectId, findOctant(objectId));
+    ++_revision;
+
+    return shared_from_this();
+}
+
+OctTree::Ptr
+OctTree::remove(std::shared_ptr<scene::Node> node)
+{
+    auto objectIt = _nodeToObject.find(node);
+
+    // not referenced by the octTree
+    if (objectIt == _nodeToObject.end())
+        return shared_from_this();
 
-    std::shared_ptr<math::Vector3>        newNodeCenter    = math::Vector3::create(
-        (nodeBoundingBox->box()->bottomLeft()->x() + nodeBoundingBox->box()->topRight()->x()) / 2,
-        (nodeBoundingBox->box()->bottomLeft()->y() + nodeBoundingBox->box()->topRight()->y()) / 2,
-        (nodeBoundingBox->box()->bottomLeft()->z() + nodeBoundingBox->box()->topRight()->z()) / 2);
+    auto objectId   = objectIt->second;
+    auto& object    = _objects[objectId];
 
-    for (currentDepth = 0; currentDepth != optimalDepth; ++currentDepth)
+    detach(objectId);
+    object.node                     = nullptr;
+    object.boundingBox              = nullptr;
+    object.modelToWorldChangedSlot  = nullptr;
+    object.boundingBoxChangedSlot   = nullptr;
+
+    if (object.invalid)
     {
-        if (!octant->_splitted)
-            octant->split();
+        object.invalid = false;
+        _invalidObjects.erase(std::find(_invalidObjects.begin(), _invalidObjects.end(), objectId));
+    }
 
-        uint xIndex = 0;
-        uint yIndex = 0;
-        uint zIndex = 0;
+    _nodeToObject.erase(objectIt);
+    _freeObjects.push_back(objectId);
+    ++_revision;
 
-        if (newNodeCenter->x() > octant->_center->x())
-            xIndex = 1;
+    return shared_from_this();
+}
 
-        if (newNodeCenter->y() > octant->_center->y())
-            yIndex = 1;
+OctTree::Ptr
+OctTree::clear()
+{
+    while (!_nodeToObject.empty())
+        remove(_nodeToObject.begin()->first);
 
-        if (newNodeCenter->z() > octant->_center->z())
-            zIndex = 1;
+    return shared_from_this();
+}
 
-        octant = octant->_children[xIndex + (yIndex << 1) + (zIndex << 2)];
+void
+OctTree::invalidate(uint objectId)
+{
+    auto& object = _objects[objectId];
+
+    if (!object.invalid)
+    {
+        object.invalid = true;
+        _invalidObjects.push_back(objectId);
     }
+}
 
-    octant->_content.push_back(node);
-    octant->addChildContent(node);
-    _nodeToOctant[node] = octant;
-    _matrixToNode[node->data()->get<std::shared_ptr<math::Matrix4x4>>("transform.modelToWorldMatrix")] = node;
+OctTree::Ptr
+OctTree::update()
+{
+    if (_invalidObjects.empty())
+        return shared_from_this();
 
-    if (_nodeToTransformChangedSlot.find(node) == _nodeToTransformChangedSlot.end())
+    for (auto objectId : _invalidObjects)
     {
-        _nodeToTransformChangedSlot[node] = node->data()->propertyValueChanged("transform.modelToWorldMatrix")->connect(std::bind(
-            &OctTree::nodeModelToWorldChanged,
-            shared_from_this(),
-            std::placeholders::_1,
-            std::placeholders::_2));
+        auto& object = _objects[objectId];
+
+        updateBounds(objectId);
+
+        auto octantId = findOctant(objectId);
+
+        object.invalid = false;
+        if (octantId != object.octant)
+        {
+            detach(objectId);
+            attach(objectId, octantId);
+        }
     }
 
+    _invalidObjects.clear();
+    ++_revision;
+
     return shared_from_this();
 }
 
-bool
-OctTree::nodeChangedOctant(std::shared_ptr<scene::Node> node)
+int
+OctTree::depth(std::shared_ptr<scene::Node> node) const
 {
-    Ptr                                        octant            = _nodeToOctant[node];
-    std::shared_ptr<component::BoundingBox> nodeBoundingBox = node->component<component::BoundingBox>();
-    std::shared_ptr<math::Vector3>            nodeCenter        = math::Vector3::create(
-        (nodeBoundingBox->box()->bottomLeft()->x() + nodeBoundingBox->box()->topRight()->x()) / 2,
-        (nodeBoundingBox->box()->bottomLeft()->y() + nodeBoundingBox->box()->topRight()->y()) / 2,
-        (nodeBoundingBox->box()->bottomLeft()->z() + nodeBoundingBox->box()->topRight()->z()) / 2);
-
-    if (sqrt(pow(nodeCenter->x() - octant->_center->x(), 2) + pow(nodeCenter->y() - octant->_center->y(), 2) + pow(nodeCenter->z() - octant->_center->z(), 2)) < octant->edgeLength())
-        return false;
-    return true;
+    auto objectIt = _nodeToObject.find(node);
+
+    if (objectIt == _nodeToObject.end())
+        return -1;
+
+    return _octants[_objects[objectIt->second].octant].depth;
 }
 
-void
-OctTree::nodeModelToWorldChanged(data::Container::Ptr    data,
-                                 const std::string&        propertyName)
+std::shared_ptr<scene::Node>
+OctTree::generateVisual(std::shared_ptr<file::AssetLibrary>     assetLibrary,
+                        std::shared_ptr<scene::Node>            rootNode)
 {
-    /*auto node        = _matrixToNode[data->get<std::shared_ptr<math::Matrix4x4>>(propertyName)];
-    auto octant        = _nodeToOctant[node];
+    if (!rootNode)
+        rootNode = scene::Node::create();
 
-    if (node && nodeChangedOctant(node)) // node is no more in the octant
+    for (auto& octant : _octants)
     {
-        _matrixToNode.erase(data->get<std::shared_ptr<math::Matrix4x4>>(propertyName));
-        _nodeToOctant.erase(node);
-        octant->_content.remove(node);
-        insert(node);
-    }*/
+        if (octant.objects.empty())
+            continue;
+
+        rootNode->addChild(scene::Node::create()
+            ->addComponent(component::Transform::create(math::Matrix4x4::create()
+                ->appendScale(octant.halfSize * 4.f - 0.1f)
+                ->appendTranslation(octant.center.x, octant.center.y, octant.center.z)))
+            ->addComponent(component::Surface::create(
+                geometry::CubeGeometry::create(assetLibrary->context()),
+                material::BasicMaterial::create()
+                    ->diffuseColor(0x00FF0030)
+                    ->blendingMode(render::Blending::Mode::ALPHA)
+                    ->triangleCulling(render::TriangleCulling::NONE),
+                assetLibrary->effect("effect/Basic.effect")
+            ))
+        );
+    }
+
+    return rootNode;
 }
 
 void
@@ -213,84 +351,174 @@ OctTree::testFrustum(std::shared_ptr<math::AbstractShape>                frustum
                      std::function<void(std::shared_ptr<scene::Node>)>    insideFrustumCallback,
                      std::function<void(std::shared_ptr<scene::Node>)>    outsideFustumCallback)
 {
-    ShapePosition result                    = frustum->testBoundingBox(_octantBox);
+    update();
+
+    if (_octants[0].numNodes != 0)
+        testOctant(0, frustum, insideFrustumCallback, outsideFustumCallback);
+}
 
-    if (result == ShapePosition::AROUND || result == ShapePosition::INSIDE)
+void
+OctTree::testOctant(uint                                                    octantId,
+                    std::shared_ptr<math::AbstractShape>                    frustum,
+                    std::function<void(std::shared_ptr<scene::Node>)>&      insideFrustumCallback,
+                    std::function<void(std::shared_ptr<scene::Node>)>&      outsideFustumCallback)
+{
+    // the root octant also holds the nodes outside of the world bounds: it is never culled as a whole
+    auto result = octantId == 0
+        ? ShapePosition::AROUND
+        : frustum->testBoundingBox(_octants[octantId].looseBox);
+
+    if (result == ShapePosition::INSIDE)
+        visitOctant(octantId, insideFrustumCallback);
+    else if (result != ShapePosition::AROUND)
+        visitOctant(octantId, outsideFustumCallback);
+    else
     {
-        if (_splitted)
+        for (auto objectId : _octants[octantId].objects)
         {
-            for (auto octantChild : _children)
-                octantChild->testFrustum(frustum, insideFrustumCallback, outsideFustumCallback);
+            auto& object        = _objects[objectId];
+            auto nodeResult     = frustum->testBoundingBox(object.boundingBox->box());
+
+            if (nodeResult == ShapePosition::INSIDE || nodeResult == ShapePosition::AROUND)
+                insideFrustumCallback(object.node);
+            else
+                outsideFustumCallback(object.node);
         }
 
-        for (auto node : _content)
-            insideFrustumCallback(node);
-    }
-    else
-    {
-        for (auto node : _childrenContent)
-            outsideFustumCallback(node);
-        for (auto node : _content)
-            insideFrustumCallback(node);
+        auto firstChild = _octants[octantId].firstChild;
+
+        if (firstChild != NO_OCTANT)
+            for (auto childId = firstChild; childId < firstChild + 8; ++childId)
+                if (_octants[childId].numNodes != 0)
+                    testOctant(childId, frustum, insideFrustumCallback, outsideFustumCallback);
     }
 }
 
-OctTree::Ptr
-OctTree::remove(std::shared_ptr<scene::Node> node)
+void
+OctTree::visit(std::function<void(std::shared_ptr<scene::Node>)> callback)
 {
-    // not reference by the octTree
-    if (_nodeToOctant.find(node) == _nodeToOctant.end())
-        return shared_from_this();
+    if (_octants[0].numNodes != 0)
+        visitOctant(0, callback);
+}
 
-    Ptr octant = _nodeToOctant[node];
+uint
+OctTree::testFrustumBatch(std::shared_ptr<math::Frustum>                     frustum,
+                          std::function<void(std::shared_ptr<scene::Node>)>  insideFrustumCallback,
+                          std::function<void(std::shared_ptr<scene::Node>)>  outsideFustumCallback)
+{
+    update();
 
-    octant->_content.remove(node);
+    const uint numObjects = _objects.size();
+    const float* centers[3] = { _centers[0].data(), _centers[1].data(), _centers[2].data() };
+    const float* extents[3] = { _extents[0].data(), _extents[1].data(), _extents[2].data() };
 
-    _nodeToOctant.erase(node);
-    _matrixToNode.erase(node->data()->get<math::Matrix4x4::Ptr>("transform.modelToWorldMatrix"));
+    _visibility.resize((numObjects + 31) >> 5);
+    frustum->testBoundingBoxes(centers, extents, numObjects, _visibility.data());
 
+    uint numVisible = 0;
 
-    return shared_from_this();
-}
+    for (uint objectId = 0; objectId < numObjects; ++objectId)
+    {
+        auto& node = _objects[objectId].node;
 
-uint
-OctTree::computeDepth(std::shared_ptr<scene::Node> node)
-{
-    component::Surface::Ptr surface = node->component<component::Surface>();
-    float                    radius    = computeRadius(node->component<component::BoundingBox>());
+        // free object ids are tested too, their result is ignored
+        if (node == nullptr)
+            continue;
 
-    return (uint)std::floor(std::log(_worldSize / radius) / std::log(2));
-}
+        if (_visibility[objectId >> 5] & (1u << (objectId & 31)))
+        {
+            ++numVisible;
+            insideFrustumCallback(node);
+        }
+        else
+            outsideFustumCallback(node);
+    }
 
-float
-OctTree::computeRadius(std::shared_ptr<component::BoundingBox> boundingBox)
-{
-    return std::max(boundingBox->box()->width() / 2.f,  std::max(boundingBox->box()->height() / 2.f, boundingBox->box()->depth() / 2.f));
+    return numVisible;
 }
 
-float
-OctTree::edgeLength()
+uint
+OctTree::cast(std::shared_ptr<math::Ray>                                    ray,
+              std::vector<std::pair<float, std::shared_ptr<scene::Node>>>&  hits,
+              float                                                         maxDistance)
 {
-    return (float)_k * (_worldSize / powf(2.f, (float)_depth));
-}
+    update();
+    hits.clear();
 
+    const auto origin       = ray->origin()->toVec3();
+    const auto direction    = ray->direction()->toVec3();
+    const Vec3 invDirection = { 1.f / direction.x, 1.f / direction.y, 1.f / direction.z };
+    float near;
+    float far;
 
-void
-OctTree::addChildContent(NodePtr node)
-{
-    if (_parent)
+    _octantStack.clear();
+    if (_octants[0].numNodes != 0)
+        _octantStack.push_back(0);
+
+    while (!_octantStack.empty())
     {
-        _parent->_childrenContent.push_back(node);
-        _parent->addChildContent(node);
+        auto octantId   = _octantStack.back();
+        auto& octant    = _octants[octantId];
+
+        _octantStack.pop_back();
+
+        // the root octant also holds the nodes outside of the world bounds: it is never skipped
+        if (octantId != 0)
+        {
+            const float looseHalfSize = octant.halfSize * 2.f;
+            const float min[3] = {
+                octant.center.x - looseHalfSize, octant.center.y - looseHalfSize, octant.center.z - looseHalfSize
+            };
+            const float max[3] = {
+                octant.center.x + looseHalfSize, octant.center.y + looseHalfSize, octant.center.z + looseHalfSize
+            };
+
+            if (!Ray::intersectBox(origin, invDirection, min, max, near, far) || near > maxDistance)
+                continue;
+        }
+
+        for (auto objectId : octant.objects)
+        {
+            const float min[3] = {
+                _centers[0][objectId] - _extents[0][objectId],
+                _centers[1][objectId] - _extents[1][objectId],
+                _centers[2][objectId] - _extents[2][objectId]
+            };
+            const float max[3] = {
+                _centers[0][objectId] + _extents[0][objectId],
+                _centers[1][objectId] + _extents[1][objectId],
+                _centers[2][objectId] + _extents[2][objectId]
+            };
+
+            if (Ray::intersectBox(origin, invDirection, min, max, near, far) && near <= maxDistance)
+                hits.push_back(std::make_pair(near, _objects[objectId].node));
+        }
+
+        if (octant.firstChild != NO_OCTANT)
+            for (auto childId = octant.firstChild; childId < octant.firstChild + 8; ++childId)
+                if (_octants[childId].numNodes != 0)
+                    _octantStack.push_back(childId);
     }
+
+    std::sort(
+        hits.begin(),
+        hits.end(),
+        [](const std::pair<float, NodePtr>& a, const std::pair<float, NodePtr>& b) { return a.first < b.first; }
+    );
+
+    return hits.size();
 }
 
 void
-OctTree::removeChildContent(NodePtr node)
+OctTree::visitOctant(uint octantId, std::function<void(std::shared_ptr<scene::Node>)>& callback)
 {
-    if (_parent)
-    {
-        _parent->_childrenContent.remove(node);
-        _parent->removeChildContent(node);
-    }
-}
\ No newline at end of file
+    for (auto objectId : _octants[octantId].objects)
+        callback(_objects[objectId].node);
+
+    auto firstChild = _octants[octantId].firstChild;
+
+    if (firstChild != NO_OCTANT)
+        for (auto childId = firstChild; childId < firstChild + 8; ++childId)
+            if (_octants[childId].numNodes != 0)
+                visitOctant(childId, callback);
+}
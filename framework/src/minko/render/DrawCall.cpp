@@ -36,6 +36,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/render/Priority.hpp"
 #include "minko/data/Container.hpp"
 #include "minko/math/Matrix4x4.hpp"
+#include "minko/math/Mat4.hpp"
+#include "minko/math/Vector4.hpp"
 #include "minko/render/Pass.hpp"
 #include "minko/data/Provider.hpp"
 #include "minko/data/ArrayProvider.hpp"
@@ -54,28 +56,33 @@ SamplerState DrawCall::_defaultSamplerState = SamplerState(WrapMode::CLAMP, Text
 
 DrawCall::DrawCall(Pass::Ptr pass) :
     _pass(pass),
-    _program(nullptr),
     _targetData(nullptr),
     _rendererData(nullptr),
     _rootData(nullptr),
-    _fullRootData(nullptr),
-    _fullRendererData(nullptr),
     _fullTargetData(nullptr),
+    _fullRendererData(nullptr),
+    _fullRootData(nullptr),
+    _program(nullptr),
     _formatFunction(nullptr),
-    _textureIds(MAX_NUM_TEXTURES, 0),
-    _textureLocations(MAX_NUM_TEXTURES, -1),
-    _textureWrapMode(MAX_NUM_TEXTURES, WrapMode::CLAMP),
-    _textureFilters(MAX_NUM_TEXTURES, TextureFilter::NEAREST),
-    _textureMipFilters(MAX_NUM_TEXTURES, MipFilter::NONE),
     _vertexBufferIds(MAX_NUM_VERTEXBUFFERS, 0),
     _vertexBufferLocations(MAX_NUM_VERTEXBUFFERS, -1),
     _vertexSizes(MAX_NUM_VERTEXBUFFERS, -1),
     _vertexAttributeSizes(MAX_NUM_VERTEXBUFFERS, -1),
     _vertexAttributeOffsets(MAX_NUM_VERTEXBUFFERS, -1),
+    _textureIds(MAX_NUM_TEXTURES, 0),
+    _textureLocations(MAX_NUM_TEXTURES, -1),
+    _textureWrapMode(MAX_NUM_TEXTURES, WrapMode::CLAMP),
+    _textureFilters(MAX_NUM_TEXTURES, TextureFilter::NEAREST),
+    _textureMipFilters(MAX_NUM_TEXTURES, MipFilter::NONE),
+    _instanceAttributes(),
+    _instances(),
+    _surfaceId(0),
+    _instanceData(),
+    _instanceBuffer(nullptr),
     _target(nullptr),
     _referenceChangedSlots(),
-    _macroChangedSlots(),
     _macroAddedOrRemovedSlots(),
+    _macroChangedSlots(),
     _indicesChangedSlot(nullptr),
     _layoutsPropertyChangedSlot(nullptr),
     _zsortNeeded(Signal<Ptr>::create()),
@@ -318,13 +325,20 @@ DrawCall::bindVertexAttribute(const std::string&    inputName,
     const auto& attributeBindings    = _pass->attributeBindings();
     auto        index                = vertexBufferIndex;
 
+    _instanceAttributes.erase(location);
+
     if (attributeBindings.count(inputName))
     {
         auto propertyName        = _formatFunction(std::get<0>(attributeBindings.at(inputName)));
         auto source                = std::get<1>(attributeBindings.at(inputName));
         const auto& container    = getContainer(ContainerId::FILTERED, source);
 
-        if (container && container->hasProperty(propertyName))
+        if (container && container->hasProperty(propertyName)
+            && !container->propertyHasType<VertexBuffer::Ptr>(propertyName, true))
+        {
+            bindInstanceAttribute(propertyName, container, location);
+        }
+        else if (container && container->hasProperty(propertyName))
         {
             auto vertexBuffer = container->get<VertexBuffer::Ptr>(propertyName);
             auto attributeName = propertyName.substr(propertyName.find_last_of('.') + 1);
@@ -358,6 +372,23 @@ DrawCall::bindVertexAttribute(const std::string&    inputName,
     }
 }
 
+void
+DrawCall::bindInstanceAttribute(const std::string&    propertyName,
+                                Container::Ptr        container,
+                                int                    location)
+{
+    InstanceAttribute attribute;
+
+    if (container->propertyHasType<Matrix4x4::Ptr>(propertyName, true))
+        attribute.matrix = container->get<Matrix4x4::Ptr>(propertyName);
+    else if (container->propertyHasType<Vector4::Ptr>(propertyName, true))
+        attribute.vector = container->get<Vector4::Ptr>(propertyName);
+    else
+        throw std::logic_error("unsupported per-instance vertex attribute type: " + propertyName);
+
+    _instanceAttributes[location] = attribute;
+}
+
 void
 DrawCall::bindTextureSampler(const std::string&        inputName,
                              int                    location,
@@ -442,27 +473,15 @@ DrawCall::bindUniform(const std::string&    inputName,
             if (container->hasProperty(propertyName))
             {
                 // This case corresponds to base types uniforms or individual members of an GLSL struct array.
+                auto propertyId = data::PropertyId::find(propertyName);
 
-                if (type == ProgramInputs::Type::float1)
-                    _uniformFloat[location]        = container->get<float>(propertyName);
-                else if (type == ProgramInputs::Type::float2)
-                    _uniformFloat2[location]    = container->get<Vector2::Ptr>(propertyName);
-                else if (type == ProgramInputs::Type::float3)
-                    _uniformFloat3[location]    = container->get<Vector3::Ptr>(propertyName);
-                else if (type == ProgramInputs::Type::float4)
-                    _uniformFloat4[location]    = container->get<Vector4::Ptr>(propertyName);
-                else if (type == ProgramInputs::Type::float16)
-                    _uniformFloat16[location]    = &(container->get<Matrix4x4::Ptr>(propertyName)->data()[0]);
-                else if (type == ProgramInputs::Type::int1)
-                    _uniformInt[location]        = container->get<int>(propertyName);
-                else if (type == ProgramInputs::Type::int2)
-                    _uniformInt2[location]        = container->get<Int2>(propertyName);
-                else if (type == ProgramInputs::Type::int3)
-                    _uniformInt3[location]        = container->get<Int3>(propertyName);
-                else if (type == ProgramInputs::Type::int4)
-                    _uniformInt4[location]        = container->get<Int4>(propertyName);
-                else
-                    throw std::logic_error("unsupported uniform type.");
+                bindUniformValue(container, propertyId, type, location);
+
+                // later changes of the property only need the resolved id, not the name formatting above
+                if (_referenceChangedSlots.count(propertyName) == 0)
+                    _referenceChangedSlots[propertyName].push_back(container->propertyReferenceChanged(propertyName)->connect(std::bind(
+                        &DrawCall::bindUniformValue, shared_from_this(), container, propertyId, type, location
+                    )));
             }
             else if (isArray)
             {
@@ -482,6 +501,34 @@ DrawCall::bindUniform(const std::string&    inputName,
     }
 }
 
+void
+DrawCall::bindUniformValue(Container::Ptr        container,
+                           uint                  propertyId,
+                           ProgramInputs::Type   type,
+                           int                   location)
+{
+    if (type == ProgramInputs::Type::float1)
+        _uniformFloat[location]        = container->get<float>(propertyId);
+    else if (type == ProgramInputs::Type::float2)
+        _uniformFloat2[location]    = container->get<Vector2::Ptr>(propertyId);
+    else if (type == ProgramInputs::Type::float3)
+        _uniformFloat3[location]    = container->get<Vector3::Ptr>(propertyId);
+    else if (type == ProgramInputs::Type::float4)
+        _uniformFloat4[location]    = container->get<Vector4::Ptr>(propertyId);
+    else if (type == ProgramInputs::Type::float16)
+        _uniformFloat16[location]    = &(container->get<Matrix4x4::Ptr>(propertyId)->data()[0]);
+    else if (type == ProgramInputs::Type::int1)
+        _uniformInt[location]        = container->get<int>(propertyId);
+    else if (type == ProgramInputs::Type::int2)
+        _uniformInt2[location]        = container->get<Int2>(propertyId);
+    else if (type == ProgramInputs::Type::int3)
+        _uniformInt3[location]        = container->get<Int3>(propertyId);
+    else if (type == ProgramInputs::Type::int4)
+        _uniformInt4[location]        = container->get<Int4>(propertyId);
+    else
+        throw std::logic_error("unsupported uniform type.");
+}
+
 void
 DrawCall::bindUniformArray(const std::string&    propertyName,
                            Container::Ptr        container,
@@ -613,6 +660,9 @@ DrawCall::reset()
     _vertexAttributeSizes    .resize(MAX_NUM_VERTEXBUFFERS, -1);
     _vertexAttributeOffsets    .resize(MAX_NUM_VERTEXBUFFERS, -1);
 
+    _instanceAttributes.clear();
+    _instances.clear();
+
     _indicesChangedSlot            = nullptr;
     _layoutsPropertyChangedSlot    = nullptr;
     _referenceChangedSlots.clear();
@@ -815,10 +865,210 @@ DrawCall::render(const AbstractContext::Ptr&    context,
     context->setScissorTest(_scissorTest, _scissorBox);
     context->setTriangleCulling(_triangleCulling);
 
+    if (_instanceAttributes.empty())
+        drawTriangles(context);
+    else if (!_instances.empty() && context->supportsInstancing())
+        drawInstances(context);
+    else
+    {
+        setInstanceAttributeValues(context, shared_from_this());
+        drawTriangles(context);
+
+        // no hardware instancing: the other instances still share the states bound above
+        for (auto& instance : _instances)
+        {
+            setInstanceAttributeValues(context, instance);
+            drawTriangles(context);
+        }
+    }
+}
+
+void
+DrawCall::drawTriangles(const AbstractContext::Ptr& context, uint numInstances)
+{
+    int indexBuffer;
+    int numTriangles;
+
     if (_program->indexBuffer() && _program->indexBuffer()->isReady())
-        context->drawTriangles(_program->indexBuffer()->id(), _program->indexBuffer()->data().size() / 3);
+    {
+        indexBuffer = _program->indexBuffer()->id();
+        numTriangles = _program->indexBuffer()->data().size() / 3;
+    }
     else if (_indexBuffer != -1)
-        context->drawTriangles(_indexBuffer, _numIndices / 3);
+    {
+        indexBuffer = _indexBuffer;
+        numTriangles = _numIndices / 3;
+    }
+    else
+        return;
+
+    if (numInstances > 1)
+        context->drawInstancedTriangles(indexBuffer, numTriangles, numInstances);
+    else
+        context->drawTriangles(indexBuffer, numTriangles);
+}
+
+void
+DrawCall::setInstanceAttributeValues(const AbstractContext::Ptr& context, Ptr instance)
+{
+    for (auto& locationAndAttribute : instance->_instanceAttributes)
+    {
+        const auto    location    = locationAndAttribute.first;
+        const auto&    attribute    = locationAndAttribute.second;
+
+        if (attribute.matrix)
+        {
+            // a mat4 attribute spans 4 locations, one per column
+            float columns[16];
+
+            Mat4::transpose(&attribute.matrix->data()[0], columns);
+            for (uint i = 0; i < 4; ++i)
+                context->setVertexAttributeValue(location + i, columns + (i << 2));
+        }
+        else
+        {
+            const auto&    vector        = attribute.vector;
+            const float    values[]    = { vector->x(), vector->y(), vector->z(), vector->w() };
+
+            context->setVertexAttributeValue(location, values);
+        }
+    }
+}
+
+void
+DrawCall::drawInstances(const AbstractContext::Ptr& context)
+{
+    uint instanceSize = 0;
+
+    for (auto& locationAndAttribute : _instanceAttributes)
+        instanceSize += locationAndAttribute.second.matrix ? 16 : 4;
+
+    const uint numInstances = _instances.size() + 1;
+    const uint size = numInstances * instanceSize;
+
+    if (_instanceBuffer == nullptr || _instanceData.size() < size)
+    {
+        _instanceData.resize(std::max<uint>(size, _instanceData.size() << 1));
+        _instanceBuffer = VertexBuffer::create(context, _instanceData);
+        _instanceBuffer->disposeData();
+    }
+
+    auto data = &_instanceData[0];
+
+    for (uint i = 0; i < numInstances; ++i)
+        for (auto& locationAndAttribute : (i == 0 ? this : _instances[i - 1].get())->_instanceAttributes)
+        {
+            const auto& attribute = locationAndAttribute.second;
+
+            if (attribute.matrix)
+            {
+                Mat4::transpose(&attribute.matrix->data()[0], data);
+                data += 16;
+            }
+            else
+            {
+                data[0] = attribute.vector->x();
+                data[1] = attribute.vector->y();
+                data[2] = attribute.vector->z();
+                data[3] = attribute.vector->w();
+                data += 4;
+            }
+        }
+
+    context->uploadVertexBufferData(_instanceBuffer->id(), 0, size, &_instanceData[0]);
+
+    uint offset = 0;
+
+    for (auto& locationAndAttribute : _instanceAttributes)
+    {
+        const uint location = locationAndAttribute.first;
+        const uint numLocations = locationAndAttribute.second.matrix ? 4 : 1;
+
+        for (uint i = 0; i < numLocations; ++i, offset += 4)
+        {
+            context->setVertexBufferAt(location + i, _instanceBuffer->id(), 4, instanceSize, offset);
+            context->setVertexAttributeDivisor(location + i, 1);
+        }
+    }
+
+    drawTriangles(context, numInstances);
+
+    // restore per-vertex attributes for the next draw calls
+    for (auto& locationAndAttribute : _instanceAttributes)
+    {
+        const uint location = locationAndAttribute.first;
+        const uint numLocations = locationAndAttribute.second.matrix ? 4 : 1;
+
+        for (uint i = 0; i < numLocations; ++i)
+        {
+            context->setVertexAttributeDivisor(location + i, 0);
+            context->setVertexBufferAt(location + i, 0, 0, 0, 0);
+        }
+    }
+}
+
+bool
+DrawCall::canBeInstancedWith(Ptr drawCall) const
+{
+    if (_program != drawCall->_program
+        || _instanceAttributes.empty()
+        || _instanceAttributes.size() != drawCall->_instanceAttributes.size())
+        return false;
+
+    for (auto it1 = _instanceAttributes.cbegin(), it2 = drawCall->_instanceAttributes.cbegin();
+         it1 != _instanceAttributes.end();
+         ++it1, ++it2)
+        if (it1->first != it2->first || !it1->second.matrix != !it2->second.matrix)
+            return false;
+
+    return _indexBuffer == drawCall->_indexBuffer
+        && _numIndices == drawCall->_numIndices
+        && _target == drawCall->_target
+        && _layouts == drawCall->_layouts
+        && _vertexBufferIds == drawCall->_vertexBufferIds
+        && _vertexBufferLocations == drawCall->_vertexBufferLocations
+        && _vertexSizes == drawCall->_vertexSizes
+        && _vertexAttributeSizes == drawCall->_vertexAttributeSizes
+        && _vertexAttributeOffsets == drawCall->_vertexAttributeOffsets
+        && _textureIds == drawCall->_textureIds
+        && _textureLocations == drawCall->_textureLocations
+        && _textureWrapMode == drawCall->_textureWrapMode
+        && _textureFilters == drawCall->_textureFilters
+        && _textureMipFilters == drawCall->_textureMipFilters
+        && _blendMode == drawCall->_blendMode
+        && _colorMask == drawCall->_colorMask
+        && _depthMask == drawCall->_depthMask
+        && _depthFunc == drawCall->_depthFunc
+        && _triangleCulling == drawCall->_triangleCulling
+        && _stencilFunc == drawCall->_stencilFunc
+        && _stencilRef == drawCall->_stencilRef
+        && _stencilMask == drawCall->_stencilMask
+        && _stencilFailOp == drawCall->_stencilFailOp
+        && _stencilZFailOp == drawCall->_stencilZFailOp
+        && _stencilZPassOp == drawCall->_stencilZPassOp
+        && _scissorTest == drawCall->_scissorTest
+        && _scissorBox.x == drawCall->_scissorBox.x
+        && _scissorBox.y == drawCall->_scissorBox.y
+        && _scissorBox.width == drawCall->_scissorBox.width
+        && _scissorBox.height == drawCall->_scissorBox.height
+        && _uniformFloat == drawCall->_uniformFloat
+        && _uniformFloat2 == drawCall->_uniformFloat2
+        && _uniformFloat3 == drawCall->_uniformFloat3
+        && _uniformFloat4 == drawCall->_uniformFloat4
+        && _uniformFloat16 == drawCall->_uniformFloat16
+        && _uniformInt == drawCall->_uniformInt
+        && _uniformInt2 == drawCall->_uniformInt2
+        && _uniformInt3 == drawCall->_uniformInt3
+        && _uniformInt4 == drawCall->_uniformInt4
+        && _uniformFloats == drawCall->_uniformFloats
+        && _uniformFloats2 == drawCall->_uniformFloats2
+        && _uniformFloats3 == drawCall->_uniformFloats3
+        && _uniformFloats4 == drawCall->_uniformFloats4
+        && _uniformFloats16 == drawCall->_uniformFloats16
+        && _uniformInts == drawCall->_uniformInts
+        && _uniformInts2 == drawCall->_uniformInts2
+        && _uniformInts3 == drawCall->_uniformInts3
+        && _uniformInts4 == drawCall->_uniformInts4;
 }
 
 Container::Ptr
@@ -840,6 +1090,12 @@ DrawCall::getEyeSpacePosition(Vector3::Ptr output)
     return _zSorter->getEyeSpacePosition(output);
 }
 
+Vec3
+DrawCall::eyeSpacePosition()
+{
+    return _zSorter->eyeSpacePosition();
+}
+
 void
 DrawCall::trackMacros()
 {
@@ -37,9 +37,9 @@ using namespace minko::component;
 using namespace minko::data;
 
 /*static*/ const unsigned int                                    DrawCallPool::NUM_FALLBACK_ATTEMPTS        = 32;
-/*static*/ std::unordered_map<DrawCall::Ptr, Vector3::Ptr>        DrawCallPool::_cachedDrawcallPositions;
 
 std::unordered_map<std::string, std::pair<std::string, int>>    DrawCallPool::_variablePropertyNameToPosition;
+/*static*/ const uint                                            DrawCallPool::NO_TARGET_RANK = 0x7f;
 
 
 DrawCallPool::DrawCallPool(Renderer::Ptr renderer):
@@ -52,6 +52,11 @@ DrawCallPool::DrawCallPool(Renderer::Ptr renderer):
     _drawcallToMacroChangedSlot(),
     _drawcallToZSortNeededSlot(),
     _drawCalls(),
+    _sortKeys(),
+    _sortKeysTmp(),
+    _targetIds(),
+    _sortedDrawCalls(),
+    _instancedDrawCalls(),
     _dirtyDrawCalls(),
     _mustZSort(true),
     _surfaceToTechniqueChangedSlot(),
@@ -73,7 +78,7 @@ DrawCallPool::initialize()
     });
 }
 
-const std::list<DrawCall::Ptr>&
+const std::vector<DrawCall::Ptr>&
 DrawCallPool::drawCalls()
 {
     const bool doZSort = _mustZSort || !_toCollect.empty();
@@ -97,62 +102,185 @@ DrawCallPool::drawCalls()
     _toCollect.clear();
 
     if (doZSort)
-    {
-        _cachedDrawcallPositions.clear();
-        _drawCalls.sort(&DrawCallPool::compareDrawCalls);
-    }
+        sortDrawCalls();
     _mustZSort = false;
 
-    return _drawCalls;
+    return groupInstances() ? _instancedDrawCalls : _drawCalls;
 }
 
-/*static*/
 bool
-DrawCallPool::compareDrawCalls(DrawCall::Ptr a,
-                               DrawCall::Ptr b)
+DrawCallPool::groupInstances()
 {
-    const float    aPriority            = a->priority();
-    const float    bPriority            = b->priority();
-    const bool    arePrioritiesEqual    = fabsf(aPriority - bPriority) < 1e-3f;
+    // consecutive draw calls that only differ by their per-instance attributes are rendered
+    // by the first one of the group, the sort keys keep such draw calls next to each other
+    const auto numDrawCalls = _drawCalls.size();
+    auto hasInstances = false;
+
+    _instancedDrawCalls.clear();
 
-    if (!arePrioritiesEqual)
-        return aPriority > bPriority;
+    if (std::none_of(_drawCalls.begin(), _drawCalls.end(), [](const DrawCallPtr& d){ return d->instanceable(); }))
+        return false;
 
-    if (a->zSorted() || b->zSorted())
+    for (uint i = 0; i < numDrawCalls;)
     {
-        static Vector3::Ptr aPosition = Vector3::create();
-        static Vector3::Ptr bPosition = Vector3::create();
+        auto& drawCall = _drawCalls[i];
+        auto& instances = drawCall->instances();
+        auto j = i + 1;
 
-        getDrawcallEyePosition(a, aPosition);
-        getDrawcallEyePosition(b, bPosition);
+        // culled or occluded draw calls are neither rendered nor rendered as instances
+        if (!_renderer->renderable(drawCall->surfaceId()))
+        {
+            ++i;
+            continue;
+        }
 
-        return aPosition->z() > bPosition->z();
+        instances.clear();
+        if (drawCall->instanceable())
+            while (j < numDrawCalls && drawCall->canBeInstancedWith(_drawCalls[j]))
+            {
+                if (_renderer->renderable(_drawCalls[j]->surfaceId()))
+                {
+                    _drawCalls[j]->instances().clear();
+                    instances.push_back(_drawCalls[j]);
+                }
+                ++j;
+            }
+
+        hasInstances = hasInstances || !instances.empty();
+        _instancedDrawCalls.push_back(drawCall);
+        i = j;
     }
+
+    if (!hasInstances)
+        _instancedDrawCalls.clear();
+
+    return hasInstances;
+}
+
+void
+DrawCallPool::sortDrawCalls()
+{
+    const auto numDrawCalls = _drawCalls.size();
+
+    // the ids of the render targets are not dense enough to be packed in the keys: they are ranked first
+    _targetIds.clear();
+    for (auto& drawCall : _drawCalls)
+        if (drawCall->target())
+            _targetIds.push_back(drawCall->target()->id());
+    std::sort(_targetIds.begin(), _targetIds.end(), std::greater<int>());
+    _targetIds.erase(std::unique(_targetIds.begin(), _targetIds.end()), _targetIds.end());
+
+    // flat pass: each key (and thus each eye space depth) is computed exactly once per sort
+    _sortKeys.resize(numDrawCalls);
+    for (uint i = 0; i < numDrawCalls; ++i)
+    {
+        const auto& target = _drawCalls[i]->target();
+        const auto targetRank = target ? getTargetRank(_targetIds, target->id()) : NO_TARGET_RANK;
+
+        _sortKeys[i] = std::make_pair(getDrawCallSortKey(_drawCalls[i], targetRank), i);
+    }
+
+    radixSort(_sortKeys, _sortKeysTmp);
+
+    _sortedDrawCalls.resize(numDrawCalls);
+    for (uint i = 0; i < numDrawCalls; ++i)
+        _sortedDrawCalls[i] = std::move(_drawCalls[_sortKeys[i].second]);
+
+    _drawCalls.swap(_sortedDrawCalls);
+    _sortedDrawCalls.clear();
+}
+
+// Maps a float onto an unsigned integer with the same ordering.
+static inline
+uint
+getSortableFloatBits(float value)
+{
+    uint bits;
+
+    std::memcpy(&bits, &value, sizeof(float));
+
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+/*static*/
+uint
+DrawCallPool::getTargetRank(const std::vector<int>& targetIds, int targetId)
+{
+    auto rank = std::lower_bound(targetIds.begin(), targetIds.end(), targetId, std::greater<int>()) - targetIds.begin();
+
+    // beyond NO_TARGET_RANK render targets, the last ones share a rank but still precede the back buffer
+    return std::min<uint>(rank, NO_TARGET_RANK - 1);
+}
+
+/*static*/
+uint64_t
+DrawCallPool::getDrawCallSortKey(DrawCall::Ptr drawCall, uint targetRank)
+{
+    // Draw calls are rendered in increasing key order:
+    // [63..32] priority, the higher the priority the earlier the draw call
+    // [31]     set for z-sorted draw calls
+    // [30..0]  z-sorted: eye space depth, back to front
+    //          otherwise: render target rank (render targets by decreasing id, then the back buffer),
+    //          program then index buffer
+    uint64_t key = uint64_t(~getSortableFloatBits(drawCall->priority())) << 32;
+
+    if (drawCall->zSorted())
+        key |= 0x80000000u | (~getSortableFloatBits(drawCall->eyeSpacePosition().z) >> 1);
     else
     {
-        // ordered by target texture id, if any
-        return a->target() && (!b->target() || (a->target()->id() > b->target()->id()));
+        const auto program = reinterpret_cast<uintptr_t>(drawCall->program().get());
+
+        key |= uint64_t(targetRank & 0x7fu) << 24;
+        key |= ((program >> 4) & 0xfffu) << 12;
+        key |= drawCall->indexBuffer() & 0xfffu;
     }
+
+    return key;
 }
 
 /*static*/
-Vector3::Ptr
-DrawCallPool::getDrawcallEyePosition(DrawCall::Ptr drawcall,
-                                     Vector3::Ptr output)
+void
+DrawCallPool::radixSort(std::vector<std::pair<uint64_t, uint>>& keys,
+                        std::vector<std::pair<uint64_t, uint>>& tmp)
 {
-    const auto foundPositionIt = _cachedDrawcallPositions.find(drawcall);
+    const auto numKeys = keys.size();
+
+    if (numKeys < 2)
+        return;
+
+    uint histograms[8][256];
+
+    std::memset(histograms, 0, sizeof(histograms));
+    for (auto& key : keys)
+        for (auto byte = 0; byte < 8; ++byte)
+            ++histograms[byte][(key.first >> (byte << 3)) & 0xff];
+
+    tmp.resize(numKeys);
 
-    if (foundPositionIt != _cachedDrawcallPositions.end())
+    // stable LSD passes, 8 bits at a time
+    for (auto byte = 0; byte < 8; ++byte)
     {
-        if (output == nullptr)
-            output = Vector3::create(foundPositionIt->second);
-        else
-            output->copyFrom(foundPositionIt->second);
+        auto& histogram = histograms[byte];
+        const auto shift = byte << 3;
+
+        // skip the pass when all the keys share the same digit
+        if (histogram[(keys[0].first >> shift) & 0xff] == numKeys)
+            continue;
+
+        uint offset = 0;
+        for (auto digit = 0; digit < 256; ++digit)
+        {
+            auto count = histogram[digit];
+
+            histogram[digit] = offset;
+            offset += count;
+        }
+
+        for (auto& key : keys)
+            tmp[histogram[(key.first >> shift) & 0xff]++] = key;
 
-        return output;
+        keys.swap(tmp);
     }
-    else
-        return drawcall->getEyeSpacePosition(output);
 }
 
 void
@@ -174,13 +302,6 @@ DrawCallPool::addSurface(Surface::Ptr surface)
         std::placeholders::_2,
         std::placeholders::_3))));
 
-    _surfaceToVisibilityChangedSlots.insert(std::pair<SurfacePtr, VisibilityChanged::Slot>(surface, surface->computedVisibilityChanged()->connect(std::bind(
-        &DrawCallPool::visibilityChangedHandler,
-        shared_from_this(),
-        std::placeholders::_1,
-        std::placeholders::_2,
-        std::placeholders::_3))));
-
     // drawcall variable monitoring handlers
 
     auto geometrySlot        = surface->geometry()->data()->indexChanged()->connect(std::bind(
@@ -261,7 +382,8 @@ DrawCallPool::visibilityChangedHandler(Surface::Ptr        surface,
     if (renderer != _renderer && renderer != nullptr)
         return;
 
-    bool visible = surface->visible(_renderer) && surface->computedVisibility(_renderer);
+    // the computed visibility is not handled here: Renderer::render() skips the culled surfaces
+    bool visible = surface->visible(_renderer);
 
     if (visible && _invisibleSurfaces.find(surface) != _invisibleSurfaces.end()) // visible and already wasn't visible before
     {
@@ -313,6 +435,7 @@ DrawCallPool::generateDrawCall(Surface::Ptr    surface,
 
         if (drawCall)
         {
+            drawCall->surfaceId(surface->id());
             _surfaceToDrawCalls[surface].push_back(drawCall);
 
             _drawcallToSurface[drawCall] = surface;
@@ -548,7 +671,8 @@ DrawCallPool::deleteDrawCalls(Surface::Ptr surface)
         _drawcallToMacroChangedSlot.erase(drawCall);
         _drawcallToZSortNeededSlot.erase(drawCall);
 
-        _drawCalls.remove(drawCall);
+        _drawCalls.erase(std::remove(_drawCalls.begin(), _drawCalls.end(), drawCall), _drawCalls.end());
+        drawCall->instances().clear();
         _dirtyDrawCalls.erase(drawCall);
     }
 }
@@ -225,23 +225,28 @@ DrawCallZSorter::recordIfPositionalMembers(Container::Ptr        container,
 Vector3::Ptr
 DrawCallZSorter::getEyeSpacePosition(Vector3::Ptr output)  const
 {
-    static auto localPos    = Vector3::create();
-    static auto modelView    = Matrix4x4::create();
+    if (output == nullptr)
+        output = Vector3::create();
+
+    return output->copyFrom(eyeSpacePosition());
+}
+
+Vec3
+DrawCallZSorter::eyeSpacePosition() const
+{
+    static auto localPos = Vector3::create();
 
     if (_vertexPositions.second)
-        localPos = _vertexPositions.second->centerPosition(localPos);
+        _vertexPositions.second->centerPosition(localPos);
     else
         localPos->setTo(0.0f, 0.0f, 0.0f);
 
-    if (_modelToWorldMatrix.second)
-        modelView->copyFrom(_modelToWorldMatrix.second);
-    else
-        modelView->identity();
+    Mat4 modelView = _modelToWorldMatrix.second
+        ? _modelToWorldMatrix.second->toMat4()
+        : Mat4::identity();
 
     if (_worldToScreenMatrix.second)
-        modelView->append(_worldToScreenMatrix.second);
-
-    output = modelView->transform(localPos, output);
+        Mat4::multiply(&_worldToScreenMatrix.second->data()[0], modelView.m, modelView.m);
 
-    return output;
+    return modelView.transformPoint(localPos->toVec3());
 }
\ No newline at end of file
@@ -21,6 +21,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 #include "minko/Common.hpp"
 #include "minko/Signal.hpp"
+#include "minko/math/Vec3.hpp"
 
 namespace minko
 {
@@ -93,6 +94,9 @@ namespace minko
             std::shared_ptr<math::Vector3>
             getEyeSpacePosition(std::shared_ptr<math::Vector3> output = nullptr) const;
 
+            math::Vec3
+            eyeSpacePosition() const;
+
         private:
             DrawCallZSorter(DrawCallPtr drawcall);
 
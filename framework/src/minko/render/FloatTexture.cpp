@@ -0,0 +1,137 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "minko/render/FloatTexture.hpp"
+
+#include "minko/render/AbstractContext.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+FloatTexture::FloatTexture(AbstractContext::Ptr    context,
+                           uint                    width,
+                           uint                    height,
+                           const std::string&      filename) :
+    AbstractTexture(
+        TextureType::Texture2D,
+        context,
+        width,
+        height,
+        TextureFormat::RGBA32F,
+        false,
+        false,
+        false,
+        filename
+    ),
+    _data(width * height * 4, 0.f),
+    _isDirty(true)
+{
+}
+
+void
+FloatTexture::data(unsigned char*    data,
+                   int               widthGPU,
+                   int               heightGPU)
+{
+    if (widthGPU >= 0 || heightGPU >= 0)
+        resize(
+            widthGPU >= 0 ? widthGPU : _widthGPU,
+            heightGPU >= 0 ? heightGPU : _heightGPU,
+            false
+        );
+
+    _data.resize(_widthGPU * _heightGPU * 4);
+    std::memcpy(&_data[0], data, _data.size() * sizeof(float));
+
+    _isDirty = true;
+}
+
+void
+FloatTexture::resize(unsigned int width, unsigned int height, bool resizeSmoothly)
+{
+    if (width > MAX_SIZE || !math::isp2(width))
+        throw std::invalid_argument("width");
+    if (height > MAX_SIZE || !math::isp2(height))
+        throw std::invalid_argument("height");
+
+    if (width == _widthGPU && height == _heightGPU)
+        return;
+
+    std::vector<float> data(width * height * 4, 0.f);
+
+    if (!_data.empty())
+    {
+        const auto rowSize  = std::min(width, _widthGPU) * 4;
+
+        for (uint y = 0; y < std::min(height, _heightGPU); ++y)
+            std::copy(
+                _data.begin() + y * _widthGPU * 4,
+                _data.begin() + y * _widthGPU * 4 + rowSize,
+                data.begin() + y * width * 4
+            );
+    }
+
+    _data.swap(data);
+
+    _width      = width;
+    _widthGPU   = width;
+    _height     = height;
+    _heightGPU  = height;
+
+    // the GPU storage has a fixed size, it is reallocated by the next upload
+    if (_id != -1)
+    {
+        _context->deleteTexture(_id);
+        _id = -1;
+    }
+
+    _isDirty = true;
+}
+
+void
+FloatTexture::upload()
+{
+    if (_id == -1)
+        _id = _context->createFloatTexture(_widthGPU, _heightGPU);
+
+    if (!_data.empty())
+        _context->uploadFloatTexture2dData(_id, _widthGPU, _heightGPU, &_data[0]);
+
+    _isDirty = false;
+}
+
+void
+FloatTexture::dispose()
+{
+    if (_id != -1)
+    {
+        _context->deleteTexture(_id);
+        _id = -1;
+    }
+
+    disposeData();
+}
+
+void
+FloatTexture::disposeData()
+{
+    _data.clear();
+    _data.shrink_to_fit();
+}
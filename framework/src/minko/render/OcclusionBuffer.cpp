@@ -0,0 +1,351 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/render/OcclusionBuffer.hpp"
+#include "minko/math/Mat4.hpp"
+
+#if defined(MINKO_AVX2)
+# include <immintrin.h>
+#elif defined(MINKO_SSE2)
+# include <emmintrin.h>
+#endif
+
+using namespace minko;
+using namespace minko::math;
+using namespace minko::render;
+
+namespace
+{
+    // edge functions (e = a * x + b * y + c, positive inside) and depth plane of a triangle,
+    // bounding rectangle clamped to the buffer
+    struct TriangleSetup
+    {
+        float   a[3];
+        float   b[3];
+        float   c[3];
+        float   zx;
+        float   zy;
+        float   z0;
+        int     minX;
+        int     maxX;
+        int     minY;
+        int     maxY;
+    };
+
+    inline
+    void
+    setupEdge(TriangleSetup& setup, uint edge, const Vec3& v0, const Vec3& v1)
+    {
+        setup.a[edge] = v0.y - v1.y;
+        setup.b[edge] = v1.x - v0.x;
+        setup.c[edge] = v0.x * v1.y - v0.y * v1.x;
+    }
+
+    bool
+    setupTriangle(Vec3 a, Vec3 b, Vec3 c, uint width, uint height, TriangleSetup& setup)
+    {
+        float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+
+        if (std::abs(area) < 1e-8f)
+            return false;
+
+        // both faces are rasterized: counter-clockwise order so that the edge functions are positive inside
+        if (area < 0.f)
+        {
+            std::swap(b, c);
+            area = -area;
+        }
+
+        setup.minX = std::max(0, (int)std::floor(std::min(a.x, std::min(b.x, c.x))));
+        setup.maxX = std::min((int)width - 1, (int)std::floor(std::max(a.x, std::max(b.x, c.x))));
+        setup.minY = std::max(0, (int)std::floor(std::min(a.y, std::min(b.y, c.y))));
+        setup.maxY = std::min((int)height - 1, (int)std::floor(std::max(a.y, std::max(b.y, c.y))));
+
+        if (setup.minX > setup.maxX || setup.minY > setup.maxY)
+            return false;
+
+        // edge i is opposite to vertex i, so that e[i] / area is the barycentric weight of vertex i
+        setupEdge(setup, 0, b, c);
+        setupEdge(setup, 1, c, a);
+        setupEdge(setup, 2, a, b);
+
+        const float invArea = 1.f / area;
+
+        setup.zx = (a.z * setup.a[0] + b.z * setup.a[1] + c.z * setup.a[2]) * invArea;
+        setup.zy = (a.z * setup.b[0] + b.z * setup.b[1] + c.z * setup.b[2]) * invArea;
+        setup.z0 = (a.z * setup.c[0] + b.z * setup.c[1] + c.z * setup.c[2]) * invArea;
+
+        // the depth written at the center of a pixel is the farthest one of the triangle plane over that pixel
+        setup.z0 += .5f * (std::abs(setup.zx) + std::abs(setup.zy));
+
+        return true;
+    }
+}
+
+OcclusionBuffer::OcclusionBuffer(uint width, uint height) :
+    _width((std::max(width, 4u) + 3) & ~3u),
+    _height(std::max(height, 1u)),
+    _levels(),
+    _levelWidths(),
+    _levelHeights(),
+    _clipVertices()
+{
+    auto levelWidth = _width;
+    auto levelHeight = _height;
+
+    while (true)
+    {
+        _levels.push_back(std::vector<float>(levelWidth * levelHeight, 1.f));
+        _levelWidths.push_back(levelWidth);
+        _levelHeights.push_back(levelHeight);
+
+        if (levelWidth == 1 && levelHeight == 1)
+            break;
+
+        levelWidth = (levelWidth + 1) >> 1;
+        levelHeight = (levelHeight + 1) >> 1;
+    }
+}
+
+OcclusionBuffer::Ptr
+OcclusionBuffer::clear()
+{
+    for (auto& level : _levels)
+        std::fill(level.begin(), level.end(), 1.f);
+
+    return shared_from_this();
+}
+
+OcclusionBuffer::Ptr
+OcclusionBuffer::rasterize(const float*             modelToScreen,
+                           const float*             vertices,
+                           uint                     numVertices,
+                           uint                     vertexSize,
+                           uint                     positionOffset,
+                           const unsigned short*    indices,
+                           uint                     numIndices)
+{
+    _clipVertices.resize(numVertices);
+
+    for (uint i = 0; i < numVertices; ++i)
+    {
+        const float* position = vertices + i * vertexSize + positionOffset;
+        Vec4 p = { position[0], position[1], position[2], 1.f };
+
+        _clipVertices[i] = Mat4::transform(modelToScreen, p);
+    }
+
+    auto& depth = _levels[0];
+
+    for (uint i = 0; i + 2 < numIndices; i += 3)
+    {
+        Vec3 screen[3];
+        bool clipped = false;
+
+        for (uint j = 0; j < 3 && !clipped; ++j)
+        {
+            const auto& p = _clipVertices[indices[i + j]];
+
+            if (p.w <= 0.f || p.z < -p.w)
+                clipped = true;
+            else
+            {
+                const float invW = 1.f / p.w;
+
+                screen[j].x = (p.x * invW * .5f + .5f) * _width;
+                screen[j].y = (p.y * invW * .5f + .5f) * _height;
+                screen[j].z = p.z * invW * .5f + .5f;
+            }
+        }
+
+        if (!clipped)
+            rasterizeTriangle(screen[0], screen[1], screen[2], &depth[0], _width, _height);
+    }
+
+    return shared_from_this();
+}
+
+OcclusionBuffer::Ptr
+OcclusionBuffer::buildHierarchy()
+{
+    for (uint level = 1; level < _levels.size(); ++level)
+    {
+        const auto& source = _levels[level - 1];
+        const auto sourceWidth = _levelWidths[level - 1];
+        const auto sourceHeight = _levelHeights[level - 1];
+        auto& destination = _levels[level];
+        const auto width = _levelWidths[level];
+        const auto height = _levelHeights[level];
+
+        for (uint y = 0; y < height; ++y)
+        {
+            const auto y0 = y << 1;
+            const auto y1 = std::min(y0 + 1, sourceHeight - 1);
+
+            for (uint x = 0; x < width; ++x)
+            {
+                const auto x0 = x << 1;
+                const auto x1 = std::min(x0 + 1, sourceWidth - 1);
+
+                destination[y * width + x] = std::max(
+                    std::max(source[y0 * sourceWidth + x0], source[y0 * sourceWidth + x1]),
+                    std::max(source[y1 * sourceWidth + x0], source[y1 * sourceWidth + x1])
+                );
+            }
+        }
+    }
+
+    return shared_from_this();
+}
+
+bool
+OcclusionBuffer::testBox(const float* worldToScreen, const Vec3& min, const Vec3& max) const
+{
+    float minX = std::numeric_limits<float>::max();
+    float minY = std::numeric_limits<float>::max();
+    float maxX = -std::numeric_limits<float>::max();
+    float maxY = -std::numeric_limits<float>::max();
+    float minDepth = std::numeric_limits<float>::max();
+
+    for (uint i = 0; i < 8; ++i)
+    {
+        Vec4 corner = { (i & 1) ? max.x : min.x, (i & 2) ? max.y : min.y, (i & 4) ? max.z : min.z, 1.f };
+        auto p = Mat4::transform(worldToScreen, corner);
+
+        // the box crosses the near plane: it cannot be hidden
+        if (p.w <= 0.f || p.z < -p.w)
+            return true;
+
+        const float invW = 1.f / p.w;
+        const float x = (p.x * invW * .5f + .5f) * _width;
+        const float y = (p.y * invW * .5f + .5f) * _height;
+
+        minX = std::min(minX, x);
+        maxX = std::max(maxX, x);
+        minY = std::min(minY, y);
+        maxY = std::max(maxY, y);
+        minDepth = std::min(minDepth, p.z * invW * .5f + .5f);
+    }
+
+    // off screen boxes are left to frustum culling
+    if (maxX < 0.f || maxY < 0.f || minX >= (float)_width || minY >= (float)_height)
+        return true;
+
+    // occluders cover the pixels whose center they cover: along their edges, a pixel the box shows through
+    // may hold their depth, but its neighbor beyond the edge does not
+    const uint x0 = (uint)std::max(0.f, minX - 1.f);
+    const uint y0 = (uint)std::max(0.f, minY - 1.f);
+    const uint x1 = (uint)std::min((float)(_width - 1), maxX + 1.f);
+    const uint y1 = (uint)std::min((float)(_height - 1), maxY + 1.f);
+    uint level = 0;
+
+    // coarsest level where the box covers at most 4x4 texels
+    while (level + 1 < _levels.size() && ((x1 >> level) - (x0 >> level) > 3 || (y1 >> level) - (y0 >> level) > 3))
+        ++level;
+
+    const auto& depth = _levels[level];
+    const auto width = _levelWidths[level];
+
+    for (uint y = y0 >> level; y <= y1 >> level; ++y)
+        for (uint x = x0 >> level; x <= x1 >> level; ++x)
+            if (minDepth <= depth[y * width + x])
+                return true;
+
+    return false;
+}
+
+/*static*/
+void
+OcclusionBuffer::rasterizeTriangle(const Vec3& a, const Vec3& b, const Vec3& c, float* depth, uint width, uint height)
+{
+#ifdef MINKO_SSE2
+    TriangleSetup setup;
+
+    if (!setupTriangle(a, b, c, width, height, setup))
+        return;
+
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 offsets = _mm_set_ps(3.5f, 2.5f, 1.5f, .5f);
+    const __m128 a0 = _mm_set1_ps(setup.a[0]);
+    const __m128 a1 = _mm_set1_ps(setup.a[1]);
+    const __m128 a2 = _mm_set1_ps(setup.a[2]);
+    const __m128 zx = _mm_set1_ps(setup.zx);
+
+    for (int y = setup.minY; y <= setup.maxY; ++y)
+    {
+        const float py = y + .5f;
+        const __m128 rowE0 = _mm_set1_ps(setup.b[0] * py + setup.c[0]);
+        const __m128 rowE1 = _mm_set1_ps(setup.b[1] * py + setup.c[1]);
+        const __m128 rowE2 = _mm_set1_ps(setup.b[2] * py + setup.c[2]);
+        const __m128 rowZ = _mm_set1_ps(setup.zy * py + setup.z0);
+        float* row = depth + y * width;
+
+        // 4 pixels aligned blocks: the buffer width is a multiple of 4
+        for (int x = setup.minX & ~3; x <= setup.maxX; x += 4)
+        {
+            const __m128 px = _mm_add_ps(_mm_set1_ps((float)x), offsets);
+            const __m128 e0 = _mm_add_ps(_mm_mul_ps(a0, px), rowE0);
+            const __m128 e1 = _mm_add_ps(_mm_mul_ps(a1, px), rowE1);
+            const __m128 e2 = _mm_add_ps(_mm_mul_ps(a2, px), rowE2);
+            const __m128 z = _mm_add_ps(_mm_mul_ps(zx, px), rowZ);
+            const __m128 previous = _mm_loadu_ps(row + x);
+            __m128 mask = _mm_and_ps(
+                _mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_cmpge_ps(e1, zero)),
+                _mm_and_ps(_mm_cmpge_ps(e2, zero), _mm_cmplt_ps(z, previous))
+            );
+
+            _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(mask, z), _mm_andnot_ps(mask, previous)));
+        }
+    }
+#else
+    rasterizeTriangleScalar(a, b, c, depth, width, height);
+#endif
+}
+
+/*static*/
+void
+OcclusionBuffer::rasterizeTriangleScalar(const Vec3& a, const Vec3& b, const Vec3& c, float* depth, uint width, uint height)
+{
+    TriangleSetup setup;
+
+    if (!setupTriangle(a, b, c, width, height, setup))
+        return;
+
+    for (int y = setup.minY; y <= setup.maxY; ++y)
+    {
+        const float py = y + .5f;
+        const float rowE0 = setup.b[0] * py + setup.c[0];
+        const float rowE1 = setup.b[1] * py + setup.c[1];
+        const float rowE2 = setup.b[2] * py + setup.c[2];
+        const float rowZ = setup.zy * py + setup.z0;
+        float* row = depth + y * width;
+
+        for (int x = setup.minX; x <= setup.maxX; ++x)
+        {
+            const float px = x + .5f;
+            const float z = setup.zx * px + rowZ;
+
+            if (setup.a[0] * px + rowE0 >= 0.f
+                && setup.a[1] * px + rowE1 >= 0.f
+                && setup.a[2] * px + rowE2 >= 0.f
+                && z < row[x])
+                row[x] = z;
+        }
+    }
+}
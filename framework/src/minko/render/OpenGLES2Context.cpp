@@ -69,6 +69,41 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 # include <EGL/egl.h>
 #endif
 
+// hardware instancing entry points, checked against the driver extensions at runtime
+#if defined(GL_ES_VERSION_2_0)
+# if (MINKO_PLATFORM == MINKO_PLATFORM_HTML5 || defined(MINKO_PLUGIN_ANGLE)) && defined(GL_ANGLE_instanced_arrays)
+#  define MINKO_GL_INSTANCING_EXTENSION     "GL_ANGLE_instanced_arrays"
+#  define MINKO_GL_VERTEX_ATTRIB_DIVISOR    glVertexAttribDivisorANGLE
+#  define MINKO_GL_DRAW_ELEMENTS_INSTANCED  glDrawElementsInstancedANGLE
+# elif MINKO_PLATFORM == MINKO_PLATFORM_IOS && defined(GL_EXT_instanced_arrays)
+#  define MINKO_GL_INSTANCING_EXTENSION     "GL_EXT_instanced_arrays"
+#  define MINKO_GL_VERTEX_ATTRIB_DIVISOR    glVertexAttribDivisorEXT
+#  define MINKO_GL_DRAW_ELEMENTS_INSTANCED  glDrawElementsInstancedEXT
+# endif
+#elif defined(GL_VERSION_3_3)
+# define MINKO_GL_INSTANCING_EXTENSION      "GL_ARB_instanced_arrays"
+# define MINKO_GL_VERTEX_ATTRIB_DIVISOR     glVertexAttribDivisor
+# define MINKO_GL_DRAW_ELEMENTS_INSTANCED   glDrawElementsInstanced
+#elif defined(GL_ARB_instanced_arrays) && defined(GL_ARB_draw_instanced)
+# define MINKO_GL_INSTANCING_EXTENSION      "GL_ARB_instanced_arrays"
+# define MINKO_GL_VERTEX_ATTRIB_DIVISOR     glVertexAttribDivisorARB
+# define MINKO_GL_DRAW_ELEMENTS_INSTANCED   glDrawElementsInstancedARB
+#endif
+
+// asynchronous read back through a pixel pack buffer, checked against the driver at runtime
+#if defined(GL_ES_VERSION_3_0) || defined(GL_VERSION_3_0)
+# define MINKO_GL_ASYNC_READ_PIXELS
+#endif
+
+// internal format of the float textures: OES_texture_float only accepts the unsized format
+#if defined(GL_ES_VERSION_2_0)
+# define MINKO_GL_FLOAT_TEXTURE_FORMAT      GL_RGBA
+#elif defined(GL_VERSION_3_0)
+# define MINKO_GL_FLOAT_TEXTURE_FORMAT      GL_RGBA32F
+#elif defined(GL_ARB_texture_float)
+# define MINKO_GL_FLOAT_TEXTURE_FORMAT      GL_RGBA32F_ARB
+#endif
+
 using namespace minko;
 using namespace minko::render;
 
@@ -139,6 +174,13 @@ std::unordered_map<TextureFormat, unsigned int> OpenGLES2Context::_availableText
 
 OpenGLES2Context::OpenGLES2Context() :
     _errorsEnabled(false),
+    _supportsInstancing(false),
+    _supportsAsyncReadPixels(false),
+    _supportsFloatTextures(false),
+    _readPixelsBuffer(0),
+    _readPixelsSize(0),
+    _readPixelsPending(false),
+    _readPixelsData(),
     _textures(),
     _textureSizes(),
     _textureHasMipmaps(),
@@ -148,10 +190,11 @@ OpenGLES2Context::OpenGLES2Context() :
     _viewportHeight(0),
     _currentTarget(0),
     _currentIndexBuffer(0),
-    _currentVertexBuffer(8, 0),
-    _currentVertexSize(8, -1),
-    _currentVertexStride(8, -1),
-    _currentVertexOffset(8, -1),
+    _currentVertexBuffer(16, 0),
+    _currentVertexSize(16, -1),
+    _currentVertexStride(16, -1),
+    _currentVertexOffset(16, -1),
+    _currentVertexDivisor(16, 0),
     _currentBoundTexture(0),
     _currentTexture(8, 0),
     _currentProgram(0),
@@ -168,7 +211,15 @@ OpenGLES2Context::OpenGLES2Context() :
     _currentStencilMask(0x1),
     _currentStencilFailOp(StencilOperation::UNSET),
     _currentStencilZFailOp(StencilOperation::UNSET),
-    _currentStencilZPassOp(StencilOperation::UNSET)
+    _currentStencilZPassOp(StencilOperation::UNSET),
+    _currentScissorTest(false),
+    _currentScissorBox(),
+    _uniformValues(),
+    _currentUniformValues(nullptr),
+    _numIssuedStateChanges(0),
+    _numSkippedStateChanges(0),
+    _lastFrameNumIssuedStateChanges(0),
+    _lastFrameNumSkippedStateChanges(0)
 {
 #if (MINKO_PLATFORM == MINKO_PLATFORM_WINDOWS) && !defined(MINKO_PLUGIN_ANGLE) && !defined(MINKO_PLUGIN_OFFSCREEN)
     glewInit();
@@ -200,6 +251,30 @@ OpenGLES2Context::OpenGLES2Context() :
     _viewportWidth = viewportSettings[2];
     _viewportHeight = viewportSettings[3];
 
+#ifdef MINKO_GL_INSTANCING_EXTENSION
+    _supportsInstancing = supportsExtension(MINKO_GL_INSTANCING_EXTENSION);
+#endif
+
+#ifdef MINKO_GL_ASYNC_READ_PIXELS
+# ifdef GL_ES_VERSION_2_0
+    _supportsAsyncReadPixels = glVersion != nullptr && std::string(glVersion).find("OpenGL ES 3") == 0;
+# else
+    _supportsAsyncReadPixels = supportsExtension("GL_ARB_pixel_buffer_object") && supportsExtension("GL_ARB_map_buffer_range");
+# endif
+#endif
+
+#ifdef MINKO_GL_FLOAT_TEXTURE_FORMAT
+    int numVertexTextureUnits = 0;
+
+    glGetIntegerv(GL_MAX_VERTEX_TEXTURE_IMAGE_UNITS, &numVertexTextureUnits);
+# ifdef GL_ES_VERSION_2_0
+    _supportsFloatTextures = numVertexTextureUnits > 0 && supportsExtension("GL_OES_texture_float");
+# else
+    _supportsFloatTextures = numVertexTextureUnits > 0
+        && ((glVersion != nullptr && glVersion[0] >= '3') || supportsExtension("GL_ARB_texture_float"));
+# endif
+#endif
+
     setColorMask(true);
     setDepthTest(true, CompareMode::LESS);
     setStencilTest(CompareMode::ALWAYS, 0, 0x1, StencilOperation::KEEP, StencilOperation::KEEP, StencilOperation::KEEP);
@@ -224,6 +299,9 @@ OpenGLES2Context::~OpenGLES2Context()
 
     for (auto& fragmentShader : _fragmentShaders)
         glDeleteShader(fragmentShader);
+
+    if (_readPixelsBuffer != 0)
+        glDeleteBuffers(1, &_readPixelsBuffer);
 }
 
 void
@@ -232,7 +310,7 @@ OpenGLES2Context::configureViewport(const uint x,
                                     const uint width,
                                     const uint height)
 {
-    if (x != _viewportX || y != _viewportY || width != _viewportWidth || height != _viewportHeight)
+    if (countStateChange(x != _viewportX || y != _viewportY || width != _viewportWidth || height != _viewportHeight))
     {
         _viewportX = x;
         _viewportY = y;
@@ -307,12 +385,17 @@ OpenGLES2Context::present()
     //glFlush();
 
     setRenderToBackBuffer();
+
+    _lastFrameNumIssuedStateChanges = _numIssuedStateChanges;
+    _lastFrameNumSkippedStateChanges = _numSkippedStateChanges;
+    _numIssuedStateChanges = 0;
+    _numSkippedStateChanges = 0;
 }
 
 void
 OpenGLES2Context::drawTriangles(const uint indexBuffer, const int numTriangles)
 {
-    if (_currentIndexBuffer != indexBuffer)
+    if (countStateChange(_currentIndexBuffer != indexBuffer))
     {
         _currentIndexBuffer = indexBuffer;
 
@@ -333,6 +416,59 @@ OpenGLES2Context::drawTriangles(const uint indexBuffer, const int numTriangles)
     checkForErrors();
 }
 
+void
+OpenGLES2Context::drawInstancedTriangles(const uint indexBuffer, const int numTriangles, const uint numInstances)
+{
+#ifdef MINKO_GL_INSTANCING_EXTENSION
+    if (!_supportsInstancing)
+        throw std::logic_error("hardware instancing is not supported");
+
+    if (countStateChange(_currentIndexBuffer != indexBuffer))
+    {
+        _currentIndexBuffer = indexBuffer;
+
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+    }
+
+    MINKO_GL_DRAW_ELEMENTS_INSTANCED(GL_TRIANGLES, numTriangles * 3, GL_UNSIGNED_SHORT, (void*)0, numInstances);
+
+    checkForErrors();
+#else
+    throw std::logic_error("hardware instancing is not supported");
+#endif
+}
+
+void
+OpenGLES2Context::setVertexAttributeDivisor(const uint position, const uint divisor)
+{
+    if (!countStateChange(_currentVertexDivisor[position] != divisor))
+        return;
+
+#ifdef MINKO_GL_INSTANCING_EXTENSION
+    if (!_supportsInstancing)
+        throw std::logic_error("hardware instancing is not supported");
+
+    _currentVertexDivisor[position] = divisor;
+
+    MINKO_GL_VERTEX_ATTRIB_DIVISOR(position, divisor);
+
+    checkForErrors();
+#else
+    throw std::logic_error("hardware instancing is not supported");
+#endif
+}
+
+void
+OpenGLES2Context::setVertexAttributeValue(const uint position, const float* values)
+{
+    // the attribute must not be read from a vertex buffer anymore
+    setVertexBufferAt(position, 0, 0, 0, 0);
+
+    glVertexAttrib4fv(position, values);
+
+    checkForErrors();
+}
+
 const uint
 OpenGLES2Context::createVertexBuffer(const uint size)
 {
@@ -431,10 +567,10 @@ OpenGLES2Context::setVertexBufferAt(const uint    position,
 {
     auto currentVertexBuffer = _currentVertexBuffer[position];
 
-    if (currentVertexBuffer == vertexBuffer
-        && _currentVertexSize[position] == size
-        && _currentVertexStride[position] == stride
-        && _currentVertexOffset[position] == position)
+    if (!countStateChange(currentVertexBuffer != vertexBuffer
+        || _currentVertexSize[position] != size
+        || _currentVertexStride[position] != stride
+        || _currentVertexOffset[position] != offset))
         return ;
 
     _currentVertexBuffer[position] = vertexBuffer;
@@ -723,6 +859,66 @@ OpenGLES2Context::uploadTexture2dData(uint         texture,
     checkForErrors();
 }
 
+uint
+OpenGLES2Context::createFloatTexture(unsigned int width, unsigned int height)
+{
+    if (!_supportsFloatTextures)
+        throw std::logic_error("Float textures are not supported.");
+
+    // make sure width and height are powers of 2
+    if (!((width != 0) && !(width & (width - 1))))
+        throw std::invalid_argument("width");
+    if (!((height != 0) && !(height & (height - 1))))
+        throw std::invalid_argument("height");
+
+    uint texture;
+
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+
+    _currentBoundTexture = texture;
+
+    // float textures are not filterable without OES_texture_float_linear
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+    _textures.push_back(texture);
+    _textureSizes[texture]            = std::make_pair(width, height);
+    _textureHasMipmaps[texture]        = false;
+    _textureTypes[texture]            = TextureType::Texture2D;
+
+    _currentWrapMode[texture]        = WrapMode::CLAMP;
+    _currentTextureFilter[texture]    = TextureFilter::NEAREST;
+    _currentMipFilter[texture]        = MipFilter::NONE;
+
+#ifdef MINKO_GL_FLOAT_TEXTURE_FORMAT
+    glTexImage2D(GL_TEXTURE_2D, 0, MINKO_GL_FLOAT_TEXTURE_FORMAT, width, height, 0, GL_RGBA, GL_FLOAT, 0);
+#endif
+
+    checkForErrors();
+
+    return texture;
+}
+
+void
+OpenGLES2Context::uploadFloatTexture2dData(uint            texture,
+                                           unsigned int    width,
+                                           unsigned int    height,
+                                           const float*    data)
+{
+    assert(getTextureType(texture) == TextureType::Texture2D);
+
+    glBindTexture(GL_TEXTURE_2D, texture);
+    // the storage was allocated by createFloatTexture(), only its content is replaced
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA, GL_FLOAT, data);
+
+    _currentBoundTexture = texture;
+
+    checkForErrors();
+}
+
 void
 OpenGLES2Context::uploadCubeTextureData(uint                texture,
                                         CubeTexture::Face    face,
@@ -855,8 +1051,8 @@ OpenGLES2Context::setTextureAt(uint    position,
         ? GL_TEXTURE_2D
         : GL_TEXTURE_CUBE_MAP;
 
-    if (_currentTexture[position] != texture ||
-        _currentBoundTexture != texture)
+    if (countStateChange(_currentTexture[position] != texture ||
+        _currentBoundTexture != texture))
     {
         glActiveTexture(GL_TEXTURE0 + position);
         glBindTexture(glTarget, texture);
@@ -865,7 +1061,7 @@ OpenGLES2Context::setTextureAt(uint    position,
         _currentBoundTexture        = texture;
     }
 
-    if (textureIsValid && location >= 0)
+    if (textureIsValid && location >= 0 && uniformChanged(location, &position, 1))
         glUniform1i(location, position);
 
     checkForErrors();
@@ -888,7 +1084,7 @@ OpenGLES2Context::setSamplerStateAt(uint            position,
     if (!_textureHasMipmaps[texture])
         mipFiltering = MipFilter::NONE;
 
-    if (_currentWrapMode[texture] != wrapping)
+    if (countStateChange(_currentWrapMode[texture] != wrapping))
     {
         _currentWrapMode[texture] = wrapping;
 
@@ -908,7 +1104,7 @@ OpenGLES2Context::setSamplerStateAt(uint            position,
         }
     }
 
-    if (_currentTextureFilter[texture] != filtering || _currentMipFilter[texture] != mipFiltering)
+    if (countStateChange(_currentTextureFilter[texture] != filtering || _currentMipFilter[texture] != mipFiltering))
     {
         _currentTextureFilter[texture] = filtering;
         _currentMipFilter[texture] = mipFiltering;
@@ -982,6 +1178,11 @@ OpenGLES2Context::linkProgram(const uint program)
 {
     glLinkProgram(program);
 
+    // linking resets all the uniforms of the program
+    _uniformValues.erase(program);
+    if (_currentProgram == program)
+        _currentUniformValues = &_uniformValues[program];
+
 #ifdef DEBUG
     auto errors = getProgramInfoLogs(program);
 
@@ -998,6 +1199,9 @@ void
 OpenGLES2Context::deleteProgram(const uint program)
 {
     _programs.erase(std::find(_programs.begin(), _programs.end(), program));
+    _uniformValues.erase(program);
+    if (_currentProgram == program)
+        _currentUniformValues = nullptr;
 
     glDeleteProgram(program);
 
@@ -1030,10 +1234,11 @@ OpenGLES2Context::compileShader(const uint shader)
 void
 OpenGLES2Context::setProgram(const uint program)
 {
-    if (_currentProgram == program)
+    if (!countStateChange(_currentProgram != program))
         return;
 
     _currentProgram = program;
+    _currentUniformValues = &_uniformValues[program];
 
     glUseProgram(program);
 
@@ -1301,6 +1506,9 @@ OpenGLES2Context::getProgramInfoLogs(const uint program)
 void
 OpenGLES2Context::setUniform(uint location, int value)
 {
+    if (!uniformChanged(location, &value, 1))
+        return;
+
     glUniform1i(location, value);
     checkForErrors();
 }
@@ -1308,6 +1516,11 @@ OpenGLES2Context::setUniform(uint location, int value)
 void
 OpenGLES2Context::setUniform(uint location, int v1, int v2)
 {
+    const int values[] = { v1, v2 };
+
+    if (!uniformChanged(location, values, 2))
+        return;
+
     glUniform2i(location, v1, v2);
     checkForErrors();
 }
@@ -1315,6 +1528,11 @@ OpenGLES2Context::setUniform(uint location, int v1, int v2)
 void
 OpenGLES2Context::setUniform(uint location, int v1, int v2, int v3)
 {
+    const int values[] = { v1, v2, v3 };
+
+    if (!uniformChanged(location, values, 3))
+        return;
+
     glUniform3i(location, v1, v2, v3);
     checkForErrors();
 }
@@ -1322,6 +1540,11 @@ OpenGLES2Context::setUniform(uint location, int v1, int v2, int v3)
 void
 OpenGLES2Context::setUniform(uint location, int v1, int v2, int v3, int v4)
 {
+    const int values[] = { v1, v2, v3, v4 };
+
+    if (!uniformChanged(location, values, 4))
+        return;
+
     glUniform4i(location, v1, v2, v3, v4);
     checkForErrors();
 }
@@ -1329,6 +1552,9 @@ OpenGLES2Context::setUniform(uint location, int v1, int v2, int v3, int v4)
 void
 OpenGLES2Context::setUniform(uint location, float value)
 {
+    if (!uniformChanged(location, &value, 1))
+        return;
+
     glUniform1f(location, value);
     checkForErrors();
 }
@@ -1336,6 +1562,11 @@ OpenGLES2Context::setUniform(uint location, float value)
 void
 OpenGLES2Context::setUniform(uint location, float v1, float v2)
 {
+    const float values[] = { v1, v2 };
+
+    if (!uniformChanged(location, values, 2))
+        return;
+
     glUniform2f(location, v1, v2);
     checkForErrors();
 }
@@ -1343,6 +1574,11 @@ OpenGLES2Context::setUniform(uint location, float v1, float v2)
 void
 OpenGLES2Context::setUniform(uint location, float v1, float v2, float v3)
 {
+    const float values[] = { v1, v2, v3 };
+
+    if (!uniformChanged(location, values, 3))
+        return;
+
     glUniform3f(location, v1, v2, v3);
     checkForErrors();
 }
@@ -1350,6 +1586,11 @@ OpenGLES2Context::setUniform(uint location, float v1, float v2, float v3)
 void
 OpenGLES2Context::setUniform(uint location, float v1, float v2, float v3, float v4)
 {
+    const float values[] = { v1, v2, v3, v4 };
+
+    if (!uniformChanged(location, values, 4))
+        return;
+
     glUniform4f(location, v1, v2, v3, v4);
     checkForErrors();
 }
@@ -1357,6 +1598,9 @@ OpenGLES2Context::setUniform(uint location, float v1, float v2, float v3, float
 void
 OpenGLES2Context::setUniforms(uint location, uint size, const float* values)
 {
+    if (!uniformChanged(location, values, size))
+        return;
+
     glUniform1fv(location, size, values);
     checkForErrors();
 }
@@ -1364,6 +1608,9 @@ OpenGLES2Context::setUniforms(uint location, uint size, const float* values)
 void
 OpenGLES2Context::setUniforms2(uint location, uint size, const float* values)
 {
+    if (!uniformChanged(location, values, size * 2))
+        return;
+
     glUniform2fv(location, size, values);
     checkForErrors();
 }
@@ -1371,6 +1618,9 @@ OpenGLES2Context::setUniforms2(uint location, uint size, const float* values)
 void
 OpenGLES2Context::setUniforms3(uint location, uint size, const float* values)
 {
+    if (!uniformChanged(location, values, size * 3))
+        return;
+
     glUniform3fv(location, size, values);
     checkForErrors();
 }
@@ -1378,6 +1628,9 @@ OpenGLES2Context::setUniforms3(uint location, uint size, const float* values)
 void
 OpenGLES2Context::setUniforms4(uint location, uint size, const float* values)
 {
+    if (!uniformChanged(location, values, size * 4))
+        return;
+
     glUniform4fv(location, size, values);
     checkForErrors();
 }
@@ -1385,6 +1638,9 @@ OpenGLES2Context::setUniforms4(uint location, uint size, const float* values)
 void
 OpenGLES2Context::setUniforms(uint location, uint size, const int* values)
 {
+    if (!uniformChanged(location, values, size))
+        return;
+
     glUniform1iv(location, size, values);
     checkForErrors();
 }
@@ -1392,6 +1648,9 @@ OpenGLES2Context::setUniforms(uint location, uint size, const int* values)
 void
 OpenGLES2Context::setUniforms2(uint location, uint size, const int* values)
 {
+    if (!uniformChanged(location, values, size * 2))
+        return;
+
     glUniform2iv(location, size, values);
     checkForErrors();
 }
@@ -1399,6 +1658,9 @@ OpenGLES2Context::setUniforms2(uint location, uint size, const int* values)
 void
 OpenGLES2Context::setUniforms3(uint location, uint size, const int* values)
 {
+    if (!uniformChanged(location, values, size * 3))
+        return;
+
     glUniform3iv(location, size, values);
     checkForErrors();
 }
@@ -1406,6 +1668,9 @@ OpenGLES2Context::setUniforms3(uint location, uint size, const int* values)
 void
 OpenGLES2Context::setUniforms4(uint location, uint size, const int* values)
 {
+    if (!uniformChanged(location, values, size * 4))
+        return;
+
     glUniform4iv(location, size, values);
     checkForErrors();
 }
@@ -1413,6 +1678,9 @@ OpenGLES2Context::setUniforms4(uint location, uint size, const int* values)
 void
 OpenGLES2Context::setUniform(const uint& location, const uint& size, bool transpose, const float* values)
 {
+    if (!uniformChanged(location, values, size << 4))
+        return;
+
 #ifdef GL_ES_VERSION_2_0
 
     if (transpose)
@@ -1461,7 +1729,7 @@ OpenGLES2Context::setUniform(const uint& location, const uint& size, bool transp
 void
 OpenGLES2Context::setBlendMode(Blending::Source source, Blending::Destination destination)
 {
-    if ((static_cast<uint>(source) | static_cast<uint>(destination)) != static_cast<uint>(_currentBlendMode))
+    if (countStateChange((static_cast<uint>(source) | static_cast<uint>(destination)) != static_cast<uint>(_currentBlendMode)))
     {
         _currentBlendMode = (Blending::Mode)((uint)source | (uint)destination);
 
@@ -1477,7 +1745,7 @@ OpenGLES2Context::setBlendMode(Blending::Source source, Blending::Destination de
 void
 OpenGLES2Context::setBlendMode(Blending::Mode blendMode)
 {
-    if (blendMode != _currentBlendMode)
+    if (countStateChange(blendMode != _currentBlendMode))
     {
         _currentBlendMode = blendMode;
 
@@ -1493,7 +1761,7 @@ OpenGLES2Context::setBlendMode(Blending::Mode blendMode)
 void
 OpenGLES2Context::setDepthTest(bool depthMask, CompareMode depthFunc)
 {
-    if (depthMask != _currentDepthMask || depthFunc != _currentDepthFunc)
+    if (countStateChange(depthMask != _currentDepthMask || depthFunc != _currentDepthFunc))
     {
         _currentDepthMask = depthMask;
         _currentDepthFunc = depthFunc;
@@ -1508,7 +1776,7 @@ OpenGLES2Context::setDepthTest(bool depthMask, CompareMode depthFunc)
 void
 OpenGLES2Context::setColorMask(bool colorMask)
 {
-    if (_currentColorMask != colorMask)
+    if (countStateChange(_currentColorMask != colorMask))
     {
         _currentColorMask = colorMask;
 
@@ -1527,9 +1795,9 @@ OpenGLES2Context::setStencilTest(CompareMode stencilFunc,
                                  StencilOperation stencilZPassOp)
 {
 #ifndef MINKO_NO_STENCIL
-    if (stencilFunc != _currentStencilFunc
+    if (countStateChange(stencilFunc != _currentStencilFunc
         || stencilRef != _currentStencilRef
-        || stencilMask != _currentStencilMask)
+        || stencilMask != _currentStencilMask))
     {
         _currentStencilFunc    = stencilFunc;
         _currentStencilRef    = stencilRef;
@@ -1540,9 +1808,9 @@ OpenGLES2Context::setStencilTest(CompareMode stencilFunc,
 
     checkForErrors();
 
-    if (stencilFailOp != _currentStencilFailOp
+    if (countStateChange(stencilFailOp != _currentStencilFailOp
         || stencilZFailOp != _currentStencilZFailOp
-        || stencilZPassOp != _currentStencilZPassOp)
+        || stencilZPassOp != _currentStencilZPassOp))
     {
         _currentStencilFailOp    = stencilFailOp;
         _currentStencilZFailOp    = stencilZFailOp;
@@ -1564,38 +1832,110 @@ OpenGLES2Context::readPixels(unsigned int x, unsigned int y, unsigned int width,
     checkForErrors();
 }
 
+void
+OpenGLES2Context::readPixelsBegin(unsigned int x, unsigned int y, unsigned int width, unsigned int height)
+{
+    const uint size = width * height * 4;
+
+#ifdef MINKO_GL_ASYNC_READ_PIXELS
+    if (_supportsAsyncReadPixels)
+    {
+        if (_readPixelsBuffer == 0)
+            glGenBuffers(1, &_readPixelsBuffer);
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, _readPixelsBuffer);
+        if (size != _readPixelsSize)
+            glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+        // with a pixel pack buffer bound, the last argument is an offset in the buffer
+        glReadPixels(x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        checkForErrors();
+
+        _readPixelsSize = size;
+        _readPixelsPending = true;
+
+        return;
+    }
+#endif
+
+    _readPixelsData.resize(size);
+    readPixels(x, y, width, height, &_readPixelsData[0]);
+    _readPixelsSize = size;
+    _readPixelsPending = true;
+}
+
+bool
+OpenGLES2Context::readPixelsEnd(unsigned char* pixels)
+{
+    if (!_readPixelsPending)
+        return false;
+
+    _readPixelsPending = false;
+
+#ifdef MINKO_GL_ASYNC_READ_PIXELS
+    if (_supportsAsyncReadPixels)
+    {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, _readPixelsBuffer);
+
+        auto data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, _readPixelsSize, GL_MAP_READ_BIT);
+
+        if (data != nullptr)
+        {
+            std::memcpy(pixels, data, _readPixelsSize);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        checkForErrors();
+
+        return data != nullptr;
+    }
+#endif
+
+    std::memcpy(pixels, &_readPixelsData[0], _readPixelsSize);
+
+    return true;
+}
+
 void
 OpenGLES2Context::setScissorTest(bool                        scissorTest,
                                  const render::ScissorBox&    scissorBox)
 {
-    if (scissorTest)
+    if (countStateChange(scissorTest != _currentScissorTest))
     {
-        glEnable(GL_SCISSOR_TEST);
+        _currentScissorTest = scissorTest;
 
-        int        x = 0;
-        int        y = 0;
-        uint    width = 0;
-        uint    height = 0;
+        if (scissorTest)
+            glEnable(GL_SCISSOR_TEST);
+        else
+            glDisable(GL_SCISSOR_TEST);
+    }
+
+    if (scissorTest)
+    {
+        render::ScissorBox box;
 
         if (scissorBox.width < 0 || scissorBox.height < 0)
         {
-            x        = _viewportX;
-            y        = _viewportY;
-            width    = _viewportWidth;
-            height    = _viewportHeight;
+            box.x        = _viewportX;
+            box.y        = _viewportY;
+            box.width    = _viewportWidth;
+            box.height    = _viewportHeight;
         }
         else
+            box = scissorBox;
+
+        if (countStateChange(box.x != _currentScissorBox.x
+            || box.y != _currentScissorBox.y
+            || box.width != _currentScissorBox.width
+            || box.height != _currentScissorBox.height))
         {
-            x        = scissorBox.x;
-            y        = scissorBox.y;
-            width    = scissorBox.width;
-            height    = scissorBox.height;
-        }
+            _currentScissorBox = box;
 
-        glScissor(x, y, width, height);
+            glScissor(box.x, box.y, box.width, box.height);
+        }
     }
-    else
-        glDisable(GL_SCISSOR_TEST);
 
     checkForErrors();
 }
@@ -1611,7 +1951,7 @@ OpenGLES2Context::readPixels(unsigned char* pixels)
 void
 OpenGLES2Context::setTriangleCulling(TriangleCulling triangleCulling)
 {
-    if (triangleCulling == _currentTriangleCulling)
+    if (!countStateChange(triangleCulling != _currentTriangleCulling))
         return;
 
     if (_currentTriangleCulling == TriangleCulling::NONE)
@@ -1741,6 +2081,24 @@ OpenGLES2Context::createRTTBuffers(TextureType    type,
     checkForErrors();
 }
 
+bool
+OpenGLES2Context::uniformChanged(uint location, const void* values, uint numWords)
+{
+    if (_currentUniformValues == nullptr)
+        return countStateChange(true);
+
+    auto& cachedValues = (*_currentUniformValues)[location];
+    const auto numBytes = numWords * sizeof(uint);
+
+    if (cachedValues.size() == numWords && std::memcmp(cachedValues.data(), values, numBytes) == 0)
+        return countStateChange(false);
+
+    cachedValues.resize(numWords);
+    std::memcpy(cachedValues.data(), values, numBytes);
+
+    return countStateChange(true);
+}
+
 uint
 OpenGLES2Context::getError()
 {
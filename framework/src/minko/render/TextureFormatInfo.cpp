@@ -45,7 +45,9 @@ std::map<TextureFormat, TextureFormatInfo::Entry> TextureFormatInfo::_formats =
     { TextureFormat::RGBA_PVRTC2_4BPP,  Entry("RGBA_PVRTC2_4BPP",   true,     4u,    32u, 16u, 16u, true,   false) },
 
     { TextureFormat::RGB_ATITC,         Entry("RGB_ATITC",          true,     8u,    16u, 4u,  4u,  false,  false) },
-    { TextureFormat::RGBA_ATITC,        Entry("RGBA_ATITC",         true,     8u,    16u, 4u,  4u,  true,   false) }
+    { TextureFormat::RGBA_ATITC,        Entry("RGBA_ATITC",         true,     8u,    16u, 4u,  4u,  true,   false) },
+
+    { TextureFormat::RGBA32F,           Entry("RGBA32F",            false,    128u,  128u, 1u, 1u,  true,   false) }
 };
 
 bool
@@ -246,8 +246,13 @@ VertexBuffer::updatePositionBounds()
 Vector3::Ptr
 VertexBuffer::centerPosition(Vector3::Ptr output)
 {
+    if (_minPosition == nullptr)
+        updatePositionBounds();
+
     if (output == nullptr)
         output = Vector3::create();
 
-    return output->copyFrom(minPosition())->add(maxPosition())->scaleBy(0.5f);
+    return _minPosition
+        ? output->copyFrom((_minPosition->toVec3() + _maxPosition->toVec3()) * 0.5f)
+        : output->setTo(0.0f, 0.0f, 0.0f);
 }
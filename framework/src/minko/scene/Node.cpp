@@ -33,6 +33,7 @@ using namespace minko::scene;
 using namespace minko::component;
 
 unsigned int Node::_lastId = 0;
+unsigned int Node::_numComponentTypes = 0;
 
 Node::Node() :
     _id(_lastId++),
@@ -41,6 +42,9 @@ Node::Node() :
     _parent(nullptr),
     _container(data::Container::create()),
     _data(data::StructureProvider::create("node")),
+    _componentsByType(),
+    _resolvedComponentTypes(),
+    _componentTypes(),
     _added(Signal<Ptr, Ptr, Ptr>::create()),
     _removed(Signal<Ptr, Ptr, Ptr>::create()),
 	_componentAdded(Signal<Ptr, Ptr, Node::AbsCmpPtr>::create()),
@@ -237,6 +241,7 @@ Node::addComponent(std::shared_ptr<AbstractComponent> component)
         throw std::logic_error("The same component cannot be added twice.");
 
     _components.push_back(component);
+    invalidateComponentTypes();
     component->_targets.push_back(shared_from_this());
 
     component->targetAdded()->execute(component, shared_from_this());
@@ -266,6 +271,7 @@ Node::removeComponent(std::shared_ptr<AbstractComponent> component)
         throw std::invalid_argument("component");
 
     _components.erase(it);
+    invalidateComponentTypes();
     component->_targets.erase(
         std::find(component->_targets.begin(), component->_targets.end(), shared_from_this())
     );
@@ -291,6 +297,24 @@ Node::hasComponent(std::shared_ptr<AbstractComponent> component)
     return std::find(_components.begin(), _components.end(), component) != _components.end();
 }
 
+uint
+Node::nextComponentTypeId()
+{
+    if (_numComponentTypes == MAX_NUM_COMPONENT_TYPES)
+        throw std::logic_error("Too many component types, MAX_NUM_COMPONENT_TYPES must be increased.");
+
+    return _numComponentTypes++;
+}
+
+void
+Node::invalidateComponentTypes()
+{
+    // looked up types are resolved again on demand, the cached components are released right away
+    _resolvedComponentTypes.reset();
+    _componentTypes.reset();
+    _componentsByType.clear();
+}
+
 void
 Node::updateRoot()
 {
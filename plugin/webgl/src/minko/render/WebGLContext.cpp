@@ -35,6 +35,9 @@ WebGLContext::setUniform(const unsigned int&    location,
                          bool                   transpose,
                          const float*           values)
 {
+    if (!uniformChanged(location, values, size << 4))
+        return;
+
     if (transpose)
     {
         float* transposed = new float[size << 4];
@@ -101,3 +101,25 @@ if _OPTIONS['no-glsl-struct'] then
 	defines { 'MINKO_NO_GLSL_STRUCT' }
 	print('GLSL structs support is disabled (--no-glsl-struct)')
 end
+
+newoption {
+	trigger	= 'no-simd',
+	description = 'Disable SSE/AVX math kernels and use the scalar implementations.'
+}
+if _OPTIONS['no-simd'] then
+	defines { 'MINKO_NO_SIMD' }
+	print('SIMD math kernels are disabled (--no-simd)')
+end
+
+newoption {
+	trigger	= 'with-avx2',
+	description = 'Enable AVX2 math kernels (the binaries will require an AVX2 capable CPU).'
+}
+if _OPTIONS['with-avx2'] and not _OPTIONS['no-simd'] then
+	configuration { 'vs*' }
+		buildoptions { '/arch:AVX2' }
+	configuration { 'not vs*', 'not html5', 'not android', 'not ios' }
+		buildoptions { '-mavx2' }
+	configuration { }
+	print('AVX2 math kernels are enabled (--with-avx2)')
+end
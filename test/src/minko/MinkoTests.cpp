@@ -21,4 +21,52 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 using namespace minko;
 
-AbstractCanvas::Ptr minko::MinkoTests::_canvas = nullptr;
\ No newline at end of file
+AbstractCanvas::Ptr minko::MinkoTests::_canvas = nullptr;
+
+geometry::Geometry::Ptr
+MinkoTests::createGeometry(const std::vector<float>&            vertices,
+                           const std::vector<unsigned short>&   indices,
+                           unsigned int                         vertexSize)
+{
+    auto vertexBuffer = render::VertexBuffer::create(nullptr);
+    auto indexBuffer = render::IndexBuffer::create(nullptr);
+    auto geometry = geometry::Geometry::create();
+
+    vertexBuffer->data() = vertices;
+    vertexBuffer->addAttribute("position", 3, 0);
+    if (vertexSize >= 6)
+        vertexBuffer->addAttribute("normal", 3, 3);
+    if (vertexSize >= 8)
+        vertexBuffer->addAttribute("uv", 2, 6);
+    indexBuffer->data() = indices;
+    geometry->addVertexBuffer(vertexBuffer);
+    geometry->indices(indexBuffer);
+
+    return geometry;
+}
+
+geometry::Geometry::Ptr
+MinkoTests::createQuadGeometry(float width, float height)
+{
+    const float x = width * .5f;
+    const float y = height * .5f;
+
+    return createGeometry(
+        { -x, -y, 0.f, x, -y, 0.f, x, y, 0.f, -x, y, 0.f },
+        { 0, 1, 2, 0, 2, 3 }
+    );
+}
+
+render::Effect::Ptr
+MinkoTests::createEffect()
+{
+    std::vector<render::Pass::Ptr> passes;
+
+    return render::Effect::create(passes, "effect");
+}
+
+component::Surface::Ptr
+MinkoTests::createSurface(geometry::Geometry::Ptr geometry)
+{
+    return component::Surface::create(geometry, material::BasicMaterial::create(), createEffect());
+}
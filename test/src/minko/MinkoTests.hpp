@@ -40,6 +40,28 @@ namespace minko
             _canvas = canvas;
         }
 
+        // a single vertex buffer of 'vertexSize' floats per vertex: a position, then a normal and uv
+        // coordinates when they fit
+        static
+        geometry::Geometry::Ptr
+        createGeometry(const std::vector<float>&           vertices,
+                       const std::vector<unsigned short>&  indices,
+                       unsigned int                        vertexSize = 3);
+
+        // a 'width' x 'height' quad centered on the origin in the z = 0 plane
+        static
+        geometry::Geometry::Ptr
+        createQuadGeometry(float width, float height);
+
+        // an effect without any pass: nothing is drawn
+        static
+        render::Effect::Ptr
+        createEffect();
+
+        static
+        component::Surface::Ptr
+        createSurface(geometry::Geometry::Ptr geometry);
+
 	private:
         static AbstractCanvas::Ptr _canvas;
 	};
@@ -187,3 +187,174 @@ TEST_F(SignalTest, LockRemove)
 	ASSERT_EQ(v, 42);
 	ASSERT_EQ(w, 42);
 }
+
+TEST_F(SignalTest, Priority)
+{
+	auto s = Signal<>::create();
+	std::vector<int> order;
+	auto slot1 = s->connect([&]() { order.push_back(1); });
+	auto slot2 = s->connect([&]() { order.push_back(2); }, 10.f);
+	auto slot3 = s->connect([&]() { order.push_back(3); });
+	auto slot4 = s->connect([&]() { order.push_back(4); }, -1.f);
+	auto slot5 = s->connect([&]() { order.push_back(5); }, 10.f);
+
+	s->execute();
+
+	ASSERT_EQ(order, std::vector<int>({ 2, 5, 1, 3, 4 }));
+
+	slot5 = nullptr;
+	slot1 = nullptr;
+	order.clear();
+	s->execute();
+
+	ASSERT_EQ(order, std::vector<int>({ 2, 3, 4 }));
+}
+
+TEST_F(SignalTest, LockAddRemove)
+{
+	auto s = Signal<int>::create();
+	auto v = 0;
+
+	Signal<int>::Slot slot2;
+	auto slot1 = s->connect([&](int i)
+	{
+		slot2 = s->connect([&](int i) { v = i; });
+		slot2 = nullptr;
+	});
+
+	s->execute(42);
+	s->execute(42);
+
+	ASSERT_EQ(s->numCallbacks(), 1);
+	ASSERT_EQ(v, 0);
+}
+
+TEST_F(SignalTest, NestedExecute)
+{
+	auto s = Signal<int>::create();
+	auto v = 0;
+
+	Signal<int>::Slot slot2;
+	auto slot1 = s->connect([&](int i)
+	{
+		if (i > 0)
+		{
+			slot2 = nullptr;
+			s->execute(i - 1);
+		}
+		v += i;
+	});
+
+	slot2 = s->connect([&](int i) { v += 100; });
+
+	s->execute(2);
+
+	ASSERT_EQ(s->numCallbacks(), 1);
+	ASSERT_EQ(v, 303);
+
+	v = 0;
+	s->execute(0);
+
+	ASSERT_EQ(v, 0);
+}
+
+TEST_F(SignalTest, ReuseDisconnectedSlotHandle)
+{
+	auto s = Signal<>::create();
+	auto v1 = 0;
+	auto v2 = 0;
+	auto slot1 = s->connect([&]() { ++v1; });
+
+	slot1->disconnect();
+
+	auto slot2 = s->connect([&]() { ++v2; });
+
+	// disconnecting twice must not disconnect the callback now using the same handle
+	slot1->disconnect();
+	s->execute();
+
+	ASSERT_EQ(s->numCallbacks(), 1);
+	ASSERT_EQ(v1, 0);
+	ASSERT_EQ(v2, 1);
+}
+
+TEST_F(SignalTest, DisconnectWithoutExecute)
+{
+	auto s = Signal<>::create();
+	std::vector<Signal<>::Slot> slots;
+	std::vector<int> calls;
+
+	for (auto i = 0; i < 100; ++i)
+		slots.push_back(s->connect([&, i]() { calls.push_back(i); }, float(i % 3)));
+
+	// disconnected slots get compacted meanwhile, the remaining ones must still be found
+	for (auto i = 0; i < 100; ++i)
+		if (i % 10 != 0)
+			slots[i] = nullptr;
+	slots[50]->disconnect();
+	s->execute();
+
+	ASSERT_EQ(s->numCallbacks(), 9);
+	ASSERT_EQ(calls, std::vector<int>({ 20, 80, 10, 40, 70, 0, 30, 60, 90 }));
+}
+
+TEST_F(SignalTest, ConnectExecuteDisconnectMany)
+{
+	const unsigned int numSlots = 10000;
+	const unsigned int numExecutions = 10;
+	std::vector<Signal<int>::Slot> slots(numSlots);
+	auto s = Signal<int>::create();
+	auto v = 0;
+
+	for (auto i = 0u; i < numSlots; ++i)
+		slots[i] = s->connect([&](int i) { v += i; });
+
+	for (auto i = 0u; i < numExecutions; ++i)
+		s->execute(1);
+
+	for (auto i = 0u; i < numSlots; ++i)
+		slots[(i * 7919) % numSlots] = nullptr;
+	s->execute(1);
+
+	ASSERT_EQ(s->numCallbacks(), 0);
+	ASSERT_EQ(v, (int)(numSlots * numExecutions));
+}
+
+// benchmark, run with --gtest_also_run_disabled_tests
+TEST_F(SignalTest, DISABLED_ConnectExecuteDisconnectBenchmark)
+{
+	const unsigned int numSlots = 10000;
+	const unsigned int numExecutions = 1000;
+	std::vector<Signal<int>::Slot> slots(numSlots);
+	auto s = Signal<int>::create();
+	auto v = 0;
+
+	auto start = std::chrono::high_resolution_clock::now();
+
+	for (auto i = 0u; i < numSlots; ++i)
+		slots[i] = s->connect([&](int i) { v += i; });
+
+	auto connectTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start);
+
+	start = std::chrono::high_resolution_clock::now();
+
+	for (auto i = 0u; i < numExecutions; ++i)
+		s->execute(1);
+
+	auto executeTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start);
+
+	start = std::chrono::high_resolution_clock::now();
+
+	for (auto i = 0u; i < numSlots; ++i)
+		slots[(i * 7919) % numSlots] = nullptr;
+	s->execute(1);
+
+	auto disconnectTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start);
+
+	std::cout << numSlots << " slots: connect " << connectTime.count() << "us, "
+		<< numExecutions << " executions " << executeTime.count() << "us, "
+		<< "disconnect " << disconnectTime.count() << "us" << std::endl;
+
+	ASSERT_EQ(s->numCallbacks(), 0);
+	ASSERT_EQ(v, (int)(numSlots * numExecutions));
+}
@@ -0,0 +1,189 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Matrix4x4TimelineTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::animation;
+using namespace minko::component;
+using namespace minko::math;
+using namespace minko::scene;
+
+// one translation along x per key, key i at 'keyTimes[i]' translating by 'i'
+static
+Matrix4x4Timeline::Ptr
+createTimeline(const std::vector<uint>& keyTimes, uint duration, bool interpolate = false)
+{
+	std::vector<Matrix4x4::Ptr> matrices;
+
+	for (uint i = 0; i < keyTimes.size(); ++i)
+		matrices.push_back(Matrix4x4::create()->appendTranslation(float(i)));
+
+	return Matrix4x4Timeline::create("transform.matrix", duration, keyTimes, matrices, interpolate);
+}
+
+TEST_F(Matrix4x4TimelineTest, StepKeys)
+{
+	auto timeline = createTimeline({ 0, 10, 20 }, 30);
+	auto matrix = Matrix4x4::create();
+
+	timeline->evaluate(0, matrix);
+	ASSERT_FLOAT_EQ(matrix->translation()->x(), 0.f);
+	timeline->evaluate(9, matrix);
+	ASSERT_FLOAT_EQ(matrix->translation()->x(), 0.f);
+	timeline->evaluate(10, matrix);
+	ASSERT_FLOAT_EQ(matrix->translation()->x(), 1.f);
+	timeline->evaluate(25, matrix);
+	ASSERT_FLOAT_EQ(matrix->translation()->x(), 2.f);
+}
+
+TEST_F(Matrix4x4TimelineTest, UnsortedKeys)
+{
+	std::vector<Matrix4x4::Ptr> matrices = {
+		Matrix4x4::create()->appendTranslation(2.f),
+		Matrix4x4::create()->appendTranslation(0.f),
+		Matrix4x4::create()->appendTranslation(1.f)
+	};
+	auto timeline = Matrix4x4Timeline::create("transform.matrix", 30, { 20, 0, 10 }, matrices);
+	auto matrix = Matrix4x4::create();
+
+	ASSERT_EQ(timeline->keyTime(0), 0);
+	ASSERT_EQ(timeline->keyTime(2), 20);
+
+	timeline->evaluate(15, matrix);
+	ASSERT_FLOAT_EQ(matrix->translation()->x(), 1.f);
+}
+
+TEST_F(Matrix4x4TimelineTest, SeekMatchesSequentialPlayback)
+{
+	std::vector<uint> keyTimes;
+
+	for (uint i = 0; i < 50; ++i)
+		keyTimes.push_back(i * 7);
+
+	auto timeline = createTimeline(keyTimes, 350);
+	auto matrix = Matrix4x4::create();
+
+	// forward playback moves the cursor key by key, seeking backward or far ahead must not rely on it
+	std::vector<uint> times;
+
+	for (uint time = 0; time <= 350; time += 3)
+		times.push_back(time);
+	for (uint time = 350; time >= 11; time -= 11)
+		times.push_back(time);
+	times.push_back(3);
+	times.push_back(300);
+	times.push_back(0);
+
+	for (auto time : times)
+	{
+		timeline->evaluate(time, matrix);
+
+		ASSERT_FLOAT_EQ(matrix->translation()->x(), float(std::min(time / 7, 49u)));
+	}
+}
+
+TEST_F(Matrix4x4TimelineTest, Interpolate)
+{
+	auto timeline = createTimeline({ 0, 10 }, 20, true);
+	auto matrix = Matrix4x4::create();
+
+	timeline->evaluate(5, matrix);
+	ASSERT_NEAR(matrix->translation()->x(), 0.5f, 1e-5f);
+
+	timeline->evaluate(15, matrix);
+	ASSERT_NEAR(matrix->translation()->x(), 1.f, 1e-5f);
+
+	timeline->evaluate(2, matrix);
+	ASSERT_NEAR(matrix->translation()->x(), 0.2f, 1e-5f);
+}
+
+TEST_F(Matrix4x4TimelineTest, HeldKeyDoesNotNotify)
+{
+	auto timeline = createTimeline({ 0, 10, 20 }, 30);
+	auto matrix = Matrix4x4::create();
+	auto numChanges = 0;
+	auto _ = matrix->changed()->connect([&](data::Value::Ptr)
+	{
+		++numChanges;
+	});
+
+	timeline->evaluate(10, matrix);
+	timeline->evaluate(12, matrix);
+	timeline->evaluate(19, matrix);
+	ASSERT_EQ(numChanges, 1);
+
+	timeline->evaluate(20, matrix);
+	ASSERT_EQ(numChanges, 2);
+}
+
+TEST_F(Matrix4x4TimelineTest, MasterAnimationDrivesAnimation)
+{
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto root = Node::create()->addComponent(sceneManager);
+	auto scene = Node::create();
+	auto group = Node::create();
+	auto node = Node::create()
+		->addComponent(Transform::create())
+		->addComponent(Animation::create({ createTimeline({ 0, 10, 20 }, 30) }));
+
+	// the animations look for the scene manager when their subtree is added to the scene
+	scene->addChild(group->addChild(node));
+	group->addComponent(MasterAnimation::create());
+	root->addChild(scene);
+
+	sceneManager->nextFrame(0.f, 0.f);
+	sceneManager->nextFrame(15.f, 15.f);
+
+	auto matrix = node->data()->get<Matrix4x4::Ptr>("transform.matrix");
+
+	ASSERT_FLOAT_EQ(matrix->translation()->x(), 1.f);
+
+	sceneManager->nextFrame(25.f, 10.f);
+	ASSERT_FLOAT_EQ(matrix->translation()->x(), 2.f);
+}
+
+TEST_F(Matrix4x4TimelineTest, AnimationFollowsReplacedMatrix)
+{
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto root = Node::create()->addComponent(sceneManager);
+	auto provider = data::Provider::create();
+	auto oldMatrix = Matrix4x4::create();
+	auto newMatrix = Matrix4x4::create();
+	auto animation = Animation::create({ createTimeline({ 0, 10, 20 }, 30) });
+	auto node = Node::create()->addComponent(animation);
+
+	provider->set("transform.matrix", oldMatrix);
+	node->data()->addProvider(provider);
+	root->addChild(node);
+	animation->play();
+
+	sceneManager->nextFrame(0.f, 0.f);
+	sceneManager->nextFrame(15.f, 15.f);
+	ASSERT_FLOAT_EQ(oldMatrix->translation()->x(), 1.f);
+
+	provider->set("transform.matrix", newMatrix);
+
+	sceneManager->nextFrame(25.f, 10.f);
+	ASSERT_FLOAT_EQ(newMatrix->translation()->x(), 2.f);
+	ASSERT_FLOAT_EQ(oldMatrix->translation()->x(), 1.f);
+}
@@ -0,0 +1,218 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "CullingTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::math;
+using namespace minko::render;
+using namespace minko::scene;
+
+static
+Node::Ptr
+createSurfaceNode(float x, float y, float z)
+{
+	auto node = Node::create()
+		->addComponent(Transform::create(Matrix4x4::create()->appendTranslation(x, y, z)))
+		->addComponent(BoundingBox::create(1.f, Vector3::create(0.f, 0.f, 0.f)))
+		->addComponent(MinkoTests::createSurface(geometry::Geometry::create()));
+
+	node->layouts(Layout::Group::DEFAULT | Layout::Group::CULLING);
+
+	return node;
+}
+
+// a 3x3 wall facing the camera
+static
+Node::Ptr
+createOccluderNode(float z)
+{
+	auto node = Node::create()
+		->addComponent(Transform::create(Matrix4x4::create()->appendTranslation(0.f, 0.f, z)))
+		->addComponent(BoundingBox::create(3.f, 3.f, .1f, Vector3::create(0.f, 0.f, 0.f)))
+		->addComponent(MinkoTests::createSurface(MinkoTests::createQuadGeometry(3.f, 3.f)));
+
+	node->layouts(Layout::Group::DEFAULT | Layout::Group::CULLING | Layout::Group::OCCLUDER);
+
+	return node;
+}
+
+// renderers are disabled: the test canvas has no context to render with
+static
+Node::Ptr
+createCamera(Renderer::Ptr renderer, Renderer::Ptr renderer2 = nullptr)
+{
+	auto camera = Node::create()
+		->addComponent(Transform::create())
+		->addComponent(PerspectiveCamera::create(1.f, .785f, .1f, 100.f))
+		->addComponent(renderer)
+		->addComponent(Culling::create(Frustum::create(), "camera.worldToScreenMatrix"));
+
+	renderer->enabled(false);
+	if (renderer2)
+	{
+		renderer2->enabled(false);
+		camera->addComponent(renderer2);
+	}
+
+	return camera;
+}
+
+TEST_F(CullingTest, VisibilitySetPerCamera)
+{
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto root = Node::create()->addComponent(sceneManager);
+	auto front = createSurfaceNode(0.f, 0.f, -10.f);
+	auto back = createSurfaceNode(0.f, 0.f, 10.f);
+	auto renderer = Renderer::create();
+	auto backRenderer = Renderer::create();
+	auto camera = createCamera(renderer);
+	auto backCamera = createCamera(backRenderer);
+	auto frontId = front->component<Surface>()->id();
+	auto backId = back->component<Surface>()->id();
+
+	// the octree walk keeps some of the boxes behind the camera, the batch test does not
+	camera->component<Culling>()->batch(true);
+	backCamera->component<Culling>()->batch(true);
+	backCamera->component<Transform>()->matrix()->appendRotationY((float)M_PI);
+	root->addChild(front)->addChild(back)->addChild(camera)->addChild(backCamera);
+	sceneManager->nextFrame(0.f, 0.f);
+
+	ASSERT_TRUE(renderer->computedVisibility(frontId));
+	ASSERT_FALSE(renderer->computedVisibility(backId));
+	ASSERT_FALSE(backRenderer->computedVisibility(frontId));
+	ASSERT_TRUE(backRenderer->computedVisibility(backId));
+	ASSERT_EQ(camera->component<Culling>()->numVisible(), 1u);
+	ASSERT_EQ(camera->component<Culling>()->numCulled(), 1u);
+
+	// the surface API reads and writes the same visibility set
+	ASSERT_FALSE(back->component<Surface>()->computedVisibility(renderer));
+
+	front->component<Transform>()->matrix()->appendTranslation(0.f, 0.f, 20.f);
+	sceneManager->nextFrame(0.f, 0.f);
+
+	ASSERT_FALSE(renderer->computedVisibility(frontId));
+	ASSERT_TRUE(backRenderer->computedVisibility(frontId));
+}
+
+TEST_F(CullingTest, AllRenderersOfTheCamera)
+{
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto root = Node::create()->addComponent(sceneManager);
+	auto back = createSurfaceNode(0.f, 0.f, 10.f);
+	auto renderer = Renderer::create();
+	auto renderer2 = Renderer::create();
+	auto camera = createCamera(renderer, renderer2);
+	auto culling = camera->component<Culling>();
+	auto backId = back->component<Surface>()->id();
+
+	culling->batch(true);
+	root->addChild(back)->addChild(camera);
+	sceneManager->nextFrame(0.f, 0.f);
+
+	ASSERT_FALSE(renderer->computedVisibility(backId));
+	ASSERT_FALSE(renderer2->computedVisibility(backId));
+
+	camera->removeComponent(culling);
+
+	ASSERT_TRUE(renderer->computedVisibility(backId));
+	ASSERT_TRUE(renderer2->computedVisibility(backId));
+}
+
+TEST_F(CullingTest, BatchMatchesOctTree)
+{
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto root = Node::create()->addComponent(sceneManager);
+	auto renderer = Renderer::create();
+	auto camera = createCamera(renderer);
+	auto culling = camera->component<Culling>();
+	std::vector<Node::Ptr> nodes;
+
+	for (auto i = 0; i < 100; ++i)
+	{
+		nodes.push_back(createSurfaceNode((float)(i % 10) * 10.f - 50.f, 0.f, (float)(i / 10) * -10.f + 20.f));
+		root->addChild(nodes.back());
+	}
+	root->addChild(camera);
+	sceneManager->nextFrame(0.f, 0.f);
+
+	auto numVisible = culling->numVisible();
+
+	culling->batch(true);
+	sceneManager->nextFrame(0.f, 0.f);
+
+	ASSERT_EQ(culling->numVisible() + culling->numCulled(), 100u);
+	ASSERT_GT(culling->numVisible(), 0u);
+	// the octree walk is conservative
+	ASSERT_LE(culling->numVisible(), numVisible);
+	for (auto& node : nodes)
+	{
+		auto id = node->component<Surface>()->id();
+		auto z = node->component<Transform>()->matrix()->translation()->z();
+
+		if (z > 1.f)
+			ASSERT_FALSE(renderer->computedVisibility(id));
+	}
+}
+
+TEST_F(CullingTest, OcclusionCulling)
+{
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto root = Node::create()->addComponent(sceneManager);
+	auto wall = createOccluderNode(-5.f);
+	auto hidden = createSurfaceNode(0.f, 0.f, -10.f);
+	auto front = createSurfaceNode(0.f, 0.f, -3.f);
+	auto side = createSurfaceNode(3.f, 0.f, -10.f);
+	auto renderer = Renderer::create();
+	auto camera = createCamera(renderer);
+	auto occlusionCulling = OcclusionCulling::create();
+	auto hiddenId = hidden->component<Surface>()->id();
+
+	camera->component<Culling>()->batch(true);
+	camera->addComponent(occlusionCulling);
+	root->addChild(wall)->addChild(hidden)->addChild(front)->addChild(side)->addChild(camera);
+	sceneManager->nextFrame(0.f, 0.f);
+
+	ASSERT_EQ(occlusionCulling->numOccluders(), 1u);
+	ASSERT_EQ(occlusionCulling->numOccluded(), 1u);
+	ASSERT_TRUE(renderer->computedVisibility(hiddenId));
+	ASSERT_TRUE(renderer->occluded(hiddenId));
+	ASSERT_FALSE(renderer->renderable(hiddenId));
+	ASSERT_TRUE(renderer->renderable(front->component<Surface>()->id()));
+	ASSERT_TRUE(renderer->renderable(side->component<Surface>()->id()));
+	ASSERT_TRUE(renderer->renderable(wall->component<Surface>()->id()));
+
+	hidden->component<Transform>()->matrix()->appendTranslation(0.f, 3.8f, 0.f);
+	sceneManager->nextFrame(0.f, 0.f);
+
+	ASSERT_EQ(occlusionCulling->numOccluded(), 0u);
+	ASSERT_TRUE(renderer->renderable(hiddenId));
+
+	hidden->component<Transform>()->matrix()->appendTranslation(0.f, -3.8f, 0.f);
+	sceneManager->nextFrame(0.f, 0.f);
+
+	ASSERT_FALSE(renderer->renderable(hiddenId));
+
+	camera->removeComponent(occlusionCulling);
+
+	ASSERT_TRUE(renderer->renderable(hiddenId));
+}
@@ -0,0 +1,120 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "PickingTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::math;
+using namespace minko::render;
+using namespace minko::scene;
+
+// a 2x2 quad facing the camera, without any vertex when 'withData' is false
+static
+Node::Ptr
+createQuadNode(float x, float y, float z, bool withData = true)
+{
+	auto geometry = withData
+		? MinkoTests::createQuadGeometry(2.f, 2.f)
+		: MinkoTests::createGeometry({}, {});
+
+	return Node::create()
+		->addComponent(Transform::create(Matrix4x4::create()->appendTranslation(x, y, z)))
+		->addComponent(BoundingBox::create(2.f, 2.f, .1f, Vector3::create(0.f, 0.f, 0.f)))
+		->addComponent(MinkoTests::createSurface(geometry));
+}
+
+static
+Node::Ptr
+createScene(Node::Ptr& camera, Picking::Ptr& picking)
+{
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto root = Node::create()->addComponent(sceneManager);
+
+	camera = Node::create()
+		->addComponent(Transform::create())
+		->addComponent(PerspectiveCamera::create(1.f, .785f, .1f, 100.f));
+	picking = Picking::create(camera, true, true, PickingMethod::RAY_CAST);
+	root->addChild(camera);
+
+	return root;
+}
+
+TEST_F(PickingTest, RayCastNearestSurface)
+{
+	Node::Ptr camera;
+	Picking::Ptr picking;
+	auto root = createScene(camera, picking);
+	auto near = createQuadNode(0.f, 0.f, -5.f);
+	auto far = createQuadNode(0.f, 0.f, -10.f);
+
+	root->addChild(far)->addChild(near);
+	root->addComponent(picking);
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+
+	ASSERT_EQ(picking->method(), PickingMethod::RAY_CAST);
+	ASSERT_EQ(picking->pick(0.f, 0.f), near->component<Surface>());
+
+	// the far quad is larger on screen than the near one once it is moved aside
+	near->component<Transform>()->matrix()->appendTranslation(1.5f, 0.f, 0.f);
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+
+	ASSERT_EQ(picking->pick(0.f, 0.f), far->component<Surface>());
+	ASSERT_EQ(picking->pick(-.9f, -.9f), nullptr);
+}
+
+TEST_F(PickingTest, RayCastWithSpatialIndex)
+{
+	Node::Ptr camera;
+	Picking::Ptr picking;
+	auto root = createScene(camera, picking);
+	auto near = createQuadNode(0.f, 0.f, -5.f);
+	auto far = createQuadNode(0.f, 0.f, -10.f);
+
+	near->layouts(near->layouts() | Layout::Group::CULLING);
+	far->layouts(far->layouts() | Layout::Group::CULLING);
+	root->addComponent(SpatialIndex::create(100.f, 8));
+	root->addChild(far)->addChild(near);
+	root->addComponent(picking);
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+
+	ASSERT_EQ(picking->pick(0.f, 0.f), near->component<Surface>());
+
+	root->removeChild(near);
+
+	ASSERT_EQ(picking->pick(0.f, 0.f), far->component<Surface>());
+}
+
+TEST_F(PickingTest, RayCastBoundingBoxWithoutData)
+{
+	Node::Ptr camera;
+	Picking::Ptr picking;
+	auto root = createScene(camera, picking);
+	auto quad = createQuadNode(0.f, 0.f, -5.f, false);
+
+	root->addChild(quad);
+	root->addComponent(picking);
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+
+	ASSERT_EQ(picking->pick(0.f, 0.f), quad->component<Surface>());
+	ASSERT_EQ(picking->pick(-.9f, -.9f), nullptr);
+}
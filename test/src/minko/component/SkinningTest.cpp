@@ -0,0 +1,606 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "SkinningTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+#include "minko/geometry/Skin.hpp"
+#include "minko/geometry/Bone.hpp"
+#include "minko/geometry/SkinClip.hpp"
+#include "minko/geometry/SkinPoseCache.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::geometry;
+using namespace minko::math;
+using namespace minko::render;
+using namespace minko::scene;
+
+// 'numVertices' vertices influenced by up to 4 of 'numBones' bones, weights summing to 1
+static
+Skin::Ptr
+createSkin(unsigned int numBones, unsigned int numVertices, unsigned int numFrames)
+{
+	std::vector<std::vector<unsigned short>> vertexIds(numBones);
+	std::vector<std::vector<float>> vertexWeights(numBones);
+
+	for (unsigned int vId = 0; vId < numVertices; ++vId)
+	{
+		const unsigned int numInfluences = 1 + vId % 4;
+
+		for (unsigned int j = 0; j < numInfluences; ++j)
+		{
+			vertexIds[(vId + j * 3) % numBones].push_back(vId);
+			vertexWeights[(vId + j * 3) % numBones].push_back(1.f / numInfluences);
+		}
+	}
+
+	auto skin = Skin::create(numBones, 1000, numFrames);
+
+	for (unsigned int boneId = 0; boneId < numBones; ++boneId)
+		skin->bone(boneId, Bone::create(Matrix4x4::create(), vertexIds[boneId], vertexWeights[boneId]));
+	skin->reorganizeByVertices();
+
+	// each bone translates along x by its id and scales by 2 on frame 1
+	for (unsigned int frameId = 0; frameId < numFrames; ++frameId)
+		for (unsigned int boneId = 0; boneId < numBones; ++boneId)
+			skin->matrix(
+				frameId,
+				boneId,
+				Matrix4x4::create()->appendScale(frameId == 0 ? 1.f : 2.f)->appendTranslation((float)boneId, 0.f, 0.f)->transpose()
+			);
+
+	return skin;
+}
+
+// interleaved positions and normals
+static
+Geometry::Ptr
+createGeometry(unsigned int numVertices)
+{
+	auto geometry = Geometry::create();
+	auto vertices = VertexBuffer::create(MinkoTests::canvas()->context());
+
+	for (unsigned int vId = 0; vId < numVertices; ++vId)
+	{
+		float vertex[] = { (float)vId, (float)(vId % 7), -(float)(vId % 5), 0.f, 1.f, 0.f };
+
+		vertices->data().insert(vertices->data().end(), vertex, vertex + 6);
+	}
+	vertices->addAttribute("position", 3, 0);
+	vertices->addAttribute("normal", 3, 3);
+	geometry->addVertexBuffer(vertices);
+
+	return geometry;
+}
+
+static
+void
+skinAndCompare(bool parallel, unsigned int numVertices)
+{
+	const unsigned int numBones = 10;
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto root = Node::create()->addComponent(sceneManager);
+	auto skin = createSkin(numBones, numVertices, 2);
+	auto geometry = createGeometry(numVertices);
+	auto input = geometry->vertexBuffer("position")->data();
+	std::vector<Pass::Ptr> passes;
+	auto node = Node::create()->addComponent(Surface::create(
+		geometry, material::BasicMaterial::create(), Effect::create(passes, "effect")
+	));
+	auto skinning = Skinning::create(skin, SkinningMethod::SOFTWARE, MinkoTests::canvas()->context(), nullptr);
+
+	if (parallel)
+		Skinning::parallelSkinning(3, 0);
+
+	node->addComponent(skinning);
+	root->addChild(node);
+	skinning->stop();
+	skinning->seek(999);
+	sceneManager->nextFrame(0.f, 0.f);
+
+	Skinning::parallelSkinning(0);
+
+	const auto& output = geometry->vertexBuffer("position")->data();
+
+	for (unsigned int vId = 0; vId < numVertices; ++vId)
+	{
+		const unsigned int numInfluences = 1 + vId % 4;
+		float translation = 0.f;
+
+		for (unsigned int j = 0; j < numInfluences; ++j)
+			translation += float((vId + j * 3) % numBones) / numInfluences;
+
+		ASSERT_NEAR(output[vId * 6], 2.f * input[vId * 6] + translation, 1e-3f);
+		ASSERT_NEAR(output[vId * 6 + 1], 2.f * input[vId * 6 + 1], 1e-3f);
+		ASSERT_NEAR(output[vId * 6 + 2], 2.f * input[vId * 6 + 2], 1e-3f);
+		// normals are not translated
+		ASSERT_NEAR(output[vId * 6 + 3], 0.f, 1e-5f);
+		ASSERT_NEAR(output[vId * 6 + 4], 2.f, 1e-5f);
+		ASSERT_NEAR(output[vId * 6 + 5], 0.f, 1e-5f);
+	}
+}
+
+TEST_F(SkinningTest, SoftwareSkinning)
+{
+	skinAndCompare(false, 1001);
+}
+
+TEST_F(SkinningTest, ParallelSoftwareSkinning)
+{
+	skinAndCompare(true, 5003);
+
+	ASSERT_EQ(Skinning::numSkinningThreads(), 0u);
+}
+
+TEST_F(SkinningTest, SkinVerticesMatchesScalar)
+{
+	const unsigned int numVertices = 1027;
+	auto skin = createSkin(13, numVertices, 1);
+	std::vector<float> boneMatrices = skin->matrices(0);
+	std::vector<float> input(numVertices * 7);
+	std::vector<float> output(input.size(), 0.f);
+	std::vector<float> expected(input.size(), 0.f);
+
+	// arbitrary matrices and vertices: positions and normals are interleaved with an extra float
+	for (unsigned int i = 0; i < boneMatrices.size(); ++i)
+		boneMatrices[i] = std::sin(float(i) * .37f);
+	for (unsigned int i = 0; i < input.size(); ++i)
+		input[i] = std::cos(float(i) * .11f) * 10.f;
+
+	Skinning::VertexStreams streams = { &input[0], &output[0], 7, &input[3], &output[3], 7 };
+	Skinning::VertexStreams expectedStreams = { &input[0], &expected[0], 7, &input[3], &expected[3], 7 };
+
+	Skinning::skinVertices(*skin, &boneMatrices[0], streams, 0, numVertices);
+	Skinning::skinVerticesScalar(*skin, &boneMatrices[0], expectedStreams, 0, numVertices);
+
+	for (unsigned int i = 0; i < input.size(); ++i)
+		ASSERT_NEAR(output[i], expected[i], 1e-3f);
+
+	// a range starting in the middle of a SIMD block
+	std::fill(output.begin(), output.end(), 0.f);
+	Skinning::skinVertices(*skin, &boneMatrices[0], streams, 5, 23);
+
+	for (unsigned int vId = 0; vId < numVertices; ++vId)
+		for (unsigned int i = 0; i < 6; ++i)
+			ASSERT_NEAR(output[vId * 7 + i], vId >= 5 && vId < 23 ? expected[vId * 7 + i] : 0.f, 1e-3f);
+}
+
+// clip of root bones without offset, translating along x by their id and scaling by 'scale' on frame 1
+static
+SkinClip::Ptr
+createClip(unsigned int numBones, float scale)
+{
+	std::vector<std::vector<float>> localMatrices(2);
+	std::vector<float> offsetMatrices;
+
+	for (unsigned int frameId = 0; frameId < 2; ++frameId)
+		for (unsigned int boneId = 0; boneId < numBones; ++boneId)
+		{
+			auto matrix = Matrix4x4::create()->appendScale(frameId == 0 ? 1.f : scale)->appendTranslation((float)boneId, 0.f, 0.f);
+
+			localMatrices[frameId].insert(localMatrices[frameId].end(), matrix->data().begin(), matrix->data().end());
+		}
+	for (unsigned int boneId = 0; boneId < numBones; ++boneId)
+	{
+		auto matrix = Matrix4x4::create();
+
+		offsetMatrices.insert(offsetMatrices.end(), matrix->data().begin(), matrix->data().end());
+	}
+
+	return SkinClip::create(std::vector<int>(numBones, -1), offsetMatrices, 1000, localMatrices);
+}
+
+static
+Skin::Ptr
+createCompressedSkin(SkinClip::Ptr clip, unsigned int numVertices)
+{
+	auto skin = Skin::create(clip->numBones(), clip);
+
+	skin->bones(createSkin(clip->numBones(), numVertices, 1)->bones());
+	skin->reorganizeByVertices();
+
+	return skin;
+}
+
+static
+Node::Ptr
+createSkinnedNode(Skin::Ptr skin, unsigned int numVertices)
+{
+	std::vector<Pass::Ptr> passes;
+
+	return Node::create()
+		->addComponent(Surface::create(
+			createGeometry(numVertices), material::BasicMaterial::create(), Effect::create(passes, "effect")
+		))
+		->addComponent(Skinning::create(skin, SkinningMethod::SOFTWARE, MinkoTests::canvas()->context(), nullptr));
+}
+
+// checks the skinned positions of the vertices of createGeometry() for the bones of createClip()
+static
+void
+checkScaledPositions(Node::Ptr node, unsigned int numBones, float scale)
+{
+	auto vertexBuffer = node->component<Surface>()->geometry()->vertexBuffer("position");
+	const auto& output = vertexBuffer->data();
+
+	for (unsigned int vId = 0; vId < vertexBuffer->numVertices(); ++vId)
+	{
+		const unsigned int numInfluences = 1 + vId % 4;
+		float translation = 0.f;
+
+		for (unsigned int j = 0; j < numInfluences; ++j)
+			translation += float((vId + j * 3) % numBones) / numInfluences;
+
+		ASSERT_NEAR(output[vId * 6], scale * vId + translation, 1e-2f);
+		ASSERT_NEAR(output[vId * 6 + 1], scale * (vId % 7), 1e-2f);
+		ASSERT_NEAR(output[vId * 6 + 4], scale, 1e-3f);
+	}
+}
+
+TEST_F(SkinningTest, CompressedSkin)
+{
+	const unsigned int numVertices = 37;
+	const unsigned int numBones = 10;
+	auto baked = createSkin(numBones, numVertices, 2);
+	std::vector<std::vector<float>> localMatrices(2);
+	std::vector<float> offsetMatrices;
+
+	// root bones without offset whose local matrices are the baked ones
+	for (unsigned int frameId = 0; frameId < 2; ++frameId)
+		for (unsigned int boneId = 0; boneId < numBones; ++boneId)
+		{
+			auto matrix = Matrix4x4::create();
+
+			std::copy(&baked->matrices(frameId)[boneId << 4], &baked->matrices(frameId)[boneId << 4] + 16, matrix->data().begin());
+			matrix->transpose();
+			localMatrices[frameId].insert(localMatrices[frameId].end(), matrix->data().begin(), matrix->data().end());
+		}
+	for (unsigned int boneId = 0; boneId < numBones; ++boneId)
+	{
+		auto matrix = Matrix4x4::create();
+
+		offsetMatrices.insert(offsetMatrices.end(), matrix->data().begin(), matrix->data().end());
+	}
+
+	auto clip = SkinClip::create(std::vector<int>(numBones, -1), offsetMatrices, 1000, localMatrices);
+	auto skin = Skin::create(numBones, clip);
+
+	skin->bones(baked->bones());
+	skin->reorganizeByVertices();
+
+	ASSERT_EQ(skin->numFrames(), 0u);
+	ASSERT_EQ(skin->duration(), 1000u);
+	// clones share the animation data
+	ASSERT_EQ(skin->clone()->clip(), clip);
+
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto root = Node::create()->addComponent(sceneManager);
+	auto geometry = createGeometry(numVertices);
+	auto input = geometry->vertexBuffer("position")->data();
+	std::vector<Pass::Ptr> passes;
+	auto node = Node::create()->addComponent(Surface::create(
+		geometry, material::BasicMaterial::create(), Effect::create(passes, "effect")
+	));
+	auto skinning = Skinning::create(skin, SkinningMethod::SOFTWARE, MinkoTests::canvas()->context(), nullptr);
+
+	node->addComponent(skinning);
+	root->addChild(node);
+	skinning->stop();
+	skinning->seek(250);
+	sceneManager->nextFrame(0.f, 0.f);
+
+	// halfway between the two frames: scaled by 1.5
+	const auto& output = geometry->vertexBuffer("position")->data();
+
+	for (unsigned int vId = 0; vId < numVertices; ++vId)
+	{
+		const unsigned int numInfluences = 1 + vId % 4;
+		float translation = 0.f;
+
+		for (unsigned int j = 0; j < numInfluences; ++j)
+			translation += float((vId + j * 3) % numBones) / numInfluences;
+
+		ASSERT_NEAR(output[vId * 6], 1.5f * input[vId * 6] + translation, 1e-2f);
+		ASSERT_NEAR(output[vId * 6 + 1], 1.5f * input[vId * 6 + 1], 1e-2f);
+		ASSERT_NEAR(output[vId * 6 + 4], 1.5f, 1e-3f);
+	}
+}
+
+TEST_F(SkinningTest, CrossFade)
+{
+	const unsigned int numBones = 10;
+	auto clip = createClip(numBones, 2.f);
+	auto other = createClip(numBones, 4.f);
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto root = Node::create()->addComponent(sceneManager);
+	auto node = createSkinnedNode(createCompressedSkin(clip, 37), 37);
+	auto skinning = node->component<Skinning>();
+
+	root->addChild(node);
+	skinning->stop();
+	skinning->seek(500);
+	sceneManager->nextFrame(0.f, 0.f);
+	checkScaledPositions(node, numBones, 2.f);
+
+	skinning->crossFade(other, 1000);
+	skinning->stop();
+	sceneManager->nextFrame(1000.f, 0.f);
+	checkScaledPositions(node, numBones, 2.f);
+
+	// the local poses are blended: the scales are interpolated
+	skinning->stop();
+	sceneManager->nextFrame(1500.f, 0.f);
+	checkScaledPositions(node, numBones, 3.f);
+
+	skinning->stop();
+	sceneManager->nextFrame(2000.f, 0.f);
+	checkScaledPositions(node, numBones, 4.f);
+	ASSERT_EQ(skinning->clip(), other);
+
+	ASSERT_THROW(skinning->crossFade(createClip(numBones + 1, 1.f), 0), std::invalid_argument);
+}
+
+TEST_F(SkinningTest, AdditiveClip)
+{
+	const unsigned int numBones = 10;
+	auto clip = createClip(numBones, 2.f);
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto root = Node::create()->addComponent(sceneManager);
+	auto node = createSkinnedNode(createCompressedSkin(clip, 37), 37);
+	auto skinning = node->component<Skinning>();
+
+	root->addChild(node);
+	skinning->additiveClip(createClip(numBones, 3.f), .5f);
+	skinning->stop();
+	skinning->seek(500);
+	sceneManager->nextFrame(0.f, 0.f);
+
+	// scale of 2, times half of the additive scale difference (1 + .5 * (3 - 1))
+	checkScaledPositions(node, numBones, 4.f);
+}
+
+TEST_F(SkinningTest, PoseCacheSharedByInstances)
+{
+	const unsigned int numBones = 10;
+	auto clip = createClip(numBones, 2.f);
+	auto cache = SkinPoseCache::create(10);
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto root = Node::create()->addComponent(sceneManager);
+	std::vector<Node::Ptr> nodes;
+
+	for (unsigned int i = 0; i < 3; ++i)
+	{
+		auto node = createSkinnedNode(createCompressedSkin(clip, 37), 37);
+		auto skinning = node->component<Skinning>();
+
+		skinning->poseCache(cache);
+		root->addChild(node);
+		skinning->stop();
+		// the last instance is not at the same time as the others
+		skinning->seek(i < 2 ? 255 : 500);
+		nodes.push_back(node);
+	}
+	sceneManager->nextFrame(0.f, 0.f);
+
+	ASSERT_EQ(cache->numPoses(), 2u);
+	ASSERT_EQ(cache->numMisses(), 2u);
+	ASSERT_EQ(cache->numHits(), 1u);
+	ASSERT_NEAR(cache->hitRate(), 1.f / 3.f, 1e-5f);
+	// 255 is rounded down to 250
+	checkScaledPositions(nodes[0], numBones, 1.5f);
+	checkScaledPositions(nodes[1], numBones, 1.5f);
+	checkScaledPositions(nodes[2], numBones, 2.f);
+}
+
+TEST_F(SkinningTest, PoseCacheClearedWhileBound)
+{
+	const unsigned int numBones = 10;
+	auto clip = createClip(numBones, 2.f);
+	auto cache = SkinPoseCache::create(10);
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto root = Node::create()->addComponent(sceneManager);
+	std::vector<Pass::Ptr> passes;
+	auto geometry = createGeometry(37);
+	auto skinning = Skinning::create(createCompressedSkin(clip, 37), SkinningMethod::HARDWARE, MinkoTests::canvas()->context(), nullptr);
+	auto node = Node::create()
+		->addComponent(Surface::create(geometry, material::BasicMaterial::create(), Effect::create(passes, "effect")))
+		->addComponent(skinning);
+
+	skinning->poseCache(cache);
+	root->addChild(node);
+	skinning->stop();
+	skinning->seek(250);
+	sceneManager->nextFrame(0.f, 0.f);
+
+	// the geometry still points to the cached pose: it must survive the cache
+	cache->clear();
+	for (unsigned int time = 0; time < 1000; time += 10)
+		cache->pose(createClip(numBones, 3.f), time);
+
+	std::vector<float> expected;
+	std::vector<float> worldMatrices;
+	const auto& boneMatrices = geometry->data()->get<data::UniformArrayPtr<float>>("boneMatrices");
+
+	clip->pose(250, expected, worldMatrices);
+	ASSERT_EQ(boneMatrices->first, (int)numBones);
+	for (unsigned int i = 0; i < expected.size(); ++i)
+		ASSERT_EQ(boneMatrices->second[i], expected[i]);
+}
+
+static
+Node::Ptr
+createTextureSkinnedNode(Skin::Ptr skin, unsigned int numVertices)
+{
+	std::vector<Pass::Ptr> passes;
+
+	return Node::create()
+		->addComponent(Surface::create(
+			createGeometry(numVertices), material::BasicMaterial::create(), Effect::create(passes, "effect")
+		))
+		->addComponent(Skinning::create(skin, SkinningMethod::TEXTURE, MinkoTests::canvas()->context(), nullptr));
+}
+
+TEST_F(SkinningTest, TextureSkinning)
+{
+	const unsigned int numBones = 10;
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto root = Node::create()->addComponent(sceneManager);
+	auto skin = createSkin(numBones, 37, 2);
+	auto node = createTextureSkinnedNode(skin, 37);
+	auto skinning = node->component<Skinning>();
+	auto geometry = node->component<Surface>()->geometry();
+	auto input = geometry->vertexBuffer("position")->data();
+
+	if (!MinkoTests::canvas()->context()->supportsFloatTextures())
+	{
+		ASSERT_EQ(skinning->method(), SkinningMethod::HARDWARE);
+		return;
+	}
+
+	root->addChild(node);
+	skinning->stop();
+	skinning->seek(999);
+	sceneManager->nextFrame(0.f, 0.f);
+
+	auto texture = skinning->boneTexture();
+
+	ASSERT_EQ(skinning->method(), SkinningMethod::TEXTURE);
+	// 4 texels per bone
+	ASSERT_EQ(texture->width(), 64u);
+	ASSERT_EQ(texture->height(), 1u);
+	ASSERT_EQ(geometry->data()->get<AbstractTexture::Ptr>("boneTexture"), texture);
+	ASSERT_EQ(geometry->data()->get<int>("numBones"), (int)numBones);
+	ASSERT_EQ(geometry->data()->get<float>("boneTextureOffset"), 0.f);
+	ASSERT_FALSE(geometry->data()->hasProperty("boneMatrices"));
+	// uploaded when the rendering begins
+	ASSERT_FALSE(texture->isDirty());
+
+	const auto& matrices = skin->matrices(1);
+
+	for (unsigned int i = 0; i < numBones * 16; ++i)
+		ASSERT_EQ(texture->data()[i], matrices[i]);
+	// the vertices are skinned by the vertex shader
+	ASSERT_EQ(geometry->vertexBuffer("position")->data(), input);
+}
+
+TEST_F(SkinningTest, SharedBoneTexture)
+{
+	const unsigned int numBones = 10;
+	const unsigned int numInstances = 3;
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto root = Node::create()->addComponent(sceneManager);
+	auto skin = createSkin(numBones, 37, 2);
+	auto texture = Skinning::createBoneTexture(MinkoTests::canvas()->context(), numInstances * numBones);
+
+	if (!MinkoTests::canvas()->context()->supportsFloatTextures())
+		return;
+
+	ASSERT_EQ(texture->width(), 128u);
+	ASSERT_EQ(texture->height(), 1u);
+
+	for (unsigned int i = 0; i < numInstances; ++i)
+	{
+		auto node = createTextureSkinnedNode(skin, 37);
+		auto skinning = node->component<Skinning>();
+
+		skinning->boneTexture(texture, i * numBones);
+		root->addChild(node);
+		skinning->stop();
+		// the second instance plays the first frame, the others the second one
+		skinning->seek(i == 1 ? 0 : 999);
+
+		ASSERT_EQ(
+			node->component<Surface>()->geometry()->data()->get<float>("boneTextureOffset"), float(i * numBones)
+		);
+	}
+	sceneManager->nextFrame(0.f, 0.f);
+
+	ASSERT_FALSE(texture->isDirty());
+	for (unsigned int i = 0; i < numInstances; ++i)
+	{
+		const auto& matrices = skin->matrices(i == 1 ? 0 : 1);
+
+		for (unsigned int j = 0; j < numBones * 16; ++j)
+			ASSERT_EQ(texture->data()[i * numBones * 16 + j], matrices[j]);
+	}
+
+	auto skinning = root->children()[0]->component<Skinning>();
+
+	// the texture holds 32 bone matrices
+
+	EXPECT_THROW(skinning->boneTexture(texture, 3 * numBones), std::invalid_argument);
+	EXPECT_THROW(skinning->boneTexture(nullptr, 0), std::invalid_argument);
+}
+
+TEST_F(SkinningTest, BoneTextureBoundBeforeUpdate)
+{
+	const unsigned int numBones = 10;
+	auto context = MinkoTests::canvas()->context();
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto root = Node::create()->addComponent(sceneManager);
+	auto skin = createSkin(numBones, 37, 2);
+	auto geometry = createGeometry(37);
+	auto indices = IndexBuffer::create(context);
+
+	if (!context->supportsFloatTextures())
+		return;
+
+	for (unsigned short i = 0; i < 36; ++i)
+		indices->data().push_back(i);
+	geometry->indices(indices);
+
+	// a pass sampling the bone texture, as the skinning effects do
+	data::BindingMap attributeBindings;
+	data::BindingMap uniformBindings;
+	data::BindingMap stateBindings;
+	data::MacroBindingMap macroBindings;
+
+	attributeBindings["position"] = data::Binding("geometry[${geometryId}].position", data::BindingSource::TARGET);
+	uniformBindings["boneTexture"] = data::Binding("geometry[${geometryId}].boneTexture", data::BindingSource::TARGET);
+
+	auto program = Program::create(
+		context,
+		Shader::create(context, Shader::Type::VERTEX_SHADER,
+			"attribute vec3 position; void main() { gl_Position = vec4(position, 1.0); }"),
+		Shader::create(context, Shader::Type::FRAGMENT_SHADER,
+			"uniform sampler2D boneTexture; void main() { gl_FragColor = texture2D(boneTexture, vec2(0.0)); }")
+	);
+	std::vector<Pass::Ptr> passes = {
+		Pass::create("pass", program, attributeBindings, uniformBindings, stateBindings, macroBindings, States::create(), "")
+	};
+	auto skinning = Skinning::create(skin, SkinningMethod::TEXTURE, context, nullptr);
+	auto node = Node::create()
+		->addComponent(Surface::create(geometry, material::BasicMaterial::create(), Effect::create(passes, "effect")))
+		->addComponent(skinning);
+	auto camera = Node::create()
+		->addComponent(Transform::create())
+		->addComponent(PerspectiveCamera::create(1.f, .785f, .1f, 100.f))
+		->addComponent(Renderer::create());
+
+	skinning->stop();
+	root->addChild(camera)->addChild(node);
+
+	// the draw call binds the bone texture before the skinning is ever updated
+	camera->component<Renderer>()->render(context);
+	sceneManager->nextFrame(0.f, 0.f);
+
+	ASSERT_FALSE(skinning->boneTexture()->isDirty());
+}
@@ -0,0 +1,198 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "StaticBatchingTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::geometry;
+using namespace minko::math;
+using namespace minko::render;
+using namespace minko::scene;
+
+static
+Node::Ptr
+createTriangleNode(material::Material::Ptr material, Effect::Ptr effect, float x)
+{
+	auto geometry = MinkoTests::createGeometry({
+		0.f, 0.f, 0.f,		0.f, 0.f, 1.f,
+		1.f, 0.f, 0.f,		0.f, 0.f, 1.f,
+		0.f, 1.f, 0.f,		0.f, 0.f, 1.f
+	}, { 0, 1, 2 }, 6);
+
+	return Node::create()
+		->addComponent(Transform::create(Matrix4x4::create()->appendTranslation(x, 0.f, 0.f)))
+		->addComponent(Surface::create(geometry, material, effect));
+}
+
+TEST_F(StaticBatchingTest, MergeSurfacesSharingMaterial)
+{
+	auto material = material::BasicMaterial::create();
+	auto effect = MinkoTests::createEffect();
+	auto root = Node::create()->addComponent(Transform::create());
+	auto n1 = createTriangleNode(material, effect, 0.f);
+	auto n2 = createTriangleNode(material, effect, 10.f);
+
+	root->addChild(n1)->addChild(n2);
+
+	auto batching = StaticBatching::create();
+
+	root->addComponent(batching);
+
+	ASSERT_EQ(batching->batches().size(), 1);
+	ASSERT_EQ(batching->numBatchedSurfaces(), 2);
+	ASSERT_FALSE(n1->hasComponent<Surface>());
+	ASSERT_FALSE(n2->hasComponent<Surface>());
+
+	auto batchSurface = batching->batches()[0].surface;
+	auto geometry = batchSurface->geometry();
+	auto& vertices = geometry->vertexBuffer("position")->data();
+	auto& indices = geometry->indices()->data();
+
+	ASSERT_EQ(geometry->numVertices(), 6);
+	ASSERT_EQ(indices, std::vector<unsigned short>({ 0, 1, 2, 3, 4, 5 }));
+	ASSERT_FLOAT_EQ(vertices[6 * 3], 10.f);
+	ASSERT_FLOAT_EQ(vertices[6 * 4], 11.f);
+	ASSERT_FLOAT_EQ(vertices[6 * 4 + 5], 1.f);
+	ASSERT_EQ(batchSurface->targets()[0]->parent(), root);
+}
+
+TEST_F(StaticBatchingTest, DifferentMaterialsAreNotMerged)
+{
+	auto effect = MinkoTests::createEffect();
+	auto root = Node::create()->addComponent(Transform::create());
+	auto n1 = createTriangleNode(material::BasicMaterial::create(), effect, 0.f);
+	auto n2 = createTriangleNode(material::BasicMaterial::create(), effect, 10.f);
+
+	root->addChild(n1)->addChild(n2);
+
+	auto batching = StaticBatching::create();
+
+	root->addComponent(batching);
+
+	ASSERT_EQ(batching->batches().size(), 0);
+	ASSERT_TRUE(n1->hasComponent<Surface>());
+	ASSERT_TRUE(n2->hasComponent<Surface>());
+}
+
+TEST_F(StaticBatchingTest, SourceMapping)
+{
+	auto material = material::BasicMaterial::create();
+	auto effect = MinkoTests::createEffect();
+	auto root = Node::create()->addComponent(Transform::create());
+	auto n1 = createTriangleNode(material, effect, 0.f);
+	auto n2 = createTriangleNode(material, effect, 10.f);
+	auto s1 = n1->component<Surface>();
+	auto s2 = n2->component<Surface>();
+
+	root->addChild(n1)->addChild(n2);
+
+	auto batching = StaticBatching::create();
+
+	root->addComponent(batching);
+
+	auto batchSurface = batching->batchSurface(s1);
+
+	ASSERT_NE(batchSurface, nullptr);
+	ASSERT_EQ(batching->batchSurface(s2), batchSurface);
+	ASSERT_EQ(batching->source(batchSurface, 0)->surface, s1);
+	ASSERT_EQ(batching->source(batchSurface, 1)->surface, s2);
+	ASSERT_EQ(batching->source(batchSurface, 1)->node, n2);
+	ASSERT_FLOAT_EQ(batching->source(batchSurface, 1)->min.x, 10.f);
+	ASSERT_FLOAT_EQ(batching->source(batchSurface, 1)->max.x, 11.f);
+	ASSERT_EQ(batching->source(batchSurface, 2), nullptr);
+}
+
+TEST_F(StaticBatchingTest, RestoreOnRemove)
+{
+	auto material = material::BasicMaterial::create();
+	auto effect = MinkoTests::createEffect();
+	auto root = Node::create()->addComponent(Transform::create());
+	auto n1 = createTriangleNode(material, effect, 0.f);
+	auto n2 = createTriangleNode(material, effect, 10.f);
+	auto s1 = n1->component<Surface>();
+
+	root->addChild(n1)->addChild(n2);
+
+	auto batching = StaticBatching::create();
+
+	root->addComponent(batching);
+	ASSERT_EQ(root->children().size(), 3);
+
+	root->removeComponent(batching);
+
+	ASSERT_EQ(root->children().size(), 2);
+	ASSERT_EQ(n1->component<Surface>(), s1);
+	ASSERT_TRUE(n2->hasComponent<Surface>());
+	ASSERT_EQ(batching->batches().size(), 0);
+}
+
+TEST_F(StaticBatchingTest, TangentsFollowNonUniformScale)
+{
+	auto material = material::BasicMaterial::create();
+	auto effect = MinkoTests::createEffect();
+	auto root = Node::create()->addComponent(Transform::create());
+	const float s = 1.f / std::sqrt(2.f);
+
+	// a triangle in the x = y plane, with tangents along (1, 1, 0)
+	for (uint i = 0; i < 2; ++i)
+	{
+		auto geometry = MinkoTests::createGeometry({
+			0.f, 0.f, 0.f,		s, -s, 0.f,
+			1.f, 1.f, 0.f,		s, -s, 0.f,
+			0.f, 0.f, 1.f,		s, -s, 0.f
+		}, { 0, 1, 2 }, 6);
+		auto tangents = VertexBuffer::create(nullptr);
+
+		tangents->data() = { s, s, 0.f, s, s, 0.f, s, s, 0.f };
+		tangents->addAttribute("tangent", 3, 0);
+		geometry->addVertexBuffer(tangents);
+
+		root->addChild(Node::create()
+			->addComponent(Transform::create(Matrix4x4::create()->appendScale(2.f, 1.f, 1.f)))
+			->addComponent(Surface::create(geometry, material, effect)));
+	}
+
+	auto batching = StaticBatching::create();
+
+	root->addComponent(batching);
+
+	ASSERT_EQ(batching->batches().size(), 1);
+
+	auto geometry = batching->batches()[0].surface->geometry();
+	auto& normals = geometry->vertexBuffer("normal")->data();
+	auto& tangents = geometry->vertexBuffer("tangent")->data();
+	auto vertexSize = geometry->vertexBuffer("tangent")->vertexSize();
+	auto normalOffset = std::get<2>(*geometry->vertexBuffer("normal")->attribute("normal"));
+	auto tangentOffset = std::get<2>(*geometry->vertexBuffer("tangent")->attribute("tangent"));
+	auto invSqrt5 = 1.f / std::sqrt(5.f);
+
+	for (uint vertexId = 0; vertexId < geometry->numVertices(); ++vertexId)
+	{
+		const float* n = &normals[vertexId * vertexSize + normalOffset];
+		const float* t = &tangents[vertexId * vertexSize + tangentOffset];
+
+		ASSERT_NEAR(t[0], 2.f * invSqrt5, 1e-5f);
+		ASSERT_NEAR(t[1], invSqrt5, 1e-5f);
+		ASSERT_NEAR(t[2], 0.f, 1e-5f);
+		ASSERT_NEAR(n[0] * t[0] + n[1] * t[1] + n[2] * t[2], 0.f, 1e-5f);
+	}
+}
@@ -329,3 +329,268 @@ TEST_F(TransformTest, Clone)
 
 	ASSERT_FALSE(n2->component<Transform>()->matrix()->equals(n1->component<Transform>()->matrix()));
 }
+
+TEST_F(TransformTest, ModelToWorldDeepHierarchy)
+{
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto root = Node::create()->addComponent(sceneManager);
+	auto n1 = Node::create()->addComponent(Transform::create(Matrix4x4::create()->appendTranslation(1.f, 2.f, 3.f)));
+	auto n2 = Node::create()->addComponent(Transform::create(Matrix4x4::create()->appendRotationY(.5f)));
+	auto n3 = Node::create()->addComponent(Transform::create(Matrix4x4::create()->appendScale(2.f)->appendTranslation(0.f, -1.f, 0.f)));
+
+	root->addChild(n1);
+	n1->addChild(n2);
+	n2->addChild(n3);
+
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	auto expected = Matrix4x4::create()
+		->copyFrom(n3->component<Transform>()->matrix())
+		->append(n2->component<Transform>()->matrix())
+		->append(n1->component<Transform>()->matrix());
+	auto modelToWorld = n3->component<Transform>()->modelToWorldMatrix();
+
+	for (auto i = 0; i < 16; ++i)
+		ASSERT_NEAR(expected->data()[i], modelToWorld->data()[i], 1e-5f);
+
+	n2->component<Transform>()->matrix()->appendTranslation(0.f, 0.f, 5.f);
+
+	expected
+		->copyFrom(n3->component<Transform>()->matrix())
+		->append(n2->component<Transform>()->matrix())
+		->append(n1->component<Transform>()->matrix());
+	modelToWorld = n3->component<Transform>()->modelToWorldMatrix(true);
+
+	for (auto i = 0; i < 16; ++i)
+		ASSERT_NEAR(expected->data()[i], modelToWorld->data()[i], 1e-5f);
+}
+
+TEST_F(TransformTest, ReparentUpdatesModelToWorld)
+{
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto root = Node::create()->addComponent(sceneManager);
+	auto n1 = Node::create()->addComponent(Transform::create(Matrix4x4::create()->appendTranslation(1.f, 0.f, 0.f)));
+	auto n2 = Node::create()->addComponent(Transform::create(Matrix4x4::create()->appendTranslation(0.f, 2.f, 0.f)));
+	auto n3 = Node::create()->addComponent(Transform::create(Matrix4x4::create()->appendTranslation(0.f, 0.f, 3.f)));
+
+	root->addChild(n1);
+	root->addChild(n2);
+	n1->addChild(n3);
+
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	ASSERT_TRUE(n3->component<Transform>()->modelToWorld(Vector3::create())->equals(Vector3::create(1.f, 0.f, 3.f)));
+
+	n2->addChild(n3);
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	ASSERT_TRUE(n3->component<Transform>()->modelToWorld(Vector3::create())->equals(Vector3::create(0.f, 2.f, 3.f)));
+
+	n2->removeComponent(n2->component<Transform>());
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	ASSERT_TRUE(n3->component<Transform>()->modelToWorld(Vector3::create())->equals(Vector3::create(0.f, 0.f, 3.f)));
+
+	n2->addComponent(Transform::create(Matrix4x4::create()->appendTranslation(0.f, 4.f, 0.f)));
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	ASSERT_TRUE(n3->component<Transform>()->modelToWorld(Vector3::create())->equals(Vector3::create(0.f, 4.f, 3.f)));
+}
+
+TEST_F(TransformTest, AddRemoveSubtreeInLargeScene)
+{
+	const unsigned int numBatchNodes = 1000;
+
+	for (auto numSceneNodes : { 1000, 20000 })
+	{
+		auto sceneManager = SceneManager::create(MinkoTests::canvas());
+		auto root = Node::create()->addComponent(sceneManager);
+
+		for (auto i = 0; i < numSceneNodes; ++i)
+			root->addChild(Node::create()->addComponent(Transform::create()));
+
+		sceneManager->nextFrame(0.0f, 0.0f);
+
+		auto batch = Node::create()->addComponent(Transform::create(Matrix4x4::create()->appendTranslation(1.f, 0.f, 0.f)));
+
+		for (auto i = 1; i < numBatchNodes; ++i)
+			batch->addChild(Node::create()->addComponent(Transform::create()));
+
+		root->addChild(batch);
+		sceneManager->nextFrame(0.0f, 0.0f);
+
+		ASSERT_TRUE(batch->children().back()->component<Transform>()->modelToWorld(Vector3::create())->equals(Vector3::create(1.f, 0.f, 0.f)));
+
+		root->removeChild(batch);
+		sceneManager->nextFrame(0.0f, 0.0f);
+
+		ASSERT_TRUE(batch->children().back()->component<Transform>()->modelToWorld(Vector3::create())->equals(Vector3::create(1.f, 0.f, 0.f)));
+		ASSERT_TRUE(root->children().back()->component<Transform>()->modelToWorld(Vector3::create())->equals(Vector3::create()));
+	}
+}
+
+// benchmark, run with --gtest_also_run_disabled_tests
+TEST_F(TransformTest, DISABLED_AddRemoveSubtreeInLargeSceneBenchmark)
+{
+	const unsigned int numBatchNodes = 1000;
+
+	for (auto numSceneNodes : { 1000, 20000 })
+	{
+		auto sceneManager = SceneManager::create(MinkoTests::canvas());
+		auto root = Node::create()->addComponent(sceneManager);
+
+		for (auto i = 0; i < numSceneNodes; ++i)
+			root->addChild(Node::create()->addComponent(Transform::create()));
+
+		sceneManager->nextFrame(0.0f, 0.0f);
+
+		auto batch = Node::create()->addComponent(Transform::create(Matrix4x4::create()->appendTranslation(1.f, 0.f, 0.f)));
+
+		for (auto i = 1; i < numBatchNodes; ++i)
+			batch->addChild(Node::create()->addComponent(Transform::create()));
+
+		auto start = std::chrono::high_resolution_clock::now();
+
+		root->addChild(batch);
+		sceneManager->nextFrame(0.0f, 0.0f);
+
+		auto addTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start);
+
+		start = std::chrono::high_resolution_clock::now();
+
+		root->removeChild(batch);
+		sceneManager->nextFrame(0.0f, 0.0f);
+
+		auto removeTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start);
+
+		std::cout << "adding " << numBatchNodes << " nodes to " << numSceneNodes << " nodes: " << addTime.count() << "us, "
+			<< "removing them: " << removeTime.count() << "us" << std::endl;
+	}
+}
+
+TEST_F(TransformTest, OnlyDirtySubtreesAreUpdated)
+{
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto root = Node::create()->addComponent(sceneManager)->addComponent(Transform::create());
+	std::vector<Node::Ptr> nodes;
+
+	for (auto i = 0; i < 100; ++i)
+	{
+		auto parent = Node::create()->addComponent(Transform::create());
+
+		for (auto j = 0; j < 9; ++j)
+			parent->addChild(Node::create()->addComponent(Transform::create()));
+
+		root->addChild(parent);
+		nodes.push_back(parent);
+	}
+
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	auto transform = root->component<Transform>();
+
+	ASSERT_EQ(transform->numVisitedTransforms(), 1001);
+	ASSERT_EQ(transform->numSkippedTransforms(), 0);
+
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	ASSERT_EQ(transform->numVisitedTransforms(), 0);
+	ASSERT_EQ(transform->numSkippedTransforms(), 1001);
+
+	nodes[10]->component<Transform>()->matrix()->appendTranslation(1.f);
+	nodes[20]->children()[3]->component<Transform>()->matrix()->appendTranslation(1.f);
+	nodes[10]->children()[0]->component<Transform>()->matrix()->appendTranslation(1.f);
+
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	ASSERT_EQ(transform->numVisitedTransforms(), 11);
+	ASSERT_EQ(transform->numSkippedTransforms(), 990);
+	ASSERT_TRUE(nodes[10]->children()[0]->component<Transform>()->modelToWorld(Vector3::create())->equals(Vector3::create(2.f, 0.f, 0.f)));
+	ASSERT_TRUE(nodes[20]->children()[3]->component<Transform>()->modelToWorld(Vector3::create())->equals(Vector3::create(1.f, 0.f, 0.f)));
+	ASSERT_TRUE(nodes[20]->children()[4]->component<Transform>()->modelToWorld(Vector3::create())->equals(Vector3::create(0.f, 0.f, 0.f)));
+
+	root->component<Transform>()->matrix()->appendTranslation(1.f);
+
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	ASSERT_EQ(transform->numVisitedTransforms(), 1001);
+	ASSERT_TRUE(nodes[10]->children()[0]->component<Transform>()->modelToWorld(Vector3::create())->equals(Vector3::create(3.f, 0.f, 0.f)));
+}
+
+TEST_F(TransformTest, ParallelUpdateMatchesSingleThreadedUpdate)
+{
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto root = Node::create()->addComponent(sceneManager)->addComponent(Transform::create());
+	std::vector<Node::Ptr> nodes;
+
+	for (auto i = 0; i < 100; ++i)
+	{
+		auto character = Node::create()->addComponent(Transform::create());
+
+		character->component<Transform>()->matrix()->appendTranslation((float)i, 0.f, 0.f);
+
+		for (auto j = 0; j < 4; ++j)
+		{
+			auto limb = Node::create()->addComponent(Transform::create());
+
+			limb->component<Transform>()->matrix()->appendTranslation(0.f, (float)j, 0.f);
+
+			for (auto k = 0; k < 4; ++k)
+			{
+				auto bone = Node::create()->addComponent(Transform::create());
+
+				bone->component<Transform>()->matrix()->appendTranslation(0.f, 0.f, (float)k);
+				limb->addChild(bone);
+				nodes.push_back(bone);
+			}
+
+			character->addChild(limb);
+		}
+
+		root->addChild(character);
+	}
+
+	Transform::parallelUpdate(3, 0);
+
+	ASSERT_EQ(Transform::numUpdateThreads(), 3);
+
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	auto transform = root->component<Transform>();
+
+	ASSERT_EQ(transform->numVisitedTransforms(), 2101);
+
+	for (auto i = 0u; i < nodes.size(); ++i)
+	{
+		auto position = nodes[i]->component<Transform>()->modelToWorld(Vector3::create());
+
+		ASSERT_TRUE(position->equals(Vector3::create((float)(i / 16), (float)((i / 4) % 4), (float)(i % 4))));
+	}
+
+	// the parallel update only refreshes the dirty subtrees as well
+	for (auto i = 0u; i < nodes.size(); i += 2)
+		nodes[i]->component<Transform>()->matrix()->appendTranslation(0.f, 0.f, 1.f);
+
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	ASSERT_EQ(transform->numVisitedTransforms(), 800);
+	ASSERT_EQ(transform->numSkippedTransforms(), 1301);
+
+	for (auto i = 0u; i < nodes.size(); ++i)
+	{
+		auto position = nodes[i]->component<Transform>()->modelToWorld(Vector3::create());
+
+		ASSERT_TRUE(position->equals(Vector3::create((float)(i / 16), (float)((i / 4) % 4), (float)(i % 4) + (i % 2 ? 0.f : 1.f))));
+	}
+
+	Transform::parallelUpdate(0);
+
+	ASSERT_EQ(Transform::numUpdateThreads(), 0);
+
+	root->component<Transform>()->matrix()->appendTranslation(1.f);
+
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	ASSERT_EQ(transform->numVisitedTransforms(), 2101);
+	ASSERT_TRUE(nodes[0]->component<Transform>()->modelToWorld(Vector3::create())->equals(Vector3::create(1.f, 0.f, 1.f)));
+}
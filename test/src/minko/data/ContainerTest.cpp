@@ -247,3 +247,76 @@ TEST_F(ContainerTest, ArrayRemoveAdd)
 	ASSERT_TRUE(c->hasProvider(array2));
 	ASSERT_FALSE(c->hasProvider(array3));
 }
+
+TEST_F(ContainerTest, GetByPropertyId)
+{
+	auto p = Provider::create();
+	auto a = ArrayProvider::create("array");
+	auto c = Container::create();
+
+	p->set("foo", 42);
+	a->set("bar", 23);
+	c->addProvider(p);
+	c->addProvider(a);
+
+	auto fooId = PropertyId::find("foo");
+	auto barId = PropertyId::find("array[0].bar");
+
+	ASSERT_NE(barId, PropertyId::UNDEFINED);
+	ASSERT_TRUE(c->hasProperty(fooId));
+	ASSERT_EQ(c->get<int>(fooId), 42);
+	ASSERT_EQ(c->get<int>(barId), 23);
+
+	c->set(barId, 24);
+
+	ASSERT_EQ(a->get<int>("bar"), 24);
+}
+
+TEST_F(ContainerTest, PropertyValueChangedOnArrayProvider)
+{
+	auto a = ArrayProvider::create("array");
+	auto c = Container::create();
+	int v = 0;
+
+	a->set("foo", 42);
+	c->addProvider(a);
+
+	auto _ = c->propertyValueChanged("array[0].foo")->connect(
+		[&](Container::Ptr container, const std::string& propertyName)
+		{
+			v = container->get<int>(propertyName);
+		}
+	);
+
+	a->set("foo", 23);
+
+	ASSERT_EQ(v, 23);
+}
+
+TEST_F(ContainerTest, PropertyValueChangedDeferredByUpdate)
+{
+	auto c = Container::create();
+	auto p = Provider::create();
+	int numCalls = 0;
+
+	p->set("foo", 1);
+	c->addProvider(p);
+
+	auto _ = c->propertyValueChanged("foo")->connect(
+		[&](Container::Ptr container, const std::string& propertyName)
+		{
+			++numCalls;
+		}
+	);
+
+	c->beginUpdate();
+	c->set("foo", 2);
+	p->set("foo", 3);
+
+	ASSERT_EQ(numCalls, 0);
+
+	c->endUpdate();
+
+	ASSERT_EQ(numCalls, 1);
+	ASSERT_EQ(c->get<int>("foo"), 3);
+}
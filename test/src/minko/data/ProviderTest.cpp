@@ -177,3 +177,151 @@ TEST_F(ProviderTest, Swap)
 	ASSERT_EQ(vFoo, 24);
 	ASSERT_EQ(vBar, 42);
 }
+
+TEST_F(ProviderTest, PropertyId)
+{
+	auto provider = Provider::create();
+	auto fooId = PropertyId::get("foo");
+
+	ASSERT_EQ(PropertyId::get("foo"), fooId);
+	ASSERT_EQ(PropertyId::name(fooId), "foo");
+
+	provider->set(fooId, 42);
+
+	ASSERT_TRUE(provider->hasProperty(fooId));
+	ASSERT_TRUE(provider->hasProperty("foo"));
+	ASSERT_EQ(provider->get<int>("foo"), 42);
+	ASSERT_EQ(provider->get<int>(fooId), 42);
+	ASSERT_EQ(provider->slot(fooId), 0);
+}
+
+TEST_F(ProviderTest, PropertyIdFromThreads)
+{
+	const unsigned int numThreads = 4;
+	const unsigned int numNames = 20011;
+	std::vector<std::vector<uint>> ids(numThreads, std::vector<uint>(numNames));
+	std::vector<std::thread> threads;
+
+	// every thread interns the same new names in a different order
+	for (auto t = 0u; t < numThreads; ++t)
+		threads.push_back(std::thread([&, t]()
+		{
+			for (auto i = 0u; i < numNames; ++i)
+			{
+				auto nameId = (i * (t * 2 + 1)) % numNames;
+
+				ids[t][nameId] = PropertyId::get("fromThreads" + std::to_string(nameId));
+			}
+		}));
+	for (auto& thread : threads)
+		thread.join();
+
+	for (auto i = 0u; i < numNames; ++i)
+	{
+		for (auto t = 1u; t < numThreads; ++t)
+			ASSERT_EQ(ids[t][i], ids[0][i]);
+		ASSERT_EQ(PropertyId::name(ids[0][i]), "fromThreads" + std::to_string(i));
+	}
+}
+
+TEST_F(ProviderTest, UnsetKeepsSlotsConsistent)
+{
+	auto provider = Provider::create();
+
+	provider->set("foo", 1);
+	provider->set("bar", 2);
+	provider->set("baz", 3);
+	provider->unset("foo");
+
+	ASSERT_FALSE(provider->hasProperty("foo"));
+	ASSERT_EQ(provider->slot(PropertyId::get("bar")), 0);
+	ASSERT_EQ(provider->slot(PropertyId::get("baz")), 1);
+	ASSERT_EQ(provider->get<int>("bar"), 2);
+	ASSERT_EQ(provider->get<int>("baz"), 3);
+}
+
+TEST_F(ProviderTest, ValueChangedDeferredByUpdate)
+{
+	auto provider = Provider::create();
+	int numCalls = 0;
+
+	provider->set("foo", 1);
+
+	auto _ = provider->propertyValueChanged()->connect(
+		[&](Provider::Ptr p, const std::string& propertyName)
+		{
+			if (p == provider && propertyName == "foo")
+				++numCalls;
+		}
+	);
+
+	provider->beginUpdate();
+	provider->set("foo", 2);
+	provider->set("foo", 3);
+	provider->beginUpdate();
+	provider->set("foo", 4);
+	provider->endUpdate();
+
+	ASSERT_EQ(numCalls, 0);
+
+	provider->endUpdate();
+
+	ASSERT_EQ(numCalls, 1);
+	ASSERT_EQ(provider->get<int>("foo"), 4);
+	ASSERT_FALSE(provider->updating());
+}
+
+TEST_F(ProviderTest, UnsetDuringUpdate)
+{
+	auto provider = Provider::create();
+	int numCalls = 0;
+
+	auto _ = provider->propertyValueChanged()->connect(
+		[&](Provider::Ptr p, const std::string& propertyName)
+		{
+			++numCalls;
+		}
+	);
+
+	provider->beginUpdate();
+	provider->set("foo", 1);
+	provider->unset("foo");
+	provider->endUpdate();
+
+	ASSERT_EQ(numCalls, 0);
+}
+
+TEST_F(ProviderTest, PropertyIdChanged)
+{
+	auto provider = Provider::create();
+	auto fooId = PropertyId::get("foo");
+	std::vector<uint> valueChanged;
+	std::vector<uint> referenceChanged;
+
+	auto _ = provider->propertyIdValueChanged()->connect(
+		[&](Provider::Ptr p, uint propertyId)
+		{
+			valueChanged.push_back(propertyId);
+		}
+	);
+	auto __ = provider->propertyIdReferenceChanged()->connect(
+		[&](Provider::Ptr p, uint propertyId)
+		{
+			referenceChanged.push_back(propertyId);
+		}
+	);
+
+	provider->set("foo", 1);
+	provider->set(fooId, 2);
+
+	ASSERT_EQ(valueChanged, std::vector<uint>({ fooId, fooId }));
+	ASSERT_EQ(referenceChanged, std::vector<uint>({ fooId, fooId }));
+
+	provider->beginUpdate();
+	provider->set("foo", 3);
+	provider->set("foo", 4);
+	provider->endUpdate();
+
+	ASSERT_EQ(valueChanged.size(), 3u);
+	ASSERT_EQ(referenceChanged.size(), 3u);
+}
@@ -130,3 +130,257 @@ TEST_F(GeometryTest, VertexBufferRemovedFromData)
 
 	ASSERT_FALSE(g->data()->hasProperty("position"));
 }
+
+static
+Geometry::Ptr
+createRandomTriangles(uint numTriangles, float size)
+{
+	auto vertices = render::VertexBuffer::create(nullptr);
+	auto indices = render::IndexBuffer::create(nullptr);
+	auto geometry = Geometry::create();
+	auto random = [&]() { return ((float)(rand() % 10000) / 10000.f - .5f) * size; };
+
+	// an unused leading attribute checks the position offset
+	for (uint i = 0; i < numTriangles; ++i)
+	{
+		float x = random();
+		float y = random();
+		float z = random();
+
+		for (uint j = 0; j < 3; ++j)
+		{
+			vertices->data().push_back(0.f);
+			vertices->data().push_back(x + random() * .05f);
+			vertices->data().push_back(y + random() * .05f);
+			vertices->data().push_back(z + random() * .05f);
+			indices->data().push_back(i * 3 + j);
+		}
+	}
+	vertices->addAttribute("padding", 1, 0);
+	vertices->addAttribute("position", 3, 1);
+	geometry->addVertexBuffer(vertices);
+	geometry->indices(indices);
+
+	return geometry;
+}
+
+TEST_F(GeometryTest, CastWithBVHMatchesBruteForce)
+{
+	srand(42);
+
+	auto geometry = createRandomTriangles(5000, 10.f);
+	auto numHits = 0u;
+
+	for (auto i = 0; i < 500; ++i)
+	{
+		auto origin = math::Vector3::create((float)(rand() % 100) / 10.f - 5.f, (float)(rand() % 100) / 10.f - 5.f, 10.f);
+		auto direction = math::Vector3::create((float)(rand() % 100) / 500.f - .1f, (float)(rand() % 100) / 500.f - .1f, -1.f);
+		auto ray = math::Ray::create(origin, direction->normalize());
+		float distance = 0.f;
+		float bruteForceDistance = 0.f;
+		uint triangle = 0;
+		uint bruteForceTriangle = 0;
+
+		geometry->useBVH(true);
+		auto hit = geometry->cast(ray, distance, triangle);
+
+		geometry->useBVH(false);
+		auto bruteForceHit = geometry->cast(ray, bruteForceDistance, bruteForceTriangle);
+
+		ASSERT_EQ(hit, bruteForceHit);
+		if (hit)
+		{
+			ASSERT_EQ(triangle, bruteForceTriangle);
+			ASSERT_FLOAT_EQ(distance, bruteForceDistance);
+			++numHits;
+		}
+	}
+
+	ASSERT_GT(numHits, 0u);
+}
+
+// a 'size' x 'size' vertices grid in the xz plane with a unit spacing, at random heights below 'maxHeight'
+static
+Geometry::Ptr
+createHeightField(uint size, float maxHeight)
+{
+	std::vector<float> vertices;
+	std::vector<unsigned short> indices;
+
+	for (uint z = 0; z < size; ++z)
+		for (uint x = 0; x < size; ++x)
+		{
+			vertices.push_back((float)x);
+			vertices.push_back((float)(rand() % 100) / 100.f * maxHeight);
+			vertices.push_back((float)z);
+		}
+	for (uint z = 0; z + 1 < size; ++z)
+		for (uint x = 0; x + 1 < size; ++x)
+		{
+			unsigned short i = z * size + x;
+			unsigned short quad[] = { i, (unsigned short)(i + size), (unsigned short)(i + 1), (unsigned short)(i + 1), (unsigned short)(i + size), (unsigned short)(i + size + 1) };
+
+			indices.insert(indices.end(), quad, quad + 6);
+		}
+
+	return MinkoTests::createGeometry(vertices, indices);
+}
+
+TEST_F(GeometryTest, CastAxisAlignedRaysAlongEdges)
+{
+	// a flat 10 x 10 quads grid in the y = 0 plane, its bounding boxes have no thickness along y
+	const uint size = 11;
+	auto geometry = createHeightField(size, 0.f);
+
+	// vertical rays through every vertex run along triangle edges, the outer ones along box faces
+	auto numInnerHits = 0u;
+
+	for (uint z = 0; z < size; ++z)
+		for (uint x = 0; x < size; ++x)
+		{
+			auto ray = math::Ray::create(math::Vector3::create((float)x, 5.f, (float)z), math::Vector3::create(0.f, -1.f, 0.f));
+			float distance = 0.f;
+			float bruteForceDistance = 0.f;
+			uint triangle = 0;
+			uint bruteForceTriangle = 0;
+
+			geometry->useBVH(true);
+			auto hit = geometry->cast(ray, distance, triangle);
+
+			geometry->useBVH(false);
+			auto bruteForceHit = geometry->cast(ray, bruteForceDistance, bruteForceTriangle);
+
+			ASSERT_EQ(hit, bruteForceHit);
+			if (hit)
+				ASSERT_FLOAT_EQ(distance, bruteForceDistance);
+			if (x > 0 && z > 0 && x + 1 < size && z + 1 < size && hit)
+				++numInnerHits;
+		}
+
+	ASSERT_EQ(numInnerHits, (size - 2) * (size - 2));
+}
+
+TEST_F(GeometryTest, RayIntersectBoxOnFaces)
+{
+	const float min[] = { 0.f, 0.f, 0.f };
+	const float max[] = { 1.f, 0.f, 1.f };
+	const float inf = std::numeric_limits<float>::infinity();
+	const math::Vec3 down = { inf, -1.f, inf };
+	const math::Vec3 side = { 1.f, inf, inf };
+	float near;
+	float far;
+
+	// parallel to x and z, starting on the x = 0 and z = 1 faces of a box with no thickness along y
+	ASSERT_TRUE(math::Ray::intersectBox({ 0.f, 2.f, 1.f }, down, min, max, near, far));
+	ASSERT_FLOAT_EQ(near, 2.f);
+	ASSERT_FLOAT_EQ(far, 2.f);
+	ASSERT_FALSE(math::Ray::intersectBox({ -.01f, 2.f, 1.f }, down, min, max, near, far));
+
+	// parallel to the y = 0 slab and lying in it
+	ASSERT_TRUE(math::Ray::intersectBox({ -1.f, 0.f, .5f }, side, min, max, near, far));
+	ASSERT_FLOAT_EQ(near, 1.f);
+	ASSERT_FLOAT_EQ(far, 2.f);
+}
+
+TEST_F(GeometryTest, CastHitAttributes)
+{
+	auto geometry = MinkoTests::createGeometry({
+		0.f, 0.f, 0.f,		0.f, 0.f, 1.f,		0.f, 0.f,
+		1.f, 0.f, 0.f,		0.f, 0.f, 1.f,		1.f, 0.f,
+		0.f, 1.f, 0.f,		0.f, 0.f, 1.f,		0.f, 1.f
+	}, { 0, 1, 2 }, 8);
+
+	auto ray = math::Ray::create(math::Vector3::create(.25f, .5f, 2.f), math::Vector3::create(0.f, 0.f, -1.f));
+	auto hitXyz = math::Vector3::create();
+	auto hitUv = math::Vector2::create();
+	auto hitNormal = math::Vector3::create();
+	float distance = 0.f;
+	uint triangle = 1;
+
+	ASSERT_TRUE(geometry->cast(ray, distance, triangle, hitXyz, hitUv, hitNormal));
+	ASSERT_EQ(triangle, 0u);
+	ASSERT_FLOAT_EQ(distance, 2.f);
+	ASSERT_FLOAT_EQ(hitXyz->x(), .25f);
+	ASSERT_FLOAT_EQ(hitXyz->y(), .5f);
+	ASSERT_FLOAT_EQ(hitUv->x(), .25f);
+	ASSERT_FLOAT_EQ(hitUv->y(), .5f);
+	ASSERT_FLOAT_EQ(hitNormal->z(), 1.f);
+
+	// triangles behind the origin of the ray are not hit
+	auto backward = math::Ray::create(math::Vector3::create(.25f, .5f, 2.f), math::Vector3::create(0.f, 0.f, 1.f));
+
+	ASSERT_FALSE(geometry->cast(backward, distance, triangle));
+}
+
+TEST_F(GeometryTest, RemoveDuplicatedVertices)
+{
+	auto vertices = render::VertexBuffer::create(nullptr);
+	auto indices = render::IndexBuffer::create(nullptr);
+	auto geometry = Geometry::create();
+	float data[] = {
+		0.f, 0.f, 0.f,
+		1.f, 0.f, 0.f,
+		0.f, 1.f, 0.f,
+		1.f, 0.f, 0.f,
+		0.f, 1.f, 0.f,
+		1.f, 1.f, 0.f
+	};
+
+	vertices->data().assign(data, data + 18);
+	vertices->addAttribute("position", 3, 0);
+	indices->data() = { 0, 1, 2, 3, 4, 5 };
+	geometry->addVertexBuffer(vertices);
+	geometry->indices(indices);
+	geometry->removeDuplicatedVertices();
+
+	std::vector<unsigned short> expectedIndices = { 0, 1, 2, 1, 2, 3 };
+
+	ASSERT_EQ(geometry->numVertices(), 4u);
+	ASSERT_EQ(vertices->data().size(), 12u);
+	ASSERT_EQ(indices->data(), expectedIndices);
+	ASSERT_FLOAT_EQ(vertices->data()[9], 1.f);
+	ASSERT_FLOAT_EQ(vertices->data()[10], 1.f);
+}
+
+TEST_F(GeometryTest, CastHeightFieldWithBVHMatchesBruteForce)
+{
+	srand(42);
+
+	// a 255 x 255 vertices height field, about as many as 16 bits indices allow
+	const uint size = 255;
+	const uint numRays = 50;
+	auto geometry = createHeightField(size, 1.f);
+	std::vector<math::Ray::Ptr> rays;
+
+	for (uint i = 0; i < numRays; ++i)
+		rays.push_back(math::Ray::create(
+			math::Vector3::create((float)(rand() % 2540) / 10.f, 10.f, (float)(rand() % 2540) / 10.f),
+			math::Vector3::create(.1f, -1.f, .2f)->normalize()
+		));
+
+	auto numHits = 0u;
+
+	for (auto& ray : rays)
+	{
+		float distance = 0.f;
+		float bruteForceDistance = 0.f;
+		uint triangle = 0;
+		uint bruteForceTriangle = 0;
+
+		geometry->useBVH(true);
+		auto hit = geometry->cast(ray, distance, triangle);
+
+		geometry->useBVH(false);
+		auto bruteForceHit = geometry->cast(ray, bruteForceDistance, bruteForceTriangle);
+
+		ASSERT_EQ(hit, bruteForceHit);
+		if (hit)
+		{
+			ASSERT_EQ(triangle, bruteForceTriangle);
+			ASSERT_FLOAT_EQ(distance, bruteForceDistance);
+			++numHits;
+		}
+	}
+
+	ASSERT_GT(numHits, 0u);
+}
@@ -0,0 +1,174 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "SkinClipTest.hpp"
+
+#include "minko/geometry/SkinClip.hpp"
+
+using namespace minko;
+using namespace minko::geometry;
+using namespace minko::math;
+
+// a = b * c, row major
+static
+void
+multiply(const float* b, const float* c, float* a)
+{
+	for (unsigned int row = 0; row < 4; ++row)
+		for (unsigned int column = 0; column < 4; ++column)
+		{
+			a[row * 4 + column] = 0.f;
+			for (unsigned int k = 0; k < 4; ++k)
+				a[row * 4 + column] += b[row * 4 + k] * c[k * 4 + column];
+		}
+}
+
+// chain of bones rotating and stretching over time
+static
+std::vector<std::vector<float>>
+createLocalMatrices(unsigned int numBones, unsigned int numFrames)
+{
+	std::vector<std::vector<float>> localMatricesPerFrame(numFrames);
+
+	for (unsigned int frameId = 0; frameId < numFrames; ++frameId)
+		for (unsigned int boneId = 0; boneId < numBones; ++boneId)
+		{
+			const float t = float(frameId) / numFrames;
+			auto matrix = Matrix4x4::create()
+				->appendScale(1.f + .5f * t, 1.f, 1.f)
+				->appendRotationZ(std::sin(t * 6.f + boneId))
+				->appendRotationX(.3f * boneId * t)
+				->appendTranslation(boneId == 0 ? 10.f * t : 2.f, 0.f, 0.f);
+
+			localMatricesPerFrame[frameId].insert(
+				localMatricesPerFrame[frameId].end(), matrix->data().begin(), matrix->data().end()
+			);
+		}
+
+	return localMatricesPerFrame;
+}
+
+static
+std::vector<float>
+createOffsetMatrices(unsigned int numBones)
+{
+	std::vector<float> offsetMatrices;
+
+	for (unsigned int boneId = 0; boneId < numBones; ++boneId)
+	{
+		auto matrix = Matrix4x4::create()->appendTranslation(-2.f * boneId, 0.f, 0.f);
+
+		offsetMatrices.insert(offsetMatrices.end(), matrix->data().begin(), matrix->data().end());
+	}
+
+	return offsetMatrices;
+}
+
+TEST_F(SkinClipTest, PoseMatchesSampledFrames)
+{
+	const unsigned int numBones = 4;
+	const unsigned int numFrames = 120;
+	std::vector<int> parentIds = { -1, 0, 1, 1 };
+	auto localMatrices = createLocalMatrices(numBones, numFrames);
+	auto offsetMatrices = createOffsetMatrices(numBones);
+	auto clip = SkinClip::create(parentIds, offsetMatrices, 4000, localMatrices);
+	std::vector<float> skinningMatrices;
+	std::vector<float> worldMatrices;
+
+	ASSERT_EQ(clip->numBones(), numBones);
+	ASSERT_EQ(clip->numFrames(), numFrames);
+
+	for (unsigned int frameId = 0; frameId < numFrames; ++frameId)
+	{
+		std::vector<float> expectedWorld(numBones * 16);
+
+		clip->pose(frameId * 4000 / numFrames, skinningMatrices, worldMatrices);
+
+		for (unsigned int boneId = 0; boneId < numBones; ++boneId)
+		{
+			float expected[16];
+
+			if (parentIds[boneId] < 0)
+				std::copy(&localMatrices[frameId][boneId * 16], &localMatrices[frameId][boneId * 16] + 16, &expectedWorld[boneId * 16]);
+			else
+				multiply(&expectedWorld[parentIds[boneId] * 16], &localMatrices[frameId][boneId * 16], &expectedWorld[boneId * 16]);
+			multiply(&expectedWorld[boneId * 16], &offsetMatrices[boneId * 16], expected);
+
+			// skinning matrices are column major
+			for (unsigned int row = 0; row < 4; ++row)
+				for (unsigned int column = 0; column < 4; ++column)
+					ASSERT_NEAR(skinningMatrices[boneId * 16 + column * 4 + row], expected[row * 4 + column], 2e-2f);
+		}
+	}
+
+	// the tracks are smaller than the baked matrices
+	ASSERT_LT(clip->numKeys(), numBones * numFrames * 3);
+	ASSERT_LT(clip->memorySize(), numBones * numFrames * 16 * sizeof(float) / 2);
+}
+
+TEST_F(SkinClipTest, ConstantTracksKeepOneKey)
+{
+	const unsigned int numBones = 3;
+	std::vector<std::vector<float>> localMatrices(60);
+
+	for (auto& matrices : localMatrices)
+		for (unsigned int boneId = 0; boneId < numBones; ++boneId)
+		{
+			auto matrix = Matrix4x4::create()->appendRotationY(.5f)->appendTranslation(1.f, 2.f, 3.f);
+
+			matrices.insert(matrices.end(), matrix->data().begin(), matrix->data().end());
+		}
+
+	auto clip = SkinClip::create({ -1, 0, 0 }, createOffsetMatrices(numBones), 1000, localMatrices);
+
+	ASSERT_EQ(clip->numKeys(), numBones * 3);
+}
+
+TEST_F(SkinClipTest, LinearTrackIsInterpolated)
+{
+	std::vector<std::vector<float>> localMatrices(100);
+
+	for (unsigned int frameId = 0; frameId < 100; ++frameId)
+	{
+		auto matrix = Matrix4x4::create()->appendTranslation(float(frameId), 0.f, 0.f);
+
+		localMatrices[frameId] = matrix->data();
+	}
+
+	auto clip = SkinClip::create({ -1 }, createOffsetMatrices(1), 1000, localMatrices);
+	float matrix[12];
+
+	// 2 translation keys, a constant rotation and a constant scale
+	ASSERT_EQ(clip->numKeys(), 4u);
+
+	// between two sampled frames
+	clip->localMatrix(0, 425, matrix);
+
+	ASSERT_NEAR(matrix[3], 42.5f, 1e-3f);
+	ASSERT_NEAR(matrix[0], 1.f, 1e-4f);
+	ASSERT_NEAR(matrix[5], 1.f, 1e-4f);
+}
+
+TEST_F(SkinClipTest, ParentsFirst)
+{
+	std::vector<std::vector<float>> localMatrices(1, std::vector<float>(32, 0.f));
+
+	ASSERT_THROW(SkinClip::create({ 1, -1 }, createOffsetMatrices(2), 1000, localMatrices), std::invalid_argument);
+}
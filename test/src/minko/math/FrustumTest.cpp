@@ -0,0 +1,93 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FrustumTest.hpp"
+
+using namespace minko;
+using namespace minko::math;
+
+TEST_F(FrustumTest, TestBoxesMatchesScalar)
+{
+	// not a multiple of 8 so that the scalar tail is used as well
+	const unsigned int numBoxes = 1003;
+	auto frustum = Frustum::create();
+	auto boxes = randomBoxes(numBoxes);
+	const float* center[3];
+	const float* extent[3];
+	std::vector<uint> visibility((numBoxes + 31) / 32, 0xffffffff);
+	std::vector<uint> expected((numBoxes + 31) / 32);
+
+	frustum->updateFromMatrix(Matrix4x4::create()->perspective(.785f, 1.f, .1f, 200.f));
+
+	auto numVisible = frustum->testBoundingBoxes(boxes.center(center), boxes.extent(extent), numBoxes, visibility.data());
+	auto expectedNumVisible = Frustum::testBoxesScalar(frustum->planes(), center, extent, numBoxes, expected.data());
+
+	ASSERT_EQ(visibility, expected);
+	ASSERT_EQ(numVisible, expectedNumVisible);
+	ASSERT_GT(numVisible, 0u);
+	ASSERT_LT(numVisible, numBoxes);
+}
+
+TEST_F(FrustumTest, TestBoxesMatchesTestBoundingBox)
+{
+	auto frustum = Frustum::create();
+	Boxes boxes;
+	const float* center[3];
+	const float* extent[3];
+	uint visibility = 0;
+	// inside, behind, too far, left, right, above, below, across the near plane, around the whole frustum
+	const float positions[] = {
+		0.f, 0.f, -10.f,
+		0.f, 0.f, 10.f,
+		0.f, 0.f, -150.f,
+		-50.f, 0.f, -10.f,
+		50.f, 0.f, -10.f,
+		0.f, 50.f, -10.f,
+		0.f, -50.f, -10.f,
+		0.f, 0.f, 0.f,
+		0.f, 0.f, -50.f
+	};
+	const float sizes[] = { 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 500.f };
+
+	frustum->updateFromMatrix(Matrix4x4::create()->perspective(.785f, 1.f, .1f, 100.f));
+
+	for (auto i = 0; i < 9; ++i)
+		for (auto j = 0; j < 3; ++j)
+		{
+			boxes.centers[j].push_back(positions[i * 3 + j]);
+			boxes.extents[j].push_back(sizes[i] * .5f);
+		}
+
+	ASSERT_EQ(frustum->testBoundingBoxes(boxes.center(center), boxes.extent(extent), 9, &visibility), 3u);
+	ASSERT_EQ(visibility, (1u << 0) | (1u << 7) | (1u << 8));
+
+	for (auto i = 0; i < 9; ++i)
+	{
+		auto halfSize = sizes[i] * .5f;
+		auto box = Box::create(
+			Vector3::create(positions[i * 3] + halfSize, positions[i * 3 + 1] + halfSize, positions[i * 3 + 2] + halfSize),
+			Vector3::create(positions[i * 3] - halfSize, positions[i * 3 + 1] - halfSize, positions[i * 3 + 2] - halfSize)
+		);
+		auto result = frustum->testBoundingBox(box);
+
+		// testBoundingBox reports some boxes as AROUND without testing all the planes
+		if (result != ShapePosition::AROUND)
+			ASSERT_EQ(result == ShapePosition::INSIDE, (visibility & (1u << i)) != 0);
+	}
+}
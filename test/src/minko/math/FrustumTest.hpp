@@ -0,0 +1,88 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Minko.hpp"
+
+#include "gtest/gtest.h"
+
+namespace minko
+{
+	namespace math
+	{
+		class FrustumTest :
+			public ::testing::Test
+		{
+		public:
+			static inline
+			float
+			random(float min, float max)
+			{
+				return min + (max - min) * rand() / (float)RAND_MAX;
+			}
+
+			// boxes as SoA centers and half extents, spread in front of and around a camera looking down -z
+			struct Boxes
+			{
+				std::array<std::vector<float>, 3> centers;
+				std::array<std::vector<float>, 3> extents;
+
+				inline
+				const float* const*
+				center(const float** pointers) const
+				{
+					for (auto i = 0; i < 3; ++i)
+						pointers[i] = centers[i].data();
+
+					return pointers;
+				}
+
+				inline
+				const float* const*
+				extent(const float** pointers) const
+				{
+					for (auto i = 0; i < 3; ++i)
+						pointers[i] = extents[i].data();
+
+					return pointers;
+				}
+			};
+
+			static inline
+			Boxes
+			randomBoxes(unsigned int numBoxes)
+			{
+				Boxes boxes;
+
+				for (auto i = 0u; i < numBoxes; ++i)
+				{
+					boxes.centers[0].push_back(random(-200.f, 200.f));
+					boxes.centers[1].push_back(random(-200.f, 200.f));
+					boxes.centers[2].push_back(random(-300.f, 100.f));
+
+					for (auto j = 0; j < 3; ++j)
+						boxes.extents[j].push_back(random(.1f, 10.f));
+				}
+
+				return boxes;
+			}
+		};
+	}
+}
@@ -0,0 +1,288 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/math/Mat4Test.hpp"
+
+using namespace minko;
+using namespace minko::math;
+
+TEST_F(Mat4Test, IsAlignedValueType)
+{
+	ASSERT_EQ(sizeof(Mat4), 16 * sizeof(float));
+	ASSERT_EQ(alignof(Mat4), 16);
+	ASSERT_EQ(alignof(Vec4), 16);
+	ASSERT_TRUE(std::is_trivial<Mat4>::value);
+	ASSERT_TRUE(std::is_trivial<Vec3>::value);
+}
+
+TEST_F(Mat4Test, MultiplyMatchesMatrix4x4Prepend)
+{
+	auto a = randomMat4(10.f);
+	auto b = randomMat4(10.f);
+	auto m = Matrix4x4::create()->initialize(a)->prepend(Matrix4x4::create()->initialize(b));
+	auto c = a * b;
+
+	ASSERT_TRUE(nearEqual(c.m, &m->data()[0]));
+}
+
+TEST_F(Mat4Test, MultiplyInPlace)
+{
+	auto a = randomMat4(10.f);
+	auto b = randomMat4(10.f);
+	auto expected = a * b;
+	auto c = a;
+
+	Mat4::multiply(c.m, b.m, c.m);
+	ASSERT_TRUE(c == expected);
+
+	c = b;
+	Mat4::multiply(a.m, c.m, c.m);
+	ASSERT_TRUE(c == expected);
+}
+
+TEST_F(Mat4Test, InvertMatchesMatrix4x4Invert)
+{
+	auto m = Matrix4x4::create()
+		->appendRotationX(random(3.f))
+		->appendScale(2.f)
+		->appendTranslation(random(), random(), random());
+	auto inverse = Mat4::identity();
+
+	ASSERT_TRUE(Mat4::invert(&m->data()[0], inverse.m));
+
+	auto product = inverse * m->toMat4();
+
+	m->invert();
+
+	ASSERT_TRUE(nearEqual(inverse.m, &m->data()[0]));
+	ASSERT_TRUE(nearEqual(product.m, Mat4::identity().m));
+}
+
+TEST_F(Mat4Test, InvertSingular)
+{
+	Mat4 zero = {{ 0.f }};
+	auto output = Mat4::identity();
+
+	ASSERT_FALSE(Mat4::invert(zero.m, output.m));
+	ASSERT_TRUE(output == Mat4::identity());
+}
+
+TEST_F(Mat4Test, Transform)
+{
+	auto m = randomMat4(10.f);
+	Vec4 v = { random(10.f), random(10.f), random(10.f), 1.f };
+	auto result = m.transform(v);
+	auto point = m.transformPoint(v.xyz());
+	float expected[4];
+
+	for (auto i = 0; i < 4; ++i)
+		expected[i] = m.m[i * 4] * v.x + m.m[i * 4 + 1] * v.y + m.m[i * 4 + 2] * v.z + m.m[i * 4 + 3] * v.w;
+
+	ASSERT_TRUE(nearEqual(result.x, expected[0]));
+	ASSERT_TRUE(nearEqual(result.y, expected[1]));
+	ASSERT_TRUE(nearEqual(result.z, expected[2]));
+	ASSERT_TRUE(nearEqual(result.w, expected[3]));
+	ASSERT_TRUE(nearEqual(point.x, expected[0]));
+	ASSERT_TRUE(nearEqual(point.y, expected[1]));
+	ASSERT_TRUE(nearEqual(point.z, expected[2]));
+}
+
+TEST_F(Mat4Test, InvertMatchesScalarInvert)
+{
+	for (auto i = 0; i < 100; ++i)
+	{
+		auto m = randomMat4(1.f);
+		auto expected = Mat4::identity();
+		auto inverse = Mat4::identity();
+
+		// keep the matrix well conditioned
+		for (auto j = 0; j < 16; j += 5)
+			m.m[j] += 4.f;
+
+		ASSERT_TRUE(Mat4::invertScalar(m.m, expected.m));
+		ASSERT_TRUE(Mat4::invert(m.m, inverse.m));
+		ASSERT_TRUE(nearEqual(inverse.m, expected.m, 1e-2f));
+		ASSERT_TRUE(nearEqual((m * inverse).m, Mat4::identity().m, 1e-2f));
+	}
+}
+
+TEST_F(Mat4Test, InvertInPlace)
+{
+	auto m = Matrix4x4::create()->appendRotationY(1.f)->appendTranslation(1.f, 2.f, 3.f)->toMat4();
+	auto expected = m;
+
+	ASSERT_TRUE(Mat4::invertScalar(expected.m, expected.m));
+	ASSERT_TRUE(Mat4::invert(m.m, m.m));
+	ASSERT_TRUE(nearEqual(m.m, expected.m));
+}
+
+TEST_F(Mat4Test, Transpose)
+{
+	auto m = randomMat4();
+	Mat4 t;
+
+	Mat4::transpose(m.m, t.m);
+
+	for (auto i = 0; i < 4; ++i)
+		for (auto j = 0; j < 4; ++j)
+			ASSERT_EQ(t.m[i * 4 + j], m.m[j * 4 + i]);
+
+	Mat4::transpose(t.m, t.m);
+
+	ASSERT_TRUE(t == m);
+}
+
+TEST_F(Mat4Test, MultiplyBatch)
+{
+	const unsigned int numMatrices = 10;
+	std::vector<float> a(numMatrices * 16);
+	std::vector<float> b(numMatrices * 16);
+	std::vector<float> output(numMatrices * 16);
+
+	for (auto i = 0u; i < a.size(); ++i)
+	{
+		a[i] = random(10.f);
+		b[i] = random(10.f);
+	}
+
+	Mat4::multiply(&a[0], &b[0], &output[0], numMatrices);
+
+	for (auto i = 0u; i < numMatrices; ++i)
+	{
+		Mat4 expected;
+
+		Mat4::multiplyScalar(&a[i * 16], &b[i * 16], expected.m);
+
+		ASSERT_TRUE(nearEqual(&output[i * 16], expected.m));
+	}
+}
+
+TEST_F(Mat4Test, TransformPointsMatchesScalar)
+{
+	const unsigned int numPoints = 33;
+	const unsigned int stride = 5;
+	auto m = randomMat4(10.f);
+	std::vector<float> points(numPoints * stride);
+
+	for (auto& value : points)
+		value = random(10.f);
+
+	auto expected = points;
+	auto output = points;
+
+	Mat4::transformPointsScalar(m.m, &points[0], &expected[0], numPoints, stride);
+	Mat4::transformPoints(m.m, &output[0], &output[0], numPoints, stride);
+
+	for (auto i = 0u; i < points.size(); ++i)
+	{
+		if (i % stride < 3)
+			ASSERT_TRUE(nearEqual(output[i], expected[i], 1e-2f));
+		else
+			ASSERT_EQ(output[i], points[i]);
+	}
+}
+
+// benchmark, run with --gtest_also_run_disabled_tests
+TEST_F(Mat4Test, DISABLED_KernelsBenchmark)
+{
+	const unsigned int numIterations = 100000;
+	const unsigned int numPoints = 100000;
+	auto matrices = std::vector<Mat4>(64);
+	auto points = std::vector<float>(numPoints * 3);
+	auto output = Mat4::identity();
+	auto accumulator = 0.f;
+
+	for (auto& m : matrices)
+		m = Matrix4x4::create()->appendRotationX(random(3.f))->appendScale(random(2.f) + 1.f)->appendTranslation(random(), random(), random())->toMat4();
+
+	for (auto& value : points)
+		value = random();
+
+	auto measure = [&](std::function<void(unsigned int)> loop, unsigned int numLoops)
+	{
+		auto start = std::chrono::high_resolution_clock::now();
+
+		for (auto i = 0u; i < numLoops; ++i)
+			loop(i);
+
+		accumulator += output.m[0];
+
+		return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start).count();
+	};
+
+	auto matrix = Matrix4x4::create();
+	auto matrices4x4 = std::vector<Matrix4x4::Ptr>();
+
+	for (auto& m : matrices)
+		matrices4x4.push_back(Matrix4x4::create()->initialize(m));
+
+	auto multiplyPtrTime = measure([&](unsigned int i)
+	{
+		matrix->copyFrom(matrices4x4[i & 63])->prepend(matrices4x4[(i + 1) & 63]);
+	}, numIterations);
+	auto multiplyScalarTime = measure([&](unsigned int i)
+	{
+		Mat4::multiplyScalar(matrices[i & 63].m, matrices[(i + 1) & 63].m, output.m);
+	}, numIterations);
+	auto multiplyTime = measure([&](unsigned int i)
+	{
+		Mat4::multiply(matrices[i & 63].m, matrices[(i + 1) & 63].m, output.m);
+	}, numIterations);
+	auto invertPtrTime = measure([&](unsigned int i)
+	{
+		matrix->copyFrom(matrices4x4[i & 63])->invert();
+	}, numIterations);
+	auto invertScalarTime = measure([&](unsigned int i)
+	{
+		Mat4::invertScalar(matrices[i & 63].m, output.m);
+	}, numIterations);
+	auto invertTime = measure([&](unsigned int i)
+	{
+		Mat4::invert(matrices[i & 63].m, output.m);
+	}, numIterations);
+
+	matrix->initialize(matrices[0]);
+
+	auto vector = Vector3::create();
+
+	auto transformPtrTime = measure([&](unsigned int i)
+	{
+		vector->setTo(points[i * 3], points[i * 3 + 1], points[i * 3 + 2]);
+		matrix->transform(vector, vector);
+	}, numPoints);
+	auto transformScalarTime = measure([&](unsigned int i)
+	{
+		Mat4::transformPointsScalar(matrices[0].m, &points[0], &points[0], numPoints);
+	}, 1);
+	auto transformTime = measure([&](unsigned int i)
+	{
+		Mat4::transformPoints(matrices[0].m, &points[0], &points[0], numPoints);
+	}, 1);
+
+	std::cout << numIterations << " multiplications: " << multiplyPtrTime << "us with Matrix4x4::prepend(), "
+		<< multiplyScalarTime << "us scalar, " << multiplyTime << "us simd" << std::endl
+		<< numIterations << " inversions: " << invertPtrTime << "us with Matrix4x4::invert(), "
+		<< invertScalarTime << "us scalar, " << invertTime << "us simd" << std::endl
+		<< numPoints << " point transforms: " << transformPtrTime << "us with Matrix4x4::transform(), "
+		<< transformScalarTime << "us scalar batch, " << transformTime << "us simd batch" << std::endl;
+
+	accumulator += matrix->data()[0];
+
+	ASSERT_FALSE(std::isnan(accumulator));
+}
@@ -0,0 +1,269 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "OctTreeTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::math;
+using namespace minko::component;
+using namespace minko::scene;
+
+TEST_F(OctTreeTest, SpatialIndexFollowsScene)
+{
+	auto spatialIndex = SpatialIndex::create(100.f, 8);
+	auto root = Node::create()
+		->addComponent(SceneManager::create(MinkoTests::canvas()))
+		->addComponent(spatialIndex);
+	auto n1 = createCulledNode(0.f, 0.f, 0.f);
+	auto n2 = createCulledNode(10.f, 0.f, 0.f);
+	auto octTree = spatialIndex->octTree();
+
+	root->addChild(n1);
+	n1->addChild(n2);
+
+	ASSERT_TRUE(octTree->contains(n1));
+	ASSERT_TRUE(octTree->contains(n2));
+
+	n2->layouts(Layout::Group::DEFAULT);
+
+	ASSERT_FALSE(octTree->contains(n2));
+
+	n2->layouts(Layout::Group::DEFAULT | Layout::Group::CULLING);
+
+	ASSERT_TRUE(octTree->contains(n2));
+
+	root->removeChild(n1);
+
+	ASSERT_EQ(octTree->numNodes(), 0);
+}
+
+TEST_F(OctTreeTest, SmallNodesGoDeeper)
+{
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto spatialIndex = SpatialIndex::create(128.f, 8);
+	auto root = Node::create()
+		->addComponent(sceneManager)
+		->addComponent(spatialIndex);
+	auto small = createCulledNode(10.f, 10.f, 10.f, 1.f);
+	auto large = createCulledNode(10.f, 10.f, 10.f, 60.f);
+	auto outside = createCulledNode(1000.f, 0.f, 0.f, 1.f);
+
+	root->addChild(small)->addChild(large)->addChild(outside);
+	sceneManager->nextFrame(0.f, 0.f);
+
+	auto octTree = spatialIndex->octTree()->update();
+
+	// a 1 unit box fits in the loose bounds of a 1 unit cell, 128 / 2^7
+	ASSERT_EQ(octTree->depth(small), 7);
+	ASSERT_EQ(octTree->depth(large), 1);
+	ASSERT_EQ(octTree->depth(outside), 0);
+}
+
+TEST_F(OctTreeTest, MovingNodesAreTracked)
+{
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto spatialIndex = SpatialIndex::create(100.f, 8);
+	auto root = Node::create()
+		->addComponent(sceneManager)
+		->addComponent(spatialIndex);
+	auto node = createCulledNode(0.f, 0.f, -10.f);
+	auto frustum = Frustum::create();
+	auto octTree = spatialIndex->octTree();
+	auto numInside = 0;
+	auto numOutside = 0;
+	auto test = [&]()
+	{
+		numInside = 0;
+		numOutside = 0;
+		octTree->testFrustum(frustum, [&](Node::Ptr n) { ++numInside; }, [&](Node::Ptr n) { ++numOutside; });
+	};
+
+	frustum->updateFromMatrix(Matrix4x4::create()->perspective(.785f, 1.f, .1f, 100.f));
+
+	root->addChild(node);
+	sceneManager->nextFrame(0.f, 0.f);
+	test();
+
+	ASSERT_EQ(numInside, 1);
+	ASSERT_EQ(numOutside, 0);
+
+	auto revision = octTree->revision();
+
+	node->component<Transform>()->matrix()->appendTranslation(40.f, 0.f, 0.f);
+	sceneManager->nextFrame(0.f, 0.f);
+	test();
+
+	ASSERT_GT(octTree->revision(), revision);
+	ASSERT_EQ(numInside, 0);
+	ASSERT_EQ(numOutside, 1);
+
+	node->component<Transform>()->matrix()->appendTranslation(-40.f, 0.f, 0.f);
+	sceneManager->nextFrame(0.f, 0.f);
+	test();
+
+	ASSERT_EQ(numInside, 1);
+	ASSERT_EQ(numOutside, 0);
+}
+
+TEST_F(OctTreeTest, SurfaceChangesAreTracked)
+{
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto spatialIndex = SpatialIndex::create(128.f, 8);
+	auto root = Node::create()
+		->addComponent(sceneManager)
+		->addComponent(spatialIndex);
+	auto node = Node::create()->addComponent(Transform::create());
+	auto octTree = spatialIndex->octTree();
+
+	node->layouts(Layout::Group::DEFAULT | Layout::Group::CULLING);
+	root->addChild(node);
+	sceneManager->nextFrame(0.f, 0.f);
+
+	// no surface yet: an empty box at the origin
+	ASSERT_EQ(octTree->update()->depth(node), 8);
+
+	auto geometry = MinkoTests::createGeometry({ -30.f, -30.f, -30.f, 30.f, 30.f, 30.f, 30.f, -30.f, 0.f }, { 0, 1, 2 });
+
+	// the node does not move, its bounds change with its surfaces
+	node->addComponent(MinkoTests::createSurface(geometry));
+	ASSERT_EQ(octTree->update()->depth(node), 1);
+
+	// and with their geometry
+	geometry->vertexBuffer("position")->data() = { -.5f, -.5f, -.5f, .5f, .5f, .5f, .5f, -.5f, 0.f };
+	node->component<BoundingBox>()->update();
+	ASSERT_EQ(octTree->update()->depth(node), 7);
+}
+
+TEST_F(OctTreeTest, ManyMovingNodes)
+{
+	const unsigned int numNodes = 5000;
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto spatialIndex = SpatialIndex::create(1000.f, 8);
+	auto root = Node::create()
+		->addComponent(sceneManager)
+		->addComponent(spatialIndex);
+	auto frustum = Frustum::create();
+	auto octTree = spatialIndex->octTree();
+	std::vector<Node::Ptr> nodes;
+
+	for (auto i = 0u; i < numNodes; ++i)
+	{
+		auto node = createCulledNode((float)(i % 100) * 8.f - 400.f, (float)(i / 100) * 8.f - 200.f, -100.f);
+
+		nodes.push_back(node);
+		root->addChild(node);
+	}
+
+	frustum->updateFromMatrix(Matrix4x4::create()->perspective(.785f, 1.f, .1f, 1000.f));
+	sceneManager->nextFrame(0.f, 0.f);
+
+	auto numInside = 0u;
+
+	for (auto frame = 0; frame < 10; ++frame)
+	{
+		for (auto& node : nodes)
+			node->component<Transform>()->matrix()->appendTranslation(5.f, 0.f, 0.f);
+		sceneManager->nextFrame(0.f, 0.f);
+
+		numInside = 0;
+		octTree->testFrustum(frustum, [&](Node::Ptr n) { ++numInside; }, [&](Node::Ptr n) { });
+	}
+
+	ASSERT_EQ(octTree->numNodes(), numNodes);
+	ASSERT_GT(numInside, 0u);
+	ASSERT_LT(numInside, numNodes);
+}
+
+TEST_F(OctTreeTest, TestFrustumBatchMatchesOctants)
+{
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto spatialIndex = SpatialIndex::create(1000.f, 8);
+	auto root = Node::create()
+		->addComponent(sceneManager)
+		->addComponent(spatialIndex);
+	auto frustum = Frustum::create();
+	auto octTree = spatialIndex->octTree();
+	std::set<Node::Ptr> inside;
+	std::set<Node::Ptr> batchInside;
+	auto numOutside = 0u;
+	auto numBatchOutside = 0u;
+
+	for (auto i = 0u; i < 1000; ++i)
+		root->addChild(createCulledNode((float)(i % 10) * 20.f - 100.f, (float)(i / 10 % 10) * 20.f - 100.f, (float)(i / 100) * -20.f + 50.f));
+
+	// free object ids must be skipped
+	root->removeChild(root->children()[10]);
+	root->removeChild(root->children()[500]);
+
+	frustum->updateFromMatrix(Matrix4x4::create()->perspective(.785f, 1.f, .1f, 100.f));
+	sceneManager->nextFrame(0.f, 0.f);
+
+	octTree->testFrustum(frustum, [&](Node::Ptr n) { inside.insert(n); }, [&](Node::Ptr n) { ++numOutside; });
+
+	auto numVisible = octTree->testFrustumBatch(
+		frustum,
+		[&](Node::Ptr n) { batchInside.insert(n); },
+		[&](Node::Ptr n) { ++numBatchOutside; }
+	);
+
+	ASSERT_EQ(numVisible, batchInside.size());
+	ASSERT_EQ(batchInside.size() + numBatchOutside, 998u);
+	ASSERT_GT(batchInside.size(), 0u);
+	ASSERT_LT(batchInside.size(), 998u);
+	// the octant walk is conservative: it may report more visible nodes, never less
+	for (auto& node : batchInside)
+		ASSERT_EQ(inside.count(node), 1u);
+}
+
+TEST_F(OctTreeTest, CastSortedByDistance)
+{
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto spatialIndex = SpatialIndex::create(128.f, 8);
+	auto root = Node::create()
+		->addComponent(sceneManager)
+		->addComponent(spatialIndex);
+	auto far = createCulledNode(0.f, 0.f, -50.f, 2.f);
+	auto near = createCulledNode(0.f, 0.f, -10.f, 2.f);
+	auto aside = createCulledNode(20.f, 0.f, -10.f, 2.f);
+	auto behind = createCulledNode(0.f, 0.f, 10.f, 2.f);
+	auto outside = createCulledNode(0.f, 0.f, -1000.f, 2.f);
+	std::vector<std::pair<float, Node::Ptr>> hits;
+
+	root->addChild(far)->addChild(near)->addChild(aside)->addChild(behind)->addChild(outside);
+	sceneManager->nextFrame(0.f, 0.f);
+
+	auto octTree = spatialIndex->octTree();
+	auto ray = Ray::create(Vector3::create(0.f, 0.f, 0.f), Vector3::create(0.f, 0.f, -1.f));
+
+	ASSERT_EQ(octTree->cast(ray, hits), 3u);
+	ASSERT_EQ(hits[0].second, near);
+	ASSERT_EQ(hits[1].second, far);
+	ASSERT_EQ(hits[2].second, outside);
+	ASSERT_NEAR(hits[0].first, 9.f, 1e-4f);
+
+	ASSERT_EQ(octTree->cast(ray, hits, 100.f), 2u);
+
+	near->component<Transform>()->matrix()->appendTranslation(5.f, 0.f, 0.f);
+	sceneManager->nextFrame(0.f, 0.f);
+
+	ASSERT_EQ(octTree->cast(ray, hits, 100.f), 1u);
+	ASSERT_EQ(hits[0].second, far);
+}
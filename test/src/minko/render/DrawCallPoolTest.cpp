@@ -0,0 +1,47 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "DrawCallPoolTest.hpp"
+
+#include "minko/render/DrawCallPool.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+TEST_F(DrawCallPoolTest, TargetRanks)
+{
+	// GL texture names grow past the width of the target field of the sort keys, multiples of 128 included
+	std::vector<int> targetIds = { 384, 300, 256, 128, 127, 5 };
+
+	for (uint i = 0; i < targetIds.size(); ++i)
+		ASSERT_EQ(DrawCallPool::getTargetRank(targetIds, targetIds[i]), i);
+}
+
+TEST_F(DrawCallPoolTest, TargetRanksPrecedeBackBuffer)
+{
+	std::vector<int> targetIds;
+
+	for (int id = 1000; id > 0; --id)
+		targetIds.push_back(id);
+
+	// the back buffer rank is never given to a render target
+	ASSERT_EQ(DrawCallPool::getTargetRank(targetIds, 1000), 0u);
+	ASSERT_EQ(DrawCallPool::getTargetRank(targetIds, 1), DrawCallPool::NO_TARGET_RANK - 1);
+	ASSERT_EQ(DrawCallPool::getTargetRank(targetIds, 1000 - (int)DrawCallPool::NO_TARGET_RANK), DrawCallPool::NO_TARGET_RANK - 1);
+}
@@ -0,0 +1,144 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "OcclusionBufferTest.hpp"
+
+using namespace minko;
+using namespace minko::math;
+using namespace minko::render;
+
+// a quad covering [-1, 1] x [-1, 1] at z = 0
+static const float QUAD_VERTICES[] = {
+	-1.f, -1.f, 0.f,
+	1.f, -1.f, 0.f,
+	1.f, 1.f, 0.f,
+	-1.f, 1.f, 0.f
+};
+static const unsigned short QUAD_INDICES[] = { 0, 1, 2, 0, 2, 3 };
+
+static
+Mat4
+createWorldToScreen()
+{
+	// a camera at the origin, looking down -z
+	auto projection = Matrix4x4::create()->perspective(.785f, 1.f, .1f, 100.f);
+
+	return Mat4::load(projection->data().data());
+}
+
+TEST_F(OcclusionBufferTest, RasterizeTriangleMatchesScalar)
+{
+	const uint width = 64;
+	const uint height = 32;
+	std::vector<float> depth(width * height, 1.f);
+	std::vector<float> depthScalar(width * height, 1.f);
+
+	srand(42);
+	for (auto i = 0; i < 200; ++i)
+	{
+		Vec3 v[3];
+
+		for (auto j = 0; j < 3; ++j)
+		{
+			v[j].x = (float)(rand() % 1000) / 1000.f * (width + 20.f) - 10.f;
+			v[j].y = (float)(rand() % 1000) / 1000.f * (height + 20.f) - 10.f;
+			v[j].z = (float)(rand() % 1000) / 1000.f;
+		}
+
+		OcclusionBuffer::rasterizeTriangle(v[0], v[1], v[2], depth.data(), width, height);
+		OcclusionBuffer::rasterizeTriangleScalar(v[0], v[1], v[2], depthScalar.data(), width, height);
+	}
+
+	for (uint i = 0; i < width * height; ++i)
+		ASSERT_FLOAT_EQ(depth[i], depthScalar[i]);
+}
+
+TEST_F(OcclusionBufferTest, HierarchyKeepsFarthestDepth)
+{
+	auto buffer = OcclusionBuffer::create(16, 8);
+
+	buffer->clear();
+	buffer->rasterize(
+		createWorldToScreen().m, QUAD_VERTICES, 4, 3, 0, QUAD_INDICES, 6
+	);
+	buffer->buildHierarchy();
+
+	ASSERT_EQ(buffer->numLevels(), 5u);
+	ASSERT_EQ(buffer->depth(buffer->numLevels() - 1).size(), 1u);
+	ASSERT_FLOAT_EQ(buffer->depth(buffer->numLevels() - 1)[0], 1.f);
+
+	for (uint level = 1; level < buffer->numLevels(); ++level)
+	{
+		auto& fine = buffer->depth(level - 1);
+		auto& coarse = buffer->depth(level);
+		auto fineMin = *std::min_element(fine.begin(), fine.end());
+
+		ASSERT_GE(*std::min_element(coarse.begin(), coarse.end()), fineMin);
+	}
+}
+
+TEST_F(OcclusionBufferTest, BoxBehindQuadIsOccluded)
+{
+	auto buffer = OcclusionBuffer::create();
+	auto worldToScreen = createWorldToScreen();
+	auto quadToWorld = Matrix4x4::create()->appendScale(1.5f, 1.5f, 1.f)->appendTranslation(0.f, 0.f, -5.f);
+	Mat4 quadToScreen;
+
+	Mat4::multiply(worldToScreen.m, quadToWorld->data().data(), quadToScreen.m, 1);
+
+	buffer->clear();
+	buffer->rasterize(quadToScreen.m, QUAD_VERTICES, 4, 3, 0, QUAD_INDICES, 6);
+	buffer->buildHierarchy();
+
+	// behind the quad
+	ASSERT_FALSE(buffer->testBox(worldToScreen.m, Vec3 { -.5f, -.5f, -11.f }, Vec3 { .5f, .5f, -10.f }));
+	// in front of the quad
+	ASSERT_TRUE(buffer->testBox(worldToScreen.m, Vec3 { -.5f, -.5f, -3.f }, Vec3 { .5f, .5f, -2.f }));
+	// behind the quad, but larger than it on screen
+	ASSERT_TRUE(buffer->testBox(worldToScreen.m, Vec3 { -20.f, -.5f, -11.f }, Vec3 { 20.f, .5f, -10.f }));
+	// crossing the near plane
+	ASSERT_TRUE(buffer->testBox(worldToScreen.m, Vec3 { -.5f, -.5f, -11.f }, Vec3 { .5f, .5f, 1.f }));
+}
+
+TEST_F(OcclusionBufferTest, BoxPeekingPastOccluderEdge)
+{
+	// the identity maps [-1, 1] to the 16 x 16 pixels of the buffer, 8 pixels per unit
+	auto buffer = OcclusionBuffer::create(16, 16);
+	auto identity = Mat4::load(Matrix4x4::create()->data().data());
+	// the right edge of the occluder lies at x = 8.6 on screen, beyond the center of the pixel 8
+	const float occluderVertices[] = {
+		-1.f, -1.f, 0.f,
+		.075f, -1.f, 0.f,
+		.075f, 1.f, 0.f,
+		-1.f, 1.f, 0.f
+	};
+
+	buffer->clear();
+	buffer->rasterize(identity.m, occluderVertices, 4, 3, 0, QUAD_INDICES, 6);
+	buffer->buildHierarchy();
+
+	ASSERT_LT(buffer->depth(0)[8], 1.f);
+
+	// behind the occluder, covering less than a pixel between x = 8.7 and x = 8.9: only visible past its edge
+	ASSERT_TRUE(buffer->testBox(identity.m, Vec3 { .0875f, -.05f, .5f }, Vec3 { .1125f, .05f, .6f }));
+	// behind the occluder, well inside its silhouette
+	ASSERT_FALSE(buffer->testBox(identity.m, Vec3 { -.75f, -.5f, .5f }, Vec3 { -.5f, .5f, .6f }));
+	// in front of the occluder
+	ASSERT_TRUE(buffer->testBox(identity.m, Vec3 { -.75f, -.5f, -.6f }, Vec3 { -.5f, .5f, -.5f }));
+}
@@ -101,3 +101,47 @@ TEST_F(NodeSetTest, DescendantsBreadthFirst5)
 		scene = scene->children()[0];
 	}
 }
+
+TEST_F(NodeSetTest, ComponentLookupFollowsAddAndRemove)
+{
+	auto node = Node::create();
+	auto light = component::AmbientLight::create();
+
+	ASSERT_FALSE(node->hasComponent<component::AbstractLight>());
+	ASSERT_EQ(node->component<component::AmbientLight>(), nullptr);
+
+	node->addComponent(light);
+
+	ASSERT_TRUE(node->hasComponent<component::AbstractLight>());
+	ASSERT_EQ(node->component<component::AmbientLight>(), light);
+	ASSERT_EQ(node->component<component::AbstractLight>(), light);
+	ASSERT_EQ(node->component<component::AbstractComponent>(), light);
+	ASSERT_FALSE(node->hasComponent<component::Transform>());
+
+	node->removeComponent(light);
+
+	ASSERT_FALSE(node->hasComponent<component::AbstractLight>());
+	ASSERT_EQ(node->component<component::AbstractComponent>(), nullptr);
+}
+
+TEST_F(NodeSetTest, WithComponents)
+{
+	auto scene = Node::create()
+		->addChild(Node::create()
+				   ->addComponent(component::Transform::create())
+				   ->addComponent(component::AmbientLight::create()))
+		->addChild(Node::create()
+				   ->addComponent(component::Transform::create()))
+		->addChild(Node::create()
+				   ->addComponent(component::AmbientLight::create()));
+	auto descendants = NodeSet::create(scene)->descendants(true);
+
+	auto transforms = descendants->withComponents<component::Transform>();
+	auto lights = descendants->withComponents<component::AbstractLight>();
+	auto both = descendants->withComponents<component::Transform, component::AbstractLight>();
+
+	ASSERT_EQ(transforms->size(), 2);
+	ASSERT_EQ(lights->size(), 2);
+	ASSERT_EQ(both->size(), 1);
+	ASSERT_EQ(both->nodes()[0], scene->children()[0]);
+}